@@ -2,6 +2,8 @@
 #define JR_ALGO_BUFFER_H
 
 #include <cstddef>
+#include <new>
+#include <utility>
 
 namespace jrSTL {
     /* RAII方式管理algorithm中分配的缓存空间 */
@@ -13,7 +15,7 @@ namespace jrSTL {
 
         public:
             _buffer(size_t len)
-                : _b(new T[len]) {
+                : _b(new(std::nothrow) T[len]) {
                 _len = _b ? len : 0;
             }
 
@@ -38,6 +40,67 @@ namespace jrSTL {
                 return _b[n];
             }
     };
+
+    /* 归并类算法使用的临时缓冲区：按需申请，内存不足时逐次减半，直至放弃（length()为0）
+     * 不要求T可默认构造：以*seed为种子链式移动构造全部对象，最后把值移回*seed，
+     * 缓冲区中始终是已构造的对象，算法只做移动赋值
+     */
+    template< class T >
+    class _temporary_buffer {
+        private:
+            T *_b;
+            size_t _len;
+
+        public:
+            template< class ForwardIt >
+            _temporary_buffer(ForwardIt seed, size_t len)
+                : _b(nullptr), _len(0) {
+                while(len > 0) {
+                    _b = static_cast<T *>(::operator new(len * sizeof(T), std::nothrow));
+                    if(_b)
+                        break;
+                    len /= 2;
+                }
+                if(!_b)
+                    return;
+                size_t i = 0;
+                try {
+                    ::new(static_cast<void *>(_b)) T(std::move(*seed));
+                    for(i = 1; i < len; ++i)
+                        ::new(static_cast<void *>(_b + i)) T(std::move(_b[i - 1]));
+                } catch(...) {
+                    // 构造失败时放弃缓冲区，退回无缓冲区的算法
+                    if(i > 0) {
+                        *seed = std::move(_b[i - 1]);
+                        for(size_t j = 0; j < i; ++j)
+                            _b[j].~T();
+                    }
+                    ::operator delete(_b);
+                    _b = nullptr;
+                    return;
+                }
+                *seed = std::move(_b[len - 1]);
+                _len = len;
+            }
+
+            _temporary_buffer(const _temporary_buffer&) = delete;
+            _temporary_buffer& operator=(const _temporary_buffer&) = delete;
+
+            ~_temporary_buffer() {
+                for(size_t i = 0; i < _len; ++i)
+                    _b[i].~T();
+                if(_b)
+                    ::operator delete(_b);
+            }
+
+            T *begin() {
+                return _b;
+            }
+
+            size_t length() const {
+                return _len;
+            }
+    };
 }
 
 #endif // JR_ALGO_BUFFER_H
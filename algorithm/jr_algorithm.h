@@ -3,12 +3,71 @@
 
 #include <cstring>
 #include <cstddef>
+#include <cstdint>
 #include <utility>
 #include <type_traits>
 #include "jr_algo_buffer.h"
+#include "jr_simd.h"
 #include "../container/utils/jr_heap.h"
 
 namespace jrSTL {
+    /* 连续区间按字节操作的条件（只在两端都是连续迭代器时才检查元素类型）：
+     * 拷贝、移动：元素类型相同（忽略const）且可平凡拷贝，使用memmove
+     * 相等比较：整数或指针，值相等即表示相同，使用memcmp
+     * 字典序比较：单字节无符号整数，memcmp的字节序即为其大小顺序
+     */
+    template< class T >
+    struct _iter_elem {
+        typedef typename std::remove_reference<decltype(*std::declval<T&>())>::type type;
+    };
+
+    template< class InputIt, class OutputIt,
+              bool = is_contiguous_iterator<InputIt>::value &&
+                     is_contiguous_iterator<OutputIt>::value >
+    struct _is_memmovable : std::false_type {};
+
+    template< class InputIt, class OutputIt >
+    struct _is_memmovable<InputIt, OutputIt, true>
+            : std::integral_constant<bool,
+                    std::is_same<typename std::remove_const<typename _iter_elem<InputIt>::type>::type,
+                                 typename _iter_elem<OutputIt>::type>::value &&
+                    !std::is_volatile<typename _iter_elem<OutputIt>::type>::value &&
+                    std::is_trivially_copyable<typename _iter_elem<OutputIt>::type>::value> {};
+
+    template< class InputIt1, class InputIt2,
+              bool = is_contiguous_iterator<InputIt1>::value &&
+                     is_contiguous_iterator<InputIt2>::value >
+    struct _is_memcmp_equal : std::false_type {};
+
+    template< class InputIt1, class InputIt2 >
+    struct _is_memcmp_equal<InputIt1, InputIt2, true> {
+        typedef typename std::remove_const<typename _iter_elem<InputIt1>::type>::type type1;
+        typedef typename std::remove_const<typename _iter_elem<InputIt2>::type>::type type2;
+        static const bool value = std::is_same<type1, type2>::value &&
+                                  !std::is_volatile<type1>::value &&
+                                  (std::is_integral<type1>::value || std::is_pointer<type1>::value);
+    };
+
+    template< class InputIt1, class InputIt2, bool = _is_memcmp_equal<InputIt1, InputIt2>::value >
+    struct _is_memcmp_less : std::false_type {};
+
+    template< class InputIt1, class InputIt2 >
+    struct _is_memcmp_less<InputIt1, InputIt2, true>
+            : std::integral_constant<bool,
+                    sizeof(typename _iter_elem<InputIt1>::type) == 1 &&
+                    std::is_unsigned<typename std::remove_const<typename _iter_elem<InputIt1>::type>::type>::value> {};
+
+    // 把[first, first + n)按字节搬移到d_first，两区间可以重叠
+    template< class InputIt, class OutputIt >
+    OutputIt _memmove_n( InputIt first, size_t n, OutputIt d_first ) {
+        typedef typename _iter_elem<OutputIt>::type type;
+        if(n)
+            std::memmove(static_cast<void *>(jrSTL::_to_address(d_first)),
+                         static_cast<const void *>(jrSTL::_to_address(first)),
+                         n * sizeof(type));
+        return d_first + static_cast<typename jrSTL::iterator_traits<OutputIt>::difference_type>(n);
+    }
+
     /*不修改序列的操作*/
     template< class InputIt, class UnaryPredicate >
     bool all_of( InputIt first, InputIt last,
@@ -67,10 +126,28 @@ namespace jrSTL {
 
     template< class InputIt, class T >
     typename jrSTL::iterator_traits<InputIt>::difference_type
-    count( InputIt first, InputIt last, const T &value )
+    _count( InputIt first, InputIt last, const T &value, std::false_type )
     { return jrSTL::count_if(first, last,
                               [&value](const T& m)->bool { return value == m; }); }
 
+    template< class V, class T >
+    std::ptrdiff_t _count( V *first, V *last, const T &value, std::true_type ) {
+        typedef typename std::remove_const<V>::type type;
+        if(!jrSTL::_simd_representable<type>(value))
+            return 0;
+        return static_cast<std::ptrdiff_t>(
+                jrSTL::_simd_count(first, static_cast<size_t>(last - first),
+                                   static_cast<type>(value)));
+    }
+
+    // 算术类型的连续区间使用SIMD
+    template< class InputIt, class T >
+    typename jrSTL::iterator_traits<InputIt>::difference_type
+    count( InputIt first, InputIt last, const T &value ) {
+        return jrSTL::_count(first, last, value,
+                             std::integral_constant<bool, _simd_comparable<InputIt, T>::value>());
+    }
+
     template< class InputIt1, class InputIt2, class BinaryPredicate >
     std::pair<InputIt1, InputIt2>
     mismatch( InputIt1 first1, InputIt1 last1, InputIt2 first2, BinaryPredicate p ) {
@@ -85,7 +162,7 @@ namespace jrSTL {
 
     template< class InputIt1, class InputIt2 >
     std::pair<InputIt1, InputIt2>
-    mismatch( InputIt1 first1, InputIt1 last1, InputIt2 first2 ) {
+    _mismatch( InputIt1 first1, InputIt1 last1, InputIt2 first2, std::false_type ) {
         typedef typename jrSTL::iterator_traits<InputIt1>::value_type type1;
         typedef typename jrSTL::iterator_traits<InputIt2>::value_type type2;
         return jrSTL::mismatch(first1, last1, first2,
@@ -93,6 +170,34 @@ namespace jrSTL {
                                 ->bool { return a == b; });
     }
 
+    // 以256字节为一块用memcmp跳过相同的部分，再在不同的块内逐个查找
+    template< class InputIt1, class InputIt2 >
+    std::pair<InputIt1, InputIt2>
+    _mismatch( InputIt1 first1, InputIt1 last1, InputIt2 first2, std::true_type ) {
+        typedef typename _iter_elem<InputIt1>::type type;
+        const size_t block = 256 / sizeof(type) ? 256 / sizeof(type) : 1;
+        size_t n = static_cast<size_t>(last1 - first1), i = 0;
+        if(n) {
+            const type *p = jrSTL::_to_address(first1);
+            const type *q = jrSTL::_to_address(first2);
+            while(i + block <= n && std::memcmp(p + i, q + i, block * sizeof(type)) == 0)
+                i += block;
+            while(i < n && p[i] == q[i])
+                ++i;
+        }
+        typedef typename jrSTL::iterator_traits<InputIt1>::difference_type diff1;
+        typedef typename jrSTL::iterator_traits<InputIt2>::difference_type diff2;
+        return std::pair<InputIt1, InputIt2>(first1 + static_cast<diff1>(i),
+                                             first2 + static_cast<diff2>(i));
+    }
+
+    template< class InputIt1, class InputIt2 >
+    std::pair<InputIt1, InputIt2>
+    mismatch( InputIt1 first1, InputIt1 last1, InputIt2 first2 ) {
+        return jrSTL::_mismatch(first1, last1, first2,
+                                std::integral_constant<bool, _is_memcmp_equal<InputIt1, InputIt2>::value>());
+    }
+
     template< class InputIt, class UnaryPredicate >
     InputIt find_if( InputIt first, InputIt last, UnaryPredicate p ) {
         while(first != last) {
@@ -114,12 +219,28 @@ namespace jrSTL {
     }
 
     template< class InputIt, class T >
-    InputIt find( InputIt first, InputIt last, const T& value ) {
+    InputIt _find( InputIt first, InputIt last, const T& value, std::false_type ) {
         return jrSTL::find_if(first, last,
                                [&value](const T& a)
                                ->bool { return value == a; });
     }
 
+    template< class V, class T >
+    V *_find( V *first, V *last, const T& value, std::true_type ) {
+        typedef typename std::remove_const<V>::type type;
+        if(!jrSTL::_simd_representable<type>(value))
+            return last;
+        return first + jrSTL::_simd_find(first, static_cast<size_t>(last - first),
+                                         static_cast<type>(value));
+    }
+
+    // 算术类型的连续区间使用SIMD
+    template< class InputIt, class T >
+    InputIt find( InputIt first, InputIt last, const T& value ) {
+        return jrSTL::_find(first, last, value,
+                            std::integral_constant<bool, _simd_comparable<InputIt, T>::value>());
+    }
+
     template< class ForwardIt1,
               class ForwardIt2,
               class BinaryPredicate >
@@ -218,8 +339,8 @@ namespace jrSTL {
     }
 
     template< class ForwardIt1, class ForwardIt2 >
-    ForwardIt1 search( ForwardIt1 first, ForwardIt1 last,
-                       ForwardIt2 s_first, ForwardIt2 s_last ) {
+    ForwardIt1 _search( ForwardIt1 first, ForwardIt1 last,
+                        ForwardIt2 s_first, ForwardIt2 s_last, std::false_type ) {
         typedef typename jrSTL::iterator_traits<ForwardIt1>::value_type type1;
         typedef typename jrSTL::iterator_traits<ForwardIt2>::value_type type2;
         return jrSTL::search(first, last, s_first, s_last,
@@ -227,6 +348,63 @@ namespace jrSTL {
                               ->bool { return a == b; });
     }
 
+    /* 连续整数区间的首元素预筛选：用memchr（单字节）或SIMD find跳到首元素出现的位置，
+     * 再用equal（memcmp）比较其余部分；候选位置上的比较量超过已扫描长度的两倍时
+     * （如在"aaaa..."中查找"aa...ab"），余下部分改用KMP，保证总体仍为线性
+     */
+    template< class T, class U >
+    T *_search( T *first, T *last, U *s_first, U *s_last, std::true_type ) {
+        typedef typename std::remove_const<T>::type type;
+        size_t m = static_cast<size_t>(s_last - s_first);
+        if(m == 0 || static_cast<size_t>(last - first) < m)
+            return last;
+        const type head = *s_first;
+        T *cur = first, *stop = last - (m - 1);
+        size_t work = 0;
+        while(cur != stop) {
+            size_t n = static_cast<size_t>(stop - cur);
+            if(sizeof(type) == 1) {
+                const void *p = std::memchr(static_cast<const void *>(cur), static_cast<unsigned char>(head), n);
+                cur = p ? cur + (static_cast<const unsigned char *>(p) - reinterpret_cast<const unsigned char *>(cur)) : stop;
+            } else {
+                cur += jrSTL::_simd_find(static_cast<const type *>(cur), n, head);
+            }
+            if(cur == stop)
+                break;
+            T *mis = jrSTL::mismatch(cur + 1, cur + m, s_first + 1).first;
+            if(mis == cur + m)
+                return cur;
+            work += static_cast<size_t>(mis - cur);
+            if(work > 2 * static_cast<size_t>(cur - first) + 256)
+                return jrSTL::_search(cur, last, s_first, s_last, std::false_type());
+            ++cur;
+        }
+        return last;
+    }
+
+    template< class ForwardIt1, class ForwardIt2 >
+    struct _is_prefilter_search : std::false_type {};
+
+    template< class T, class U >
+    struct _is_prefilter_search<T*, U*>
+            : std::integral_constant<bool,
+                    _simd_comparable<T*, U>::value &&
+                    _is_memcmp_equal<T*, U*>::value &&
+                    std::is_integral<typename std::remove_const<T>::type>::value> {};
+
+    template< class ForwardIt1, class ForwardIt2 >
+    ForwardIt1 search( ForwardIt1 first, ForwardIt1 last,
+                       ForwardIt2 s_first, ForwardIt2 s_last ) {
+        return jrSTL::_search(first, last, s_first, s_last,
+                              std::integral_constant<bool, _is_prefilter_search<ForwardIt1, ForwardIt2>::value>());
+    }
+
+    // 使用搜索器（见jr_searcher.h），预处理好的搜索器可以在多次查找间复用
+    template< class ForwardIt, class Searcher >
+    ForwardIt search( ForwardIt first, ForwardIt last, const Searcher& searcher ) {
+        return searcher(first, last).first;
+    }
+
     template< class ForwardIt1,
               class ForwardIt2,
               class BinaryPredicate >
@@ -349,11 +527,13 @@ namespace jrSTL {
 
     template< class ForwardIt, class BinaryPredicate>
     ForwardIt adjacent_find( ForwardIt first, ForwardIt last, BinaryPredicate p ) {
-        while(first != last) {
-            ForwardIt tmp = first;
-            ++first;
-            if(p(*tmp, *first))
-                return tmp;
+        if(first == last)
+            return last;
+        ForwardIt next = first;
+        while(++next != last) {
+            if(p(*first, *next))
+                return first;
+            first = next;
         }
         return last;
     }
@@ -403,54 +583,32 @@ namespace jrSTL {
         return jrSTL::_copy_d(first, last, d_first);
     }
 
-    // 分发器(包装成仿函数是因为函数不能特例化)
+    // 分发器：可按字节搬移时直接memmove，否则按迭代器类型逐个拷贝
     template< class InputIt, class OutputIt >
-    struct _copy_dispatch {
-        OutputIt operator()( InputIt first, InputIt last, OutputIt d_first ) {
-            return jrSTL::_copy(first, last, d_first,
-                                 typename jrSTL::iterator_traits<InputIt>::iterator_category());
-        }
-    };
-
-    // 原生指针类型（判断是否存在平凡特性）
-    template< class T>
-    struct _copy_dispatch<T*, T*>{
-        T* operator()( T* first, T* last, T* d_first ) {
-            if(std::is_trivial<T>::value) {
-                std::memmove(d_first, first, static_cast<size_t>(last - first));
-                return d_first + (last - first);
-            }
-            else
-                return jrSTL::_copy_d(first, last, d_first);
-        }
-    };
+    OutputIt _copy_dispatch( InputIt first, InputIt last, OutputIt d_first, std::false_type ) {
+        return jrSTL::_copy(first, last, d_first,
+                             typename jrSTL::iterator_traits<InputIt>::iterator_category());
+    }
 
-    template< class T>
-    struct _copy_dispatch<const T*, T*>{
-        T* operator()( const T* first, const T* last, T* d_first ) {
-            if(std::is_trivial<T>::value) {
-                std::memmove(d_first, first, static_cast<size_t>(last - first));
-                return d_first + (last - first);
-            }
-            else
-                return jrSTL::_copy_d(first, last, d_first);
-        }
-    };
+    template< class InputIt, class OutputIt >
+    OutputIt _copy_dispatch( InputIt first, InputIt last, OutputIt d_first, std::true_type ) {
+        return jrSTL::_memmove_n(first, static_cast<size_t>(last - first), d_first);
+    }
 
     // 完全泛化版本
     template< class InputIt, class OutputIt >
     OutputIt copy( InputIt first, InputIt last, OutputIt d_first ) {
-        return jrSTL::_copy_dispatch<InputIt, OutputIt >()(first, last, d_first);
+        return jrSTL::_copy_dispatch(first, last, d_first, _is_memmovable<InputIt, OutputIt>());
     }
 
     // char/wchar_t具有平凡特性，可以直接操作内存，速度很快
-    char* copy( const char* first, const char* last, char* d_first) {
+    inline char* copy( const char* first, const char* last, char* d_first) {
         std::memmove(d_first, first, static_cast<size_t>(last - first));
         return d_first + (last - first);
     }
 
-    wchar_t* copy( const wchar_t* first, const wchar_t* last, wchar_t* d_first) {
-        std::memmove(d_first, first, static_cast<size_t>(last - first));
+    inline wchar_t* copy( const wchar_t* first, const wchar_t* last, wchar_t* d_first) {
+        std::memmove(d_first, first, static_cast<size_t>(last - first) * sizeof(wchar_t));
         return d_first + (last - first);
     }
 
@@ -485,8 +643,8 @@ namespace jrSTL {
     }
 
     template< class InputIt, class Size, class OutputIt >
-    OutputIt copy_n( InputIt first, Size count, OutputIt result ) {
-        while(count--) {
+    OutputIt _copy_n( InputIt first, Size count, OutputIt result, std::false_type ) {
+        for(; count > 0; --count) {
             *result = *first;
             ++first;
             ++result;
@@ -494,14 +652,39 @@ namespace jrSTL {
         return result;
     }
 
+    template< class InputIt, class Size, class OutputIt >
+    OutputIt _copy_n( InputIt first, Size count, OutputIt result, std::true_type ) {
+        if(count <= 0)
+            return result;
+        return jrSTL::_memmove_n(first, static_cast<size_t>(count), result);
+    }
+
+    template< class InputIt, class Size, class OutputIt >
+    OutputIt copy_n( InputIt first, Size count, OutputIt result ) {
+        return jrSTL::_copy_n(first, count, result, _is_memmovable<InputIt, OutputIt>());
+    }
+
+    // 可按字节搬移时memmove到[d_last - n, d_last)，memmove允许区间重叠
     template< class BidirIt1, class BidirIt2 >
-    BidirIt2 copy_backward( BidirIt1 first, BidirIt1 last, BidirIt2 d_last ) {
+    BidirIt2 _copy_backward( BidirIt1 first, BidirIt1 last, BidirIt2 d_last, std::true_type ) {
+        BidirIt2 d_first = d_last - (last - first);
+        jrSTL::_memmove_n(first, static_cast<size_t>(last - first), d_first);
+        return d_first;
+    }
+
+    template< class BidirIt1, class BidirIt2 >
+    BidirIt2 _copy_backward( BidirIt1 first, BidirIt1 last, BidirIt2 d_last, std::false_type ) {
         auto res = jrSTL::copy(jrSTL::reverse_iterator<BidirIt1>(last),
                                 jrSTL::reverse_iterator<BidirIt1>(first),
                                 jrSTL::reverse_iterator<BidirIt2>(d_last));
         return res.base();
     }
 
+    template< class BidirIt1, class BidirIt2 >
+    BidirIt2 copy_backward( BidirIt1 first, BidirIt1 last, BidirIt2 d_last ) {
+        return jrSTL::_copy_backward(first, last, d_last, _is_memmovable<BidirIt1, BidirIt2>());
+    }
+
     template< class InputIt, class OutputIt >
     OutputIt _move( InputIt first, InputIt last, OutputIt d_first,
                     input_iterator_tag ) {
@@ -525,20 +708,41 @@ namespace jrSTL {
         return d_first;
     }
 
+    // 可平凡拷贝的类型移动即拷贝
     template< class InputIt, class OutputIt >
-    OutputIt move( InputIt first, InputIt last, OutputIt d_first ) {
+    OutputIt _move_dispatch( InputIt first, InputIt last, OutputIt d_first, std::false_type ) {
         return jrSTL::_move(first, last, d_first,
                      typename jrSTL::iterator_traits<InputIt>::iterator_category());
     }
 
+    template< class InputIt, class OutputIt >
+    OutputIt _move_dispatch( InputIt first, InputIt last, OutputIt d_first, std::true_type ) {
+        return jrSTL::_memmove_n(first, static_cast<size_t>(last - first), d_first);
+    }
+
+    template< class InputIt, class OutputIt >
+    OutputIt move( InputIt first, InputIt last, OutputIt d_first ) {
+        return jrSTL::_move_dispatch(first, last, d_first, _is_memmovable<InputIt, OutputIt>());
+    }
+
     template< class BidirIt1, class BidirIt2 >
-    BidirIt2 move_backward( BidirIt1 first, BidirIt1 last, BidirIt2 d_last ) {
+    BidirIt2 _move_backward( BidirIt1 first, BidirIt1 last, BidirIt2 d_last, std::true_type ) {
+        return jrSTL::_copy_backward(first, last, d_last, std::true_type());
+    }
+
+    template< class BidirIt1, class BidirIt2 >
+    BidirIt2 _move_backward( BidirIt1 first, BidirIt1 last, BidirIt2 d_last, std::false_type ) {
         auto ret = jrSTL::move(jrSTL::reverse_iterator<BidirIt1>(last),
                                 jrSTL::reverse_iterator<BidirIt1>(first),
                                 jrSTL::reverse_iterator<BidirIt2>(d_last));
         return ret.base();
     }
 
+    template< class BidirIt1, class BidirIt2 >
+    BidirIt2 move_backward( BidirIt1 first, BidirIt1 last, BidirIt2 d_last ) {
+        return jrSTL::_move_backward(first, last, d_last, _is_memmovable<BidirIt1, BidirIt2>());
+    }
+
     template< class ForwardIt, class T >
     void _fill( ForwardIt first, ForwardIt last, const T& value, input_iterator_tag ) {
         while(first != last) {
@@ -556,21 +760,79 @@ namespace jrSTL {
         }
     }
 
+    // 连续区间中的算术类型或指针可以考虑memset
+    template< class ForwardIt, bool = is_contiguous_iterator<ForwardIt>::value >
+    struct _is_memsettable : std::false_type {};
+
+    template< class ForwardIt >
+    struct _is_memsettable<ForwardIt, true> {
+        typedef typename _iter_elem<ForwardIt>::type type;
+        static const bool value = !std::is_const<type>::value && !std::is_volatile<type>::value &&
+                                  (std::is_arithmetic<type>::value || std::is_pointer<type>::value);
+    };
+
+    /* 单字节类型总能memset；更宽的类型只有值的各字节均为0时才能memset，
+     * 需要在运行时检查（如浮点数-0.0不是全0）；返回false表示需要逐个赋值
+     */
     template< class ForwardIt, class T >
-    void fill( ForwardIt first, ForwardIt last, const T& value ) {
+    bool _memset_n( ForwardIt first, size_t n, const T& value ) {
+        typedef typename _iter_elem<ForwardIt>::type type;
+        const type v = value;
+        unsigned char bytes[sizeof(type)];
+        std::memcpy(bytes, &v, sizeof(type));
+        for(size_t i = 1; i < sizeof(type); ++i) {
+            if(bytes[i] != bytes[0])
+                return false;
+        }
+        if(sizeof(type) > 1 && bytes[0] != 0)
+            return false;
+        if(n)
+            std::memset(static_cast<void *>(jrSTL::_to_address(first)), bytes[0], n * sizeof(type));
+        return true;
+    }
+
+    template< class ForwardIt, class T >
+    void _fill_dispatch( ForwardIt first, ForwardIt last, const T& value, std::false_type ) {
         jrSTL::_fill(first, last, value,
                 typename jrSTL::iterator_traits<ForwardIt>::iterator_category());
     }
 
+    template< class ForwardIt, class T >
+    void _fill_dispatch( ForwardIt first, ForwardIt last, const T& value, std::true_type ) {
+        if(!jrSTL::_memset_n(first, static_cast<size_t>(last - first), value))
+            jrSTL::_fill(first, last, value, random_access_iterator_tag());
+    }
+
+    template< class ForwardIt, class T >
+    void fill( ForwardIt first, ForwardIt last, const T& value ) {
+        jrSTL::_fill_dispatch(first, last, value,
+                              std::integral_constant<bool, _is_memsettable<ForwardIt>::value>());
+    }
+
     template< class OutputIt, class Size, class T >
-    OutputIt fill_n( OutputIt first, Size count, const T& value ) {
-        while(count--) {
+    OutputIt _fill_n( OutputIt first, Size count, const T& value, std::false_type ) {
+        for(; count > 0; --count) {
             *first = value;
             ++first;
         }
         return first;
     }
 
+    template< class OutputIt, class Size, class T >
+    OutputIt _fill_n( OutputIt first, Size count, const T& value, std::true_type ) {
+        if(count <= 0)
+            return first;
+        OutputIt last = first + count;
+        jrSTL::_fill_dispatch(first, last, value, std::true_type());
+        return last;
+    }
+
+    template< class OutputIt, class Size, class T >
+    OutputIt fill_n( OutputIt first, Size count, const T& value ) {
+        return jrSTL::_fill_n(first, count, value,
+                              std::integral_constant<bool, _is_memsettable<OutputIt>::value>());
+    }
+
     template< class ForwardIt, class Generator >
     void _generate( ForwardIt first, ForwardIt last, Generator g, input_iterator_tag ) {
         while(first != last) {
@@ -833,71 +1095,117 @@ namespace jrSTL {
         return d_first;
     }
 
+    /* 写游标：result指向最后保留的元素，之后与它不等价的元素移动到result的下一个位置，单趟O(n)
+     * 算术类型与指针的连续区间使用无分支写法：总是写入result + 1（不超过当前读取位置），
+     * 只在不等价时前移result，重复段长短随机时不会因分支预测失败而变慢
+     */
+    template< class ForwardIt, class BinaryPredicate >
+    ForwardIt _unique( ForwardIt first, ForwardIt last, BinaryPredicate p, std::false_type ) {
+        ForwardIt result = first;
+        while(++first != last) {
+            if(!p(*result, *first) && ++result != first)
+                *result = std::move(*first);
+        }
+        return ++result;
+    }
+
+    template< class T, class BinaryPredicate >
+    T *_unique( T *first, T *last, BinaryPredicate p, std::true_type ) {
+        T *result = first;
+        // 最后保留的值放在寄存器中，避免每次从刚写入的result处读回
+        T kept = *first;
+        while(++first != last) {
+            T value = *first;
+            bool keep = !p(kept, value);
+            result[1] = value;
+            result += keep;
+            kept = keep ? value : kept;
+        }
+        return result + 1;
+    }
+
+    template< class ForwardIt >
+    struct _is_branchless_unique
+            : std::integral_constant<bool,
+                    is_contiguous_iterator<ForwardIt>::value &&
+                    (std::is_arithmetic<typename _iter_elem<ForwardIt>::type>::value ||
+                     std::is_pointer<typename _iter_elem<ForwardIt>::type>::value)> {};
+
     template< class ForwardIt, class BinaryPredicate >
     ForwardIt unique( ForwardIt first, ForwardIt last, BinaryPredicate p ) {
+        // 第一对相邻的等价元素之前的部分无需移动
+        first = jrSTL::adjacent_find(first, last, p);
         if(first == last)
             return last;
-        ForwardIt ret = first;
-        while(first != last) {
-            ForwardIt next = first;
-            ++next;
-            if(next == last)
-                break;
-            if(p(*next, *first)) {
-                while(p(*next, *first) && (next != last)) {
-                    ++next;
-                }
-                rotate(++first, next, last);
-            } else {
-                ++first;
-                ++ret;
-            }
-        }
-        return ++ret;
+        return jrSTL::_unique(first, last, p,
+                              std::integral_constant<bool, _is_branchless_unique<ForwardIt>::value>());
     }
 
     template< class ForwardIt >
     ForwardIt unique( ForwardIt first, ForwardIt last ) {
         typedef typename jrSTL::iterator_traits<ForwardIt>::value_type type;
-        return unique(first, last,
-                      [](const type& a, const type& b)
-                      ->bool { return a == b; });
+        return jrSTL::unique(first, last,
+                             [](const type& a, const type& b)
+                             ->bool { return a == b; });
     }
 
+    // 输入迭代器只能读取一次，保存最后写出元素的副本用于比较
     template< class InputIt, class OutputIt, class BinaryPredicate >
-    OutputIt unique_copy( InputIt first, InputIt last,
-                          OutputIt d_first, BinaryPredicate p ) {
-        while(first != last) {
-            InputIt next = first;
-            ++next;
-            if(next == last)
-                break;
-            *d_first = *next;
-            ++d_first;
-            if(p(*next, *first)) {
-                while(p(*next, *first) && (next != last)) {
-                    ++next;
-                }
-                first = next;
-            } else {
-                ++first;
+    OutputIt _unique_copy( InputIt first, InputIt last,
+                           OutputIt d_first, BinaryPredicate p,
+                           input_iterator_tag ) {
+        typename jrSTL::iterator_traits<InputIt>::value_type value = *first;
+        *d_first = value;
+        ++d_first;
+        while(++first != last) {
+            if(!p(value, *first)) {
+                value = *first;
+                *d_first = value;
+                ++d_first;
             }
         }
         return d_first;
     }
 
+    // 前向迭代器可以再次读取，只记录最后写出元素的位置
+    template< class ForwardIt, class OutputIt, class BinaryPredicate >
+    OutputIt _unique_copy( ForwardIt first, ForwardIt last,
+                           OutputIt d_first, BinaryPredicate p,
+                           forward_iterator_tag ) {
+        ForwardIt kept = first;
+        *d_first = *first;
+        ++d_first;
+        while(++first != last) {
+            if(!p(*kept, *first)) {
+                kept = first;
+                *d_first = *first;
+                ++d_first;
+            }
+        }
+        return d_first;
+    }
+
+    template< class InputIt, class OutputIt, class BinaryPredicate >
+    OutputIt unique_copy( InputIt first, InputIt last,
+                          OutputIt d_first, BinaryPredicate p ) {
+        if(first == last)
+            return d_first;
+        return jrSTL::_unique_copy(first, last, d_first, p,
+                                   typename jrSTL::iterator_traits<InputIt>::iterator_category());
+    }
+
     template< class InputIt, class OutputIt >
     OutputIt unique_copy( InputIt first, InputIt last, OutputIt d_first ) {
         typedef typename jrSTL::iterator_traits<InputIt>::value_type type;
-        return unique_copy(first, last, d_first,
-                      [](const type& a, const type& b)
-                           ->bool { return a == b; });
+        return jrSTL::unique_copy(first, last, d_first,
+                                  [](const type& a, const type& b)
+                                  ->bool { return a == b; });
     }
 
     template< class ForwardIt1, class ForwardIt2 >
     ForwardIt2 swap_ranges( ForwardIt1 first1, ForwardIt1 last1, ForwardIt2 first2 ) {
         while(first1 != last1) {
-            iter_swap(first1, first2);
+            jrSTL::iter_swap(first1, first2);
             ++first1;
             ++first2;
         }
@@ -943,7 +1251,7 @@ namespace jrSTL {
     }
 
     template< class ForwardIt >
-    ForwardIt max_element(ForwardIt first, ForwardIt last ) {
+    ForwardIt _max_element(ForwardIt first, ForwardIt last, std::false_type ) {
         ForwardIt max_it = first;
         while(first != last) {
             if(*max_it < *first)
@@ -953,6 +1261,20 @@ namespace jrSTL {
         return max_it;
     }
 
+    template< class T >
+    T *_max_element(T *first, T *last, std::true_type ) {
+        if(first == last)
+            return last;
+        size_t imin, imax;
+        jrSTL::_simd_minmax_index(first, static_cast<size_t>(last - first), imin, imax, false);
+        return first + imax;
+    }
+
+    template< class ForwardIt >
+    ForwardIt max_element(ForwardIt first, ForwardIt last ) {
+        return jrSTL::_max_element(first, last, _simd_range<ForwardIt>());
+    }
+
     template< class T >
     const T& min( const T& a, const T& b ) { return a < b ? a : b; }
 
@@ -971,7 +1293,7 @@ namespace jrSTL {
     }
 
     template< class ForwardIt >
-    ForwardIt min_element(ForwardIt first, ForwardIt last ) {
+    ForwardIt _min_element(ForwardIt first, ForwardIt last, std::false_type ) {
         ForwardIt min_it = first;
         while(first != last) {
             if(*first < *min_it)
@@ -981,6 +1303,20 @@ namespace jrSTL {
         return min_it;
     }
 
+    template< class T >
+    T *_min_element(T *first, T *last, std::true_type ) {
+        if(first == last)
+            return last;
+        size_t imin, imax;
+        jrSTL::_simd_minmax_index(first, static_cast<size_t>(last - first), imin, imax, false);
+        return first + imin;
+    }
+
+    template< class ForwardIt >
+    ForwardIt min_element(ForwardIt first, ForwardIt last ) {
+        return jrSTL::_min_element(first, last, _simd_range<ForwardIt>());
+    }
+
     template< class T, class Compare >
     std::pair<const T&,const T&> minmax( const T& a, const T& b, Compare comp )
     { return std::pair<const T&,const T&>(jrSTL::min(a, b, comp),
@@ -991,17 +1327,44 @@ namespace jrSTL {
     { return std::pair<const T&,const T&>(jrSTL::min(a, b),
                                           jrSTL::max(a, b)); }
 
+    // 与std一致：最小值取第一个，最大值取最后一个
     template< class ForwardIt, class Compare >
     std::pair<ForwardIt,ForwardIt>
-    minmax_element( ForwardIt first, ForwardIt last, Compare comp )
-    { return std::pair<ForwardIt,ForwardIt>(jrSTL::min(first, last, comp),
-                                            jrSTL::max(first, last, comp)); }
+    minmax_element( ForwardIt first, ForwardIt last, Compare comp ) {
+        ForwardIt min_it = first, max_it = first;
+        while(first != last) {
+            if(comp(*first, *min_it))
+                min_it = first;
+            if(!comp(*first, *max_it))
+                max_it = first;
+            ++first;
+        }
+        return std::pair<ForwardIt,ForwardIt>(min_it, max_it);
+    }
+
+    template< class ForwardIt >
+    std::pair<ForwardIt,ForwardIt>
+    _minmax_element( ForwardIt first, ForwardIt last, std::false_type ) {
+        typedef typename jrSTL::iterator_traits<ForwardIt>::value_type type;
+        return jrSTL::minmax_element(first, last,
+                                     [](const type& a, const type& b)
+                                     ->bool { return a < b; });
+    }
+
+    template< class T >
+    std::pair<T*,T*> _minmax_element( T *first, T *last, std::true_type ) {
+        if(first == last)
+            return std::pair<T*,T*>(last, last);
+        size_t imin, imax;
+        jrSTL::_simd_minmax_index(first, static_cast<size_t>(last - first), imin, imax, true);
+        return std::pair<T*,T*>(first + imin, first + imax);
+    }
 
     template< class ForwardIt >
     std::pair<ForwardIt,ForwardIt>
-    minmax_element( ForwardIt first, ForwardIt last )
-    { return std::pair<ForwardIt,ForwardIt>(jrSTL::min(first, last),
-                                            jrSTL::max(first, last)); }
+    minmax_element( ForwardIt first, ForwardIt last ) {
+        return jrSTL::_minmax_element(first, last, _simd_range<ForwardIt>());
+    }
 
     /*有序序列的归并操作*/
     // 非原地归并
@@ -1009,49 +1372,19 @@ namespace jrSTL {
     OutputIt merge( InputIt1 first1, InputIt1 last1,
                     InputIt2 first2, InputIt2 last2,
                     OutputIt d_first, Compare comp ) {
-        if(first1 == last1)
-            d_first = copy(first2, last2, d_first);
-        else if(first2 == last2)
-            d_first = copy(first1, last1, d_first);
-        else {
-            if(comp(*first1, *first2)) {
-                while((first1 != last1) && (first2 != last2)) {
-                    if(comp(*first1, *first2)) {
-                        *d_first = *first1;
-                        ++first1;
-                        ++d_first;
-                    }
-                    else {
-                        *d_first = *first2;
-                        ++first2;
-                        ++d_first;
-                    }
-                }
+        // 相等时先取第一个序列的元素，保证稳定
+        while((first1 != last1) && (first2 != last2)) {
+            if(comp(*first2, *first1)) {
+                *d_first = *first2;
+                ++first2;
             } else {
-                while((first1 != last1) && (first2 != last2)) {
-                    if(comp(*first2, *first1)) {
-                        *d_first = *first2;
-                        ++first2;
-                        ++d_first;
-                    }
-                    else {
-                        *d_first = *first1;
-                        ++first1;
-                        ++d_first;
-                    }
-                }
-            }
-            while(first1 != last1) {
                 *d_first = *first1;
                 ++first1;
-                ++d_first;
-            }
-            while(first2 != last2) {
-                *d_first = *first2;
-                ++first2;
-                ++d_first;
             }
+            ++d_first;
         }
+        d_first = jrSTL::copy(first1, last1, d_first);
+        d_first = jrSTL::copy(first2, last2, d_first);
         return d_first;
     }
 
@@ -1066,28 +1399,106 @@ namespace jrSTL {
                              ->bool { return a < b; });
     }
 
-    // 原地归并(完全不同于普通归并！！！！)
-    template< class BidirIt, class Compare>
-    void inplace_merge( BidirIt first, BidirIt middle, BidirIt last, Compare comp ) {
-        if(first == last)
-            return;
-        else {
-            while((first != middle) && (middle != last)) {
-                // 找到左侧第一个大于中点值的位置
-                while((first != middle) && !comp(*middle, *first)) {
-                    ++first;
-                }
-                // 找到右侧与上述位置归并后紧挨着的位置
-                BidirIt tmp = middle;
-                while((middle != last) && comp(*middle, *first)) {
-                    ++middle;
-                }
-                // 将二者中间夹的部分旋转到尾端
-                jrSTL::rotate(first, tmp, middle);
-                // 缩小区间范围，跳过刚刚已完成归并的内容（即被旋转到尾部的范围）
-                jrSTL::advance(first, jrSTL::distance(tmp, middle));
+    template< class ForwardIt, class T, class Compare >
+    ForwardIt lower_bound( ForwardIt first, ForwardIt last, const T& value, Compare comp );
+
+    template< class ForwardIt, class T, class Compare >
+    ForwardIt upper_bound( ForwardIt first, ForwardIt last, const T& value, Compare comp );
+
+    // 左半段移入缓冲区，从前向后归并；相等时左侧优先以保持稳定
+    template< class BidirIt, class T, class Compare >
+    void _merge_lo( BidirIt first, BidirIt middle, BidirIt last,
+                    T *buf, Compare comp ) {
+        T *b = buf, *bend = jrSTL::move(first, middle, buf);
+        BidirIt r = middle, out = first;
+        while(b != bend && r != last) {
+            if(comp(*r, *b)) {
+                *out = std::move(*r);
+                ++r;
+            } else {
+                *out = std::move(*b);
+                ++b;
+            }
+            ++out;
+        }
+        jrSTL::move(b, bend, out);
+    }
+
+    // 右半段移入缓冲区，从后向前归并
+    template< class BidirIt, class T, class Compare >
+    void _merge_hi( BidirIt first, BidirIt middle, BidirIt last,
+                    T *buf, Compare comp ) {
+        T *b = jrSTL::move(middle, last, buf);
+        BidirIt l = middle, out = last;
+        while(b != buf && l != first) {
+            BidirIt lp = l;
+            --lp;
+            if(comp(*(b - 1), *lp)) {
+                l = lp;
+                *--out = std::move(*l);
+            } else {
+                --b;
+                *--out = std::move(*b);
             }
         }
+        jrSTL::move_backward(buf, b, out);
+    }
+
+    /* 自适应归并：较短一侧能放入缓冲区时线性归并；
+     * 否则在较长一侧取中点、于另一侧二分出对应位置，旋转后分两半递归，
+     * 缓冲区为空时即为O(n log n)的无缓冲原地归并
+     */
+    template< class BidirIt, class Distance, class T, class Compare >
+    void _merge_adaptive( BidirIt first, BidirIt middle, BidirIt last,
+                          Distance len1, Distance len2,
+                          T *buf, Distance buf_size, Compare comp ) {
+        if(len1 == 0 || len2 == 0)
+            return;
+        if(len1 + len2 == 2) {
+            if(comp(*middle, *first))
+                jrSTL::iter_swap(first, middle);
+            return;
+        }
+        if(len1 <= len2 && len1 <= buf_size) {
+            jrSTL::_merge_lo(first, middle, last, buf, comp);
+            return;
+        }
+        if(len2 <= buf_size) {
+            jrSTL::_merge_hi(first, middle, last, buf, comp);
+            return;
+        }
+        BidirIt cut1 = first, cut2 = middle;
+        Distance len11, len22;
+        if(len1 > len2) {
+            len11 = len1 / 2;
+            jrSTL::advance(cut1, len11);
+            cut2 = jrSTL::lower_bound(middle, last, *cut1, comp);
+            len22 = jrSTL::distance(middle, cut2);
+        } else {
+            len22 = len2 / 2;
+            jrSTL::advance(cut2, len22);
+            cut1 = jrSTL::upper_bound(first, middle, *cut2, comp);
+            len11 = jrSTL::distance(first, cut1);
+        }
+        BidirIt new_middle = jrSTL::rotate(cut1, middle, cut2);
+        jrSTL::_merge_adaptive(first, cut1, new_middle, len11, len22,
+                               buf, buf_size, comp);
+        jrSTL::_merge_adaptive(new_middle, cut2, last, len1 - len11, len2 - len22,
+                               buf, buf_size, comp);
+    }
+
+    // 原地归并：尽量申请较短一侧大小的缓冲区，申请失败时退化为旋转归并
+    template< class BidirIt, class Compare>
+    void inplace_merge( BidirIt first, BidirIt middle, BidirIt last, Compare comp ) {
+        typedef typename jrSTL::iterator_traits<BidirIt>::value_type type;
+        typedef typename jrSTL::iterator_traits<BidirIt>::difference_type dis_type;
+        dis_type len1 = jrSTL::distance(first, middle);
+        dis_type len2 = jrSTL::distance(middle, last);
+        if(len1 == 0 || len2 == 0)
+            return;
+        jrSTL::_temporary_buffer<type> buf(first, static_cast<size_t>(len1 < len2 ? len1 : len2));
+        jrSTL::_merge_adaptive(first, middle, last, len1, len2, buf.begin(),
+                               static_cast<dis_type>(buf.length()), comp);
     }
 
     template< class BidirIt >
@@ -1112,7 +1523,7 @@ namespace jrSTL {
     }
 
     template< class InputIt1, class InputIt2 >
-    bool equal( InputIt1 first1, InputIt1 last1, InputIt2 first2 ) {
+    bool _equal( InputIt1 first1, InputIt1 last1, InputIt2 first2, std::false_type ) {
         typedef typename jrSTL::iterator_traits<InputIt1>::value_type type1;
         typedef typename jrSTL::iterator_traits<InputIt2>::value_type type2;
         return equal(first1, last1, first2,
@@ -1120,57 +1531,67 @@ namespace jrSTL {
                      ->bool { return a == b; });
     }
 
+    template< class InputIt1, class InputIt2 >
+    bool _equal( InputIt1 first1, InputIt1 last1, InputIt2 first2, std::true_type ) {
+        typedef typename _iter_elem<InputIt1>::type type;
+        size_t n = static_cast<size_t>(last1 - first1);
+        return n == 0 || std::memcmp(jrSTL::_to_address(first1), jrSTL::_to_address(first2),
+                                     n * sizeof(type)) == 0;
+    }
+
+    template< class InputIt1, class InputIt2 >
+    bool equal( InputIt1 first1, InputIt1 last1, InputIt2 first2 ) {
+        return jrSTL::_equal(first1, last1, first2,
+                             std::integral_constant<bool, _is_memcmp_equal<InputIt1, InputIt2>::value>());
+    }
+
     template< class InputIt1, class InputIt2, class Compare >
-    bool _lexicographical_compare( InputIt1 first1, InputIt1 last1,
-                                   InputIt2 first2, InputIt2 last2,
-                                   Compare comp,
-                                   input_iterator_tag,
-                                   input_iterator_tag ) {
+    bool lexicographical_compare( InputIt1 first1, InputIt1 last1,
+                                  InputIt2 first2, InputIt2 last2,
+                                  Compare comp ) {
         while((first1 != last1) && (first2 != last2)) {
-            if(!comp(*first1, *first2))
+            if(comp(*first1, *first2))
+                return true;
+            if(comp(*first2, *first1))
                 return false;
             ++first1;
             ++first2;
         }
-        return first1 == last1;
+        return first1 == last1 && first2 != last2;
     }
 
-    template< class InputIt1, class InputIt2, class Compare >
+    template< class InputIt1, class InputIt2 >
     bool _lexicographical_compare( InputIt1 first1, InputIt1 last1,
                                    InputIt2 first2, InputIt2 last2,
-                                   Compare comp,
-                                   random_access_iterator_tag,
-                                   random_access_iterator_tag ) {
-        if(comp(last1-first1, last2-first2))
-            return true;
-        if(comp(last2-first2, last1-first1))
-            return false;
-        while(first1 != last1) {
-            if(!comp(*first1, *first2))
-                return false;
-            ++first1;
-            ++first2;
-        }
-        return true;
+                                   std::false_type ) {
+        typedef typename jrSTL::iterator_traits<InputIt1>::value_type type1;
+        typedef typename jrSTL::iterator_traits<InputIt2>::value_type type2;
+        return jrSTL::lexicographical_compare(first1, last1, first2, last2,
+                                               [](const type1& a, const type2& b)
+                                               ->bool { return a < b; });
     }
 
-    template< class InputIt1, class InputIt2, class Compare >
-    bool lexicographical_compare( InputIt1 first1, InputIt1 last1,
-                                  InputIt2 first2, InputIt2 last2,
-                                  Compare comp ) {
-        return jrSTL::_lexicographical_compare(first1, last1, first2, last2, comp,
-                                        jrSTL::iterator_traits<InputIt1>::iterator_category(),
-                                        jrSTL::iterator_traits<InputIt2>::iterator_category());
+    // 先比较公共长度部分，相同时短者为小
+    template< class InputIt1, class InputIt2 >
+    bool _lexicographical_compare( InputIt1 first1, InputIt1 last1,
+                                   InputIt2 first2, InputIt2 last2,
+                                   std::true_type ) {
+        size_t n1 = static_cast<size_t>(last1 - first1);
+        size_t n2 = static_cast<size_t>(last2 - first2);
+        size_t n = n1 < n2 ? n1 : n2;
+        if(n) {
+            int r = std::memcmp(jrSTL::_to_address(first1), jrSTL::_to_address(first2), n);
+            if(r)
+                return r < 0;
+        }
+        return n1 < n2;
     }
 
     template< class InputIt1, class InputIt2 >
     bool lexicographical_compare( InputIt1 first1, InputIt1 last1,
                                   InputIt2 first2, InputIt2 last2 ) {
-        typedef typename jrSTL::iterator_traits<InputIt1>::value_type type1;
-        typedef typename jrSTL::iterator_traits<InputIt2>::value_type type2;
-        return jrSTL::lexicographical_compare(first1, last1, first2, last2,
-                                               [](const type1& a, const type2& b)
-                                               ->bool { return a < b; });
+        return jrSTL::_lexicographical_compare(first1, last1, first2, last2,
+                                                std::integral_constant<bool, _is_memcmp_less<InputIt1, InputIt2>::value>());
     }
 
     /*二分搜索操作*/
@@ -1314,19 +1735,18 @@ namespace jrSTL {
     // 非稳定划分（！！！）
     template< class ForwardIt, class UnaryPredicate >
     ForwardIt partition( ForwardIt first, ForwardIt last, UnaryPredicate p ) {
-        ForwardIt tmp = first;
-        while(first != last) {
-            for(; (first != last) && p(*first); ++first);
-            if(first == last)
-                break;
-            tmp = first;
-            for(; (first != last) && !p(*first); ++first);
-            if(first == last)
-                break;
-            iter_swap(tmp, first);
-            first = tmp;
+        // first始终指向第一个不满足p的元素，其后满足p的元素逐个与之交换
+        first = jrSTL::find_if_not(first, last, p);
+        if(first == last)
+            return first;
+        ForwardIt it = first;
+        while(++it != last) {
+            if(p(*it)) {
+                jrSTL::iter_swap(it, first);
+                ++first;
+            }
         }
-        return tmp;
+        return first;
     }
 
     // 稳定划分（！！！）
@@ -1716,140 +2136,358 @@ namespace jrSTL {
                                        ->bool { return a < b; });
     }
 
+    /* 模式消除快速排序（pdqsort）：
+     * - 小区间插入排序；大区间取伪中位数（ninther），否则取三数中值
+     * - 划分前若主元不大于左侧哨兵（上一次划分的主元），说明区间内有大量相等元素，
+     *   改为把相等元素划到左侧并直接跳过，重复值多的输入为线性
+     * - 划分时未发生交换说明区间可能已有序，以限次插入排序尝试直接完成
+     * - 划分严重失衡时打乱少量元素破坏输入模式，失衡次数超过log2(n)时改用堆排序，最坏O(n log n)
+     * - 算术类型比较代价低，使用分块无分支划分（BlockQuicksort），避免分支预测失败
+     */
+    static const ptrdiff_t _pdq_insertion_threshold = 24;
+    static const ptrdiff_t _pdq_ninther_threshold = 128;
+    static const ptrdiff_t _pdq_partial_insertion_limit = 8;
+    static const ptrdiff_t _pdq_block_size = 64;
+
+    // 插入排序
     template< class RandomIt, class Compare >
-    void partial_sort( RandomIt first, RandomIt middle, RandomIt last,
-                       Compare comp ) {
-        // first到middle建最大堆
-        jrSTL::make_heap(first, middle, comp);
-        for(RandomIt it = middle; it != last; ++it) {
-            if(comp(*it, *first)) {
-                // 将前半部分最大元素与后半部分小于它的元素互换
-                jrSTL::iter_swap(first, it);
-                jrSTL::make_heap(first, middle, comp);
+    void _insertion_sort( RandomIt first, RandomIt last, Compare comp ) {
+        typedef typename jrSTL::iterator_traits<RandomIt>::value_type type;
+        if(first == last)
+            return;
+        for(RandomIt cur = first + 1; cur != last; ++cur) {
+            RandomIt sift = cur, sift_1 = cur - 1;
+            if(comp(*sift, *sift_1)) {
+                type t = std::move(*sift);
+                do {
+                    *sift-- = std::move(*sift_1);
+                } while(sift != first && comp(t, *--sift_1));
+                *sift = std::move(t);
             }
         }
-        jrSTL::sort_heap(first, middle, comp);
     }
 
-    template< class RandomIt >
-    void partial_sort( RandomIt first, RandomIt middle, RandomIt last ) {
-        typedef typename iterator_traits<RandomIt>::value_type type;
-        jrSTL::partial_sort(first, middle, last,
-                             [](const type& a, const type& b)
-                             ->bool { return a < b; });
+    // 无边界检查的插入排序，要求first左侧存在不大于区间内任何元素的哨兵
+    template< class RandomIt, class Compare >
+    void _unguarded_insertion_sort( RandomIt first, RandomIt last, Compare comp ) {
+        typedef typename jrSTL::iterator_traits<RandomIt>::value_type type;
+        if(first == last)
+            return;
+        for(RandomIt cur = first + 1; cur != last; ++cur) {
+            RandomIt sift = cur, sift_1 = cur - 1;
+            if(comp(*sift, *sift_1)) {
+                type t = std::move(*sift);
+                do {
+                    *sift-- = std::move(*sift_1);
+                } while(comp(t, *--sift_1));
+                *sift = std::move(t);
+            }
+        }
     }
 
-    template< class InputIt, class RandomIt, class Compare >
-    RandomIt partial_sort_copy( InputIt first, InputIt last,
-                                RandomIt d_first, RandomIt d_last,
-                                Compare comp ) {
-        typedef typename jrSTL::iterator_traits<InputIt>::value_type type;
-        typename jrSTL::iterator_traits<InputIt>::difference_type len;
-        len = jrSTL::distance(first, last);
-        type *buffer = nullptr, *b = nullptr;
-        buffer = new type[len];
-        // 缓冲区分配失败，原样返回
-        if(!buffer)
-            return d_first;
-        RandomIt pos = d_first;
-        for(b = buffer; first != last; ++first, ++b) {
-            *b = *first;
-        }
-        jrSTL::partial_sort(buffer, buffer + len, b, comp);
-        while((d_first != d_last) && (buffer != b)) {
-            *d_first = *buffer;
-            ++d_first;
-            ++buffer;
+    // 限次插入排序：移动次数超过阈值时放弃并返回false
+    template< class RandomIt, class Compare >
+    bool _partial_insertion_sort( RandomIt first, RandomIt last, Compare comp ) {
+        typedef typename jrSTL::iterator_traits<RandomIt>::value_type type;
+        if(first == last)
+            return true;
+        ptrdiff_t limit = 0;
+        for(RandomIt cur = first + 1; cur != last; ++cur) {
+            if(limit > _pdq_partial_insertion_limit)
+                return false;
+            RandomIt sift = cur, sift_1 = cur - 1;
+            if(comp(*sift, *sift_1)) {
+                type t = std::move(*sift);
+                do {
+                    *sift-- = std::move(*sift_1);
+                } while(sift != first && comp(t, *--sift_1));
+                *sift = std::move(t);
+                limit += cur - sift;
+            }
         }
-        return d_first;
+        return true;
     }
 
-    template< class InputIt, class RandomIt >
-    RandomIt partial_sort_copy( InputIt first, InputIt last,
-                                RandomIt d_first, RandomIt d_last ) {
-        typedef typename iterator_traits<RandomIt>::value_type type;
-        return jrSTL::partial_sort_copy(first, last, d_first, d_last,
-                                         [](const type& a, const type& b)
-                                         ->bool { return a < b; });
+    template< class RandomIt, class Compare >
+    void _sort2( RandomIt a, RandomIt b, Compare comp ) {
+        if(comp(*b, *a))
+            jrSTL::iter_swap(a, b);
     }
 
-    // 插入排序
     template< class RandomIt, class Compare >
-    void _insertion_sort( RandomIt first, RandomIt last, Compare comp ) {
-        for(RandomIt i = first; i != last; ++i) {
-            typename jrSTL::iterator_traits<RandomIt>::value_type t;
-            t = *i;
-            RandomIt j;
-            for(j = i; (j != first) && comp(t, *(j - 1)); j--) {
-                *j = *(j - 1);
+    void _sort3( RandomIt a, RandomIt b, RandomIt c, Compare comp ) {
+        jrSTL::_sort2(a, b, comp);
+        jrSTL::_sort2(b, c, comp);
+        jrSTL::_sort2(a, b, comp);
+    }
+
+    /* 以*first为主元划分，小于主元的在左、不小于的在右，返回主元最终位置，
+     * 以及划分过程中是否未发生任何交换（区间可能已有序）
+     * 要求first左侧或区间内存在不小于主元的元素作为右扫描的哨兵（由取主元时的排序保证）
+     */
+    template< class RandomIt, class Compare >
+    std::pair<RandomIt, bool> _partition_right( RandomIt first, RandomIt last,
+                                                Compare comp, std::false_type ) {
+        typedef typename jrSTL::iterator_traits<RandomIt>::value_type type;
+        type pivot(std::move(*first));
+        RandomIt f = first, l = last;
+        while(comp(*++f, pivot));
+        if(f - 1 == first)
+            while(f < l && !comp(*--l, pivot));
+        else
+            while(!comp(*--l, pivot));
+        bool already_partitioned = f >= l;
+        while(f < l) {
+            jrSTL::iter_swap(f, l);
+            while(comp(*++f, pivot));
+            while(!comp(*--l, pivot));
+        }
+        RandomIt pivot_pos = f - 1;
+        *first = std::move(*pivot_pos);
+        *pivot_pos = std::move(pivot);
+        return std::make_pair(pivot_pos, already_partitioned);
+    }
+
+    // 按两侧偏移表成对交换；两侧数目相同时逐对交换，否则沿环移动以减少一半写入
+    template< class RandomIt >
+    void _swap_offsets( RandomIt first, RandomIt last,
+                        unsigned char *offsets_l, unsigned char *offsets_r,
+                        size_t num, bool use_swaps ) {
+        typedef typename jrSTL::iterator_traits<RandomIt>::value_type type;
+        if(use_swaps) {
+            for(size_t i = 0; i < num; ++i)
+                jrSTL::iter_swap(first + offsets_l[i], last - offsets_r[i]);
+        } else if(num > 0) {
+            RandomIt l = first + offsets_l[0], r = last - offsets_r[0];
+            type t(std::move(*l));
+            *l = std::move(*r);
+            for(size_t i = 1; i < num; ++i) {
+                l = first + offsets_l[i];
+                *r = std::move(*l);
+                r = last - offsets_r[i];
+                *l = std::move(*r);
             }
-            *j = t;
+            *r = std::move(t);
         }
     }
 
-    // 找三者的中位数
+    /* 分块无分支划分：两端各扫描一块，把位于错误一侧的元素偏移写入表中，
+     * 写表与计数都不依赖比较结果的分支，之后再按表成对交换
+     */
     template< class RandomIt, class Compare >
-    RandomIt _find_pivot( RandomIt a, RandomIt b, RandomIt c, Compare comp ) {
-        if(comp(*a, *b)) {
-            if(comp(*b, *c))
-                return b;
-            else {
-                if(comp(*a, *c))
-                    return c;
-                else
-                    return a;
+    std::pair<RandomIt, bool> _partition_right( RandomIt first, RandomIt last,
+                                                Compare comp, std::true_type ) {
+        typedef typename jrSTL::iterator_traits<RandomIt>::value_type type;
+        const ptrdiff_t block = _pdq_block_size;
+        type pivot(std::move(*first));
+        RandomIt f = first, l = last;
+        while(comp(*++f, pivot));
+        if(f - 1 == first)
+            while(f < l && !comp(*--l, pivot));
+        else
+            while(!comp(*--l, pivot));
+        bool already_partitioned = f >= l;
+        if(!already_partitioned) {
+            jrSTL::iter_swap(f, l);
+            ++f;
+            unsigned char offsets_l[_pdq_block_size], offsets_r[_pdq_block_size];
+            size_t num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+            // 剩余至少两块时整块扫描
+            while(l - f > 2 * block) {
+                if(num_l == 0) {
+                    start_l = 0;
+                    RandomIt it = f;
+                    for(unsigned char i = 0; i < block; ++it) {
+                        offsets_l[num_l] = i++;
+                        num_l += !comp(*it, pivot);
+                    }
+                }
+                if(num_r == 0) {
+                    start_r = 0;
+                    RandomIt it = l;
+                    for(unsigned char i = 0; i < block; ) {
+                        offsets_r[num_r] = ++i;
+                        num_r += comp(*--it, pivot);
+                    }
+                }
+                size_t num = num_l < num_r ? num_l : num_r;
+                jrSTL::_swap_offsets(f, l, offsets_l + start_l, offsets_r + start_r,
+                                     num, num_l == num_r);
+                num_l -= num;
+                num_r -= num;
+                start_l += num;
+                start_r += num;
+                if(num_l == 0)
+                    f += block;
+                if(num_r == 0)
+                    l -= block;
             }
-        } else {
-            if(comp(*a, *c))
-                return a;
-            else {
-                if(comp(*b, *c))
-                    return c;
-                else
-                    return b;
+            // 剩余不足两块，按未扫描部分的大小分给两侧
+            size_t l_size = 0, r_size = 0;
+            size_t unknown_left = (l - f) - ((num_r || num_l) ? block : 0);
+            if(num_r) {
+                l_size = unknown_left;
+                r_size = block;
+            } else if(num_l) {
+                l_size = block;
+                r_size = unknown_left;
+            } else {
+                l_size = unknown_left / 2;
+                r_size = unknown_left - l_size;
+            }
+            if(unknown_left && !num_l) {
+                start_l = 0;
+                RandomIt it = f;
+                for(unsigned char i = 0; i < l_size; ++it) {
+                    offsets_l[num_l] = i++;
+                    num_l += !comp(*it, pivot);
+                }
+            }
+            if(unknown_left && !num_r) {
+                start_r = 0;
+                RandomIt it = l;
+                for(unsigned char i = 0; i < r_size; ) {
+                    offsets_r[num_r] = ++i;
+                    num_r += comp(*--it, pivot);
+                }
+            }
+            size_t num = num_l < num_r ? num_l : num_r;
+            jrSTL::_swap_offsets(f, l, offsets_l + start_l, offsets_r + start_r,
+                                 num, num_l == num_r);
+            num_l -= num;
+            num_r -= num;
+            start_l += num;
+            start_r += num;
+            if(num_l == 0)
+                f += l_size;
+            if(num_r == 0)
+                l -= r_size;
+            // 一侧的表已用尽，另一侧剩余的错位元素逐个交换到边界
+            if(num_l) {
+                while(num_l--)
+                    jrSTL::iter_swap(f + offsets_l[start_l + num_l], --l);
+                f = l;
+            }
+            if(num_r) {
+                while(num_r--) {
+                    jrSTL::iter_swap(l - offsets_r[start_r + num_r], f);
+                    ++f;
+                }
+                l = f;
             }
         }
+        RandomIt pivot_pos = f - 1;
+        *first = std::move(*pivot_pos);
+        *pivot_pos = std::move(pivot);
+        return std::make_pair(pivot_pos, already_partitioned);
     }
 
-    // 可控制递归深度与区间长度的快速排序
+    // 以*first为主元划分，不大于主元的在左、大于的在右，返回主元最终位置
     template< class RandomIt, class Compare >
-    void _quick_sort( RandomIt first, RandomIt last, Compare comp, int depth ) {
-        if(last - first <= 5) {
-            // 当前区间长度小于阈值，则转为插入排序
-            jrSTL::_insertion_sort(first, last, comp);
-            return;
-        }
-        if(depth > 16) {
-            // 递归深度超过阈值，则转为堆排序
-            jrSTL::partial_sort(first, last, last, comp);
-            return;
-        }
-        RandomIt middle = first + (last - first) / 2;
-        // 寻找主元
-        RandomIt pivot = jrSTL::_find_pivot(first, middle, last - 1, comp);
-        // 划分区间
-        jrSTL::iter_swap(pivot, last - 1);  // 将主元放在末尾，简化区间划分过程
-        RandomIt low = first, high = last - 2;
-        while(true) {     // 左右两边同时扫描，交换不满足条件的两个元素
-            while(comp(*low, *(last - 1)))
-                ++low;
-            while(comp(*(last - 1), *high))
-                --high;
-            if(low < high)
-                jrSTL::iter_swap(low, high);
-            else
-                break;
+    RandomIt _partition_left( RandomIt first, RandomIt last, Compare comp ) {
+        typedef typename jrSTL::iterator_traits<RandomIt>::value_type type;
+        type pivot(std::move(*first));
+        RandomIt f = first, l = last;
+        while(comp(pivot, *--l));
+        if(l + 1 == last)
+            while(f < l && !comp(pivot, *++f));
+        else
+            while(!comp(pivot, *++f));
+        while(f < l) {
+            jrSTL::iter_swap(f, l);
+            while(comp(pivot, *--l));
+            while(!comp(pivot, *++f));
+        }
+        RandomIt pivot_pos = l;
+        *first = std::move(*pivot_pos);
+        *pivot_pos = std::move(pivot);
+        return pivot_pos;
+    }
+
+    // 主循环：先递归较左的一半，右半通过循环处理；leftmost表示区间左侧没有可作哨兵的元素
+    template< class RandomIt, class Compare, class Branchless >
+    void _pdq_sort( RandomIt first, RandomIt last, Compare comp,
+                    int bad_allowed, bool leftmost, Branchless branchless ) {
+        typedef typename jrSTL::iterator_traits<RandomIt>::difference_type dis_type;
+        while(true) {
+            dis_type size = last - first;
+            if(size < _pdq_insertion_threshold) {
+                if(leftmost)
+                    jrSTL::_insertion_sort(first, last, comp);
+                else
+                    jrSTL::_unguarded_insertion_sort(first, last, comp);
+                return;
+            }
+            // 取主元放到first：大区间用三组三数中值的中值
+            dis_type s2 = size / 2;
+            if(size > _pdq_ninther_threshold) {
+                jrSTL::_sort3(first, first + s2, last - 1, comp);
+                jrSTL::_sort3(first + 1, first + (s2 - 1), last - 2, comp);
+                jrSTL::_sort3(first + 2, first + (s2 + 1), last - 3, comp);
+                jrSTL::_sort3(first + (s2 - 1), first + s2, first + (s2 + 1), comp);
+                jrSTL::iter_swap(first, first + s2);
+            } else {
+                jrSTL::_sort3(first + s2, first, last - 1, comp);
+            }
+            // 区间内没有小于*(first - 1)的元素，主元与之相等时相等元素全部划到左侧且无需再排
+            if(!leftmost && !comp(*(first - 1), *first)) {
+                first = jrSTL::_partition_left(first, last, comp) + 1;
+                continue;
+            }
+            std::pair<RandomIt, bool> part = jrSTL::_partition_right(first, last, comp, branchless);
+            RandomIt pivot_pos = part.first;
+            dis_type l_size = pivot_pos - first;
+            dis_type r_size = last - (pivot_pos + 1);
+            if(l_size < size / 8 || r_size < size / 8) {
+                // 严重失衡：次数用尽则改用堆排序，否则打乱两侧的若干元素
+                if(--bad_allowed == 0) {
+                    jrSTL::make_heap(first, last, comp);
+                    jrSTL::sort_heap(first, last, comp);
+                    return;
+                }
+                if(l_size >= _pdq_insertion_threshold) {
+                    jrSTL::iter_swap(first, first + l_size / 4);
+                    jrSTL::iter_swap(pivot_pos - 1, pivot_pos - l_size / 4);
+                    if(l_size > _pdq_ninther_threshold) {
+                        jrSTL::iter_swap(first + 1, first + (l_size / 4 + 1));
+                        jrSTL::iter_swap(first + 2, first + (l_size / 4 + 2));
+                        jrSTL::iter_swap(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
+                        jrSTL::iter_swap(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
+                    }
+                }
+                if(r_size >= _pdq_insertion_threshold) {
+                    jrSTL::iter_swap(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+                    jrSTL::iter_swap(last - 1, last - r_size / 4);
+                    if(r_size > _pdq_ninther_threshold) {
+                        jrSTL::iter_swap(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
+                        jrSTL::iter_swap(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
+                        jrSTL::iter_swap(last - 2, last - (1 + r_size / 4));
+                        jrSTL::iter_swap(last - 3, last - (2 + r_size / 4));
+                    }
+                }
+            } else if(part.second
+                      && jrSTL::_partial_insertion_sort(first, pivot_pos, comp)
+                      && jrSTL::_partial_insertion_sort(pivot_pos + 1, last, comp)) {
+                // 划分均衡且未发生交换，两侧经少量插入即有序
+                return;
+            }
+            jrSTL::_pdq_sort(first, pivot_pos, comp, bad_allowed, leftmost, branchless);
+            first = pivot_pos + 1;
+            leftmost = false;
         }
-        jrSTL::iter_swap(low, last - 1);  // 将主元交换至原位置
-        // 递归排序
-        _quick_sort(first, low, comp, ++depth);
-        _quick_sort(low + 1, last, comp, ++depth);
     }
 
-    // Intro排序
     template< class RandomIt, class Compare >
     void sort( RandomIt first, RandomIt last, Compare comp ) {
-        jrSTL::_quick_sort(first, last, comp, 0); // 初始递归深度为0
+        typedef typename jrSTL::iterator_traits<RandomIt>::value_type type;
+        typedef std::integral_constant<bool, std::is_arithmetic<type>::value
+                                             || std::is_pointer<type>::value> branchless;
+        if(last - first < 2)
+            return;
+        int bad_allowed = 0;
+        for(ptrdiff_t n = last - first; n > 0; n >>= 1)
+            ++bad_allowed;
+        jrSTL::_pdq_sort(first, last, comp, bad_allowed, true, branchless());
     }
 
     template< class RandomIt >
@@ -1860,15 +2498,285 @@ namespace jrSTL {
                     ->bool { return a < b; });
     }
 
-    // 归并排序
+    /* 稳定排序（TimSort）：
+     * 1. 从左到右识别自然有序段，严格降序段原地翻转，过短的段以二分插入排序补足到minrun
+     * 2. 有序段压栈，维持栈顶三段长度满足 A > B + C、B > C，保证归并大致平衡
+     * 3. 相邻段归并前先二分裁掉已在最终位置的首尾，较短一侧移入缓冲区后线性归并；
+     *    一侧连续胜出多次时进入跳跃(galloping)模式，以指数搜索成块搬移
+     * 缓冲区按n/2申请，不足时对放不下的归并退化为旋转归并，申请不到时整体为O(n log^2 n)
+     */
+    static const ptrdiff_t _timsort_min_gallop = 7;
+
+    // minrun取[32, 64]，使n / minrun恰为或略小于2的幂
+    inline ptrdiff_t _timsort_min_run( ptrdiff_t n ) {
+        ptrdiff_t r = 0;
+        while(n >= 64) {
+            r |= n & 1;
+            n >>= 1;
+        }
+        return n + r;
+    }
+
+    // 返回从first开始的自然有序段的尾后位置，严格降序段翻转为升序（严格保证稳定）
+    template< class RandomIt, class Compare >
+    RandomIt _timsort_count_run( RandomIt first, RandomIt last, Compare comp ) {
+        RandomIt run = first + 1;
+        if(run == last)
+            return run;
+        if(comp(*run, *first)) {
+            for(++run; run != last && comp(*run, *(run - 1)); ++run);
+            jrSTL::reverse(first, run);
+        } else {
+            for(++run; run != last && !comp(*run, *(run - 1)); ++run);
+        }
+        return run;
+    }
+
+    // [first, start)已有序，将[start, last)逐个二分插入
+    template< class RandomIt, class Compare >
+    void _binary_insertion_sort( RandomIt first, RandomIt start, RandomIt last, Compare comp ) {
+        typedef typename jrSTL::iterator_traits<RandomIt>::value_type type;
+        for(; start != last; ++start) {
+            type t = std::move(*start);
+            RandomIt pos = jrSTL::upper_bound(first, start, t, comp);
+            jrSTL::move_backward(pos, start, start + 1);
+            *pos = std::move(t);
+        }
+    }
+
+    // 在满足p的元素构成前缀的有序区间中，从左端指数搜索再二分，返回前缀长度
+    template< class RandomIt, class Distance, class Predicate >
+    Distance _gallop_from_left( RandomIt first, Distance n, Predicate p ) {
+        Distance lo = 0, hi = 1;
+        while(hi < n && p(first[hi - 1])) {
+            lo = hi;
+            hi = 2 * hi + 1;
+        }
+        if(hi > n)
+            hi = n;
+        while(lo < hi) {
+            Distance mid = lo + (hi - lo) / 2;
+            if(p(first[mid]))
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        return lo;
+    }
+
+    // 同上，从右端开始搜索
+    template< class RandomIt, class Distance, class Predicate >
+    Distance _gallop_from_right( RandomIt first, Distance n, Predicate p ) {
+        Distance last_ofs = 0, ofs = 1;
+        while(ofs <= n && !p(first[n - ofs])) {
+            last_ofs = ofs;
+            ofs = 2 * ofs + 1;
+        }
+        Distance lo = ofs > n ? 0 : n - ofs + 1, hi = n - last_ofs;
+        while(lo < hi) {
+            Distance mid = lo + (hi - lo) / 2;
+            if(p(first[mid]))
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        return lo;
+    }
+
+    // 带跳跃模式的前向归并，左段[first, middle)移入缓冲区
+    template< class RandomIt, class T, class Compare >
+    void _timsort_merge_lo( RandomIt first, RandomIt middle, RandomIt last,
+                            T *buf, Compare comp, ptrdiff_t& min_gallop ) {
+        T *b = buf, *bend = jrSTL::move(first, middle, buf);
+        RandomIt r = middle, out = first;
+        while(b != bend && r != last) {
+            ptrdiff_t count_b = 0, count_r = 0;
+            while(b != bend && r != last && (count_b | count_r) < min_gallop) {
+                if(comp(*r, *b)) {
+                    *out = std::move(*r);
+                    ++r;
+                    ++count_r;
+                    count_b = 0;
+                } else {
+                    *out = std::move(*b);
+                    ++b;
+                    ++count_b;
+                    count_r = 0;
+                }
+                ++out;
+            }
+            while(b != bend && r != last) {
+                // 缓冲区中不大于*r的元素整块输出
+                count_b = jrSTL::_gallop_from_left(b, bend - b,
+                                                   [&](const T& x) { return !comp(*r, x); });
+                out = jrSTL::move(b, b + count_b, out);
+                b += count_b;
+                if(b == bend)
+                    break;
+                *out = std::move(*r);
+                ++out;
+                if(++r == last)
+                    break;
+                // 右段中小于*b的元素整块输出
+                count_r = jrSTL::_gallop_from_left(r, last - r,
+                                                   [&](const T& x) { return comp(x, *b); });
+                out = jrSTL::move(r, r + count_r, out);
+                r += count_r;
+                if(r == last)
+                    break;
+                *out = std::move(*b);
+                ++out;
+                if(++b == bend)
+                    break;
+                if(min_gallop > 1)
+                    --min_gallop;
+                if(count_b < _timsort_min_gallop && count_r < _timsort_min_gallop) {
+                    // 跳跃收益不足，回到逐个比较并提高进入门槛
+                    min_gallop += 2;
+                    break;
+                }
+            }
+        }
+        jrSTL::move(b, bend, out);
+    }
+
+    // 带跳跃模式的后向归并，右段[middle, last)移入缓冲区
+    template< class RandomIt, class T, class Compare >
+    void _timsort_merge_hi( RandomIt first, RandomIt middle, RandomIt last,
+                            T *buf, Compare comp, ptrdiff_t& min_gallop ) {
+        T *b = jrSTL::move(middle, last, buf);
+        RandomIt l = middle, out = last;
+        while(b != buf && l != first) {
+            ptrdiff_t count_b = 0, count_l = 0;
+            while(b != buf && l != first && (count_b | count_l) < min_gallop) {
+                if(comp(*(b - 1), *(l - 1))) {
+                    *--out = std::move(*--l);
+                    ++count_l;
+                    count_b = 0;
+                } else {
+                    *--out = std::move(*--b);
+                    ++count_b;
+                    count_l = 0;
+                }
+            }
+            while(b != buf && l != first) {
+                // 左段中大于*(b - 1)的元素整块输出
+                ptrdiff_t k = jrSTL::_gallop_from_right(first, l - first,
+                                                        [&](const T& x) { return !comp(*(b - 1), x); });
+                count_l = (l - first) - k;
+                out = jrSTL::move_backward(first + k, l, out);
+                l = first + k;
+                if(l == first)
+                    break;
+                *--out = std::move(*--b);
+                if(b == buf)
+                    break;
+                // 缓冲区中不小于*(l - 1)的元素整块输出
+                k = jrSTL::_gallop_from_right(buf, b - buf,
+                                              [&](const T& x) { return comp(x, *(l - 1)); });
+                count_b = (b - buf) - k;
+                out = jrSTL::move_backward(buf + k, b, out);
+                b = buf + k;
+                if(b == buf)
+                    break;
+                *--out = std::move(*--l);
+                if(l == first)
+                    break;
+                if(min_gallop > 1)
+                    --min_gallop;
+                if(count_b < _timsort_min_gallop && count_l < _timsort_min_gallop) {
+                    min_gallop += 2;
+                    break;
+                }
+            }
+        }
+        jrSTL::move_backward(buf, b, out);
+    }
+
+    // 归并相邻的两个有序段
+    template< class RandomIt, class T, class Compare >
+    void _timsort_merge_at( RandomIt first, RandomIt middle, RandomIt last,
+                            T *buf, ptrdiff_t buf_size, Compare comp,
+                            ptrdiff_t& min_gallop ) {
+        // 左段中不大于右段首元素的前缀、右段中不小于左段尾元素的后缀已在最终位置
+        first += jrSTL::_gallop_from_left(first, middle - first,
+                                          [&](const T& x) { return !comp(*middle, x); });
+        if(first == middle)
+            return;
+        last = middle + jrSTL::_gallop_from_right(middle, last - middle,
+                                                  [&](const T& x) { return comp(x, *(middle - 1)); });
+        if(middle == last)
+            return;
+        ptrdiff_t len1 = middle - first, len2 = last - middle;
+        if(len1 <= len2 && len1 <= buf_size)
+            jrSTL::_timsort_merge_lo(first, middle, last, buf, comp, min_gallop);
+        else if(len2 <= buf_size)
+            jrSTL::_timsort_merge_hi(first, middle, last, buf, comp, min_gallop);
+        else
+            jrSTL::_merge_adaptive(first, middle, last, len1, len2, buf, buf_size, comp);
+    }
+
     template< class RandomIt, class Compare >
     void stable_sort( RandomIt first, RandomIt last, Compare comp ) {
-        if(last - first <= 1)
+        typedef typename jrSTL::iterator_traits<RandomIt>::value_type type;
+        ptrdiff_t n = last - first;
+        if(n < 2)
             return;
-        RandomIt middle = first + (last - first) / 2;
-        jrSTL::stable_sort(first, middle, comp);
-        jrSTL::stable_sort(middle, last, comp);
-        jrSTL::inplace_merge(first, middle, last, comp);
+        ptrdiff_t min_run = jrSTL::_timsort_min_run(n);
+        if(n <= min_run) {
+            jrSTL::_binary_insertion_sort(first, jrSTL::_timsort_count_run(first, last, comp),
+                                          last, comp);
+            return;
+        }
+        jrSTL::_temporary_buffer<type> buffer(first, static_cast<size_t>(n / 2));
+        type *buf = buffer.begin();
+        ptrdiff_t buf_size = static_cast<ptrdiff_t>(buffer.length());
+        ptrdiff_t min_gallop = _timsort_min_gallop;
+        // 有序段栈，存各段起点与长度；由栈不变式，段数不超过log_phi(n)
+        ptrdiff_t run_base[96], run_len[96];
+        int runs = 0;
+        auto merge_at = [&](int i) {
+            jrSTL::_timsort_merge_at(first + run_base[i], first + run_base[i + 1],
+                                     first + run_base[i + 1] + run_len[i + 1],
+                                     buf, buf_size, comp, min_gallop);
+            run_len[i] += run_len[i + 1];
+            if(i == runs - 3) {
+                run_base[i + 1] = run_base[i + 2];
+                run_len[i + 1] = run_len[i + 2];
+            }
+            --runs;
+        };
+        RandomIt cur = first;
+        while(cur != last) {
+            RandomIt run_end = jrSTL::_timsort_count_run(cur, last, comp);
+            if(run_end - cur < min_run) {
+                RandomIt forced = last - cur < min_run ? last : cur + min_run;
+                jrSTL::_binary_insertion_sort(cur, run_end, forced, comp);
+                run_end = forced;
+            }
+            run_base[runs] = cur - first;
+            run_len[runs] = run_end - cur;
+            ++runs;
+            cur = run_end;
+            // 恢复栈不变式
+            while(runs > 1) {
+                int i = runs - 2;
+                if((i > 0 && run_len[i - 1] <= run_len[i] + run_len[i + 1]) ||
+                   (i > 1 && run_len[i - 2] <= run_len[i - 1] + run_len[i])) {
+                    if(run_len[i - 1] < run_len[i + 1])
+                        --i;
+                } else if(run_len[i] > run_len[i + 1]) {
+                    break;
+                }
+                merge_at(i);
+            }
+        }
+        while(runs > 1) {
+            int i = runs - 2;
+            if(i > 0 && run_len[i - 1] < run_len[i + 1])
+                --i;
+            merge_at(i);
+        }
     }
 
     template< class RandomIt >
@@ -1879,30 +2787,399 @@ namespace jrSTL {
                            ->bool { return a < b; });
     }
 
+    /* 基数排序：按key(x)取出的键升序稳定排序，要求随机访问迭代器
+     * 整数与浮点键走LSD：键编码为同宽的无符号整数后逐字节分配，一次遍历统计全部字节的直方图，
+     * 所有元素该字节相同的趟直接跳过；
+     * 字符串键（有size()与下标访问的字节序列，如std::string）走MSD：按当前字节分桶后递归各桶，小桶改用插入排序
+     * 两者都需要n个元素的_temporary_buffer，申请不到时退回stable_sort
+     * long double、bool等没有保序编码的算术键直接按键比较做stable_sort
+     */
+    static const ptrdiff_t _radix_lsd_threshold = 256;
+    static const ptrdiff_t _radix_msd_threshold = 32;
+
+    // 键编码：保序地映射为无符号整数
+    template< class K, class = void >
+    struct _radix_key_traits {};
+
+    // 有符号整数翻转符号位
+    template< class K >
+    struct _radix_key_traits<K, typename std::enable_if<std::is_integral<K>::value &&
+                                                        !std::is_same<K, bool>::value>::type> {
+        typedef typename std::make_unsigned<K>::type type;
+
+        static type encode(K k) {
+            type u = static_cast<type>(k);
+            if(std::is_signed<K>::value)
+                u ^= static_cast<type>(type(1) << (sizeof(type) * 8 - 1));
+            return u;
+        }
+    };
+
+    // IEEE浮点数：负数按位取反，非负数翻转符号位；-0.0先换成+0.0，与operator<一样视为相等以保持稳定
+    template< >
+    struct _radix_key_traits<float> {
+        typedef std::uint32_t type;
+
+        static type encode(float k) {
+            if(k == 0.0f)
+                return 0x80000000u;
+            type u;
+            std::memcpy(&u, &k, sizeof(u));
+            return (u >> 31) ? ~u : u ^ 0x80000000u;
+        }
+    };
+
+    template< >
+    struct _radix_key_traits<double> {
+        typedef std::uint64_t type;
+
+        static type encode(double k) {
+            if(k == 0.0)
+                return 0x8000000000000000ull;
+            type u;
+            std::memcpy(&u, &k, sizeof(u));
+            return (u >> 63) ? ~u : u ^ 0x8000000000000000ull;
+        }
+    };
+
+    // 有_radix_key_traits特化的键才能走LSD
+    template< class T >
+    struct _radix_void {
+        typedef void type;
+    };
+
+    template< class K, class = void >
+    struct _is_radix_encodable : std::false_type {};
+
+    template< class K >
+    struct _is_radix_encodable<K, typename _radix_void<typename _radix_key_traits<K>::type>::type>
+        : std::true_type {};
+
+    /* 键的排序方式：可编码的键走LSD（true_type），字节序列走MSD（false_type），
+     * 其余算术类型（long double、bool等）没有编码，退回按键比较的stable_sort
+     */
+    struct _radix_compare_tag {};
+
+    template< class K >
+    struct _radix_category {
+        typedef typename std::conditional<_is_radix_encodable<K>::value, std::true_type,
+                typename std::conditional<std::is_arithmetic<K>::value, _radix_compare_tag,
+                                          std::false_type>::type>::type type;
+    };
+
+    struct _radix_identity {
+        template< class T >
+        const T& operator()(const T& x) const {
+            return x;
+        }
+    };
+
+    template< class KeyFn >
+    struct _radix_key_less {
+        KeyFn key;
+
+        template< class T >
+        bool operator()(const T& a, const T& b) const {
+            typedef typename std::decay<decltype(key(a))>::type key_type;
+            return jrSTL::_radix_key_traits<key_type>::encode(key(a))
+                 < jrSTL::_radix_key_traits<key_type>::encode(key(b));
+        }
+    };
+
+    // 统计[0, n)的全部字节直方图，count[b][d]为第b个字节等于d的元素个数
+    template< class RandomIt, class KeyFn, class U >
+    void _radix_histogram( RandomIt first, size_t n, KeyFn key, size_t (*count)[256], U ) {
+        typedef typename std::decay<decltype(key(*first))>::type key_type;
+        for(size_t i = 0; i < n; ++i) {
+            U u = jrSTL::_radix_key_traits<key_type>::encode(key(first[i]));
+            for(size_t b = 0; b < sizeof(U); ++b)
+                ++count[b][(u >> (8 * b)) & 0xff];
+        }
+    }
+
+    // 某一字节上所有元素都相同（只有一个非空桶）时该趟无需分配
+    inline bool _radix_trivial_pass( const size_t *count, size_t n ) {
+        for(size_t d = 0; d < 256; ++d) {
+            if(count[d] != 0)
+                return count[d] == n;
+        }
+        return true;
+    }
+
+    // 按第b个字节把src稳定地分配到dst，offset为各桶的起点，分配后指向各桶的终点
+    template< class SrcIt, class DstIt, class KeyFn >
+    void _radix_scatter( SrcIt src, size_t n, DstIt dst, size_t b, KeyFn key, size_t *offset ) {
+        typedef typename std::decay<decltype(key(*src))>::type key_type;
+        for(size_t i = 0; i < n; ++i) {
+            size_t d = (jrSTL::_radix_key_traits<key_type>::encode(key(src[i])) >> (8 * b)) & 0xff;
+            dst[offset[d]++] = std::move(src[i]);
+        }
+    }
+
+    template< class RandomIt, class KeyFn >
+    void _radix_sort( RandomIt first, RandomIt last, KeyFn key, std::true_type ) {
+        typedef typename jrSTL::iterator_traits<RandomIt>::value_type type;
+        typedef typename std::decay<decltype(key(*first))>::type key_type;
+        typedef typename jrSTL::_radix_key_traits<key_type>::type U;
+        ptrdiff_t len = last - first;
+        jrSTL::_radix_key_less<KeyFn> less = {key};
+        if(len < _radix_lsd_threshold) {
+            jrSTL::stable_sort(first, last, less);
+            return;
+        }
+        size_t n = static_cast<size_t>(len);
+        jrSTL::_temporary_buffer<type> buffer(first, n);
+        if(buffer.length() < n) {
+            jrSTL::stable_sort(first, last, less);
+            return;
+        }
+        type *buf = buffer.begin();
+        size_t count[sizeof(U)][256];
+        std::memset(count, 0, sizeof(count));
+        jrSTL::_radix_histogram(first, n, key, count, U());
+        bool in_buf = false;
+        for(size_t b = 0; b < sizeof(U); ++b) {
+            if(jrSTL::_radix_trivial_pass(count[b], n))
+                continue;
+            size_t offset[256], sum = 0;
+            for(size_t d = 0; d < 256; ++d) {
+                offset[d] = sum;
+                sum += count[b][d];
+            }
+            if(in_buf)
+                jrSTL::_radix_scatter(buf, n, first, b, key, offset);
+            else
+                jrSTL::_radix_scatter(first, n, buf, b, key, offset);
+            in_buf = !in_buf;
+        }
+        if(in_buf)
+            jrSTL::move(buf, buf + n, first);
+    }
+
+    // 字符串在depth处的桶号，0号桶为长度不超过depth的串
+    template< class S >
+    size_t _radix_byte( const S& s, size_t depth ) {
+        return depth < s.size() ? static_cast<unsigned char>(s[depth]) + 1 : 0;
+    }
+
+    template< class KeyFn >
+    struct _radix_suffix_less {
+        KeyFn key;
+        size_t depth;
+
+        template< class T >
+        bool operator()(const T& a, const T& b) const {
+            const auto& x = key(a);
+            const auto& y = key(b);
+            size_t n = x.size() < y.size() ? x.size() : y.size();
+            for(size_t i = depth; i < n; ++i) {
+                unsigned char c1 = static_cast<unsigned char>(x[i]);
+                unsigned char c2 = static_cast<unsigned char>(y[i]);
+                if(c1 != c2)
+                    return c1 < c2;
+            }
+            return x.size() < y.size();
+        }
+    };
+
+    /* 按depth处的字节把[first, first + n)稳定地分到257个桶，bounds[d]为第d个桶的起点，bounds[257] = n
+     * 只有一个非空桶时不移动元素
+     */
+    template< class RandomIt, class T, class KeyFn >
+    void _radix_msd_split( RandomIt first, size_t n, T *buf, size_t depth, KeyFn key, size_t *bounds ) {
+        size_t count[257];
+        std::memset(count, 0, sizeof(count));
+        for(size_t i = 0; i < n; ++i)
+            ++count[jrSTL::_radix_byte(key(first[i]), depth)];
+        size_t sum = 0, nonempty = 0;
+        for(size_t d = 0; d < 257; ++d) {
+            bounds[d] = sum;
+            sum += count[d];
+            nonempty += count[d] != 0;
+        }
+        bounds[257] = n;
+        if(nonempty == 1)
+            return;
+        size_t offset[257];
+        std::memcpy(offset, bounds, sizeof(offset));
+        for(size_t i = 0; i < n; ++i)
+            buf[offset[jrSTL::_radix_byte(key(first[i]), depth)]++] = std::move(first[i]);
+        jrSTL::move(buf, buf + n, first);
+    }
+
+    // buf与first对齐，长度不小于last - first
+    template< class RandomIt, class T, class KeyFn >
+    void _radix_sort_msd( RandomIt first, RandomIt last, T *buf, size_t depth, KeyFn key ) {
+        while(last - first >= _radix_msd_threshold) {
+            size_t n = static_cast<size_t>(last - first);
+            size_t bounds[258];
+            jrSTL::_radix_msd_split(first, n, buf, depth, key, bounds);
+            // 最大的桶留给循环处理，其余的递归
+            size_t big = 1;
+            for(size_t d = 1; d < 257; ++d) {
+                if(bounds[d + 1] - bounds[d] > bounds[big + 1] - bounds[big])
+                    big = d;
+            }
+            for(size_t d = 1; d < 257; ++d) {
+                if(d != big && bounds[d + 1] - bounds[d] > 1)
+                    jrSTL::_radix_sort_msd(first + bounds[d], first + bounds[d + 1],
+                                           buf + bounds[d], depth + 1, key);
+            }
+            buf += bounds[big];
+            last = first + bounds[big + 1];
+            first += bounds[big];
+            ++depth;
+        }
+        jrSTL::_radix_suffix_less<KeyFn> less = {key, depth};
+        jrSTL::_binary_insertion_sort(first, first, last, less);
+    }
+
+    template< class RandomIt, class KeyFn >
+    void _radix_sort( RandomIt first, RandomIt last, KeyFn key, std::false_type ) {
+        typedef typename jrSTL::iterator_traits<RandomIt>::value_type type;
+        size_t n = static_cast<size_t>(last - first);
+        if(n < 2)
+            return;
+        jrSTL::_temporary_buffer<type> buffer(first, n);
+        if(buffer.length() < n) {
+            jrSTL::_radix_suffix_less<KeyFn> less = {key, 0};
+            jrSTL::stable_sort(first, last, less);
+            return;
+        }
+        jrSTL::_radix_sort_msd(first, last, buffer.begin(), 0, key);
+    }
+
+    template< class KeyFn >
+    struct _radix_plain_less {
+        KeyFn key;
+
+        template< class T >
+        bool operator()(const T& a, const T& b) const {
+            return key(a) < key(b);
+        }
+    };
+
+    template< class RandomIt, class KeyFn >
+    void _radix_sort( RandomIt first, RandomIt last, KeyFn key, _radix_compare_tag ) {
+        jrSTL::_radix_plain_less<KeyFn> less = {key};
+        jrSTL::stable_sort(first, last, less);
+    }
+
+    template< class RandomIt, class KeyFn >
+    void radix_sort( RandomIt first, RandomIt last, KeyFn key ) {
+        typedef typename std::decay<decltype(key(*first))>::type key_type;
+        jrSTL::_radix_sort(first, last, key, typename jrSTL::_radix_category<key_type>::type());
+    }
+
+    template< class RandomIt >
+    void radix_sort( RandomIt first, RandomIt last ) {
+        jrSTL::radix_sort(first, last, _radix_identity());
+    }
+
+    /* 内省选择（introselect）：与sort相同地取主元、划分，但只继续处理nth所在的一侧，期望O(n)
+     * 划分严重失衡的次数用尽后改用中位数的中位数取主元并三路划分，
+     * 此时每轮至少去掉3/10的元素，最坏仍为O(n)
+     */
+    template< class RandomIt, class Compare, class Branchless >
+    void _introselect( RandomIt first, RandomIt nth, RandomIt last, Compare comp,
+                       int bad_allowed, bool leftmost, Branchless branchless );
+
+    // 每5个一组插入排序，各组中位数移到区间头部，递归选出它们的中位数后放到first
+    template< class RandomIt, class Compare, class Branchless >
+    void _median_of_medians( RandomIt first, RandomIt last, Compare comp, Branchless branchless ) {
+        typedef typename jrSTL::iterator_traits<RandomIt>::difference_type dis_type;
+        dis_type groups = (last - first) / 5;
+        for(dis_type i = 0; i < groups; ++i) {
+            RandomIt g = first + i * 5;
+            jrSTL::_insertion_sort(g, g + 5, comp);
+            jrSTL::iter_swap(first + i, g + 2);
+        }
+        int bad_allowed = 0;
+        for(dis_type n = groups; n > 0; n >>= 1)
+            ++bad_allowed;
+        jrSTL::_introselect(first, first + groups / 2, first + groups, comp,
+                            bad_allowed, true, branchless);
+        jrSTL::iter_swap(first, first + groups / 2);
+    }
+
+    template< class RandomIt, class Compare, class Branchless >
+    void _introselect( RandomIt first, RandomIt nth, RandomIt last, Compare comp,
+                       int bad_allowed, bool leftmost, Branchless branchless ) {
+        typedef typename jrSTL::iterator_traits<RandomIt>::value_type type;
+        typedef typename jrSTL::iterator_traits<RandomIt>::difference_type dis_type;
+        while(true) {
+            dis_type size = last - first;
+            if(size < _pdq_insertion_threshold) {
+                if(leftmost)
+                    jrSTL::_insertion_sort(first, last, comp);
+                else
+                    jrSTL::_unguarded_insertion_sort(first, last, comp);
+                return;
+            }
+            RandomIt pivot_pos;
+            if(bad_allowed > 0) {
+                // 取主元与划分同_pdq_sort
+                dis_type s2 = size / 2;
+                if(size > _pdq_ninther_threshold) {
+                    jrSTL::_sort3(first, first + s2, last - 1, comp);
+                    jrSTL::_sort3(first + 1, first + (s2 - 1), last - 2, comp);
+                    jrSTL::_sort3(first + 2, first + (s2 + 1), last - 3, comp);
+                    jrSTL::_sort3(first + (s2 - 1), first + s2, first + (s2 + 1), comp);
+                    jrSTL::iter_swap(first, first + s2);
+                } else {
+                    jrSTL::_sort3(first + s2, first, last - 1, comp);
+                }
+                // 主元与*(first - 1)相等：[first, 返回位置]全部与主元相等
+                if(!leftmost && !comp(*(first - 1), *first)) {
+                    RandomIt eq_last = jrSTL::_partition_left(first, last, comp);
+                    if(nth <= eq_last)
+                        return;
+                    first = eq_last + 1;
+                    continue;
+                }
+                pivot_pos = jrSTL::_partition_right(first, last, comp, branchless).first;
+                dis_type l_size = pivot_pos - first;
+                dis_type r_size = last - (pivot_pos + 1);
+                if(l_size < size / 8 || r_size < size / 8)
+                    --bad_allowed;
+            } else {
+                jrSTL::_median_of_medians(first, last, comp, branchless);
+                pivot_pos = jrSTL::_partition_right(first, last, comp, branchless).first;
+                // 右侧中与主元相等的元素再划到左边，保证两侧都至少有3/10的元素被去掉
+                if(pivot_pos < nth) {
+                    RandomIt eq_last = jrSTL::partition(pivot_pos + 1, last,
+                                                        [&comp, pivot_pos](const type& x)
+                                                        ->bool { return !comp(*pivot_pos, x); }) - 1;
+                    if(nth <= eq_last)
+                        return;
+                    first = eq_last + 1;
+                    leftmost = false;
+                    continue;
+                }
+            }
+            if(nth == pivot_pos)
+                return;
+            if(nth < pivot_pos) {
+                last = pivot_pos;
+            } else {
+                first = pivot_pos + 1;
+                leftmost = false;
+            }
+        }
+    }
+
     template< class RandomIt, class Compare >
     void nth_element( RandomIt first, RandomIt nth, RandomIt last,
                       Compare comp ) {
-        if(nth == last)
+        typedef typename jrSTL::iterator_traits<RandomIt>::value_type type;
+        typedef std::integral_constant<bool, std::is_arithmetic<type>::value
+                                             || std::is_pointer<type>::value> branchless;
+        if(nth == last || last - first < 2)
             return;
-        // 利用最大堆找到排序后的第n个元素（即第(长度-n)个最大元素）
-        typename jrSTL::iterator_traits<RandomIt>::difference_type n;
-        n = last - nth;
-        jrSTL::make_heap(first, last, comp);
-        for(RandomIt t = last; n; --n, --t) {
-            jrSTL::pop_heap(first, t, comp);
-        }
-        // 左右两边同时遍历，交换不符合大小要求的元素
-        RandomIt low = first, high = last - 1;
-        while(true) {
-            while((low < nth) && !comp(*nth, *low))
-                ++low;
-            while((nth < high) && comp(*high, *nth))
-                --high;
-            if((low < nth) && (nth < high))
-                jrSTL::iter_swap(low, high);
-            else
-                break;
-        }
+        int bad_allowed = 0;
+        for(ptrdiff_t n = last - first; n > 0; n >>= 1)
+            ++bad_allowed;
+        jrSTL::_introselect(first, nth, last, comp, bad_allowed, true, branchless());
     }
 
     template< class RandomIt >
@@ -1912,6 +3189,92 @@ namespace jrSTL {
                            [](const type& a, const type& b)
                            ->bool { return a < b; });
     }
+
+    /* k远小于n时先尝试有界堆：[first, middle)建最大堆，之后的元素小于堆顶才与之交换并向下调整，
+     * 随机输入下几乎所有元素只需与堆顶比较一次；替换次数超出预算（输入接近按comp逆序）时放弃并返回false，
+     * 此时区间仍是原元素的一个排列，预算保证放弃前的代价不超过约n/8次比较
+     */
+    template< class RandomIt, class Compare >
+    bool _heap_select( RandomIt first, RandomIt middle, RandomIt last, Compare comp ) {
+        typedef typename jrSTL::iterator_traits<RandomIt>::value_type type;
+        typedef typename jrSTL::iterator_traits<RandomIt>::difference_type dis_type;
+        dis_type k = middle - first, lg = 1;
+        for(dis_type n = k; n > 1; n >>= 1)
+            ++lg;
+        dis_type budget = (last - middle) / (8 * lg);
+        jrSTL::make_heap(first, middle, comp);
+        for(RandomIt it = middle; it != last; ++it) {
+            if(comp(*it, *first)) {
+                if(--budget < 0)
+                    return false;
+                type value = std::move(*it);
+                *it = std::move(*first);
+                jrSTL::_adjust_heap(first, dis_type(0), k, std::move(value), comp);
+            }
+        }
+        jrSTL::sort_heap(first, middle, comp);
+        return true;
+    }
+
+    /* 先用nth_element把前k小的元素选到[first, middle)，第k小者位于middle - 1，只需再排序其前面部分，O(n + klogk)
+     * k不超过n/64时先尝试_heap_select
+     */
+    template< class RandomIt, class Compare >
+    void partial_sort( RandomIt first, RandomIt middle, RandomIt last,
+                       Compare comp ) {
+        if(middle == last) {
+            jrSTL::sort(first, last, comp);
+        } else if(first != middle) {
+            if((last - first) / 64 >= middle - first
+               && jrSTL::_heap_select(first, middle, last, comp))
+                return;
+            jrSTL::nth_element(first, middle - 1, last, comp);
+            jrSTL::sort(first, middle - 1, comp);
+        }
+    }
+
+    template< class RandomIt >
+    void partial_sort( RandomIt first, RandomIt middle, RandomIt last ) {
+        typedef typename iterator_traits<RandomIt>::value_type type;
+        jrSTL::partial_sort(first, middle, last,
+                             [](const type& a, const type& b)
+                             ->bool { return a < b; });
+    }
+
+    /* 有界堆：前d_last - d_first个元素拷入目标区间建最大堆，之后的元素小于堆顶时替换堆顶并向下调整，
+     * 最后堆排序；输入只遍历一次，不需要额外的缓冲区
+     */
+    template< class InputIt, class RandomIt, class Compare >
+    RandomIt partial_sort_copy( InputIt first, InputIt last,
+                                RandomIt d_first, RandomIt d_last,
+                                Compare comp ) {
+        typedef typename jrSTL::iterator_traits<RandomIt>::value_type type;
+        typedef typename jrSTL::iterator_traits<RandomIt>::difference_type dis_type;
+        RandomIt r = d_first;
+        for(; first != last && r != d_last; ++first, ++r)
+            *r = *first;
+        if(r == d_first)
+            return r;
+        dis_type len = r - d_first;
+        jrSTL::make_heap(d_first, r, comp);
+        for(; first != last; ++first) {
+            if(comp(*first, *d_first)) {
+                type value = *first;
+                jrSTL::_adjust_heap(d_first, dis_type(0), len, std::move(value), comp);
+            }
+        }
+        jrSTL::sort_heap(d_first, r, comp);
+        return r;
+    }
+
+    template< class InputIt, class RandomIt >
+    RandomIt partial_sort_copy( InputIt first, InputIt last,
+                                RandomIt d_first, RandomIt d_last ) {
+        typedef typename iterator_traits<RandomIt>::value_type type;
+        return jrSTL::partial_sort_copy(first, last, d_first, d_last,
+                                         [](const type& a, const type& b)
+                                         ->bool { return a < b; });
+    }
 }
 
 #endif // JR_ALGORITHM_H
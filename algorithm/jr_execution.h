@@ -0,0 +1,772 @@
+#ifndef JR_EXECUTION_H
+#define JR_EXECUTION_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "jr_algorithm.h"
+#include "jr_task_pool.h"
+
+/* 执行策略与并行算法
+ *     jrSTL::sort(jrSTL::execution::par, v.begin(), v.end());
+ *     jrSTL::task_pool pool(8);
+ *     jrSTL::stable_sort(jrSTL::execution::par.on(pool), v.begin(), v.end());
+ * sort/stable_sort为并行归并排序：叶子区间各自顺序排序，逐层两两并行归并，需要n个元素的临时缓冲区；
+ * merge/inplace_merge按二分切分为互不重叠的子归并并行执行；
+ * partial_sort各块并行选出前k小，再对候选者做一次顺序partial_sort；
+ * unique各块并行去重，再顺序把各块的结果移动到一起；
+ * radix_sort并行统计直方图与分配
+ * 非随机访问迭代器、规模过小或缓冲区申请失败时退回顺序算法
+ */
+namespace jrSTL {
+    namespace execution {
+        class sequenced_policy {};
+
+        class parallel_policy {
+            private:
+                task_pool *_pool;
+
+            public:
+                parallel_policy() : _pool(nullptr) {}
+                explicit parallel_policy(task_pool& pool) : _pool(&pool) {}
+
+                // 在指定的线程池上执行，可据此限制并发度
+                parallel_policy on(task_pool& pool) const {
+                    return parallel_policy(pool);
+                }
+
+                task_pool& pool() const {
+                    return _pool ? *_pool : task_pool::instance();
+                }
+        };
+
+        static const sequenced_policy seq = sequenced_policy();
+        static const parallel_policy par = parallel_policy();
+    }
+
+    template< class T >
+    struct is_execution_policy : std::false_type {};
+
+    template< >
+    struct is_execution_policy<execution::sequenced_policy> : std::true_type {};
+
+    template< >
+    struct is_execution_policy<execution::parallel_policy> : std::true_type {};
+
+    template< class ExecutionPolicy, class R >
+    struct _enable_if_execution_policy
+        : std::enable_if<is_execution_policy<typename std::decay<ExecutionPolicy>::type>::value, R> {};
+
+    // 并行粒度：小于该规模的区间顺序处理
+    static const ptrdiff_t _par_min_grain = 1 << 13;
+
+    template< class It >
+    struct _is_random_access
+        : std::is_convertible<typename jrSTL::iterator_traits<It>::iterator_category,
+                              jrSTL::random_access_iterator_tag> {};
+
+    // 将[0, n)切成若干块并行执行f(s, e)
+    template< class F >
+    void _par_for_chunks( task_pool& pool, size_t n, F f ) {
+        size_t chunks = pool.concurrency() * 4;
+        size_t chunk = (n + chunks - 1) / chunks;
+        if(chunk < static_cast<size_t>(_par_min_grain))
+            chunk = _par_min_grain;
+        _task_group g(pool);
+        for(size_t s = 0; s < n; s += chunk) {
+            size_t e = s + chunk < n ? s + chunk : n;
+            g.run([=]() { f(s, e); });
+        }
+        g.wait();
+    }
+
+    /* 并行算法的临时缓冲区，必须整块申请成功，否则length()为0
+     * 与_temporary_buffer一样以输入元素为种子链式移动构造，但各块分别以对应位置的元素为种子并行构造
+     */
+    template< class T >
+    class _par_buffer {
+        private:
+            task_pool &_pool;
+            T *_b;
+            size_t _len;
+
+            template< class RandomIt >
+            static bool _construct(RandomIt seed, T *dst, size_t n) {
+                size_t i = 0;
+                try {
+                    ::new(static_cast<void *>(dst)) T(std::move(*seed));
+                    for(i = 1; i < n; ++i)
+                        ::new(static_cast<void *>(dst + i)) T(std::move(dst[i - 1]));
+                } catch(...) {
+                    if(i > 0) {
+                        *seed = std::move(dst[i - 1]);
+                        for(size_t j = 0; j < i; ++j)
+                            dst[j].~T();
+                    }
+                    return false;
+                }
+                *seed = std::move(dst[n - 1]);
+                return true;
+            }
+
+            static void _destroy(T *p, size_t n) {
+                for(size_t i = 0; i < n; ++i)
+                    p[i].~T();
+            }
+
+        public:
+            template< class RandomIt >
+            _par_buffer(task_pool& pool, RandomIt seed, size_t len)
+                : _pool(pool), _b(nullptr), _len(0) {
+                if(len == 0)
+                    return;
+                _b = static_cast<T *>(::operator new(len * sizeof(T), std::nothrow));
+                if(!_b)
+                    return;
+                std::vector<size_t> begins;
+                size_t chunks = pool.concurrency() * 4;
+                size_t chunk = (len + chunks - 1) / chunks;
+                for(size_t s = 0; s < len; s += chunk)
+                    begins.push_back(s);
+                std::unique_ptr<std::atomic<bool>[]> ok(new std::atomic<bool>[begins.size()]);
+                bool all_ok = true;
+                {
+                    _task_group g(pool);
+                    for(size_t i = 0; i < begins.size(); ++i) {
+                        size_t s = begins[i], e = s + chunk < len ? s + chunk : len;
+                        std::atomic<bool> *flag = &ok[i];
+                        T *b = _b;
+                        g.run([=]() { flag->store(_construct(seed + s, b + s, e - s)); });
+                    }
+                    g.wait();
+                }
+                for(size_t i = 0; i < begins.size(); ++i)
+                    all_ok = all_ok && ok[i].load();
+                if(!all_ok) {
+                    for(size_t i = 0; i < begins.size(); ++i) {
+                        size_t s = begins[i], e = s + chunk < len ? s + chunk : len;
+                        if(ok[i].load())
+                            _destroy(_b + s, e - s);
+                    }
+                    ::operator delete(_b);
+                    _b = nullptr;
+                    return;
+                }
+                _len = len;
+            }
+
+            _par_buffer(const _par_buffer&) = delete;
+            _par_buffer& operator=(const _par_buffer&) = delete;
+
+            ~_par_buffer() {
+                if(!_b)
+                    return;
+                if(!std::is_trivially_destructible<T>::value) {
+                    T *b = _b;
+                    jrSTL::_par_for_chunks(_pool, _len, [=](size_t s, size_t e) {
+                        _destroy(b + s, e - s);
+                    });
+                }
+                ::operator delete(_b);
+            }
+
+            T *begin() {
+                return _b;
+            }
+
+            size_t length() const {
+                return _len;
+            }
+    };
+
+    // 顺序归并的两种叶子操作：复制（merge）与移动（排序与原地归并内部使用）
+    struct _merge_copy_op {
+        template< class It1, class It2, class OutIt, class Compare >
+        void operator()(It1 f1, It1 l1, It2 f2, It2 l2, OutIt d, Compare comp) const {
+            jrSTL::merge(f1, l1, f2, l2, d, comp);
+        }
+    };
+
+    struct _merge_move_op {
+        template< class It1, class It2, class OutIt, class Compare >
+        void operator()(It1 f1, It1 l1, It2 f2, It2 l2, OutIt d, Compare comp) const {
+            while(f1 != l1 && f2 != l2) {
+                if(comp(*f2, *f1)) {
+                    *d = std::move(*f2);
+                    ++f2;
+                } else {
+                    *d = std::move(*f1);
+                    ++f1;
+                }
+                ++d;
+            }
+            d = jrSTL::move(f1, l1, d);
+            jrSTL::move(f2, l2, d);
+        }
+    };
+
+    /* 并行稳定归并：在较长一侧取中点，于另一侧二分出分界，
+     * 两侧左半归并到输出前段、右半归并到输出后段，两个子归并互不重叠可并行
+     */
+    template< class It1, class It2, class OutIt, class Compare, class Op >
+    void _par_merge( task_pool& pool, It1 f1, It1 l1, It2 f2, It2 l2,
+                     OutIt d, Compare comp, Op op ) {
+        ptrdiff_t n1 = l1 - f1, n2 = l2 - f2;
+        if(n1 + n2 <= 2 * _par_min_grain) {
+            op(f1, l1, f2, l2, d, comp);
+            return;
+        }
+        It1 m1;
+        It2 m2;
+        if(n1 >= n2) {
+            m1 = f1 + n1 / 2;
+            m2 = jrSTL::lower_bound(f2, l2, *m1, comp);
+        } else {
+            m2 = f2 + n2 / 2;
+            m1 = jrSTL::upper_bound(f1, l1, *m2, comp);
+        }
+        OutIt dm = d + (m1 - f1) + (m2 - f2);
+        _task_group g(pool);
+        g.run([=, &pool]() { jrSTL::_par_merge(pool, f1, m1, f2, m2, d, comp, op); });
+        jrSTL::_par_merge(pool, m1, l1, m2, l2, dm, comp, op);
+        g.wait();
+    }
+
+    struct _sort_leaf {
+        template< class RandomIt, class Compare >
+        void operator()(RandomIt first, RandomIt last, Compare comp) const {
+            jrSTL::sort(first, last, comp);
+        }
+    };
+
+    struct _stable_sort_leaf {
+        template< class RandomIt, class Compare >
+        void operator()(RandomIt first, RandomIt last, Compare comp) const {
+            jrSTL::stable_sort(first, last, comp);
+        }
+    };
+
+    /* 并行归并排序：into_buf为true时结果写入buf，否则留在原区间
+     * 两个子区间的结果写到与本层相反的一侧，本层归并时正好从另一侧读入，每层只移动一次
+     */
+    template< class RandomIt, class T, class Compare, class Leaf >
+    void _par_sort_into( task_pool& pool, RandomIt first, RandomIt last,
+                         T *buf, bool into_buf, ptrdiff_t cutoff,
+                         Compare comp, Leaf leaf ) {
+        ptrdiff_t n = last - first;
+        if(n <= cutoff) {
+            leaf(first, last, comp);
+            if(into_buf)
+                jrSTL::move(first, last, buf);
+            return;
+        }
+        ptrdiff_t mid = n / 2;
+        {
+            _task_group g(pool);
+            g.run([=, &pool]() {
+                jrSTL::_par_sort_into(pool, first, first + mid, buf, !into_buf, cutoff, comp, leaf);
+            });
+            jrSTL::_par_sort_into(pool, first + mid, last, buf + mid, !into_buf, cutoff, comp, leaf);
+            g.wait();
+        }
+        if(into_buf)
+            jrSTL::_par_merge(pool, first, first + mid, first + mid, last, buf, comp, _merge_move_op());
+        else
+            jrSTL::_par_merge(pool, buf, buf + mid, buf + mid, buf + n, first, comp, _merge_move_op());
+    }
+
+    template< class RandomIt, class Compare, class Leaf >
+    void _par_sort( task_pool& pool, RandomIt first, RandomIt last, Compare comp, Leaf leaf ) {
+        typedef typename jrSTL::iterator_traits<RandomIt>::value_type type;
+        ptrdiff_t n = last - first;
+        if(pool.concurrency() < 2 || n <= 2 * _par_min_grain) {
+            leaf(first, last, comp);
+            return;
+        }
+        _par_buffer<type> buf(pool, first, static_cast<size_t>(n));
+        if(buf.length() == 0) {
+            leaf(first, last, comp);
+            return;
+        }
+        // 叶子数约为并发度的8倍，以便负载均衡
+        ptrdiff_t cutoff = n / static_cast<ptrdiff_t>(pool.concurrency() * 8);
+        if(cutoff < _par_min_grain)
+            cutoff = _par_min_grain;
+        jrSTL::_par_sort_into(pool, first, last, buf.begin(), false, cutoff, comp, leaf);
+    }
+
+    // sort
+    template< class RandomIt, class Compare >
+    void _sort( const execution::sequenced_policy&, RandomIt first, RandomIt last, Compare comp ) {
+        jrSTL::sort(first, last, comp);
+    }
+
+    template< class RandomIt, class Compare >
+    void _sort( const execution::parallel_policy& policy, RandomIt first, RandomIt last, Compare comp ) {
+        jrSTL::_par_sort(policy.pool(), first, last, comp, _sort_leaf());
+    }
+
+    template< class ExecutionPolicy, class RandomIt, class Compare >
+    typename _enable_if_execution_policy<ExecutionPolicy, void>::type
+    sort( ExecutionPolicy&& policy, RandomIt first, RandomIt last, Compare comp ) {
+        jrSTL::_sort(policy, first, last, comp);
+    }
+
+    template< class ExecutionPolicy, class RandomIt >
+    typename _enable_if_execution_policy<ExecutionPolicy, void>::type
+    sort( ExecutionPolicy&& policy, RandomIt first, RandomIt last ) {
+        typedef typename iterator_traits<RandomIt>::value_type type;
+        jrSTL::_sort(policy, first, last,
+                     [](const type& a, const type& b)
+                     ->bool { return a < b; });
+    }
+
+    // stable_sort
+    template< class RandomIt, class Compare >
+    void _stable_sort( const execution::sequenced_policy&, RandomIt first, RandomIt last, Compare comp ) {
+        jrSTL::stable_sort(first, last, comp);
+    }
+
+    template< class RandomIt, class Compare >
+    void _stable_sort( const execution::parallel_policy& policy, RandomIt first, RandomIt last, Compare comp ) {
+        jrSTL::_par_sort(policy.pool(), first, last, comp, _stable_sort_leaf());
+    }
+
+    template< class ExecutionPolicy, class RandomIt, class Compare >
+    typename _enable_if_execution_policy<ExecutionPolicy, void>::type
+    stable_sort( ExecutionPolicy&& policy, RandomIt first, RandomIt last, Compare comp ) {
+        jrSTL::_stable_sort(policy, first, last, comp);
+    }
+
+    template< class ExecutionPolicy, class RandomIt >
+    typename _enable_if_execution_policy<ExecutionPolicy, void>::type
+    stable_sort( ExecutionPolicy&& policy, RandomIt first, RandomIt last ) {
+        typedef typename iterator_traits<RandomIt>::value_type type;
+        jrSTL::_stable_sort(policy, first, last,
+                            [](const type& a, const type& b)
+                            ->bool { return a < b; });
+    }
+
+    // merge
+    template< class It1, class It2, class OutIt, class Compare >
+    OutIt _merge( const execution::sequenced_policy&, It1 f1, It1 l1, It2 f2, It2 l2,
+                  OutIt d, Compare comp ) {
+        return jrSTL::merge(f1, l1, f2, l2, d, comp);
+    }
+
+    template< class It1, class It2, class OutIt, class Compare >
+    OutIt _merge( const execution::parallel_policy& policy, It1 f1, It1 l1, It2 f2, It2 l2,
+                  OutIt d, Compare comp, std::true_type ) {
+        jrSTL::_par_merge(policy.pool(), f1, l1, f2, l2, d, comp, _merge_copy_op());
+        return d + (l1 - f1) + (l2 - f2);
+    }
+
+    template< class It1, class It2, class OutIt, class Compare >
+    OutIt _merge( const execution::parallel_policy&, It1 f1, It1 l1, It2 f2, It2 l2,
+                  OutIt d, Compare comp, std::false_type ) {
+        return jrSTL::merge(f1, l1, f2, l2, d, comp);
+    }
+
+    template< class It1, class It2, class OutIt, class Compare >
+    OutIt _merge( const execution::parallel_policy& policy, It1 f1, It1 l1, It2 f2, It2 l2,
+                  OutIt d, Compare comp ) {
+        typedef std::integral_constant<bool, _is_random_access<It1>::value
+                                             && _is_random_access<It2>::value
+                                             && _is_random_access<OutIt>::value> type;
+        return jrSTL::_merge(policy, f1, l1, f2, l2, d, comp, type());
+    }
+
+    template< class ExecutionPolicy, class It1, class It2, class OutIt, class Compare >
+    typename _enable_if_execution_policy<ExecutionPolicy, OutIt>::type
+    merge( ExecutionPolicy&& policy, It1 first1, It1 last1, It2 first2, It2 last2,
+           OutIt d_first, Compare comp ) {
+        return jrSTL::_merge(policy, first1, last1, first2, last2, d_first, comp);
+    }
+
+    template< class ExecutionPolicy, class It1, class It2, class OutIt >
+    typename _enable_if_execution_policy<ExecutionPolicy, OutIt>::type
+    merge( ExecutionPolicy&& policy, It1 first1, It1 last1, It2 first2, It2 last2,
+           OutIt d_first ) {
+        typedef typename jrSTL::iterator_traits<It1>::value_type type1;
+        typedef typename jrSTL::iterator_traits<It2>::value_type type2;
+        return jrSTL::_merge(policy, first1, last1, first2, last2, d_first,
+                             [](const type1& a, const type2& b)
+                             ->bool { return a < b; });
+    }
+
+    // inplace_merge：两段整体移入缓冲区，再并行归并回原区间
+    template< class BidirIt, class Compare >
+    void _inplace_merge( const execution::sequenced_policy&, BidirIt first, BidirIt middle,
+                         BidirIt last, Compare comp ) {
+        jrSTL::inplace_merge(first, middle, last, comp);
+    }
+
+    template< class BidirIt, class Compare >
+    void _inplace_merge( const execution::parallel_policy& policy, BidirIt first, BidirIt middle,
+                         BidirIt last, Compare comp, std::true_type ) {
+        typedef typename jrSTL::iterator_traits<BidirIt>::value_type type;
+        task_pool& pool = policy.pool();
+        ptrdiff_t n = last - first, n1 = middle - first;
+        if(pool.concurrency() < 2 || n <= 2 * _par_min_grain) {
+            jrSTL::inplace_merge(first, middle, last, comp);
+            return;
+        }
+        _par_buffer<type> buf(pool, first, static_cast<size_t>(n));
+        if(buf.length() == 0) {
+            jrSTL::inplace_merge(first, middle, last, comp);
+            return;
+        }
+        type *b = buf.begin();
+        jrSTL::_par_for_chunks(pool, static_cast<size_t>(n), [=](size_t s, size_t e) {
+            jrSTL::move(first + s, first + e, b + s);
+        });
+        jrSTL::_par_merge(pool, b, b + n1, b + n1, b + n, first, comp, _merge_move_op());
+    }
+
+    template< class BidirIt, class Compare >
+    void _inplace_merge( const execution::parallel_policy&, BidirIt first, BidirIt middle,
+                         BidirIt last, Compare comp, std::false_type ) {
+        jrSTL::inplace_merge(first, middle, last, comp);
+    }
+
+    template< class BidirIt, class Compare >
+    void _inplace_merge( const execution::parallel_policy& policy, BidirIt first, BidirIt middle,
+                         BidirIt last, Compare comp ) {
+        jrSTL::_inplace_merge(policy, first, middle, last, comp,
+                              std::integral_constant<bool, _is_random_access<BidirIt>::value>());
+    }
+
+    template< class ExecutionPolicy, class BidirIt, class Compare >
+    typename _enable_if_execution_policy<ExecutionPolicy, void>::type
+    inplace_merge( ExecutionPolicy&& policy, BidirIt first, BidirIt middle, BidirIt last,
+                   Compare comp ) {
+        jrSTL::_inplace_merge(policy, first, middle, last, comp);
+    }
+
+    template< class ExecutionPolicy, class BidirIt >
+    typename _enable_if_execution_policy<ExecutionPolicy, void>::type
+    inplace_merge( ExecutionPolicy&& policy, BidirIt first, BidirIt middle, BidirIt last ) {
+        typedef typename iterator_traits<BidirIt>::value_type type;
+        jrSTL::_inplace_merge(policy, first, middle, last,
+                              [](const type& a, const type& b)
+                              ->bool { return a < b; });
+    }
+
+    // partial_sort：各块并行求出块内前k小并集中到区间头部，再对候选者顺序partial_sort
+    template< class RandomIt, class Compare >
+    void _partial_sort( const execution::sequenced_policy&, RandomIt first, RandomIt middle,
+                        RandomIt last, Compare comp ) {
+        jrSTL::partial_sort(first, middle, last, comp);
+    }
+
+    template< class RandomIt, class Compare >
+    void _partial_sort( const execution::parallel_policy& policy, RandomIt first, RandomIt middle,
+                        RandomIt last, Compare comp ) {
+        task_pool& pool = policy.pool();
+        ptrdiff_t n = last - first, k = middle - first;
+        if(k == 0)
+            return;
+        if(pool.concurrency() < 2 || n <= 2 * _par_min_grain) {
+            jrSTL::partial_sort(first, middle, last, comp);
+            return;
+        }
+        ptrdiff_t chunks = static_cast<ptrdiff_t>(pool.concurrency() * 2);
+        ptrdiff_t chunk = (n + chunks - 1) / chunks;
+        if(k > n / 8 || chunk <= 2 * k) {
+            // 前k个占比较大时候选者过多，直接并行全排序
+            jrSTL::_par_sort(pool, first, last, comp, _sort_leaf());
+            return;
+        }
+        {
+            _task_group g(pool);
+            for(ptrdiff_t s = 0; s < n; s += chunk) {
+                ptrdiff_t e = s + chunk < n ? s + chunk : n;
+                ptrdiff_t kc = e - s < k ? e - s : k;
+                g.run([=]() { jrSTL::partial_sort(first + s, first + s + kc, first + e, comp); });
+            }
+            g.wait();
+        }
+        // 各块的前kc个依次交换到头部；目标总在源之前，顺序逐个交换不会覆盖尚未搬运的元素
+        ptrdiff_t total = 0;
+        for(ptrdiff_t s = 0; s < n; s += chunk) {
+            ptrdiff_t kc = n - s < k ? n - s : k;
+            if(s != total)
+                jrSTL::swap_ranges(first + s, first + s + kc, first + total);
+            total += kc;
+        }
+        jrSTL::partial_sort(first, middle, first + total, comp);
+    }
+
+    template< class ExecutionPolicy, class RandomIt, class Compare >
+    typename _enable_if_execution_policy<ExecutionPolicy, void>::type
+    partial_sort( ExecutionPolicy&& policy, RandomIt first, RandomIt middle, RandomIt last,
+                  Compare comp ) {
+        jrSTL::_partial_sort(policy, first, middle, last, comp);
+    }
+
+    template< class ExecutionPolicy, class RandomIt >
+    typename _enable_if_execution_policy<ExecutionPolicy, void>::type
+    partial_sort( ExecutionPolicy&& policy, RandomIt first, RandomIt middle, RandomIt last ) {
+        typedef typename iterator_traits<RandomIt>::value_type type;
+        jrSTL::_partial_sort(policy, first, middle, last,
+                             [](const type& a, const type& b)
+                             ->bool { return a < b; });
+    }
+
+    /* unique：要求p为等价关系，此时只需比较相邻元素，各块可以独立去重
+     * 先并行地求出各块开头与前一块末尾等价、应当删去的元素个数（只读），
+     * 再并行地在块内顺序去重，最后按顺序把各块的结果移动到前面（可平凡拷贝时为memmove）
+     */
+    template< class ForwardIt, class BinaryPredicate >
+    ForwardIt _unique( const execution::sequenced_policy&, ForwardIt first, ForwardIt last,
+                       BinaryPredicate p ) {
+        return jrSTL::unique(first, last, p);
+    }
+
+    template< class RandomIt, class BinaryPredicate >
+    RandomIt _unique( const execution::parallel_policy& policy, RandomIt first, RandomIt last,
+                      BinaryPredicate p, std::true_type ) {
+        task_pool& pool = policy.pool();
+        ptrdiff_t n = last - first;
+        if(pool.concurrency() < 2 || n <= 2 * _par_min_grain)
+            return jrSTL::unique(first, last, p);
+        ptrdiff_t chunks = static_cast<ptrdiff_t>(pool.concurrency() * 4);
+        ptrdiff_t chunk = (n + chunks - 1) / chunks;
+        if(chunk < _par_min_grain)
+            chunk = _par_min_grain;
+        chunks = (n + chunk - 1) / chunk;
+        std::vector<ptrdiff_t> begins(chunks), ends(chunks);
+        {
+            _task_group g(pool);
+            for(ptrdiff_t c = 0; c < chunks; ++c) {
+                ptrdiff_t *b = &begins[c];
+                g.run([=]() {
+                    ptrdiff_t i = c * chunk, e = i + chunk < n ? i + chunk : n;
+                    if(c > 0) {
+                        while(i < e && p(first[i - 1], first[i]))
+                            ++i;
+                    }
+                    *b = i;
+                });
+            }
+            g.wait();
+        }
+        {
+            _task_group g(pool);
+            for(ptrdiff_t c = 0; c < chunks; ++c) {
+                ptrdiff_t b = begins[c], *r = &ends[c];
+                g.run([=]() {
+                    ptrdiff_t e = c * chunk + chunk < n ? c * chunk + chunk : n;
+                    *r = b == e ? e : jrSTL::unique(first + b, first + e, p) - first;
+                });
+            }
+            g.wait();
+        }
+        // 目标位置总不超过源位置，且前面的块先搬运，不会覆盖尚未搬运的元素
+        RandomIt out = first + ends[0];
+        for(ptrdiff_t c = 1; c < chunks; ++c) {
+            if(out == first + begins[c])
+                out = first + ends[c];
+            else
+                out = jrSTL::move(first + begins[c], first + ends[c], out);
+        }
+        return out;
+    }
+
+    template< class ForwardIt, class BinaryPredicate >
+    ForwardIt _unique( const execution::parallel_policy&, ForwardIt first, ForwardIt last,
+                       BinaryPredicate p, std::false_type ) {
+        return jrSTL::unique(first, last, p);
+    }
+
+    template< class ForwardIt, class BinaryPredicate >
+    ForwardIt _unique( const execution::parallel_policy& policy, ForwardIt first, ForwardIt last,
+                       BinaryPredicate p ) {
+        return jrSTL::_unique(policy, first, last, p,
+                              std::integral_constant<bool, _is_random_access<ForwardIt>::value>());
+    }
+
+    template< class ExecutionPolicy, class ForwardIt, class BinaryPredicate >
+    typename _enable_if_execution_policy<ExecutionPolicy, ForwardIt>::type
+    unique( ExecutionPolicy&& policy, ForwardIt first, ForwardIt last, BinaryPredicate p ) {
+        return jrSTL::_unique(policy, first, last, p);
+    }
+
+    template< class ExecutionPolicy, class ForwardIt >
+    typename _enable_if_execution_policy<ExecutionPolicy, ForwardIt>::type
+    unique( ExecutionPolicy&& policy, ForwardIt first, ForwardIt last ) {
+        typedef typename iterator_traits<ForwardIt>::value_type type;
+        return jrSTL::_unique(policy, first, last,
+                              [](const type& a, const type& b)
+                              ->bool { return a == b; });
+    }
+
+    /* radix_sort：LSD每一趟先并行统计各块的桶计数，由(桶, 块)的前缀和得到各块在各桶中的写入起点，
+     * 再并行分配，各块写入的位置互不重叠且保持稳定；
+     * MSD先按首字节分桶，各桶作为独立任务并行递归
+     */
+    template< class RandomIt, class KeyFn >
+    void _par_radix_sort( task_pool& pool, RandomIt first, RandomIt last, KeyFn key, std::true_type ) {
+        typedef typename jrSTL::iterator_traits<RandomIt>::value_type type;
+        typedef typename std::decay<decltype(key(*first))>::type key_type;
+        typedef typename jrSTL::_radix_key_traits<key_type>::type U;
+        ptrdiff_t len = last - first;
+        if(pool.concurrency() < 2 || len <= 2 * _par_min_grain) {
+            jrSTL::radix_sort(first, last, key);
+            return;
+        }
+        size_t n = static_cast<size_t>(len);
+        _par_buffer<type> buffer(pool, first, n);
+        if(buffer.length() == 0) {
+            jrSTL::radix_sort(first, last, key);
+            return;
+        }
+        type *buf = buffer.begin();
+        size_t chunk = (n + pool.concurrency() - 1) / pool.concurrency();
+        if(chunk < static_cast<size_t>(_par_min_grain))
+            chunk = _par_min_grain;
+        size_t chunks = (n + chunk - 1) / chunk;
+        // 各块的全字节直方图，合计后用于跳过平凡的趟
+        typedef size_t histogram[sizeof(U)][256];
+        std::unique_ptr<histogram[]> hist(new histogram[chunks]);
+        {
+            _task_group g(pool);
+            for(size_t c = 0; c < chunks; ++c) {
+                histogram *h = &hist[c];
+                g.run([=]() {
+                    size_t s = c * chunk, e = s + chunk < n ? s + chunk : n;
+                    std::memset(*h, 0, sizeof(histogram));
+                    jrSTL::_radix_histogram(first + s, e - s, key, *h, U());
+                });
+            }
+            g.wait();
+        }
+        std::vector<size_t> offsets(chunks * 256);
+        bool in_buf = false, permuted = false;
+        for(size_t b = 0; b < sizeof(U); ++b) {
+            size_t total[256] = {};
+            for(size_t c = 0; c < chunks; ++c) {
+                for(size_t d = 0; d < 256; ++d)
+                    total[d] += hist[c][b][d];
+            }
+            if(jrSTL::_radix_trivial_pass(total, n))
+                continue;
+            // 元素经过分配后已重排，各块的计数需按当前位置重新统计
+            if(permuted) {
+                _task_group g(pool);
+                for(size_t c = 0; c < chunks; ++c) {
+                    size_t *o = &offsets[c * 256];
+                    bool from_buf = in_buf;
+                    g.run([=]() {
+                        size_t s = c * chunk, e = s + chunk < n ? s + chunk : n;
+                        jrSTL::fill(o, o + 256, size_t(0));
+                        for(size_t i = s; i < e; ++i) {
+                            U u = from_buf ? jrSTL::_radix_key_traits<key_type>::encode(key(buf[i]))
+                                           : jrSTL::_radix_key_traits<key_type>::encode(key(first[i]));
+                            ++o[(u >> (8 * b)) & 0xff];
+                        }
+                    });
+                }
+                g.wait();
+            } else {
+                for(size_t c = 0; c < chunks; ++c)
+                    jrSTL::copy(hist[c][b], hist[c][b] + 256, &offsets[c * 256]);
+            }
+            // 块内计数转换为写入起点：先按桶、再按块累加
+            size_t sum = 0;
+            for(size_t d = 0; d < 256; ++d) {
+                for(size_t c = 0; c < chunks; ++c) {
+                    size_t cnt = offsets[c * 256 + d];
+                    offsets[c * 256 + d] = sum;
+                    sum += cnt;
+                }
+            }
+            {
+                _task_group g(pool);
+                for(size_t c = 0; c < chunks; ++c) {
+                    size_t *o = &offsets[c * 256];
+                    bool from_buf = in_buf;
+                    g.run([=]() {
+                        size_t s = c * chunk, e = s + chunk < n ? s + chunk : n;
+                        if(from_buf)
+                            jrSTL::_radix_scatter(buf + s, e - s, first, b, key, o);
+                        else
+                            jrSTL::_radix_scatter(first + s, e - s, buf, b, key, o);
+                    });
+                }
+                g.wait();
+            }
+            in_buf = !in_buf;
+            permuted = true;
+        }
+        if(in_buf) {
+            jrSTL::_par_for_chunks(pool, n, [=](size_t s, size_t e) {
+                jrSTL::move(buf + s, buf + e, first + s);
+            });
+        }
+    }
+
+    template< class RandomIt, class KeyFn >
+    void _par_radix_sort( task_pool& pool, RandomIt first, RandomIt last, KeyFn key, std::false_type ) {
+        typedef typename jrSTL::iterator_traits<RandomIt>::value_type type;
+        ptrdiff_t len = last - first;
+        if(pool.concurrency() < 2 || len <= 2 * _par_min_grain) {
+            jrSTL::radix_sort(first, last, key);
+            return;
+        }
+        size_t n = static_cast<size_t>(len);
+        _par_buffer<type> buffer(pool, first, n);
+        if(buffer.length() == 0) {
+            jrSTL::radix_sort(first, last, key);
+            return;
+        }
+        type *buf = buffer.begin();
+        size_t bounds[258];
+        jrSTL::_radix_msd_split(first, n, buf, 0, key, bounds);
+        _task_group g(pool);
+        for(size_t d = 1; d < 257; ++d) {
+            size_t s = bounds[d], e = bounds[d + 1];
+            if(e - s > 1)
+                g.run([=]() { jrSTL::_radix_sort_msd(first + s, first + e, buf + s, 1, key); });
+        }
+        g.wait();
+    }
+
+    // 没有编码的算术键按键比较并行归并排序
+    template< class RandomIt, class KeyFn >
+    void _par_radix_sort( task_pool& pool, RandomIt first, RandomIt last, KeyFn key, _radix_compare_tag ) {
+        jrSTL::_radix_plain_less<KeyFn> less = {key};
+        jrSTL::_par_sort(pool, first, last, less, _stable_sort_leaf());
+    }
+
+    template< class RandomIt, class KeyFn >
+    void _radix_sort( const execution::sequenced_policy&, RandomIt first, RandomIt last, KeyFn key ) {
+        jrSTL::radix_sort(first, last, key);
+    }
+
+    template< class RandomIt, class KeyFn >
+    void _radix_sort( const execution::parallel_policy& policy, RandomIt first, RandomIt last, KeyFn key ) {
+        typedef typename std::decay<decltype(key(*first))>::type key_type;
+        jrSTL::_par_radix_sort(policy.pool(), first, last, key,
+                               typename jrSTL::_radix_category<key_type>::type());
+    }
+
+    template< class ExecutionPolicy, class RandomIt, class KeyFn >
+    typename _enable_if_execution_policy<ExecutionPolicy, void>::type
+    radix_sort( ExecutionPolicy&& policy, RandomIt first, RandomIt last, KeyFn key ) {
+        jrSTL::_radix_sort(policy, first, last, key);
+    }
+
+    template< class ExecutionPolicy, class RandomIt >
+    typename _enable_if_execution_policy<ExecutionPolicy, void>::type
+    radix_sort( ExecutionPolicy&& policy, RandomIt first, RandomIt last ) {
+        jrSTL::_radix_sort(policy, first, last, _radix_identity());
+    }
+}
+
+#endif // JR_EXECUTION_H
@@ -0,0 +1,254 @@
+#ifndef JR_SEARCHER_H
+#define JR_SEARCHER_H
+
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+#include "jr_algorithm.h"
+#include "../functional/jr_functional.h"
+#include "../memory/jr_allocator.h"
+#include "../container/sequence/jr_vector.h"
+#include "../container/associate/jr_unordered_map.h"
+
+/* 与C++17相同的搜索器对象，构造时对模式串做一次预处理，之后可以反复用于不同的文本：
+ *     jrSTL::boyer_moore_searcher<const char *> s(pat, pat + m);
+ *     for(每个缓冲区) it = jrSTL::search(buf, buf + n, s);
+ * 搜索器只保存模式串的迭代器，模式串需在搜索器使用期间保持有效
+ * operator()返回匹配区间[first, first + m)，未找到时返回{last, last}，空模式返回{first, first}
+ *
+ * default_searcher               即jrSTL::search，默认谓词且为连续整数区间时使用首元素预筛选
+ * boyer_moore_horspool_searcher  坏字符表，平均比较次数约为n/m，最坏O(nm)
+ * boyer_moore_searcher           坏字符表与好后缀表，查找第一个匹配时最坏O(n)
+ * 坏字符表在元素为单字节整数且使用默认散列与谓词时为256项的数组，否则为散列表
+ */
+namespace jrSTL {
+    template< class Key, class Hash, class Pred >
+    struct _is_byte_skip_table
+            : std::integral_constant<bool,
+                    std::is_integral<Key>::value && sizeof(Key) == 1 &&
+                    std::is_same<Hash, std::hash<Key> >::value &&
+                    (std::is_same<Pred, jrSTL::equal_to<Key> >::value ||
+                     std::is_same<Pred, std::equal_to<Key> >::value)> {};
+
+    // 坏字符表：模式串中出现过的元素对应的跳跃距离，其余元素为默认值
+    template< class Key, class Value, class Hash, class Pred,
+              bool = _is_byte_skip_table<Key, Hash, Pred>::value >
+    class _skip_table {
+        private:
+            typedef jrSTL::unordered_map<Key, Value, Hash, Pred,
+                                         jrSTL::allocator<std::pair<const Key, Value> >,
+                                         flat_hash_policy> map_type;
+            map_type _map;
+            Value _default;
+
+        public:
+            _skip_table(size_t n, Value def, const Hash& hf, const Pred& pred)
+                : _map(n, hf, pred), _default(def) {}
+
+            void set(const Key& k, Value v) {
+                _map[k] = v;
+            }
+
+            Value get(const Key& k) const {
+                typename map_type::const_iterator it = _map.find(k);
+                return it == _map.end() ? _default : it->second;
+            }
+    };
+
+    template< class Key, class Value, class Hash, class Pred >
+    class _skip_table<Key, Value, Hash, Pred, true> {
+        private:
+            Value _tab[256];
+
+        public:
+            _skip_table(size_t, Value def, const Hash&, const Pred&) {
+                for(size_t i = 0; i < 256; ++i)
+                    _tab[i] = def;
+            }
+
+            void set(const Key& k, Value v) {
+                _tab[static_cast<unsigned char>(k)] = v;
+            }
+
+            Value get(const Key& k) const {
+                return _tab[static_cast<unsigned char>(k)];
+            }
+    };
+
+    template< class ForwardIt,
+              class BinaryPredicate = jrSTL::equal_to<typename jrSTL::iterator_traits<ForwardIt>::value_type> >
+    class default_searcher {
+        private:
+            ForwardIt _pat_first;
+            ForwardIt _pat_last;
+            BinaryPredicate _pred;
+
+            template< class ForwardIt2 >
+            ForwardIt2 _search(ForwardIt2 first, ForwardIt2 last, std::true_type) const {
+                return jrSTL::search(first, last, _pat_first, _pat_last);
+            }
+
+            template< class ForwardIt2 >
+            ForwardIt2 _search(ForwardIt2 first, ForwardIt2 last, std::false_type) const {
+                return jrSTL::search(first, last, _pat_first, _pat_last, _pred);
+            }
+
+        public:
+            default_searcher(ForwardIt pat_first, ForwardIt pat_last,
+                             BinaryPredicate pred = BinaryPredicate())
+                : _pat_first(pat_first), _pat_last(pat_last), _pred(pred) {}
+
+            template< class ForwardIt2 >
+            std::pair<ForwardIt2, ForwardIt2> operator()(ForwardIt2 first, ForwardIt2 last) const {
+                typedef typename jrSTL::iterator_traits<ForwardIt>::value_type type;
+                if(_pat_first == _pat_last)
+                    return std::make_pair(first, first);
+                // 默认谓词交给不带谓词的search，以便使用预筛选
+                ForwardIt2 it = _search(first, last,
+                                        std::integral_constant<bool,
+                                            std::is_same<BinaryPredicate, jrSTL::equal_to<type> >::value>());
+                if(it == last)
+                    return std::make_pair(last, last);
+                ForwardIt2 it_last = it;
+                jrSTL::advance(it_last, jrSTL::distance(_pat_first, _pat_last));
+                return std::make_pair(it, it_last);
+            }
+    };
+
+    template< class RandomIt,
+              class Hash = std::hash<typename jrSTL::iterator_traits<RandomIt>::value_type>,
+              class BinaryPredicate = jrSTL::equal_to<typename jrSTL::iterator_traits<RandomIt>::value_type> >
+    class boyer_moore_horspool_searcher {
+        private:
+            typedef typename jrSTL::iterator_traits<RandomIt>::value_type value_type;
+            typedef typename jrSTL::iterator_traits<RandomIt>::difference_type difference_type;
+
+            RandomIt _pat;
+            difference_type _m;
+            _skip_table<value_type, difference_type, Hash, BinaryPredicate> _skip;
+            BinaryPredicate _pred;
+
+        public:
+            // 窗口末元素c对应的跳跃距离为m - 1 - (c在pat[0, m - 1)中最后出现的位置)，未出现时为m
+            boyer_moore_horspool_searcher(RandomIt pat_first, RandomIt pat_last,
+                                          Hash hf = Hash(),
+                                          BinaryPredicate pred = BinaryPredicate())
+                : _pat(pat_first), _m(pat_last - pat_first),
+                  _skip(static_cast<size_t>(_m), _m, hf, pred), _pred(pred) {
+                for(difference_type i = 0; i + 1 < _m; ++i)
+                    _skip.set(_pat[i], _m - 1 - i);
+            }
+
+            template< class RandomIt2 >
+            std::pair<RandomIt2, RandomIt2> operator()(RandomIt2 first, RandomIt2 last) const {
+                if(_m == 0)
+                    return std::make_pair(first, first);
+                if(last - first < _m)
+                    return std::make_pair(last, last);
+                RandomIt2 cur = first, stop = last - _m;
+                while(true) {
+                    difference_type j = _m - 1;
+                    while(_pred(cur[j], _pat[j])) {
+                        if(j == 0)
+                            return std::make_pair(cur, cur + _m);
+                        --j;
+                    }
+                    difference_type shift = _skip.get(cur[_m - 1]);
+                    if(stop - cur < shift)
+                        break;
+                    cur += shift;
+                }
+                return std::make_pair(last, last);
+            }
+    };
+
+    template< class RandomIt,
+              class Hash = std::hash<typename jrSTL::iterator_traits<RandomIt>::value_type>,
+              class BinaryPredicate = jrSTL::equal_to<typename jrSTL::iterator_traits<RandomIt>::value_type> >
+    class boyer_moore_searcher {
+        private:
+            typedef typename jrSTL::iterator_traits<RandomIt>::value_type value_type;
+            typedef typename jrSTL::iterator_traits<RandomIt>::difference_type difference_type;
+
+            RandomIt _pat;
+            difference_type _m;
+            _skip_table<value_type, difference_type, Hash, BinaryPredicate> _skip;
+            jrSTL::vector<difference_type> _good;
+            BinaryPredicate _pred;
+
+            /* 好后缀表：pat[i]失配而pat(i, m)已匹配时的安全移动距离
+             * suff[i]为以pat[i]结尾的子串与模式串后缀的最长公共长度
+             */
+            void _build_good_suffix() {
+                jrSTL::vector<difference_type> suff(static_cast<size_t>(_m));
+                suff[_m - 1] = _m;
+                difference_type f = 0, g = _m - 1;
+                for(difference_type i = _m - 2; i >= 0; --i) {
+                    if(i > g && suff[i + _m - 1 - f] < i - g) {
+                        suff[i] = suff[i + _m - 1 - f];
+                    } else {
+                        if(i < g)
+                            g = i;
+                        f = i;
+                        while(g >= 0 && _pred(_pat[g], _pat[g + _m - 1 - f]))
+                            --g;
+                        suff[i] = f - g;
+                    }
+                }
+                _good.assign(static_cast<size_t>(_m), _m);
+                // 已匹配部分只有某个前缀同时是其后缀时，对齐到该前缀
+                difference_type j = 0;
+                for(difference_type i = _m - 1; i >= 0; --i) {
+                    if(suff[i] == i + 1) {
+                        for(; j < _m - 1 - i; ++j) {
+                            if(_good[j] == _m)
+                                _good[j] = _m - 1 - i;
+                        }
+                    }
+                }
+                // 已匹配部分在模式串中另有出现时，对齐到最靠右的一处
+                for(difference_type i = 0; i + 1 < _m; ++i)
+                    _good[_m - 1 - suff[i]] = _m - 1 - i;
+            }
+
+        public:
+            boyer_moore_searcher(RandomIt pat_first, RandomIt pat_last,
+                                 Hash hf = Hash(),
+                                 BinaryPredicate pred = BinaryPredicate())
+                : _pat(pat_first), _m(pat_last - pat_first),
+                  _skip(static_cast<size_t>(_m), _m, hf, pred), _pred(pred) {
+                if(_m == 0)
+                    return;
+                for(difference_type i = 0; i + 1 < _m; ++i)
+                    _skip.set(_pat[i], _m - 1 - i);
+                _build_good_suffix();
+            }
+
+            template< class RandomIt2 >
+            std::pair<RandomIt2, RandomIt2> operator()(RandomIt2 first, RandomIt2 last) const {
+                if(_m == 0)
+                    return std::make_pair(first, first);
+                if(last - first < _m)
+                    return std::make_pair(last, last);
+                RandomIt2 cur = first, stop = last - _m;
+                while(true) {
+                    difference_type j = _m - 1;
+                    while(_pred(cur[j], _pat[j])) {
+                        if(j == 0)
+                            return std::make_pair(cur, cur + _m);
+                        --j;
+                    }
+                    // 坏字符规则以窗口中失配的元素计算，可能为负，与好后缀规则取较大者
+                    difference_type bad = _skip.get(cur[j]) - (_m - 1 - j);
+                    difference_type shift = _good[j] > bad ? _good[j] : bad;
+                    if(stop - cur < shift)
+                        break;
+                    cur += shift;
+                }
+                return std::make_pair(last, last);
+            }
+    };
+}
+
+#endif // JR_SEARCHER_H
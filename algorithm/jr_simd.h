@@ -0,0 +1,618 @@
+#ifndef JR_SIMD_H
+#define JR_SIMD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define JRSTL_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+/* find、count、min/max_element在连续的算术类型区间上的SIMD实现
+ * 运行时通过CPUID选择AVX2或SSE2，其他平台及不支持的处理器使用标量循环；
+ * 各指令集的实现共用同一份以指令集为模板参数的算法，只有最底层的向量操作按指令集分别编写
+ */
+namespace jrSTL {
+    // 可以向量化的元素类型：除bool外的整数、float、double
+    template< class T >
+    struct _simd_element
+            : std::integral_constant<bool,
+                                     !std::is_volatile<T>::value &&
+                                     ((std::is_integral<T>::value &&
+                                       !std::is_same<T, bool>::value) ||
+                                      std::is_same<T, float>::value ||
+                                      std::is_same<T, double>::value)> {};
+
+    // 指向可向量化元素的指针（vector、array的迭代器即为指针）
+    template< class It >
+    struct _simd_range : std::false_type {};
+
+    template< class T >
+    struct _simd_range<T*>
+            : _simd_element<typename std::remove_const<T>::type> {};
+
+    // 按元素宽度与有无符号选择向量操作
+    template< size_t N >
+    struct _simd_i {};
+
+    template< size_t N >
+    struct _simd_u {};
+
+    struct _simd_f32 {};
+
+    struct _simd_f64 {};
+
+    template< class T, bool = std::is_integral<T>::value >
+    struct _simd_tag {
+        typedef typename std::conditional<std::is_signed<T>::value,
+                                          _simd_i<sizeof(T)>,
+                                          _simd_u<sizeof(T)> >::type type;
+    };
+
+    template< >
+    struct _simd_tag<float, false> {
+        typedef _simd_f32 type;
+    };
+
+    template< >
+    struct _simd_tag<double, false> {
+        typedef _simd_f64 type;
+    };
+
+    template< size_t N >
+    struct _simd_lane {};
+
+    template< >
+    struct _simd_lane<1> { typedef uint8_t type; };
+
+    template< >
+    struct _simd_lane<2> { typedef uint16_t type; };
+
+    template< >
+    struct _simd_lane<4> { typedef uint32_t type; };
+
+    template< >
+    struct _simd_lane<8> { typedef uint64_t type; };
+
+    template< class T >
+    bool _simd_is_nan(const T& x) {
+        return x != x;
+    }
+
+    enum {
+        _simd_isa_scalar = 0,
+        _simd_isa_sse2 = 1,
+        _simd_isa_avx2 = 2
+    };
+
+    inline int _simd_detect() {
+#ifdef JRSTL_SIMD_X86
+        __builtin_cpu_init();
+        if(__builtin_cpu_supports("avx2"))
+            return _simd_isa_avx2;
+        if(__builtin_cpu_supports("sse2"))
+            return _simd_isa_sse2;
+#endif
+        return _simd_isa_scalar;
+    }
+
+    // 当前使用的指令集，首次使用时检测；测试与基准测试可以改写它以比较各实现
+    inline int& _simd_level() {
+        static int level = _simd_detect();
+        return level;
+    }
+
+#ifdef JRSTL_SIMD_X86
+#define JRSTL_TARGET_SSE2 __attribute__((target("sse2")))
+#define JRSTL_TARGET_AVX2 __attribute__((target("avx2")))
+#define JRSTL_KERNEL_SSE2 __attribute__((target("sse2"), flatten))
+#define JRSTL_KERNEL_AVX2 __attribute__((target("avx2"), flatten))
+
+    /* 向量操作一律通过引用传递向量：不带target属性的通用算法与带target属性的操作之间
+     * 按值传递__m256i时两边的调用约定不同（未开启AVX时经内存传递），未内联（如-O0）就会出错；
+     * 入口带flatten属性，优化时整个算法内联进入口，向量仍然留在寄存器中
+     */
+    struct _simd_sse2 {
+        typedef __m128i vec;
+        static const size_t bytes = 16;
+
+        JRSTL_TARGET_SSE2 static void load(vec& r, const void *p) {
+            r = _mm_loadu_si128(static_cast<const __m128i*>(p));
+        }
+
+        JRSTL_TARGET_SSE2 static void store(void *p, const vec& v) {
+            _mm_storeu_si128(static_cast<__m128i*>(p), v);
+        }
+
+        // 每字节一位
+        JRSTL_TARGET_SSE2 static unsigned mask(const vec& v) {
+            return static_cast<unsigned>(_mm_movemask_epi8(v));
+        }
+
+        JRSTL_TARGET_SSE2 static void zero(vec& r) {
+            r = _mm_setzero_si128();
+        }
+
+        JRSTL_TARGET_SSE2 static void bit_or(vec& r, const vec& a, const vec& b) {
+            r = _mm_or_si128(a, b);
+        }
+
+        JRSTL_TARGET_SSE2 static void bit_xor(vec& r, const vec& a, const vec& b) {
+            r = _mm_xor_si128(a, b);
+        }
+
+        // m的各通道全1时取a，全0时取b
+        JRSTL_TARGET_SSE2 static void sel(vec& r, const vec& m, const vec& a, const vec& b) {
+            r = _mm_or_si128(_mm_and_si128(m, a), _mm_andnot_si128(m, b));
+        }
+
+        JRSTL_TARGET_SSE2 static void splat(vec& r, int64_t v, _simd_i<1>) { r = _mm_set1_epi8(static_cast<char>(v)); }
+        JRSTL_TARGET_SSE2 static void splat(vec& r, int64_t v, _simd_i<2>) { r = _mm_set1_epi16(static_cast<short>(v)); }
+        JRSTL_TARGET_SSE2 static void splat(vec& r, int64_t v, _simd_i<4>) { r = _mm_set1_epi32(static_cast<int>(v)); }
+        JRSTL_TARGET_SSE2 static void splat(vec& r, int64_t v, _simd_i<8>) { r = _mm_set1_epi64x(static_cast<long long>(v)); }
+        JRSTL_TARGET_SSE2 static void splat(vec& r, float v, _simd_f32) { r = _mm_castps_si128(_mm_set1_ps(v)); }
+        JRSTL_TARGET_SSE2 static void splat(vec& r, double v, _simd_f64) { r = _mm_castpd_si128(_mm_set1_pd(v)); }
+
+        JRSTL_TARGET_SSE2 static void eq(vec& r, const vec& a, const vec& b, _simd_i<1>) { r = _mm_cmpeq_epi8(a, b); }
+        JRSTL_TARGET_SSE2 static void eq(vec& r, const vec& a, const vec& b, _simd_i<2>) { r = _mm_cmpeq_epi16(a, b); }
+        JRSTL_TARGET_SSE2 static void eq(vec& r, const vec& a, const vec& b, _simd_i<4>) { r = _mm_cmpeq_epi32(a, b); }
+
+        // SSE2没有64位比较，高低两半都相等才相等
+        JRSTL_TARGET_SSE2 static void eq(vec& r, const vec& a, const vec& b, _simd_i<8>) {
+            vec t = _mm_cmpeq_epi32(a, b);
+            r = _mm_and_si128(t, _mm_shuffle_epi32(t, _MM_SHUFFLE(2, 3, 0, 1)));
+        }
+
+        JRSTL_TARGET_SSE2 static void eq(vec& r, const vec& a, const vec& b, _simd_f32) {
+            r = _mm_castps_si128(_mm_cmpeq_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+        }
+
+        JRSTL_TARGET_SSE2 static void eq(vec& r, const vec& a, const vec& b, _simd_f64) {
+            r = _mm_castpd_si128(_mm_cmpeq_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)));
+        }
+
+        JRSTL_TARGET_SSE2 static void gt(vec& r, const vec& a, const vec& b, _simd_i<1>) { r = _mm_cmpgt_epi8(a, b); }
+        JRSTL_TARGET_SSE2 static void gt(vec& r, const vec& a, const vec& b, _simd_i<2>) { r = _mm_cmpgt_epi16(a, b); }
+        JRSTL_TARGET_SSE2 static void gt(vec& r, const vec& a, const vec& b, _simd_i<4>) { r = _mm_cmpgt_epi32(a, b); }
+
+        // 高32位有符号比较，高32位相等时比较低32位（无符号）
+        JRSTL_TARGET_SSE2 static void gt(vec& r, const vec& a, const vec& b, _simd_i<8>) {
+            vec s = _mm_set1_epi32(static_cast<int>(0x80000000u));
+            vec gt32 = _mm_cmpgt_epi32(a, b);
+            vec eq32 = _mm_cmpeq_epi32(a, b);
+            vec gtu = _mm_cmpgt_epi32(_mm_xor_si128(a, s), _mm_xor_si128(b, s));
+            vec t = _mm_or_si128(gt32, _mm_and_si128(eq32, _mm_shuffle_epi32(gtu, _MM_SHUFFLE(2, 2, 0, 0))));
+            r = _mm_shuffle_epi32(t, _MM_SHUFFLE(3, 3, 1, 1));
+        }
+
+        JRSTL_TARGET_SSE2 static void gt(vec& r, const vec& a, const vec& b, _simd_f32) {
+            r = _mm_castps_si128(_mm_cmpgt_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+        }
+
+        JRSTL_TARGET_SSE2 static void gt(vec& r, const vec& a, const vec& b, _simd_f64) {
+            r = _mm_castpd_si128(_mm_cmpgt_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)));
+        }
+
+        JRSTL_TARGET_SSE2 static void sub(vec& r, const vec& a, const vec& b, _simd_i<1>) { r = _mm_sub_epi8(a, b); }
+        JRSTL_TARGET_SSE2 static void sub(vec& r, const vec& a, const vec& b, _simd_i<2>) { r = _mm_sub_epi16(a, b); }
+        JRSTL_TARGET_SSE2 static void sub(vec& r, const vec& a, const vec& b, _simd_i<4>) { r = _mm_sub_epi32(a, b); }
+        JRSTL_TARGET_SSE2 static void sub(vec& r, const vec& a, const vec& b, _simd_i<8>) { r = _mm_sub_epi64(a, b); }
+
+        template< size_t N >
+        static void nan(vec& r, const vec&, _simd_i<N>) { zero(r); }
+
+        JRSTL_TARGET_SSE2 static void nan(vec& r, const vec& a, _simd_f32) {
+            __m128 x = _mm_castsi128_ps(a);
+            r = _mm_castps_si128(_mm_cmpunord_ps(x, x));
+        }
+
+        JRSTL_TARGET_SSE2 static void nan(vec& r, const vec& a, _simd_f64) {
+            __m128d x = _mm_castsi128_pd(a);
+            r = _mm_castpd_si128(_mm_cmpunord_pd(x, x));
+        }
+    };
+
+    struct _simd_avx2 {
+        typedef __m256i vec;
+        static const size_t bytes = 32;
+
+        JRSTL_TARGET_AVX2 static void load(vec& r, const void *p) {
+            r = _mm256_loadu_si256(static_cast<const __m256i*>(p));
+        }
+
+        JRSTL_TARGET_AVX2 static void store(void *p, const vec& v) {
+            _mm256_storeu_si256(static_cast<__m256i*>(p), v);
+        }
+
+        JRSTL_TARGET_AVX2 static unsigned mask(const vec& v) {
+            return static_cast<unsigned>(_mm256_movemask_epi8(v));
+        }
+
+        JRSTL_TARGET_AVX2 static void zero(vec& r) {
+            r = _mm256_setzero_si256();
+        }
+
+        JRSTL_TARGET_AVX2 static void bit_or(vec& r, const vec& a, const vec& b) {
+            r = _mm256_or_si256(a, b);
+        }
+
+        JRSTL_TARGET_AVX2 static void bit_xor(vec& r, const vec& a, const vec& b) {
+            r = _mm256_xor_si256(a, b);
+        }
+
+        JRSTL_TARGET_AVX2 static void sel(vec& r, const vec& m, const vec& a, const vec& b) {
+            r = _mm256_blendv_epi8(b, a, m);
+        }
+
+        JRSTL_TARGET_AVX2 static void splat(vec& r, int64_t v, _simd_i<1>) { r = _mm256_set1_epi8(static_cast<char>(v)); }
+        JRSTL_TARGET_AVX2 static void splat(vec& r, int64_t v, _simd_i<2>) { r = _mm256_set1_epi16(static_cast<short>(v)); }
+        JRSTL_TARGET_AVX2 static void splat(vec& r, int64_t v, _simd_i<4>) { r = _mm256_set1_epi32(static_cast<int>(v)); }
+        JRSTL_TARGET_AVX2 static void splat(vec& r, int64_t v, _simd_i<8>) { r = _mm256_set1_epi64x(static_cast<long long>(v)); }
+        JRSTL_TARGET_AVX2 static void splat(vec& r, float v, _simd_f32) { r = _mm256_castps_si256(_mm256_set1_ps(v)); }
+        JRSTL_TARGET_AVX2 static void splat(vec& r, double v, _simd_f64) { r = _mm256_castpd_si256(_mm256_set1_pd(v)); }
+
+        JRSTL_TARGET_AVX2 static void eq(vec& r, const vec& a, const vec& b, _simd_i<1>) { r = _mm256_cmpeq_epi8(a, b); }
+        JRSTL_TARGET_AVX2 static void eq(vec& r, const vec& a, const vec& b, _simd_i<2>) { r = _mm256_cmpeq_epi16(a, b); }
+        JRSTL_TARGET_AVX2 static void eq(vec& r, const vec& a, const vec& b, _simd_i<4>) { r = _mm256_cmpeq_epi32(a, b); }
+        JRSTL_TARGET_AVX2 static void eq(vec& r, const vec& a, const vec& b, _simd_i<8>) { r = _mm256_cmpeq_epi64(a, b); }
+
+        JRSTL_TARGET_AVX2 static void eq(vec& r, const vec& a, const vec& b, _simd_f32) {
+            r = _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _CMP_EQ_OQ));
+        }
+
+        JRSTL_TARGET_AVX2 static void eq(vec& r, const vec& a, const vec& b, _simd_f64) {
+            r = _mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b), _CMP_EQ_OQ));
+        }
+
+        JRSTL_TARGET_AVX2 static void gt(vec& r, const vec& a, const vec& b, _simd_i<1>) { r = _mm256_cmpgt_epi8(a, b); }
+        JRSTL_TARGET_AVX2 static void gt(vec& r, const vec& a, const vec& b, _simd_i<2>) { r = _mm256_cmpgt_epi16(a, b); }
+        JRSTL_TARGET_AVX2 static void gt(vec& r, const vec& a, const vec& b, _simd_i<4>) { r = _mm256_cmpgt_epi32(a, b); }
+        JRSTL_TARGET_AVX2 static void gt(vec& r, const vec& a, const vec& b, _simd_i<8>) { r = _mm256_cmpgt_epi64(a, b); }
+
+        JRSTL_TARGET_AVX2 static void gt(vec& r, const vec& a, const vec& b, _simd_f32) {
+            r = _mm256_castps_si256(_mm256_cmp_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _CMP_GT_OQ));
+        }
+
+        JRSTL_TARGET_AVX2 static void gt(vec& r, const vec& a, const vec& b, _simd_f64) {
+            r = _mm256_castpd_si256(_mm256_cmp_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b), _CMP_GT_OQ));
+        }
+
+        JRSTL_TARGET_AVX2 static void sub(vec& r, const vec& a, const vec& b, _simd_i<1>) { r = _mm256_sub_epi8(a, b); }
+        JRSTL_TARGET_AVX2 static void sub(vec& r, const vec& a, const vec& b, _simd_i<2>) { r = _mm256_sub_epi16(a, b); }
+        JRSTL_TARGET_AVX2 static void sub(vec& r, const vec& a, const vec& b, _simd_i<4>) { r = _mm256_sub_epi32(a, b); }
+        JRSTL_TARGET_AVX2 static void sub(vec& r, const vec& a, const vec& b, _simd_i<8>) { r = _mm256_sub_epi64(a, b); }
+
+        template< size_t N >
+        static void nan(vec& r, const vec&, _simd_i<N>) { zero(r); }
+
+        JRSTL_TARGET_AVX2 static void nan(vec& r, const vec& a, _simd_f32) {
+            __m256 x = _mm256_castsi256_ps(a);
+            r = _mm256_castps_si256(_mm256_cmp_ps(x, x, _CMP_UNORD_Q));
+        }
+
+        JRSTL_TARGET_AVX2 static void nan(vec& r, const vec& a, _simd_f64) {
+            __m256d x = _mm256_castsi256_pd(a);
+            r = _mm256_castpd_si256(_mm256_cmp_pd(x, x, _CMP_UNORD_Q));
+        }
+    };
+
+    /* 与指令集无关的部分：无符号数翻转符号位后按有符号比较，等值比较与计数不区分符号，
+     * 浮点数的计数按同宽度整数通道累加
+     */
+    template< class Isa >
+    struct _simd_ops : Isa {
+        typedef typename Isa::vec vec;
+        using Isa::splat;
+        using Isa::eq;
+        using Isa::gt;
+        using Isa::sub;
+        using Isa::nan;
+
+        template< size_t N >
+        static void splat(vec& r, int64_t v, _simd_u<N>) { Isa::splat(r, v, _simd_i<N>()); }
+
+        template< size_t N >
+        static void eq(vec& r, const vec& a, const vec& b, _simd_u<N>) { Isa::eq(r, a, b, _simd_i<N>()); }
+
+        template< size_t N >
+        static void gt(vec& r, const vec& a, const vec& b, _simd_u<N>) {
+            vec s, x, y;
+            Isa::splat(s, static_cast<int64_t>(uint64_t(1) << (8 * N - 1)), _simd_i<N>());
+            Isa::bit_xor(x, a, s);
+            Isa::bit_xor(y, b, s);
+            Isa::gt(r, x, y, _simd_i<N>());
+        }
+
+        template< size_t N >
+        static void sub(vec& r, const vec& a, const vec& b, _simd_u<N>) { Isa::sub(r, a, b, _simd_i<N>()); }
+
+        static void sub(vec& r, const vec& a, const vec& b, _simd_f32) { Isa::sub(r, a, b, _simd_i<4>()); }
+
+        static void sub(vec& r, const vec& a, const vec& b, _simd_f64) { Isa::sub(r, a, b, _simd_i<8>()); }
+
+        template< size_t N >
+        static void nan(vec& r, const vec& a, _simd_u<N>) { Isa::nan(r, a, _simd_i<N>()); }
+    };
+
+    // 广播的值统一转换为int64_t（整数）或保持原类型（浮点）
+    template< class T >
+    typename std::conditional<std::is_integral<T>::value, int64_t, T>::type
+    _simd_scalar(T v) {
+        return static_cast<typename std::conditional<std::is_integral<T>::value, int64_t, T>::type>(v);
+    }
+
+    // 返回第一个等于v的元素下标，没有时返回n；每次检查四个向量，减少分支
+    template< class Isa, class T >
+    size_t _simd_find_impl(const T *p, size_t n, T v) {
+        typedef _simd_ops<Isa> ops;
+        typedef typename _simd_tag<T>::type tag;
+        typedef typename ops::vec vec;
+        const size_t w = Isa::bytes / sizeof(T);
+        vec s, x, e0, e1, e2, e3;
+        ops::splat(s, jrSTL::_simd_scalar(v), tag());
+        size_t i = 0;
+        for(; i + 4 * w <= n; i += 4 * w) {
+            ops::load(x, p + i);
+            ops::eq(e0, x, s, tag());
+            ops::load(x, p + i + w);
+            ops::eq(e1, x, s, tag());
+            ops::load(x, p + i + 2 * w);
+            ops::eq(e2, x, s, tag());
+            ops::load(x, p + i + 3 * w);
+            ops::eq(e3, x, s, tag());
+            ops::bit_or(e0, e0, e1);
+            ops::bit_or(e2, e2, e3);
+            ops::bit_or(e0, e0, e2);
+            if(ops::mask(e0))
+                break;
+        }
+        for(; i + w <= n; i += w) {
+            ops::load(x, p + i);
+            ops::eq(e0, x, s, tag());
+            unsigned m = ops::mask(e0);
+            if(m)
+                return i + __builtin_ctz(m) / sizeof(T);
+        }
+        for(; i < n; ++i) {
+            if(p[i] == v)
+                return i;
+        }
+        return n;
+    }
+
+    // 相等的通道为全1，减去它即加一；每条通道至多累加255次后汇总，8位通道也不会溢出
+    template< class Isa, class T >
+    size_t _simd_count_impl(const T *p, size_t n, T v) {
+        typedef _simd_ops<Isa> ops;
+        typedef typename _simd_tag<T>::type tag;
+        typedef typename ops::vec vec;
+        typedef typename _simd_lane<sizeof(T)>::type lane;
+        const size_t w = Isa::bytes / sizeof(T);
+        vec s, x, acc;
+        ops::splat(s, jrSTL::_simd_scalar(v), tag());
+        size_t cnt = 0, i = 0;
+        while(i + w <= n) {
+            ops::zero(acc);
+            for(size_t k = 0; k < 255 && i + w <= n; ++k, i += w) {
+                ops::load(x, p + i);
+                ops::eq(x, x, s, tag());
+                ops::sub(acc, acc, x, tag());
+            }
+            lane buf[w];
+            ops::store(buf, acc);
+            for(size_t j = 0; j < w; ++j)
+                cnt += buf[j];
+        }
+        for(; i < n; ++i) {
+            if(p[i] == v)
+                ++cnt;
+        }
+        return cnt;
+    }
+
+    // 求[p, p + n)的最小值与最大值（n > 0），遇到NaN时返回false
+    template< class Isa, class T >
+    bool _simd_minmax_impl(const T *p, size_t n, T& mn, T& mx) {
+        typedef _simd_ops<Isa> ops;
+        typedef typename _simd_tag<T>::type tag;
+        typedef typename ops::vec vec;
+        const size_t w = Isa::bytes / sizeof(T);
+        size_t i = 0;
+        mn = mx = p[0];
+        if(n >= w) {
+            vec lo, hi, bad, x, m;
+            ops::load(lo, p);
+            hi = lo;
+            ops::nan(bad, lo, tag());
+            for(i = w; i + w <= n; i += w) {
+                ops::load(x, p + i);
+                ops::gt(m, lo, x, tag());
+                ops::sel(lo, m, x, lo);
+                ops::gt(m, x, hi, tag());
+                ops::sel(hi, m, x, hi);
+                ops::nan(m, x, tag());
+                ops::bit_or(bad, bad, m);
+            }
+            if(ops::mask(bad))
+                return false;
+            T lbuf[w], hbuf[w];
+            ops::store(lbuf, lo);
+            ops::store(hbuf, hi);
+            mn = lbuf[0];
+            mx = hbuf[0];
+            for(size_t j = 1; j < w; ++j) {
+                if(lbuf[j] < mn)
+                    mn = lbuf[j];
+                if(mx < hbuf[j])
+                    mx = hbuf[j];
+            }
+        }
+        for(; i < n; ++i) {
+            if(jrSTL::_simd_is_nan(p[i]))
+                return false;
+            if(p[i] < mn)
+                mn = p[i];
+            if(mx < p[i])
+                mx = p[i];
+        }
+        return true;
+    }
+
+    // 各指令集的入口，通用算法内联进来后按对应指令集生成代码
+    template< class T >
+    JRSTL_KERNEL_SSE2 size_t _simd_find_sse2(const T *p, size_t n, T v) {
+        return jrSTL::_simd_find_impl<_simd_sse2>(p, n, v);
+    }
+
+    template< class T >
+    JRSTL_KERNEL_AVX2 size_t _simd_find_avx2(const T *p, size_t n, T v) {
+        return jrSTL::_simd_find_impl<_simd_avx2>(p, n, v);
+    }
+
+    template< class T >
+    JRSTL_KERNEL_SSE2 size_t _simd_count_sse2(const T *p, size_t n, T v) {
+        return jrSTL::_simd_count_impl<_simd_sse2>(p, n, v);
+    }
+
+    template< class T >
+    JRSTL_KERNEL_AVX2 size_t _simd_count_avx2(const T *p, size_t n, T v) {
+        return jrSTL::_simd_count_impl<_simd_avx2>(p, n, v);
+    }
+
+    template< class T >
+    JRSTL_KERNEL_SSE2 bool _simd_minmax_sse2(const T *p, size_t n, T& mn, T& mx) {
+        return jrSTL::_simd_minmax_impl<_simd_sse2>(p, n, mn, mx);
+    }
+
+    template< class T >
+    JRSTL_KERNEL_AVX2 bool _simd_minmax_avx2(const T *p, size_t n, T& mn, T& mx) {
+        return jrSTL::_simd_minmax_impl<_simd_avx2>(p, n, mn, mx);
+    }
+#endif // JRSTL_SIMD_X86
+
+    template< class T >
+    size_t _simd_find(const T *p, size_t n, T v) {
+#ifdef JRSTL_SIMD_X86
+        switch(_simd_level()) {
+            case _simd_isa_avx2:
+                return jrSTL::_simd_find_avx2(p, n, v);
+            case _simd_isa_sse2:
+                return jrSTL::_simd_find_sse2(p, n, v);
+        }
+#endif
+        for(size_t i = 0; i < n; ++i) {
+            if(p[i] == v)
+                return i;
+        }
+        return n;
+    }
+
+    template< class T >
+    size_t _simd_count(const T *p, size_t n, T v) {
+#ifdef JRSTL_SIMD_X86
+        switch(_simd_level()) {
+            case _simd_isa_avx2:
+                return jrSTL::_simd_count_avx2(p, n, v);
+            case _simd_isa_sse2:
+                return jrSTL::_simd_count_sse2(p, n, v);
+        }
+#endif
+        size_t cnt = 0;
+        for(size_t i = 0; i < n; ++i) {
+            if(p[i] == v)
+                ++cnt;
+        }
+        return cnt;
+    }
+
+    template< class T >
+    bool _simd_minmax(const T *p, size_t n, T& mn, T& mx) {
+#ifdef JRSTL_SIMD_X86
+        switch(_simd_level()) {
+            case _simd_isa_avx2:
+                return jrSTL::_simd_minmax_avx2(p, n, mn, mx);
+            case _simd_isa_sse2:
+                return jrSTL::_simd_minmax_sse2(p, n, mn, mx);
+        }
+#endif
+        mn = mx = p[0];
+        for(size_t i = 0; i < n; ++i) {
+            if(jrSTL::_simd_is_nan(p[i]))
+                return false;
+            if(p[i] < mn)
+                mn = p[i];
+            if(mx < p[i])
+                mx = p[i];
+        }
+        return true;
+    }
+
+    /* 最小值、最大值的下标（n > 0），与标量算法的结果一致：
+     * 最小值取第一个；last_max为true时最大值取最后一个（minmax_element），否则取第一个（max_element）
+     * 按16KB分块求块内最值，只记录最值所在的块，最后在该块内定位，除该块外整个区间只读一遍
+     * 出现NaN时比较不再构成严格弱序，结果依赖比较顺序，改用与标量算法相同的循环
+     */
+    template< class T >
+    void _simd_minmax_index(const T *p, size_t n, size_t& imin, size_t& imax, bool last_max) {
+        const size_t block = 16384 / sizeof(T);
+        T best_min = T(), best_max = T();
+        size_t min_blk = 0, max_blk = 0;
+        for(size_t b = 0; b < n; b += block) {
+            size_t len = n - b < block ? n - b : block;
+            T mn, mx;
+            if(!jrSTL::_simd_minmax(p + b, len, mn, mx)) {
+                imin = imax = 0;
+                for(size_t i = 1; i < n; ++i) {
+                    if(p[i] < p[imin])
+                        imin = i;
+                    if(last_max ? !(p[i] < p[imax]) : p[imax] < p[i])
+                        imax = i;
+                }
+                return;
+            }
+            if(b == 0 || mn < best_min) {
+                best_min = mn;
+                min_blk = b;
+            }
+            if(b == 0 || (last_max ? !(mx < best_max) : best_max < mx)) {
+                best_max = mx;
+                max_blk = b;
+            }
+        }
+        size_t min_len = n - min_blk < block ? n - min_blk : block;
+        size_t max_len = n - max_blk < block ? n - max_blk : block;
+        imin = min_blk + jrSTL::_simd_find(p + min_blk, min_len, best_min);
+        if(last_max) {
+            imax = max_blk + max_len - 1;
+            while(!(p[imax] == best_max))
+                --imax;
+        } else {
+            imax = max_blk + jrSTL::_simd_find(p + max_blk, max_len, best_max);
+        }
+    }
+
+    // 整数value不能用元素类型表示时不可能与任何元素相等
+    template< class T, class U >
+    bool _simd_representable(const U& value) {
+        typedef typename std::common_type<T, U>::type C;
+        return static_cast<C>(static_cast<T>(value)) == static_cast<C>(value);
+    }
+
+    // find、count的value与元素同为整数，或类型相同时可以向量化
+    template< class It, class U >
+    struct _simd_comparable : std::false_type {};
+
+    template< class T, class U >
+    struct _simd_comparable<T*, U>
+            : std::integral_constant<bool,
+                                     _simd_range<T*>::value &&
+                                     ((std::is_integral<U>::value &&
+                                       !std::is_same<U, bool>::value &&
+                                       std::is_integral<T>::value) ||
+                                      std::is_same<typename std::remove_const<T>::type,
+                                                   typename std::remove_cv<U>::type>::value)> {};
+}
+
+#endif // JR_SIMD_H
@@ -0,0 +1,201 @@
+#ifndef JR_TASK_POOL_H
+#define JR_TASK_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace jrSTL {
+    /* 工作窃取线程池：每个工作线程一个任务队列，自己的队列后进先出（利于局部性），
+     * 空闲时从其他队列头部窃取（先进先出，窃取到的通常是较大的任务）
+     * 池外线程提交的任务进入0号队列；等待任务组完成的线程（含池外线程）会帮忙执行任务，
+     * 因此嵌套的fork-join不会死锁，并发度为工作线程数加上调用线程
+     */
+    class task_pool {
+        private:
+            struct _queue {
+                std::mutex m;
+                std::deque<std::function<void()> > tasks;
+            };
+
+            struct _thread_slot {
+                task_pool *pool;
+                size_t index;
+            };
+
+            std::vector<std::thread> _threads;
+            std::unique_ptr<_queue[]> _queues;
+            size_t _num_queues;
+            std::atomic<size_t> _queued;
+            std::atomic<size_t> _next;
+            std::atomic<bool> _stop;
+            std::mutex _sleep_m;
+            std::condition_variable _sleep_cv;
+
+            // 当前线程所属的池及其队列编号，池外线程为{nullptr, 0}
+            static _thread_slot& _slot() {
+                static thread_local _thread_slot s = {nullptr, 0};
+                return s;
+            }
+
+            size_t _my_queue() const {
+                _thread_slot& s = _slot();
+                return s.pool == this ? s.index : 0;
+            }
+
+            bool _pop(size_t i, std::function<void()>& task, bool back) {
+                _queue& q = _queues[i];
+                std::lock_guard<std::mutex> guard(q.m);
+                if(q.tasks.empty())
+                    return false;
+                if(back) {
+                    task = std::move(q.tasks.back());
+                    q.tasks.pop_back();
+                } else {
+                    task = std::move(q.tasks.front());
+                    q.tasks.pop_front();
+                }
+                --_queued;
+                return true;
+            }
+
+            void _worker(size_t index) {
+                _slot().pool = this;
+                _slot().index = index;
+                while(true) {
+                    if(run_one())
+                        continue;
+                    std::unique_lock<std::mutex> lk(_sleep_m);
+                    _sleep_cv.wait(lk, [this] { return _queued.load() > 0 || _stop.load(); });
+                    if(_stop.load() && _queued.load() == 0)
+                        return;
+                }
+            }
+
+        public:
+            // concurrency为包括调用线程在内的并发度，池中创建concurrency - 1个工作线程
+            explicit task_pool(size_t concurrency = std::thread::hardware_concurrency())
+                : _num_queues(concurrency ? concurrency : 1),
+                  _queued(0), _next(0), _stop(false) {
+                _queues.reset(new _queue[_num_queues]);
+                for(size_t i = 1; i < _num_queues; ++i)
+                    _threads.push_back(std::thread(&task_pool::_worker, this, i));
+            }
+
+            task_pool(const task_pool&) = delete;
+            task_pool& operator=(const task_pool&) = delete;
+
+            ~task_pool() {
+                {
+                    std::lock_guard<std::mutex> guard(_sleep_m);
+                    _stop = true;
+                }
+                _sleep_cv.notify_all();
+                for(size_t i = 0; i < _threads.size(); ++i)
+                    _threads[i].join();
+            }
+
+            size_t concurrency() const noexcept {
+                return _num_queues;
+            }
+
+            void push(std::function<void()> task) {
+                size_t i = _my_queue();
+                {
+                    std::lock_guard<std::mutex> guard(_queues[i].m);
+                    _queues[i].tasks.push_back(std::move(task));
+                }
+                ++_queued;
+                {
+                    std::lock_guard<std::mutex> guard(_sleep_m);
+                }
+                _sleep_cv.notify_one();
+            }
+
+            // 执行一个任务：先取自己队列尾部，再轮流窃取其他队列头部；没有任务时返回false
+            bool run_one() {
+                if(_queued.load() == 0)
+                    return false;
+                std::function<void()> task;
+                size_t me = _my_queue();
+                bool found = _pop(me, task, true);
+                if(!found) {
+                    size_t start = _next++;
+                    for(size_t k = 0; k < _num_queues && !found; ++k) {
+                        size_t i = (start + k) % _num_queues;
+                        if(i != me)
+                            found = _pop(i, task, false);
+                    }
+                }
+                if(found)
+                    task();
+                return found;
+            }
+
+            // 默认线程池，并发度为硬件线程数
+            static task_pool& instance() {
+                static task_pool pool;
+                return pool;
+            }
+    };
+
+    /* fork-join任务组：run提交子任务，wait等待全部完成，等待期间帮忙执行池中任务
+     * 子任务抛出的第一个异常在wait中重新抛出
+     */
+    class _task_group {
+        private:
+            task_pool &_pool;
+            std::atomic<size_t> _pending;
+            std::mutex _error_m;
+            std::exception_ptr _error;
+
+        public:
+            explicit _task_group(task_pool& pool) : _pool(pool), _pending(0) {}
+
+            _task_group(const _task_group&) = delete;
+            _task_group& operator=(const _task_group&) = delete;
+
+            ~_task_group() {
+                while(_pending.load() != 0) {
+                    if(!_pool.run_one())
+                        std::this_thread::yield();
+                }
+            }
+
+            template< class F >
+            void run(F f) {
+                ++_pending;
+                _pool.push([this, f]() {
+                    try {
+                        f();
+                    } catch(...) {
+                        std::lock_guard<std::mutex> guard(_error_m);
+                        if(!_error)
+                            _error = std::current_exception();
+                    }
+                    --_pending;
+                });
+            }
+
+            void wait() {
+                while(_pending.load() != 0) {
+                    if(!_pool.run_one())
+                        std::this_thread::yield();
+                }
+                if(_error) {
+                    std::exception_ptr e = _error;
+                    _error = nullptr;
+                    std::rethrow_exception(e);
+                }
+            }
+    };
+}
+
+#endif // JR_TASK_POOL_H
@@ -0,0 +1,89 @@
+#ifndef JR_TOP_K_H
+#define JR_TOP_K_H
+
+#include <cstddef>
+#include <utility>
+#include "jr_algorithm.h"
+#include "../functional/jr_functional.h"
+#include "../container/sequence/jr_vector.h"
+#include "../container/utils/jr_heap.h"
+
+/* 流式top-k：逐个接收元素，只保留按comp排序后最靠前的k个，适合长度未知或只能遍历一次的输入
+ *     jrSTL::top_k<int, jrSTL::greater<int> > slowest(100);
+ *     for(每个延迟样本) slowest.push(x);
+ *     jrSTL::vector<int> r = slowest.sorted();     // 最大的100个，从大到小
+ * 内部为容量k的最大堆（按comp），堆顶是当前保留者中最靠后的一个，新元素不排在它之前时只需一次比较，
+ * 否则替换堆顶并向下调整；总代价O(nlogk)，随机输入下替换很少，接近O(n)
+ */
+namespace jrSTL {
+    template< class T, class Compare = jrSTL::less<T> >
+    class top_k {
+        private:
+            jrSTL::vector<T> _heap;
+            size_t _k;
+            Compare _comp;
+
+            template< class U >
+            void _push(U&& value) {
+                typedef typename jrSTL::vector<T>::difference_type dis_type;
+                if(_heap.size() < _k) {
+                    _heap.push_back(std::forward<U>(value));
+                    jrSTL::push_heap(_heap.begin(), _heap.end(), _comp);
+                } else if(_k && _comp(value, _heap.front())) {
+                    jrSTL::_adjust_heap(_heap.begin(), dis_type(0), static_cast<dis_type>(_k),
+                                        T(std::forward<U>(value)), _comp);
+                }
+            }
+
+        public:
+            explicit top_k(size_t k, const Compare& comp = Compare())
+                : _k(k), _comp(comp) {
+                _heap.reserve(k);
+            }
+
+            void push(const T& value) {
+                _push(value);
+            }
+
+            void push(T&& value) {
+                _push(std::move(value));
+            }
+
+            template< class InputIt >
+            void push(InputIt first, InputIt last) {
+                for(; first != last; ++first)
+                    _push(*first);
+            }
+
+            size_t size() const {
+                return _heap.size();
+            }
+
+            size_t k() const {
+                return _k;
+            }
+
+            bool empty() const {
+                return _heap.empty();
+            }
+
+            // 当前保留的元素中排在最后的一个，即下一个会被淘汰者；要求非空
+            const T& back() const {
+                return _heap.front();
+            }
+
+            void clear() {
+                _heap.clear();
+            }
+
+            // 按comp排好序的结果，不改变累加器的状态
+            jrSTL::vector<T> sorted() const {
+                jrSTL::vector<T> result(_heap);
+                Compare comp(_comp);
+                jrSTL::sort_heap(result.begin(), result.end(), comp);
+                return result;
+            }
+    };
+}
+
+#endif // JR_TOP_K_H
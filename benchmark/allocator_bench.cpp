@@ -0,0 +1,70 @@
+#include <iostream>
+#include <vector>
+#include "jr_bench.h"
+#include "../memory/jr_pool_allocator.h"
+#include "../container/sequence/jr_list.h"
+#include "../container/associate/jr_map.h"
+
+// 对比默认分配器、节点池与单调区域下节点式容器的建立、遍历与析构耗时
+// 用法：allocator_bench [n1 n2 ...]，默认规模为1e5、1e6
+struct bench_tag {};
+
+template<class Map>
+void run_map(const char *impl, size_t n) {
+    std::vector<int> keys(n);
+    jrBench::xorshift rng;
+    for(size_t i = 0; i < n; ++i)
+        keys[i] = static_cast<int>(rng());
+    jrBench::timer t;
+    {
+        Map m;
+        for(size_t i = 0; i < n; ++i)
+            m.insert(std::make_pair(keys[i], static_cast<int>(i)));
+        jrBench::report("map_insert", impl, n, t.elapsed_ns(), n);
+        t.reset();
+        long long sum = 0;
+        for(auto it = m.begin(); it != m.end(); ++it)
+            sum += it->second;
+        jrBench::do_not_optimize(sum);
+        jrBench::report("map_iterate", impl, n, t.elapsed_ns(), n);
+        t.reset();
+    }
+    jrBench::report("map_destroy", impl, n, t.elapsed_ns(), n);
+}
+
+template<class List>
+void run_list(const char *impl, size_t n) {
+    jrBench::timer t;
+    {
+        List l;
+        for(size_t i = 0; i < n; ++i)
+            l.push_back(static_cast<int>(i));
+        jrBench::report("list_push_back", impl, n, t.elapsed_ns(), n);
+        t.reset();
+        long long sum = 0;
+        for(auto it = l.begin(); it != l.end(); ++it)
+            sum += *it;
+        jrBench::do_not_optimize(sum);
+        jrBench::report("list_iterate", impl, n, t.elapsed_ns(), n);
+        t.reset();
+    }
+    jrBench::report("list_destroy", impl, n, t.elapsed_ns(), n);
+}
+
+int main(int argc, char **argv) {
+    std::vector<size_t> ns = jrBench::sizes(argc, argv, {100000, 1000000});
+    typedef std::pair<const int, int> value;
+    for(size_t n : ns) {
+        run_map<jrSTL::map<int, int> >("allocator", n);
+        run_map<jrSTL::map<int, int, jrSTL::less<int>,
+                           jrSTL::pool_allocator<value> > >("pool_allocator", n);
+        run_map<jrSTL::map<int, int, jrSTL::less<int>,
+                           jrSTL::arena_allocator<value, bench_tag> > >("arena_allocator", n);
+        jrSTL::arena_allocator<value, bench_tag>::arena().release();
+        run_list<jrSTL::list<int> >("allocator", n);
+        run_list<jrSTL::list<int, jrSTL::pool_allocator<int> > >("pool_allocator", n);
+        run_list<jrSTL::list<int, jrSTL::arena_allocator<int, bench_tag> > >("arena_allocator", n);
+        jrSTL::arena_allocator<int, bench_tag>::arena().release();
+    }
+    return 0;
+}
@@ -0,0 +1,70 @@
+#include <iostream>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "jr_bench.h"
+#include "../memory/jr_smart_ptr.h"
+
+// 读多写少的快照发布：1个写者不停地替换快照，N个读者各自读取n次，报告读者每次读取的平均耗时
+// 对比标准库的atomic_load/atomic_store（libstdc++按地址散列到一组互斥锁）
+// 用法：atomic_shared_ptr_bench [n1 n2 ...]，n为每个读者的读取次数，默认规模为1e6
+struct config {
+    long version, checksum;
+    config(long v) : version(v), checksum(~v) {}
+};
+
+template<class Ptr, class Load, class Store, class Make>
+void run(const char *impl, size_t n, size_t readers, Load load, Store store, Make make) {
+    Ptr slot = make(0);
+    std::atomic<size_t> running(readers);
+    std::atomic<size_t> stores(0);
+    std::thread writer([&]() {
+        long v = 0;
+        while(running.load() != 0) {
+            store(&slot, make(++v));
+            ++stores;
+        }
+    });
+    std::vector<std::thread> ts;
+    jrBench::timer t;
+    for(size_t i = 0; i < readers; ++i) {
+        ts.push_back(std::thread([&]() {
+            long sum = 0;
+            for(size_t k = 0; k < n; ++k) {
+                Ptr p = load(&slot);
+                sum += p->version ^ p->checksum;
+            }
+            jrBench::do_not_optimize(sum);
+            --running;
+        }));
+    }
+    for(size_t i = 0; i < readers; ++i)
+        ts[i].join();
+    double ns = t.elapsed_ns();
+    writer.join();
+    char bench[32];
+    std::snprintf(bench, sizeof(bench), "load 1w/%zur", readers);
+    jrBench::report(bench, impl, n, ns, n * readers);
+    std::printf("%-24s %-24s %12s %12zu stores\n", bench, impl, "", stores.load());
+}
+
+int main(int argc, char **argv) {
+    std::vector<size_t> ns = jrBench::sizes(argc, argv, {1000000});
+    size_t hw = std::thread::hardware_concurrency();
+    if(hw < 4)
+        hw = 4;
+    for(size_t n : ns) {
+        for(size_t r = 1; r <= hw; r *= 2) {
+            run<std::shared_ptr<config> >("std::atomic_load", n, r,
+                [](const std::shared_ptr<config> *p) { return std::atomic_load(p); },
+                [](std::shared_ptr<config> *p, std::shared_ptr<config> v) { std::atomic_store(p, v); },
+                [](long v) { return std::make_shared<config>(v); });
+            run<jrSTL::shared_ptr<config> >("jrSTL::atomic_load", n, r,
+                [](const jrSTL::shared_ptr<config> *p) { return jrSTL::atomic_load(p); },
+                [](jrSTL::shared_ptr<config> *p, jrSTL::shared_ptr<config> v) { jrSTL::atomic_store(p, v); },
+                [](long v) { return jrSTL::make_shared<config>(v); });
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,79 @@
+#include <iostream>
+#include <algorithm>
+#include <deque>
+#include <vector>
+#include "jr_bench.h"
+#include "../algorithm/jr_algorithm.h"
+#include "../container/sequence/jr_vector.h"
+#include "../container/sequence/jr_deque.h"
+
+// 连续区间上的move、fill、fill_n、copy_backward、equal、mismatch、lexicographical_compare（改用memmove/memset/memcmp后）
+// 与std的对比，以及容器内部受益的操作：vector每次删除首元素、deque删除中部元素
+// 用法：bytewise_bench [n1 n2 ...]，默认规模为1e4、1e6
+template<class F>
+void run(const char *bench, const char *impl, size_t n, size_t reps, F f) {
+    f();
+    jrBench::timer t;
+    for(size_t r = 0; r < reps; ++r)
+        f();
+    jrBench::report(bench, impl, n, t.elapsed_ns(), n * reps);
+}
+
+template<class Vec>
+void erase_front(const char *impl, size_t n) {
+    Vec v(n, 1);
+    jrBench::timer t;
+    while(!v.empty())
+        v.erase(v.begin());
+    jrBench::report("vector erase(begin)", impl, n, t.elapsed_ns(), n);
+}
+
+template<class Deque>
+void erase_middle(const char *impl, size_t n) {
+    Deque d(n, 1);
+    jrBench::timer t;
+    while(!d.empty())
+        d.erase(d.cbegin() + d.size() / 3);
+    jrBench::report("deque erase(size/3)", impl, n, t.elapsed_ns(), n);
+}
+
+int main(int argc, char **argv) {
+    std::vector<size_t> ns = jrBench::sizes(argc, argv, {10000, 1000000});
+    for(size_t n : ns) {
+        std::vector<int> a(n), b(n);
+        jrBench::xorshift rng;
+        for(size_t i = 0; i < n; ++i)
+            a[i] = b[i] = static_cast<int>(rng() % 1000);
+        std::vector<unsigned char> s(n, 'x'), t(n, 'x');
+        int *pa = a.data(), *pb = b.data();
+        size_t reps = 100000000 / n + 1;
+
+        run("move", "jrSTL", n, reps, [&]() { jrBench::do_not_optimize(jrSTL::move(pa, pa + n, pb)); });
+        run("move", "std", n, reps, [&]() { jrBench::do_not_optimize(std::move(pa, pa + n, pb)); });
+        run("copy_backward", "jrSTL", n, reps, [&]() { jrBench::do_not_optimize(jrSTL::copy_backward(pa, pa + n, pb + n)); });
+        run("copy_backward", "std", n, reps, [&]() { jrBench::do_not_optimize(std::copy_backward(pa, pa + n, pb + n)); });
+        run("fill(0)", "jrSTL", n, reps, [&]() { jrSTL::fill(pb, pb + n, 0); jrBench::do_not_optimize(pb); });
+        run("fill(0)", "std", n, reps, [&]() { std::fill(pb, pb + n, 0); jrBench::do_not_optimize(pb); });
+        run("fill_n(uchar)", "jrSTL", n, reps, [&]() { jrBench::do_not_optimize(jrSTL::fill_n(t.data(), n, 'x')); });
+        run("fill_n(uchar)", "std", n, reps, [&]() { jrBench::do_not_optimize(std::fill_n(t.data(), n, 'x')); });
+        std::copy(pa, pa + n, pb);
+        run("equal", "jrSTL", n, reps, [&]() { jrBench::do_not_optimize(jrSTL::equal(pa, pa + n, pb)); });
+        run("equal", "std", n, reps, [&]() { jrBench::do_not_optimize(std::equal(pa, pa + n, pb)); });
+        run("mismatch", "jrSTL", n, reps, [&]() { jrBench::do_not_optimize(jrSTL::mismatch(pa, pa + n, pb)); });
+        run("mismatch", "std", n, reps, [&]() { jrBench::do_not_optimize(std::mismatch(pa, pa + n, pb)); });
+        run("lexicographical(uchar)", "jrSTL", n, reps, [&]() {
+            jrBench::do_not_optimize(jrSTL::lexicographical_compare(s.data(), s.data() + n, t.data(), t.data() + n));
+        });
+        run("lexicographical(uchar)", "std", n, reps, [&]() {
+            jrBench::do_not_optimize(std::lexicographical_compare(s.data(), s.data() + n, t.data(), t.data() + n));
+        });
+
+        // 逐个删除为O(n^2)，只在较小的规模上进行
+        size_t m = n < 100000 ? n : 100000;
+        erase_front<std::vector<int> >("std::vector", m);
+        erase_front<jrSTL::vector<int> >("jrSTL::vector", m);
+        erase_middle<std::deque<int> >("std::deque", m);
+        erase_middle<jrSTL::deque<int> >("jrSTL::deque", m);
+    }
+    return 0;
+}
@@ -0,0 +1,48 @@
+#include <iostream>
+#include <deque>
+#include "jr_bench.h"
+#include "../container/sequence/jr_deque.h"
+
+// 对比jrSTL::deque与std::deque的头尾插入删除吞吐量
+// 用法：deque_bench [n1 n2 ...]，默认规模为1e4、1e6、1e7
+template<class Deque>
+void run(const char *impl, size_t n) {
+    Deque d;
+    jrBench::timer t;
+    for(size_t i = 0; i < n; ++i)
+        d.push_front(static_cast<int>(i));
+    jrBench::report("push_front", impl, n, t.elapsed_ns(), n);
+    t.reset();
+    for(size_t i = 0; i < n; ++i)
+        d.push_back(static_cast<int>(i));
+    jrBench::report("push_back", impl, n, t.elapsed_ns(), n);
+    t.reset();
+    // 队列用法：尾部入队、头部出队
+    for(size_t i = 0; i < n; ++i) {
+        d.push_back(static_cast<int>(i));
+        d.pop_front();
+    }
+    jrBench::report("queue_push_pop", impl, n, t.elapsed_ns(), n);
+    t.reset();
+    long long sum = 0;
+    for(size_t i = 0; i < d.size(); ++i)
+        sum += d[i];
+    jrBench::report("random_access", impl, n, t.elapsed_ns(), d.size());
+    t.reset();
+    while(!d.empty()) {
+        d.pop_front();
+        if(!d.empty())
+            d.pop_back();
+    }
+    jrBench::report("pop_front_back", impl, n, t.elapsed_ns(), 2 * n);
+    jrBench::do_not_optimize(sum);
+}
+
+int main(int argc, char **argv) {
+    std::vector<size_t> ns = jrBench::sizes(argc, argv, {10000, 1000000, 10000000});
+    for(size_t n : ns) {
+        run<std::deque<int> >("std::deque", n);
+        run<jrSTL::deque<int> >("jrSTL::deque", n);
+    }
+    return 0;
+}
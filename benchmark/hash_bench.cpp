@@ -0,0 +1,89 @@
+#include <iostream>
+#include <unordered_map>
+#include <string>
+#include "jr_bench.h"
+#include "../container/associate/jr_unordered_map.h"
+
+// 对比链式散列、开放定址（flat_hash_policy）与std::unordered_map的
+// 插入、命中查找、未命中查找、删除吞吐量，分别使用long long与string键
+// 用法：hash_bench [n1 n2 ...]，默认规模为1e4、1e6；可传入1e7、1e8等更大规模
+template<class Key>
+struct bench_hash {
+    size_t operator()(const Key& k) const {
+        return std::hash<Key>()(k);
+    }
+};
+
+// 以与插入不同的随机顺序访问，避免结点按分配顺序连续存放带来的缓存优势
+template<class Key>
+std::vector<Key> shuffled(std::vector<Key> v) {
+    jrBench::xorshift rng(12345);
+    for(size_t i = v.size(); i > 1; --i)
+        std::swap(v[i - 1], v[rng() % i]);
+    return v;
+}
+
+template<class Map, class Key>
+void run(const char *impl, const std::vector<Key>& keys,
+         const std::vector<Key>& misses) {
+    size_t n = keys.size();
+    std::vector<Key> order = shuffled(keys);
+    Map m;
+    jrBench::timer t;
+    for(size_t i = 0; i < n; ++i)
+        m.insert(std::make_pair(keys[i], static_cast<int>(i)));
+    jrBench::report("insert", impl, n, t.elapsed_ns(), n);
+    t.reset();
+    size_t found = 0;
+    for(size_t i = 0; i < n; ++i)
+        found += m.count(order[i]);
+    jrBench::report("lookup_hit", impl, n, t.elapsed_ns(), n);
+    t.reset();
+    for(size_t i = 0; i < misses.size(); ++i)
+        found += m.count(misses[i]);
+    jrBench::report("lookup_miss", impl, n, t.elapsed_ns(), misses.size());
+    t.reset();
+    size_t erased = 0;
+    for(size_t i = 0; i < n; ++i)
+        erased += m.erase(order[i]);
+    jrBench::report("erase", impl, n, t.elapsed_ns(), n);
+    jrBench::do_not_optimize(found);
+    jrBench::do_not_optimize(erased);
+}
+
+template<class Key>
+void run_all(const char *key_name, const std::vector<Key>& keys,
+             const std::vector<Key>& misses) {
+    typedef std::pair<const Key, int> value_type;
+    std::printf("-- %s keys\n", key_name);
+    run<std::unordered_map<Key, int>, Key>("std::unordered_map", keys, misses);
+    run<jrSTL::unordered_map<Key, int, bench_hash<Key>, jrSTL::equal_to<Key>,
+                             jrSTL::allocator<value_type>,
+                             jrSTL::chained_hash_policy>, Key>
+        ("jrSTL chained", keys, misses);
+    run<jrSTL::unordered_map<Key, int, bench_hash<Key>, jrSTL::equal_to<Key>,
+                             jrSTL::allocator<value_type>,
+                             jrSTL::flat_hash_policy>, Key>
+        ("jrSTL flat", keys, misses);
+}
+
+int main(int argc, char **argv) {
+    std::vector<size_t> ns = jrBench::sizes(argc, argv, {10000, 1000000});
+    for(size_t n : ns) {
+        jrBench::xorshift rng;
+        // 奇数键用于插入，偶数键保证未命中
+        std::vector<long long> ikeys(n), imiss(n);
+        for(size_t i = 0; i < n; ++i) {
+            ikeys[i] = static_cast<long long>((rng() >> 2) | 1);
+            imiss[i] = static_cast<long long>((rng() >> 2) & ~1ULL);
+        }
+        run_all<long long>("long long", ikeys, imiss);
+        std::vector<std::string> skeys(n), smiss(n);
+        for(size_t i = 0; i < n; ++i) {
+            skeys[i] = "key_" + std::to_string(ikeys[i]);
+            smiss[i] = "key_" + std::to_string(imiss[i]);
+        }
+        run_all<std::string>("string", skeys, smiss);
+    }
+    return 0;
+}
@@ -0,0 +1,75 @@
+#include <iostream>
+#include <unordered_set>
+#include "jr_bench.h"
+#include "../container/associate/jr_unordered_set.h"
+
+// 控制字节分组探测的微基准：
+// 1. 单独比较标量实现与SIMD实现匹配一组16个控制字节的耗时；
+// 2. 分别测量unordered_set命中与未命中查找的延迟（去重过滤场景以未命中为主）
+// 用法：hash_probe_bench [n1 n2 ...]，默认规模为1e4、1e6
+// 以-DJR_HASH_NO_SIMD编译可令容器本身也使用标量实现
+template<class Group>
+void run_group(const char *impl, const std::vector<signed char>& ctrl, size_t rounds) {
+    size_t groups = ctrl.size() / Group::width;
+    unsigned acc = 0;
+    jrBench::timer t;
+    for(size_t r = 0; r < rounds; ++r) {
+        for(size_t g = 0; g < groups; ++g) {
+            Group grp(&ctrl[g * Group::width]);
+            acc += grp.match(static_cast<signed char>(r & 0x7F));
+            acc += grp.match_empty();
+        }
+    }
+    jrBench::report("group_match", impl, groups, t.elapsed_ns(), groups * rounds);
+    jrBench::do_not_optimize(acc);
+}
+
+template<class Set>
+void run_set(const char *impl, const std::vector<long long>& keys,
+             const std::vector<long long>& misses) {
+    size_t n = keys.size();
+    Set s;
+    for(size_t i = 0; i < n; ++i)
+        s.insert(keys[i]);
+    size_t found = 0;
+    jrBench::timer t;
+    for(size_t i = 0; i < n; ++i)
+        found += s.count(keys[n - 1 - i]);
+    jrBench::report("lookup_hit", impl, n, t.elapsed_ns(), n);
+    t.reset();
+    for(size_t i = 0; i < misses.size(); ++i)
+        found += s.count(misses[i]);
+    jrBench::report("lookup_miss", impl, n, t.elapsed_ns(), misses.size());
+    jrBench::do_not_optimize(found);
+}
+
+int main(int argc, char **argv) {
+    std::vector<size_t> ns = jrBench::sizes(argc, argv, {10000, 1000000});
+    {
+        // 按7/8负载随机生成控制字节
+        jrBench::xorshift rng;
+        std::vector<signed char> ctrl(1 << 16);
+        for(size_t i = 0; i < ctrl.size(); ++i)
+            ctrl[i] = rng() % 8 ? static_cast<signed char>(rng() & 0x7F) : jrSTL::_ctrl_empty;
+        run_group<jrSTL::_ctrl_group_portable>("portable", ctrl, 1000);
+#ifdef JR_HASH_USE_SSE2
+        run_group<jrSTL::_ctrl_group_sse2>("sse2", ctrl, 1000);
+#endif
+    }
+    for(size_t n : ns) {
+        jrBench::xorshift rng;
+        // 奇数键用于插入，偶数键保证未命中
+        std::vector<long long> keys(n), misses(n);
+        for(size_t i = 0; i < n; ++i) {
+            keys[i] = static_cast<long long>((rng() >> 2) | 1);
+            misses[i] = static_cast<long long>((rng() >> 2) & ~1ULL);
+        }
+        run_set<std::unordered_set<long long> >("std::unordered_set", keys, misses);
+        run_set<jrSTL::unordered_set<long long> >("jrSTL chained", keys, misses);
+        run_set<jrSTL::unordered_set<long long, std::hash<long long>,
+                                     jrSTL::equal_to<long long>,
+                                     jrSTL::allocator<long long>,
+                                     jrSTL::flat_hash_policy> >("jrSTL flat", keys, misses);
+    }
+    return 0;
+}
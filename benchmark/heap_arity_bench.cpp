@@ -0,0 +1,160 @@
+#include <iostream>
+#include <queue>
+#include <vector>
+#include "jr_bench.h"
+#include "../container/adapter/jr_priority_queue.h"
+#include "../container/adapter/jr_pairing_heap.h"
+
+// 不同叉数的堆与配对堆的吞吐对比：
+// pop_drain：装满n个元素后依次弹出；hold：保持n个元素，每次pop后push一个更大的键（事件调度的典型模式）；
+// dijkstra：随机稀疏图上的最短路，二叉堆/四叉堆惰性删除与配对堆decrease_key对比
+// 用法：heap_arity_bench [n1 n2 ...]，默认规模为1e5、1e6
+typedef jrSTL::greater<unsigned long long> later;
+
+template<class Queue>
+void run_queue(const char *impl, const std::vector<unsigned long long>& keys) {
+    size_t n = keys.size();
+    Queue q;
+    q.push_range(keys.begin(), keys.end());
+    jrBench::timer t;
+    unsigned long long sum = 0;
+    for(size_t i = 0; i < n; ++i) {
+        sum += q.top();
+        q.pop();
+    }
+    jrBench::report("pop_drain", impl, n, t.elapsed_ns(), n);
+    jrBench::do_not_optimize(sum);
+
+    q.push_range(keys.begin(), keys.end());
+    t.reset();
+    for(size_t i = 0; i < n; ++i) {
+        unsigned long long x = q.top();
+        q.pop();
+        q.push(x + keys[i] % 1024 + 1);
+    }
+    jrBench::report("hold", impl, n, t.elapsed_ns(), n);
+    jrBench::do_not_optimize(q);
+}
+
+void run_pairing(const std::vector<unsigned long long>& keys) {
+    size_t n = keys.size();
+    jrSTL::pairing_heap<unsigned long long, later> q;
+    for(size_t i = 0; i < n; ++i)
+        q.push(keys[i]);
+    jrBench::timer t;
+    unsigned long long sum = 0;
+    for(size_t i = 0; i < n; ++i) {
+        sum += q.top();
+        q.pop();
+    }
+    jrBench::report("pop_drain", "pairing_heap", n, t.elapsed_ns(), n);
+    jrBench::do_not_optimize(sum);
+
+    for(size_t i = 0; i < n; ++i)
+        q.push(keys[i]);
+    t.reset();
+    for(size_t i = 0; i < n; ++i) {
+        unsigned long long x = q.top();
+        q.pop();
+        q.push(x + keys[i] % 1024 + 1);
+    }
+    jrBench::report("hold", "pairing_heap", n, t.elapsed_ns(), n);
+    jrBench::do_not_optimize(q);
+}
+
+struct graph {
+    std::vector<size_t> begin, to;
+    std::vector<unsigned long long> w;
+};
+
+static graph make_graph(size_t n) {
+    graph g;
+    jrBench::xorshift rng;
+    for(size_t u = 0; u < n; ++u) {
+        g.begin.push_back(g.to.size());
+        for(int k = 0; k < 8; ++k) {
+            g.to.push_back(static_cast<size_t>(rng() % n));
+            g.w.push_back(rng() % 1000 + 1);
+        }
+    }
+    g.begin.push_back(g.to.size());
+    return g;
+}
+
+typedef std::pair<unsigned long long, size_t> item;
+
+template<size_t Arity>
+void dijkstra_lazy(const char *impl, const graph& g, size_t n) {
+    const unsigned long long inf = ~0ull;
+    std::vector<unsigned long long> d(n, inf);
+    jrSTL::priority_queue<item, jrSTL::vector<item>, jrSTL::greater<item>, Arity> q;
+    jrBench::timer t;
+    d[0] = 0;
+    q.push(item(0, 0));
+    while(!q.empty()) {
+        item x = q.top();
+        q.pop();
+        if(x.first != d[x.second])
+            continue;
+        for(size_t e = g.begin[x.second]; e < g.begin[x.second + 1]; ++e) {
+            unsigned long long nd = x.first + g.w[e];
+            if(nd < d[g.to[e]]) {
+                d[g.to[e]] = nd;
+                q.push(item(nd, g.to[e]));
+            }
+        }
+    }
+    jrBench::report("dijkstra", impl, n, t.elapsed_ns(), n);
+    jrBench::do_not_optimize(d);
+}
+
+void dijkstra_pairing(const graph& g, size_t n) {
+    typedef jrSTL::pairing_heap<item, jrSTL::greater<item> > heap;
+    const unsigned long long inf = ~0ull;
+    std::vector<unsigned long long> d(n, inf);
+    std::vector<heap::handle> handle(n);
+    std::vector<bool> done(n, false);
+    heap q;
+    jrBench::timer t;
+    d[0] = 0;
+    handle[0] = q.push(item(0, 0));
+    while(!q.empty()) {
+        item x = q.top();
+        q.pop();
+        done[x.second] = true;
+        for(size_t e = g.begin[x.second]; e < g.begin[x.second + 1]; ++e) {
+            size_t v = g.to[e];
+            unsigned long long nd = x.first + g.w[e];
+            if(d[v] == inf) {
+                d[v] = nd;
+                handle[v] = q.push(item(nd, v));
+            } else if(!done[v] && nd < d[v]) {
+                d[v] = nd;
+                q.decrease_key(handle[v], item(nd, v));
+            }
+        }
+    }
+    jrBench::report("dijkstra", "pairing_heap", n, t.elapsed_ns(), n);
+    jrBench::do_not_optimize(d);
+}
+
+int main(int argc, char **argv) {
+    std::vector<size_t> ns = jrBench::sizes(argc, argv, {100000, 1000000});
+    for(size_t n : ns) {
+        std::vector<unsigned long long> keys(n);
+        jrBench::xorshift rng;
+        for(size_t i = 0; i < n; ++i)
+            keys[i] = rng();
+        typedef jrSTL::vector<unsigned long long> vec;
+        run_queue<jrSTL::priority_queue<unsigned long long, vec, later, 2> >("binary", keys);
+        run_queue<jrSTL::priority_queue<unsigned long long, vec, later, 4> >("4-ary", keys);
+        run_queue<jrSTL::priority_queue<unsigned long long, vec, later, 8> >("8-ary", keys);
+        run_pairing(keys);
+
+        graph g = make_graph(n);
+        dijkstra_lazy<2>("binary(lazy)", g, n);
+        dijkstra_lazy<4>("4-ary(lazy)", g, n);
+        dijkstra_pairing(g, n);
+    }
+    return 0;
+}
@@ -0,0 +1,64 @@
+#include <iostream>
+#include <algorithm>
+#include <queue>
+#include <vector>
+#include "jr_bench.h"
+#include "../container/adapter/jr_priority_queue.h"
+
+// 建堆与优先队列批量装载：make_heap、逐个push与push_range的耗时对比
+// 用法：heap_bench [n1 n2 ...]，默认规模为1e5、1e6、1e7
+int main(int argc, char **argv) {
+    std::vector<size_t> ns = jrBench::sizes(argc, argv, {100000, 1000000, 10000000});
+    for(size_t n : ns) {
+        jrSTL::vector<long long> input;
+        input.reserve(n);
+        jrBench::xorshift rng;
+        for(size_t i = 0; i < n; ++i)
+            input.push_back(static_cast<long long>(rng()));
+
+        std::vector<long long> s(input.begin(), input.end());
+        jrBench::timer t;
+        std::make_heap(s.begin(), s.end());
+        jrBench::report("make_heap", "std::make_heap", n, t.elapsed_ns(), n);
+        jrBench::do_not_optimize(s);
+
+        jrSTL::vector<long long> v(input);
+        t.reset();
+        jrSTL::make_heap(v.begin(), v.end());
+        jrBench::report("make_heap", "jrSTL::make_heap", n, t.elapsed_ns(), n);
+        jrBench::do_not_optimize(v);
+
+        // 随机键下逐个push的上滤期望为O(1)；升序键（如递增的时间戳）每次都上滤到根，是逐个push的最坏情况
+        jrSTL::vector<long long> ascending(input);
+        std::sort(ascending.begin(), ascending.end());
+        const char *loads[] = {"load<random>", "load<ascending>"};
+        for(int k = 0; k < 2; ++k) {
+            const jrSTL::vector<long long>& in = k ? ascending : input;
+            t.reset();
+            {
+                jrSTL::priority_queue<long long> q;
+                for(size_t i = 0; i < n; ++i)
+                    q.push(in[i]);
+                jrBench::do_not_optimize(q);
+            }
+            jrBench::report(loads[k], "push", n, t.elapsed_ns(), n);
+
+            t.reset();
+            {
+                jrSTL::priority_queue<long long> q;
+                q.reserve(n);
+                q.push_range(in.begin(), in.end());
+                jrBench::do_not_optimize(q);
+            }
+            jrBench::report(loads[k], "reserve+push_range", n, t.elapsed_ns(), n);
+        }
+
+        // 装载后依次弹出，检验堆的质量不因批量建堆而变差
+        jrSTL::priority_queue<long long> q(jrSTL::less<long long>(), v);
+        t.reset();
+        for(size_t i = 0; i < n; ++i)
+            q.pop();
+        jrBench::report("priority_queue_drain", "pop", n, t.elapsed_ns(), n);
+    }
+    return 0;
+}
@@ -0,0 +1,73 @@
+#ifndef JR_BENCH_H
+#define JR_BENCH_H
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstddef>
+#include <vector>
+
+namespace jrBench {
+    // 计时器，以纳秒为单位返回自构造（或上次reset）以来经过的时间
+    class timer {
+        private:
+            std::chrono::steady_clock::time_point _start;
+
+        public:
+            timer() : _start(std::chrono::steady_clock::now()) {}
+
+            void reset() {
+                _start = std::chrono::steady_clock::now();
+            }
+
+            double elapsed_ns() const {
+                return static_cast<double>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now() - _start).count());
+            }
+    };
+
+    // 从命令行读取元素规模，未给出时使用默认规模
+    inline std::vector<size_t> sizes(int argc, char **argv,
+                                     std::vector<size_t> defaults) {
+        if(argc <= 1)
+            return defaults;
+        std::vector<size_t> ret;
+        for(int i = 1; i < argc; ++i)
+            ret.push_back(static_cast<size_t>(std::strtod(argv[i], nullptr)));
+        return ret;
+    }
+
+    // 简单的xorshift伪随机数发生器，保证各实现使用相同的输入序列
+    class xorshift {
+        private:
+            unsigned long long _s;
+
+        public:
+            explicit xorshift(unsigned long long seed = 88172645463325252ULL)
+                : _s(seed ? seed : 1) {}
+
+            unsigned long long operator()() {
+                _s ^= _s << 13;
+                _s ^= _s >> 7;
+                _s ^= _s << 17;
+                return _s;
+            }
+    };
+
+    // 输出一行结果：测试项、实现名、规模、每次操作耗时
+    inline void report(const char *bench, const char *impl,
+                       size_t n, double total_ns, size_t ops) {
+        std::printf("%-24s %-24s %12zu %12.2f ns/op\n",
+                    bench, impl, n, ops ? total_ns / ops : 0.0);
+        std::fflush(stdout);
+    }
+
+    // 防止编译器将被测结果优化掉
+    template<class T>
+    inline void do_not_optimize(const T& v) {
+        asm volatile("" : : "g"(&v) : "memory");
+    }
+}
+
+#endif // JR_BENCH_H
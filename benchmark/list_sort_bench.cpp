@@ -0,0 +1,70 @@
+#include <iostream>
+#include <list>
+#include <forward_list>
+#include <vector>
+#include "jr_bench.h"
+#include "../container/sequence/jr_list.h"
+#include "../container/sequence/jr_forward_list.h"
+#include "../functional/jr_functional.h"
+
+// 链表排序：std::list::sort、自底向上归并与指针数组排序的耗时对比
+// 节点按插入顺序分配时在内存中基本连续，shuffled先打乱再排序一次，使节点顺序与地址无关，模拟长期运行后的链表
+// 用法：list_sort_bench [n1 n2 ...]，默认规模为1e6、1e7
+template<class List>
+void fill(List& l, const std::vector<int>& keys) {
+    for(size_t i = keys.size(); i > 0; --i)
+        l.push_front(keys[i - 1]);
+}
+
+template<class List, class Sort>
+void run(const char *bench, const char *impl, const std::vector<int>& keys, bool shuffle, Sort sort) {
+    size_t n = keys.size();
+    List l;
+    fill(l, keys);
+    if(shuffle) {
+        // 按随机键排序一次把节点打乱到与地址无关的顺序，再写入原始键
+        List tmp;
+        for(size_t i = n; i > 0; --i)
+            tmp.push_front(static_cast<int>(jrBench::xorshift()()));
+        l.swap(tmp);
+        l.sort();
+        size_t i = 0;
+        for(auto it = l.begin(); it != l.end(); ++it)
+            *it = keys[i++];
+    }
+    jrBench::timer t;
+    sort(l);
+    jrBench::report(bench, impl, n, t.elapsed_ns(), n);
+    jrBench::do_not_optimize(l);
+}
+
+int main(int argc, char **argv) {
+    std::vector<size_t> ns = jrBench::sizes(argc, argv, {1000000, 10000000});
+    for(size_t n : ns) {
+        std::vector<int> keys(n);
+        jrBench::xorshift rng;
+        for(size_t i = 0; i < n; ++i)
+            keys[i] = static_cast<int>(rng());
+        for(int shuffle = 0; shuffle < 2; ++shuffle) {
+            const char *lb = shuffle ? "list<shuffled>" : "list<sequential>";
+            const char *fb = shuffle ? "forward_list<shuffled>" : "forward_list<sequential>";
+            run<std::list<int> >(lb, "std::list", keys, shuffle,
+                                 [](std::list<int>& l) { l.sort(); });
+            run<jrSTL::list<int> >(lb, "bottom_up", keys, shuffle,
+                                   [](jrSTL::list<int>& l) { l.sort(); });
+            run<jrSTL::list<int> >(lb, "by_pointer", keys, shuffle,
+                                   [](jrSTL::list<int>& l) {
+                                       l.sort(jrSTL::less<int>(), jrSTL::list_sort_by_pointer());
+                                   });
+            run<std::forward_list<int> >(fb, "std::forward_list", keys, shuffle,
+                                         [](std::forward_list<int>& l) { l.sort(); });
+            run<jrSTL::forward_list<int> >(fb, "bottom_up", keys, shuffle,
+                                           [](jrSTL::forward_list<int>& l) { l.sort(); });
+            run<jrSTL::forward_list<int> >(fb, "by_pointer", keys, shuffle,
+                                           [](jrSTL::forward_list<int>& l) {
+                                               l.sort(jrSTL::less<int>(), jrSTL::list_sort_by_pointer());
+                                           });
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,39 @@
+#include <iostream>
+#include <memory>
+#include <vector>
+#include "jr_bench.h"
+#include "../memory/jr_smart_ptr.h"
+
+// 创建并销毁shared_ptr：make_shared把对象与计数放在同一次分配中，由指针构造则对象与控制块各分配一次
+// 用法：make_shared_bench [n1 n2 ...]，默认规模为1e7
+struct payload {
+    long a, b;
+    payload(long x) : a(x), b(x + 1) {}
+};
+
+template<class Make>
+void run(const char *bench, const char *impl, size_t n, Make make) {
+    jrBench::timer t;
+    long sum = 0;
+    for(size_t i = 0; i < n; ++i) {
+        auto sp = make(static_cast<long>(i));
+        sum += sp->b;
+    }
+    jrBench::report(bench, impl, n, t.elapsed_ns(), n);
+    jrBench::do_not_optimize(sum);
+}
+
+int main(int argc, char **argv) {
+    std::vector<size_t> ns = jrBench::sizes(argc, argv, {10000000});
+    for(size_t n : ns) {
+        run("make_shared", "std", n,
+            [](long x) { return std::make_shared<payload>(x); });
+        run("make_shared", "jrSTL", n,
+            [](long x) { return jrSTL::make_shared<payload>(x); });
+        run("shared_ptr(new)", "std", n,
+            [](long x) { return std::shared_ptr<payload>(new payload(x)); });
+        run("shared_ptr(new)", "jrSTL", n,
+            [](long x) { return jrSTL::shared_ptr<payload>(new payload(x)); });
+    }
+    return 0;
+}
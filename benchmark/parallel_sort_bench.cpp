@@ -0,0 +1,67 @@
+#include <iostream>
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <vector>
+#include "jr_bench.h"
+#include "../algorithm/jr_execution.h"
+#include "../container/sequence/jr_vector.h"
+
+// 并行sort/stable_sort/partial_sort的加速曲线：并发度依次取1、2、4……直至硬件线程数，
+// 每一行在实现名中给出并发度，末尾附加相对并发度1的加速比；jrSTL的各次运行以jrSTL::vector存放数据
+// 用法：parallel_sort_bench [n1 n2 ...]，默认规模为1e6、1e7
+template<class Run>
+void curve(const char *bench, size_t n, const std::vector<int>& input, Run run) {
+    size_t hw = std::thread::hardware_concurrency();
+    if(hw == 0)
+        hw = 1;
+    double base = 0;
+    for(size_t p = 1; ; p *= 2) {
+        if(p > hw)
+            p = hw;
+        jrSTL::task_pool pool(p);
+        jrSTL::vector<int> v(input.data(), input.data() + input.size());
+        jrBench::timer t;
+        run(jrSTL::execution::par.on(pool), v);
+        double ns = t.elapsed_ns();
+        jrBench::do_not_optimize(v);
+        if(p == 1)
+            base = ns;
+        char impl[32];
+        std::snprintf(impl, sizeof(impl), "par(%zu)", p);
+        jrBench::report(bench, impl, n, ns, n);
+        std::printf("%-24s %-24s %12s %12.2fx speedup\n", bench, impl, "", base / ns);
+        if(p == hw)
+            break;
+    }
+}
+
+int main(int argc, char **argv) {
+    std::vector<size_t> ns = jrBench::sizes(argc, argv, {1000000, 10000000});
+    for(size_t n : ns) {
+        std::vector<int> input(n);
+        jrBench::xorshift rng;
+        for(size_t i = 0; i < n; ++i)
+            input[i] = static_cast<int>(rng());
+
+        std::vector<int> v(input);
+        jrBench::timer t;
+        std::sort(v.begin(), v.end());
+        jrBench::report("sort", "std::sort", n, t.elapsed_ns(), n);
+        jrBench::do_not_optimize(v);
+
+        curve("sort", n, input,
+              [](const jrSTL::execution::parallel_policy& par, jrSTL::vector<int>& x) {
+                  jrSTL::sort(par, x.begin(), x.end());
+              });
+        curve("stable_sort", n, input,
+              [](const jrSTL::execution::parallel_policy& par, jrSTL::vector<int>& x) {
+                  jrSTL::stable_sort(par, x.begin(), x.end());
+              });
+        curve("partial_sort<n/1000>", n, input,
+              [](const jrSTL::execution::parallel_policy& par, jrSTL::vector<int>& x) {
+                  jrSTL::partial_sort(par, x.begin(), x.begin() + x.size() / 1000, x.end());
+              });
+    }
+    return 0;
+}
@@ -0,0 +1,64 @@
+#include <iostream>
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "jr_bench.h"
+#include "../algorithm/jr_execution.h"
+
+// 对比基数排序与比较排序：uint64_t时间戳、(uint32_t, float)按浮点键、字符串
+// 用法：radix_sort_bench [n1 n2 ...]，默认规模为1e5、1e6
+template<class T, class Key>
+void run(const char *bench, const std::vector<T>& input, Key key) {
+    size_t n = input.size();
+    auto less = [&](const T& a, const T& b) { return key(a) < key(b); };
+
+    std::vector<T> v(input);
+    jrBench::timer t;
+    std::sort(v.begin(), v.end(), less);
+    jrBench::report(bench, "std::sort", n, t.elapsed_ns(), n);
+    jrBench::do_not_optimize(v);
+
+    v = input;
+    t.reset();
+    jrSTL::sort(v.begin(), v.end(), less);
+    jrBench::report(bench, "jrSTL::sort", n, t.elapsed_ns(), n);
+    jrBench::do_not_optimize(v);
+
+    v = input;
+    t.reset();
+    jrSTL::radix_sort(v.begin(), v.end(), key);
+    jrBench::report(bench, "jrSTL::radix_sort", n, t.elapsed_ns(), n);
+    jrBench::do_not_optimize(v);
+
+    v = input;
+    t.reset();
+    jrSTL::radix_sort(jrSTL::execution::par, v.begin(), v.end(), key);
+    jrBench::report(bench, "radix_sort(par)", n, t.elapsed_ns(), n);
+    jrBench::do_not_optimize(v);
+}
+
+int main(int argc, char **argv) {
+    std::vector<size_t> ns = jrBench::sizes(argc, argv, {100000, 1000000});
+    for(size_t n : ns) {
+        jrBench::xorshift rng;
+        // 时间戳：高位基本相同，基数排序可跳过这些字节
+        std::vector<uint64_t> ts(n);
+        for(size_t i = 0; i < n; ++i)
+            ts[i] = 1700000000000000ull + rng() % 100000000000ull;
+        run("radix<uint64_t>", ts, [](uint64_t x) { return x; });
+
+        std::vector<std::pair<uint32_t, float> > pairs(n);
+        for(size_t i = 0; i < n; ++i)
+            pairs[i] = std::make_pair(static_cast<uint32_t>(i),
+                                      static_cast<float>(static_cast<int>(rng() % 2000001) - 1000000) / 3.0f);
+        run("radix<pair,float>", pairs,
+            [](const std::pair<uint32_t, float>& x) { return x.second; });
+
+        std::vector<std::string> strs(n / 4);
+        for(size_t i = 0; i < strs.size(); ++i)
+            strs[i] = "user/" + std::to_string(rng() % 1000000);
+        run("radix<string>", strs, [](const std::string& x) -> const std::string& { return x; });
+    }
+    return 0;
+}
@@ -0,0 +1,80 @@
+#include <iostream>
+#include <algorithm>
+#include <functional>
+#include <vector>
+#include "jr_bench.h"
+#include "../algorithm/jr_algorithm.h"
+#include "../algorithm/jr_top_k.h"
+#include "../functional/jr_functional.h"
+
+// 百分位与top-k查询：nth_element求中位数与p99，partial_sort求最大的100个，与std比较；
+// 以及top_k流式累加（不修改输入），和先整体排序再取前100个的做法
+// 输入为随机的延迟样本，以及有序、逆序、少量不同值三种容易使快速选择退化的分布
+// 用法：select_bench [n1 n2 ...]，默认规模为1e6、1e8
+static const char *kinds[] = {"random", "sorted", "reversed", "few-unique"};
+
+static std::vector<unsigned> make_input(size_t n, int kind) {
+    std::vector<unsigned> v(n);
+    jrBench::xorshift rng;
+    for(size_t i = 0; i < n; ++i) {
+        switch(kind) {
+            case 0: v[i] = static_cast<unsigned>(rng() % 10000000); break;
+            case 1: v[i] = static_cast<unsigned>(i); break;
+            case 2: v[i] = static_cast<unsigned>(n - i); break;
+            default: v[i] = static_cast<unsigned>(rng() % 16); break;
+        }
+    }
+    return v;
+}
+
+// 每次在输入的副本上运行，拷贝不计时
+template<class F>
+void run(const char *bench, const char *impl, const std::vector<unsigned>& input, F f) {
+    std::vector<unsigned> v(input);
+    jrBench::timer t;
+    f(v);
+    jrBench::report(bench, impl, input.size(), t.elapsed_ns(), input.size());
+    jrBench::do_not_optimize(v);
+}
+
+int main(int argc, char **argv) {
+    std::vector<size_t> ns = jrBench::sizes(argc, argv, {1000000, 100000000});
+    const size_t k = 100;
+    for(size_t n : ns) {
+        for(int kind = 0; kind < 4; ++kind) {
+            std::vector<unsigned> input = make_input(n, kind);
+            char bench[32];
+            size_t p50 = n / 2, p99 = n / 100 * 99;
+            std::snprintf(bench, sizeof(bench), "median %s", kinds[kind]);
+            run(bench, "std", input, [p50](std::vector<unsigned>& v) {
+                std::nth_element(v.begin(), v.begin() + p50, v.end());
+            });
+            run(bench, "jrSTL", input, [p50](std::vector<unsigned>& v) {
+                jrSTL::nth_element(v.data(), v.data() + p50, v.data() + v.size());
+            });
+            std::snprintf(bench, sizeof(bench), "p99 %s", kinds[kind]);
+            run(bench, "std", input, [p99](std::vector<unsigned>& v) {
+                std::nth_element(v.begin(), v.begin() + p99, v.end());
+            });
+            run(bench, "jrSTL", input, [p99](std::vector<unsigned>& v) {
+                jrSTL::nth_element(v.data(), v.data() + p99, v.data() + v.size());
+            });
+            std::snprintf(bench, sizeof(bench), "top-100 %s", kinds[kind]);
+            run(bench, "std::partial_sort", input, [k](std::vector<unsigned>& v) {
+                std::partial_sort(v.begin(), v.begin() + k, v.end(), std::greater<unsigned>());
+            });
+            run(bench, "jrSTL::partial_sort", input, [k](std::vector<unsigned>& v) {
+                jrSTL::partial_sort(v.data(), v.data() + k, v.data() + v.size(), jrSTL::greater<unsigned>());
+            });
+            run(bench, "jrSTL::top_k", input, [k](std::vector<unsigned>& v) {
+                jrSTL::top_k<unsigned, jrSTL::greater<unsigned> > top(k);
+                top.push(v.begin(), v.end());
+                jrBench::do_not_optimize(top.sorted());
+            });
+            run(bench, "jrSTL::sort", input, [](std::vector<unsigned>& v) {
+                jrSTL::sort(v.data(), v.data() + v.size(), jrSTL::greater<unsigned>());
+            });
+        }
+    }
+    return 0;
+}
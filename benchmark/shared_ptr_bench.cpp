@@ -0,0 +1,70 @@
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "jr_bench.h"
+#include "../memory/jr_smart_ptr.h"
+
+// shared_ptr拷贝、销毁的竞争测试：所有线程反复拷贝同一个shared_ptr再销毁，计数器所在的缓存行在线程间来回传递
+// 以及单线程下原子计数与普通计数的对比（编译时定义JRSTL_SHARED_PTR_SINGLE_THREADED即让shared_ptr使用后者）
+// 用法：shared_ptr_bench [n1 n2 ...]，n为每个线程的拷贝次数，默认规模为1e6
+template<class Ptr>
+void contention(const char *impl, size_t n, size_t threads) {
+    Ptr sp(new int(1));
+    std::vector<std::thread> ts;
+    jrBench::timer t;
+    for(size_t i = 0; i < threads; ++i) {
+        ts.push_back(std::thread([&sp, n]() {
+            for(size_t k = 0; k < n; ++k) {
+                Ptr c(sp);
+                jrBench::do_not_optimize(c);
+            }
+        }));
+    }
+    for(size_t i = 0; i < threads; ++i)
+        ts[i].join();
+    double ns = t.elapsed_ns();
+    char bench[32];
+    std::snprintf(bench, sizeof(bench), "copy+destroy x%zu", threads);
+    jrBench::report(bench, impl, n, ns, n * threads);
+}
+
+template<class Policy>
+void count_ops(const char *impl, size_t n) {
+    jrSTL::_shared_count<Policy> cnt;
+    jrBench::timer t;
+    for(size_t k = 0; k < n; ++k) {
+        cnt.add_strong_cnt();
+        jrBench::do_not_optimize(cnt);
+        cnt.decrease_strong_cnt();
+    }
+    jrBench::report("count inc+dec", impl, n, t.elapsed_ns(), n);
+    jrBench::do_not_optimize(cnt);
+}
+
+int main(int argc, char **argv) {
+    std::vector<size_t> ns = jrBench::sizes(argc, argv, {1000000});
+#ifdef JRSTL_SHARED_PTR_SINGLE_THREADED
+    std::printf("jrSTL::shared_ptr: single-threaded counting\n");
+#else
+    std::printf("jrSTL::shared_ptr: atomic counting\n");
+#endif
+    size_t hw = std::thread::hardware_concurrency();
+    if(hw < 4)
+        hw = 4;
+    for(size_t n : ns) {
+        count_ops<jrSTL::_atomic_count_policy>("atomic", n);
+        count_ops<jrSTL::_single_thread_count_policy>("single-thread", n);
+        // 单线程计数不能在多线程下使用，竞争测试只在原子模式下进行多线程部分
+#ifdef JRSTL_SHARED_PTR_SINGLE_THREADED
+        size_t max_threads = 1;
+#else
+        size_t max_threads = hw;
+#endif
+        for(size_t p = 1; p <= max_threads; p *= 2) {
+            contention<std::shared_ptr<int> >("std::shared_ptr", n, p);
+            contention<jrSTL::shared_ptr<int> >("jrSTL::shared_ptr", n, p);
+        }
+    }
+    return 0;
+}
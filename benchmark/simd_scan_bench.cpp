@@ -0,0 +1,77 @@
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+#include <vector>
+#include "jr_bench.h"
+#include "../algorithm/jr_algorithm.h"
+
+// find、count、min/max_element的扫描带宽：查找不存在的值以遍历整个区间，
+// 分别强制使用标量、SSE2、AVX2实现，并与std及memchr（字节查找，作为内存带宽的参照）比较
+// 规模超过末级缓存时各实现应受内存带宽限制，SIMD实现应接近memchr
+// 用法：simd_scan_bench [n1 n2 ...]，n为区间的字节数，默认规模为32KB与256MB
+static const char *level_name[] = {"jrSTL scalar", "jrSTL sse2", "jrSTL avx2"};
+
+static void report_bw(const char *bench, const char *impl, size_t bytes, double ns, size_t reps) {
+    std::printf("%-24s %-24s %12zu %12.2f GB/s\n",
+                bench, impl, bytes, ns > 0 ? static_cast<double>(bytes) * reps / ns : 0.0);
+    std::fflush(stdout);
+}
+
+// 重复扫描，使总读取量约为1GB
+static size_t reps_for(size_t bytes) {
+    size_t reps = (size_t(1) << 30) / (bytes ? bytes : 1);
+    return reps ? reps : 1;
+}
+
+template<class T, class F>
+void run(const char *bench, const char *impl, const std::vector<T>& v, F f) {
+    size_t bytes = v.size() * sizeof(T), reps = reps_for(bytes);
+    f(v.data(), v.data() + v.size());
+    jrBench::timer t;
+    for(size_t r = 0; r < reps; ++r)
+        jrBench::do_not_optimize(f(v.data(), v.data() + v.size()));
+    report_bw(bench, impl, bytes, t.elapsed_ns(), reps);
+}
+
+template<class T>
+void bench_type(const char *type, size_t bytes) {
+    std::vector<T> v(bytes / sizeof(T));
+    jrBench::xorshift rng;
+    for(size_t i = 0; i < v.size(); ++i)
+        v[i] = static_cast<T>(rng() % 100);
+    const T absent = static_cast<T>(101);
+    char bench[32];
+    int saved = jrSTL::_simd_level();
+    for(int level = 0; level <= jrSTL::_simd_detect(); ++level) {
+        jrSTL::_simd_level() = level;
+        std::snprintf(bench, sizeof(bench), "find<%s>", type);
+        run(bench, level_name[level], v, [absent](const T *b, const T *e) { return jrSTL::find(b, e, absent); });
+        std::snprintf(bench, sizeof(bench), "count<%s>", type);
+        run(bench, level_name[level], v, [](const T *b, const T *e) { return jrSTL::count(b, e, T(7)); });
+        std::snprintf(bench, sizeof(bench), "minmax_element<%s>", type);
+        run(bench, level_name[level], v, [](const T *b, const T *e) { return jrSTL::minmax_element(b, e).first; });
+    }
+    jrSTL::_simd_level() = saved;
+    std::snprintf(bench, sizeof(bench), "find<%s>", type);
+    run(bench, "std", v, [absent](const T *b, const T *e) { return std::find(b, e, absent); });
+    std::snprintf(bench, sizeof(bench), "count<%s>", type);
+    run(bench, "std", v, [](const T *b, const T *e) { return std::count(b, e, T(7)); });
+    std::snprintf(bench, sizeof(bench), "minmax_element<%s>", type);
+    run(bench, "std", v, [](const T *b, const T *e) { return std::minmax_element(b, e).first; });
+}
+
+int main(int argc, char **argv) {
+    std::vector<size_t> ns = jrBench::sizes(argc, argv, {size_t(32) << 10, size_t(256) << 20});
+    for(size_t n : ns) {
+        std::vector<uint8_t> bytes(n, 1);
+        run("memchr", "libc", bytes, [](const uint8_t *b, const uint8_t *e) {
+            return std::memchr(b, 0, static_cast<size_t>(e - b));
+        });
+        bench_type<uint8_t>("uint8_t", n);
+        bench_type<int32_t>("int32_t", n);
+        bench_type<float>("float", n);
+        bench_type<int64_t>("int64_t", n);
+    }
+    return 0;
+}
@@ -0,0 +1,64 @@
+#include <iostream>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "jr_bench.h"
+#include "../algorithm/jr_algorithm.h"
+
+// 对比jrSTL::sort与std::sort在常见输入分布上的耗时：
+// 随机、有序、逆序、少量不同值、先升后降（organ pipe）、有序后追加少量随机、锯齿
+// 整数走无分支划分，字符串走普通划分
+// 用法：sort_bench [n1 n2 ...]，默认规模为1e5、1e6
+static const char *kinds[] = {"random", "sorted", "reverse", "few_unique",
+                              "organ_pipe", "sorted_tail", "sawtooth"};
+
+static std::vector<int> make_input(int kind, size_t n) {
+    std::vector<int> v(n);
+    jrBench::xorshift rng;
+    for(size_t i = 0; i < n; ++i) {
+        switch(kind) {
+            case 0: v[i] = static_cast<int>(rng()); break;
+            case 1: v[i] = static_cast<int>(i); break;
+            case 2: v[i] = static_cast<int>(n - i); break;
+            case 3: v[i] = static_cast<int>(rng() % 16); break;
+            case 4: v[i] = static_cast<int>(i < n / 2 ? i : n - i); break;
+            case 5: v[i] = i < n - n / 64 ? static_cast<int>(i) : static_cast<int>(rng()); break;
+            default: v[i] = static_cast<int>(i % 1024); break;
+        }
+    }
+    return v;
+}
+
+template<class T>
+void run(const char *type, const char *kind, const std::vector<T>& input) {
+    char bench[64];
+    size_t n = input.size();
+    std::snprintf(bench, sizeof(bench), "sort<%s,%s>", type, kind);
+
+    std::vector<T> v(input);
+    jrBench::timer t;
+    std::sort(v.begin(), v.end());
+    jrBench::report(bench, "std::sort", n, t.elapsed_ns(), n);
+    jrBench::do_not_optimize(v);
+
+    v = input;
+    t.reset();
+    jrSTL::sort(v.begin(), v.end());
+    jrBench::report(bench, "jrSTL::sort", n, t.elapsed_ns(), n);
+    jrBench::do_not_optimize(v);
+}
+
+int main(int argc, char **argv) {
+    std::vector<size_t> ns = jrBench::sizes(argc, argv, {100000, 1000000});
+    for(size_t n : ns) {
+        for(int k = 0; k < 7; ++k) {
+            std::vector<int> input = make_input(k, n);
+            run("int", kinds[k], input);
+            std::vector<std::string> strs;
+            for(size_t i = 0; i < n / 4; ++i)
+                strs.push_back(std::to_string(input[i]));
+            run("string", kinds[k], strs);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,64 @@
+#include <iostream>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "jr_bench.h"
+#include "../algorithm/jr_algorithm.h"
+
+// 对比jrSTL::stable_sort与std::stable_sort在随机、有序、逆序、少量不同值输入上的耗时
+// 用法：stable_sort_bench [n1 n2 ...]，默认规模为1e5、1e6
+struct record {
+    int key;
+    int payload[3];
+};
+
+struct by_key {
+    bool operator()(const record& a, const record& b) const {
+        return a.key < b.key;
+    }
+};
+
+static std::vector<record> make_input(const char *kind, size_t n) {
+    std::vector<record> v(n);
+    jrBench::xorshift rng;
+    std::string k(kind);
+    for(size_t i = 0; i < n; ++i) {
+        int key;
+        if(k == "random")
+            key = static_cast<int>(rng());
+        else if(k == "sorted")
+            key = static_cast<int>(i);
+        else if(k == "reverse")
+            key = static_cast<int>(n - i);
+        else
+            key = static_cast<int>(rng() % 16);
+        v[i].key = key;
+        v[i].payload[0] = static_cast<int>(i);
+    }
+    return v;
+}
+
+int main(int argc, char **argv) {
+    std::vector<size_t> ns = jrBench::sizes(argc, argv, {100000, 1000000});
+    const char *kinds[] = {"random", "sorted", "reverse", "few_unique"};
+    for(size_t n : ns) {
+        for(const char *kind : kinds) {
+            char bench[64];
+            std::snprintf(bench, sizeof(bench), "stable_sort<%s>", kind);
+            std::vector<record> input = make_input(kind, n);
+
+            std::vector<record> v(input);
+            jrBench::timer t;
+            std::stable_sort(v.begin(), v.end(), by_key());
+            jrBench::report(bench, "std::stable_sort", n, t.elapsed_ns(), n);
+            jrBench::do_not_optimize(v);
+
+            v = input;
+            t.reset();
+            jrSTL::stable_sort(v.begin(), v.end(), by_key());
+            jrBench::report(bench, "jrSTL::stable_sort", n, t.elapsed_ns(), n);
+            jrBench::do_not_optimize(v);
+        }
+    }
+    return 0;
+}
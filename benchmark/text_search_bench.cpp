@@ -0,0 +1,98 @@
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <string.h>
+#include "jr_bench.h"
+#include "../algorithm/jr_algorithm.h"
+#include "../algorithm/jr_searcher.h"
+
+// 在类似日志的文本中查找不存在的模式（遍历整个文本），比较KMP（带谓词的search）、
+// 带首字节预筛选的search、default/boyer_moore_horspool/boyer_moore搜索器、std::search与memmem的吞吐量
+// 搜索器在计时之外构造一次，之后在同一文本上反复使用
+// 用法：text_search_bench [n1 n2 ...]，n为文本的字节数，默认规模为1MB与64MB
+static const char *levels[] = {"DEBUG", "INFO", "INFO", "INFO", "WARN", "ERROR"};
+static const char *words[] = {"request", "served", "upstream", "cache", "miss", "hit", "connect",
+                              "timeout", "user", "session", "retry", "queue", "flush", "shard"};
+
+static std::string make_log(size_t n) {
+    std::string text;
+    text.reserve(n + 256);
+    jrBench::xorshift rng;
+    char line[256];
+    while(text.size() < n) {
+        unsigned long r = static_cast<unsigned long>(rng());
+        int len = std::snprintf(line, sizeof(line), "2026-10-17T%02lu:%02lu:%02lu.%03lu %-5s [worker-%lu] %s %s id=%lu latency_us=%lu\n",
+                                r % 24, r / 24 % 60, r / 1440 % 60, r / 86400 % 1000,
+                                levels[r % 6], r / 7 % 32,
+                                words[r / 3 % 14], words[r / 5 % 14], r % 1000003, r / 11 % 100000);
+        text.append(line, static_cast<size_t>(len));
+    }
+    text.resize(n);
+    return text;
+}
+
+static void report_bw(const char *bench, const char *impl, size_t bytes, double ns, size_t reps) {
+    std::printf("%-24s %-24s %12zu %12.2f GB/s\n",
+                bench, impl, bytes, ns > 0 ? static_cast<double>(bytes) * reps / ns : 0.0);
+    std::fflush(stdout);
+}
+
+template<class F>
+void run(const char *bench, const char *impl, const std::string& text, F f) {
+    const char *b = text.data(), *e = b + text.size();
+    size_t reps = (size_t(1) << 28) / text.size() + 1;
+    if(f(b, e) != e)
+        std::printf("unexpected match\n");
+    jrBench::timer t;
+    for(size_t r = 0; r < reps; ++r)
+        jrBench::do_not_optimize(f(b, e));
+    report_bw(bench, impl, text.size(), t.elapsed_ns(), reps);
+}
+
+int main(int argc, char **argv) {
+    std::vector<size_t> ns = jrBench::sizes(argc, argv, {size_t(1) << 20, size_t(64) << 20});
+    // 模式与日志行相似但不会出现：首字节常见，预筛选会频繁命中候选位置
+    const std::string patterns[] = {
+        "upstream timeout id=42x",
+        "ERROR [worker-7] upstream connect timeout id=",
+        "2026-10-17T23:59:59.999 ERROR [worker-31] shard flush retry queue session user cache miss hit "
+        "connect timeout served request id=1000002 latency_us=99999!"
+    };
+    for(size_t n : ns) {
+        std::string text = make_log(n);
+        for(const std::string& pat : patterns) {
+            const char *pb = pat.data(), *pe = pb + pat.size();
+            char bench[32];
+            std::snprintf(bench, sizeof(bench), "search m=%zu", pat.size());
+            jrSTL::default_searcher<const char *> ds(pb, pe);
+            jrSTL::boyer_moore_horspool_searcher<const char *> bmh(pb, pe);
+            jrSTL::boyer_moore_searcher<const char *> bm(pb, pe);
+
+            run(bench, "jrSTL KMP", text, [pb, pe](const char *b, const char *e) {
+                return jrSTL::search(b, e, pb, pe, [](char x, char y) { return x == y; });
+            });
+            run(bench, "jrSTL prefilter", text, [pb, pe](const char *b, const char *e) {
+                return jrSTL::search(b, e, pb, pe);
+            });
+            run(bench, "jrSTL default_searcher", text, [&ds](const char *b, const char *e) {
+                return jrSTL::search(b, e, ds);
+            });
+            run(bench, "jrSTL bm_horspool", text, [&bmh](const char *b, const char *e) {
+                return jrSTL::search(b, e, bmh);
+            });
+            run(bench, "jrSTL boyer_moore", text, [&bm](const char *b, const char *e) {
+                return jrSTL::search(b, e, bm);
+            });
+            run(bench, "std::search", text, [pb, pe](const char *b, const char *e) {
+                return std::search(b, e, pb, pe);
+            });
+            run(bench, "memmem", text, [pb, pe](const char *b, const char *e) {
+                const void *p = memmem(b, static_cast<size_t>(e - b), pb, static_cast<size_t>(pe - pb));
+                return p ? static_cast<const char *>(p) : e;
+            });
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,34 @@
+#include <map>
+#include "jr_bench.h"
+#include "../container/associate/jr_map.h"
+
+// 对比jrSTL::map与std::map的随机键插入、删除吞吐量
+// 用法：tree_bench [n1 n2 ...]，默认规模为1e4、1e6、1e7
+template<class Map>
+void run(const char *impl, const std::vector<long long>& keys) {
+    size_t n = keys.size();
+    Map m;
+    jrBench::timer t;
+    for(size_t i = 0; i < n; ++i)
+        m.insert(std::make_pair(keys[i], static_cast<int>(i)));
+    jrBench::report("insert", impl, n, t.elapsed_ns(), n);
+    t.reset();
+    size_t erased = 0;
+    for(size_t i = 0; i < n; ++i)
+        erased += m.erase(keys[i]);
+    jrBench::report("erase", impl, n, t.elapsed_ns(), n);
+    jrBench::do_not_optimize(erased);
+}
+
+int main(int argc, char **argv) {
+    std::vector<size_t> ns = jrBench::sizes(argc, argv, {10000, 1000000, 10000000});
+    for(size_t n : ns) {
+        jrBench::xorshift rng;
+        std::vector<long long> keys(n);
+        for(size_t i = 0; i < n; ++i)
+            keys[i] = static_cast<long long>(rng() >> 1);
+        run<std::map<long long, int> >("std::map", keys);
+        run<jrSTL::map<long long, int> >("jrSTL::map", keys);
+    }
+    return 0;
+}
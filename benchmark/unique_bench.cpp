@@ -0,0 +1,85 @@
+#include <iostream>
+#include <algorithm>
+#include <cstdint>
+#include <list>
+#include <string>
+#include <thread>
+#include <vector>
+#include "jr_bench.h"
+#include "../algorithm/jr_algorithm.h"
+#include "../algorithm/jr_execution.h"
+#include "../container/sequence/jr_list.h"
+
+// 有序ID去重：重复段平均长度分别约为1、4、64（长度随机），比较std::unique、jrSTL::unique与并行unique；
+// 以及string元素（移动赋值）与list::unique
+// 用法：unique_bench [n1 n2 ...]，默认规模为1e6、1e8
+static std::vector<uint64_t> sorted_ids(size_t n, size_t avg_run) {
+    std::vector<uint64_t> v(n);
+    jrBench::xorshift rng;
+    uint64_t id = 0;
+    for(size_t i = 0; i < n; ++i) {
+        v[i] = id;
+        if(rng() % avg_run == 0)
+            id += 1 + rng() % 16;
+    }
+    return v;
+}
+
+// 每次在输入的副本上运行，拷贝不计时
+template<class T, class F>
+void run(const char *bench, const char *impl, const std::vector<T>& input, F f) {
+    std::vector<T> v(input);
+    jrBench::timer t;
+    jrBench::do_not_optimize(f(v));
+    jrBench::report(bench, impl, input.size(), t.elapsed_ns(), input.size());
+}
+
+int main(int argc, char **argv) {
+    std::vector<size_t> ns = jrBench::sizes(argc, argv, {1000000, 100000000});
+    size_t hw = std::thread::hardware_concurrency();
+    jrSTL::task_pool pool(hw > 1 ? hw : 2);
+    const jrSTL::execution::parallel_policy par = jrSTL::execution::par.on(pool);
+    for(size_t n : ns) {
+        for(size_t avg_run : {1, 4, 64}) {
+            std::vector<uint64_t> ids = sorted_ids(n, avg_run);
+            char bench[32];
+            std::snprintf(bench, sizeof(bench), "unique<u64> run~%zu", avg_run);
+            run(bench, "std", ids, [](std::vector<uint64_t>& v) {
+                return std::unique(v.begin(), v.end()) - v.begin();
+            });
+            run(bench, "jrSTL", ids, [](std::vector<uint64_t>& v) {
+                return jrSTL::unique(v.data(), v.data() + v.size()) - v.data();
+            });
+            run(bench, "jrSTL par", ids, [&par](std::vector<uint64_t>& v) {
+                return jrSTL::unique(par, v.data(), v.data() + v.size()) - v.data();
+            });
+        }
+        // string与链表只在较小的规模上进行
+        size_t m = n < 1000000 ? n : 1000000;
+        std::vector<uint64_t> ids = sorted_ids(m, 4);
+        std::vector<std::string> strs(m);
+        for(size_t i = 0; i < m; ++i)
+            strs[i] = "user-" + std::to_string(ids[i]) + "-session";
+        run("unique<string> run~4", "std", strs, [](std::vector<std::string>& v) {
+            return std::unique(v.begin(), v.end()) - v.begin();
+        });
+        run("unique<string> run~4", "jrSTL", strs, [](std::vector<std::string>& v) {
+            return jrSTL::unique(v.data(), v.data() + v.size()) - v.data();
+        });
+        {
+            std::list<uint64_t> l(ids.begin(), ids.end());
+            jrBench::timer t;
+            l.unique();
+            jrBench::report("list::unique run~4", "std::list", m, t.elapsed_ns(), m);
+        }
+        {
+            jrSTL::list<uint64_t> l;
+            for(size_t i = 0; i < m; ++i)
+                l.push_back(ids[i]);
+            jrBench::timer t;
+            l.unique();
+            jrBench::report("list::unique run~4", "jrSTL::list", m, t.elapsed_ns(), m);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,61 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include "jr_bench.h"
+#include "../container/sequence/jr_vector.h"
+
+// 对比jrSTL::vector与std::vector在不预留容量时的push_back吞吐量，
+// 以及对已有n个元素的vector执行一次reserve(2n)的耗时（考察扩容时的元素搬移）
+// 用法：vector_bench [n1 n2 ...]，默认规模为1e6、1e7；可传入1e8观察大块realloc/mremap
+struct record {
+    long long key;
+    double values[7];
+};
+
+// 用户类型：非平凡可复制，但可声明为可平凡重定位
+struct handle_record {
+    long long key;
+    double values[7];
+    handle_record() : key(0) {}
+    handle_record(const handle_record& x) : key(x.key) {
+        for(int i = 0; i < 7; ++i)
+            values[i] = x.values[i];
+    }
+};
+
+namespace jrSTL {
+    template<>
+    struct is_trivially_relocatable<handle_record> : std::true_type {};
+}
+
+template<class Vec, class T>
+void run(const char *name, const char *impl, size_t n, const T& value) {
+    char bench[64];
+    Vec v;
+    jrBench::timer t;
+    for(size_t i = 0; i < n; ++i)
+        v.push_back(value);
+    std::snprintf(bench, sizeof(bench), "push_back<%s>", name);
+    jrBench::report(bench, impl, n, t.elapsed_ns(), n);
+    t.reset();
+    v.reserve(v.capacity() * 2);
+    std::snprintf(bench, sizeof(bench), "reserve_2x<%s>", name);
+    jrBench::report(bench, impl, n, t.elapsed_ns(), n);
+    jrBench::do_not_optimize(v);
+}
+
+int main(int argc, char **argv) {
+    std::vector<size_t> ns = jrBench::sizes(argc, argv, {1000000, 10000000});
+    record r = record();
+    handle_record h;
+    std::string s("a string longer than sso buffer");
+    for(size_t n : ns) {
+        run<std::vector<record> >("record", "std::vector", n, r);
+        run<jrSTL::vector<record> >("record", "jrSTL::vector", n, r);
+        run<std::vector<handle_record> >("handle_record", "std::vector", n, h);
+        run<jrSTL::vector<handle_record> >("handle_record", "jrSTL::vector", n, h);
+        run<std::vector<std::string> >("string", "std::vector", n, s);
+        run<jrSTL::vector<std::string> >("string", "jrSTL::vector", n, s);
+    }
+    return 0;
+}
@@ -0,0 +1,78 @@
+#include <iostream>
+#include <vector>
+#include "jr_bench.h"
+#include "../container/sequence/jr_vector.h"
+
+// 对比各扩容策略下逐个push_back的吞吐量、重新分配次数与峰值内存
+// 峰值内存由计数分配器统计：allocate/deallocate直接增减，reallocate视为realloc/mremap原地完成，
+// 只计新旧大小之差；对非平凡重定位类型，扩容时新旧两块同时存在，峰值会更高
+// 用法：vector_growth_bench [n1 n2 ...]，默认规模为1e6、1e7、1e8
+namespace {
+    size_t live_bytes = 0, peak_bytes = 0;
+
+    void _track(size_t old_bytes, size_t new_bytes) {
+        live_bytes = live_bytes - old_bytes + new_bytes;
+        if(live_bytes > peak_bytes)
+            peak_bytes = live_bytes;
+    }
+}
+
+template<class T>
+class tracking_allocator : public jrSTL::allocator<T> {
+    public:
+        typedef jrSTL::allocator<T> base;
+        typedef typename base::pointer pointer;
+        typedef typename base::size_type size_type;
+
+        template<class U>
+        struct rebind {
+            typedef tracking_allocator<U> other;
+        };
+
+        pointer allocate(size_type n, const void *hint = 0) const {
+            _track(0, n * sizeof(T));
+            return base::allocate(n, hint);
+        }
+
+        void deallocate(pointer p, size_type n) {
+            _track(n * sizeof(T), 0);
+            base::deallocate(p, n);
+        }
+
+        pointer reallocate(pointer p, size_type n, size_type new_n) const {
+            _track(n * sizeof(T), new_n * sizeof(T));
+            return base::reallocate(p, n, new_n);
+        }
+};
+
+template<class Policy>
+void run(const char *name, size_t n) {
+    typedef jrSTL::vector<long long, tracking_allocator<long long>, Policy> vec;
+    live_bytes = peak_bytes = 0;
+    size_t reallocs, cap;
+    jrBench::timer t;
+    {
+        vec v;
+        for(size_t i = 0; i < n; ++i)
+            v.push_back(static_cast<long long>(i));
+        jrBench::do_not_optimize(v);
+        reallocs = v.reallocation_count();
+        cap = v.capacity();
+    }
+    jrBench::report("push_back<long long>", name, n, t.elapsed_ns(), n);
+    std::printf("%-24s %-24s %12zu reallocs %8zu peak %10.2f MB (%.2fx) cap/size %.3f\n",
+                "", "", n, reallocs, peak_bytes / 1048576.0,
+                static_cast<double>(peak_bytes) / (n * sizeof(long long)),
+                static_cast<double>(cap) / n);
+}
+
+int main(int argc, char **argv) {
+    std::vector<size_t> ns = jrBench::sizes(argc, argv, {1000000, 10000000, 100000000});
+    for(size_t n : ns) {
+        run<jrSTL::vector_growth_double>("double", n);
+        run<jrSTL::vector_growth_golden>("golden(1.5x)", n);
+        run<jrSTL::vector_growth_chunk<(1 << 20)> >("chunk<1M>", n);
+        run<jrSTL::vector_growth_paged<> >("paged<4K,1M>", n);
+    }
+    return 0;
+}
@@ -0,0 +1,276 @@
+#ifndef JR_PAIRING_HEAP_H
+#define JR_PAIRING_HEAP_H
+
+#include <cstddef>
+#include <utility>
+#include "../../memory/jr_allocator.h"
+#include "../../functional/jr_functional.h"
+#include "../utils/jr_nodes.h"
+
+namespace jrSTL {
+    /* 配对堆：与priority_queue一样，Compare为less时堆顶为最大元素
+     * push返回指向元素的句柄，元素出堆前句柄一直有效，可据此提升优先级（decrease_key）或删除；
+     * push、top、decrease_key、merge均摊O(1)，pop均摊O(log n)，适合Dijkstra等需要decrease_key的单调场景
+     */
+    template<class T,
+             class Compare = jrSTL::less<T>,
+             class Allocator = allocator<T> >
+    class pairing_heap {
+        public:
+            typedef T value_type;
+            typedef const T& const_reference;
+            typedef size_t size_type;
+            typedef Compare value_compare;
+            typedef Allocator allocator_type;
+
+            class handle {
+                friend class pairing_heap;
+
+                private:
+                    _pairing_node<T> *_node;
+
+                    explicit handle(_pairing_node<T> *node) : _node(node) {}
+
+                public:
+                    handle() : _node(nullptr) {}
+
+                    const T& operator*() const { return _node->data; }
+
+                    const T *operator->() const { return &_node->data; }
+
+                    bool operator==(const handle& other) const { return _node == other._node; }
+
+                    bool operator!=(const handle& other) const { return _node != other._node; }
+            };
+
+        private:
+            typedef _pairing_node<T> node;
+
+            typename Allocator::template rebind<node>::other _alloc_node;
+            node *_root;
+            size_type _size;
+            Compare _comp;
+
+            template<class... Args>
+            node *_create_node(Args&&... args) {
+                node *n = _alloc_node.allocate(1);
+                try {
+                    _alloc_node.construct(&(n->data), static_cast<Args&&>(args)...);
+                } catch(...) {
+                    _alloc_node.deallocate(n, 1);
+                    throw;
+                }
+                n->child = n->sibling = n->prev = nullptr;
+                return n;
+            }
+
+            void _destroy_node(node *n) {
+                _alloc_node.destroy(&(n->data));
+                _alloc_node.deallocate(n, 1);
+            }
+
+            // 合并两棵独立的树：优先级低的根成为另一个根的第一个儿子
+            node *_link(node *a, node *b) {
+                if(!a)
+                    return b;
+                if(!b)
+                    return a;
+                if(_comp(a->data, b->data)) {
+                    node *t = a;
+                    a = b;
+                    b = t;
+                }
+                b->prev = a;
+                b->sibling = a->child;
+                if(a->child)
+                    a->child->prev = b;
+                a->child = b;
+                a->sibling = a->prev = nullptr;
+                return a;
+            }
+
+            // 两趟合并兄弟链表：先从左到右两两合并，再从右到左逐个并入
+            node *_merge_pairs(node *first) {
+                node *pairs = nullptr;
+                while(first) {
+                    node *a = first, *b = first->sibling;
+                    first = b ? b->sibling : nullptr;
+                    a->sibling = a->prev = nullptr;
+                    if(b)
+                        b->sibling = b->prev = nullptr;
+                    node *m = _link(a, b);
+                    // 逆序串起，第二趟即为从右到左
+                    m->sibling = pairs;
+                    pairs = m;
+                }
+                node *root = nullptr;
+                while(pairs) {
+                    node *next = pairs->sibling;
+                    pairs->sibling = nullptr;
+                    root = _link(root, pairs);
+                    pairs = next;
+                }
+                return root;
+            }
+
+            // 把以x为根的子树从所在的兄弟链表中摘下
+            void _cut(node *x) {
+                if(x->prev->child == x)
+                    x->prev->child = x->sibling;
+                else
+                    x->prev->sibling = x->sibling;
+                if(x->sibling)
+                    x->sibling->prev = x->prev;
+                x->sibling = x->prev = nullptr;
+            }
+
+        public:
+            pairing_heap()
+                : _root(nullptr), _size(0), _comp(Compare())
+            {}
+
+            explicit pairing_heap(const Compare& comp)
+                : _root(nullptr), _size(0), _comp(comp)
+            {}
+
+            // 句柄指向具体节点，拷贝后无法对应，因此只允许移动
+            pairing_heap(const pairing_heap&) = delete;
+            pairing_heap& operator=(const pairing_heap&) = delete;
+
+            pairing_heap(pairing_heap&& other)
+                : _root(other._root), _size(other._size), _comp(other._comp) {
+                other._root = nullptr;
+                other._size = 0;
+            }
+
+            pairing_heap& operator=(pairing_heap&& other) {
+                if(this != &other) {
+                    clear();
+                    _root = other._root;
+                    _size = other._size;
+                    _comp = other._comp;
+                    other._root = nullptr;
+                    other._size = 0;
+                }
+                return *this;
+            }
+
+            ~pairing_heap() {
+                clear();
+            }
+
+            bool empty() const { return _root == nullptr; }
+
+            size_type size() const { return _size; }
+
+            const_reference top() const { return _root->data; }
+
+            handle push(const value_type& x) {
+                return emplace(x);
+            }
+
+            handle push(value_type&& x) {
+                return emplace(static_cast<value_type&&>(x));
+            }
+
+            template<class... Args>
+            handle emplace(Args&&... args) {
+                node *n = _create_node(static_cast<Args&&>(args)...);
+                _root = _link(_root, n);
+                ++_size;
+                return handle(n);
+            }
+
+            void pop() {
+                node *old = _root;
+                _root = _merge_pairs(old->child);
+                _destroy_node(old);
+                --_size;
+            }
+
+            /* 把h指向的元素改为x，x的优先级不得低于原值（即!comp(x, *h)）
+             * Compare为greater时即为通常意义上的减小键值
+             */
+            void decrease_key(handle h, const value_type& x) {
+                node *n = h._node;
+                n->data = x;
+                if(n == _root)
+                    return;
+                _cut(n);
+                _root = _link(_root, n);
+            }
+
+            void decrease_key(handle h, value_type&& x) {
+                node *n = h._node;
+                n->data = static_cast<value_type&&>(x);
+                if(n == _root)
+                    return;
+                _cut(n);
+                _root = _link(_root, n);
+            }
+
+            // 删除h指向的元素：摘下其子树，删除子树根后把剩余部分并回
+            void erase(handle h) {
+                node *n = h._node;
+                if(n == _root) {
+                    pop();
+                    return;
+                }
+                _cut(n);
+                node *rest = _merge_pairs(n->child);
+                _destroy_node(n);
+                --_size;
+                _root = _link(_root, rest);
+            }
+
+            // 并入other的全部元素，other的句柄转为属于*this
+            void merge(pairing_heap& other) {
+                if(this == &other)
+                    return;
+                _root = _link(_root, other._root);
+                _size += other._size;
+                other._root = nullptr;
+                other._size = 0;
+            }
+
+            // 逐个摘下第一个儿子压入待处理链表，没有儿子时才释放节点，不需要递归与额外空间
+            void clear() {
+                node *todo = _root;
+                while(todo) {
+                    node *n = todo;
+                    if(n->child) {
+                        node *c = n->child;
+                        n->child = c->sibling;
+                        c->sibling = todo;
+                        todo = c;
+                    } else {
+                        todo = n->sibling;
+                        _destroy_node(n);
+                    }
+                }
+                _root = nullptr;
+                _size = 0;
+            }
+
+            void swap(pairing_heap& other) noexcept {
+                node *r = _root;
+                _root = other._root;
+                other._root = r;
+                size_type s = _size;
+                _size = other._size;
+                other._size = s;
+                Compare c = _comp;
+                _comp = other._comp;
+                other._comp = c;
+            }
+    };
+
+    template<class T, class Compare, class Allocator>
+    void swap(pairing_heap<T, Compare, Allocator>& x,
+              pairing_heap<T, Compare, Allocator>& y)
+              noexcept(noexcept(x.swap(y))) {
+        x.swap(y);
+    }
+}
+
+#endif // JR_PAIRING_HEAP_H
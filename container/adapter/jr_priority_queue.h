@@ -7,9 +7,13 @@
 #include "../../functional/jr_functional.h"
 
 namespace jrSTL {
+    /* Arity为底层堆每个节点的儿子数，默认为二叉堆；pop远多于push时可取4或8，
+     * 以较多的比较换取更低的树高与更好的缓存局部性
+     */
     template<class T,
              class Container = jrSTL::vector<T>,
-             class Compare = jrSTL::less<typename Container::value_type> >
+             class Compare = jrSTL::less<typename Container::value_type>,
+             size_t Arity = 2>
     class priority_queue {
         public:
             typedef typename Container::value_type value_type;
@@ -33,12 +37,14 @@ namespace jrSTL {
             {}
 
             priority_queue(const Compare& x, const Container& y)
-                : c(y), comp(x)
-            {}
+                : c(y), comp(x) {
+                jrSTL::make_heap<Arity>(c.begin(), c.end(), comp);
+            }
 
             priority_queue(const Compare& x, Container&& y)
-                : c(static_cast<Container&&>(y)), comp(x)
-            {}
+                : c(static_cast<Container&&>(y)), comp(x) {
+                jrSTL::make_heap<Arity>(c.begin(), c.end(), comp);
+            }
 
             priority_queue( const priority_queue& other )
                 : c(other.c), comp(other.comp)
@@ -62,14 +68,16 @@ namespace jrSTL {
             template< class Alloc >
             priority_queue( const Compare& compare, const Container& cont,
                             const Alloc& alloc )
-                : c(cont, alloc), comp(compare)
-            {}
+                : c(cont, alloc), comp(compare) {
+                jrSTL::make_heap<Arity>(c.begin(), c.end(), comp);
+            }
 
             template< class Alloc >
             priority_queue( const Compare& compare, Container&& cont,
                             const Alloc& alloc )
-                : c(static_cast<Container&&>(cont), alloc), comp(compare)
-            {}
+                : c(static_cast<Container&&>(cont), alloc), comp(compare) {
+                jrSTL::make_heap<Arity>(c.begin(), c.end(), comp);
+            }
 
             template< class Alloc >
             priority_queue( const priority_queue& other,
@@ -89,7 +97,7 @@ namespace jrSTL {
                            const Container& y)
                 : c(y), comp(x) {
                 c.insert(c.end(), first, last);
-                jrSTL::make_heap(c.begin(), c.end(), comp);
+                jrSTL::make_heap<Arity>(c.begin(), c.end(), comp);
             }
 
             template<class InputIt>
@@ -98,7 +106,7 @@ namespace jrSTL {
                            Container&& y = Container())
                 : c(static_cast<Container&&>(y)), comp(x) {
                 c.insert(c.end(), first, last);
-                jrSTL::make_heap(c.begin(), c.end(), comp);
+                jrSTL::make_heap<Arity>(c.begin(), c.end(), comp);
             }
 
             ~priority_queue() = default;
@@ -123,25 +131,49 @@ namespace jrSTL {
 
             void push(const value_type& x) {
                 c.push_back(x);
-                jrSTL::push_heap(c.begin(), c.end(), comp);
+                jrSTL::push_heap<Arity>(c.begin(), c.end(), comp);
             }
 
             void push(value_type&& x) {
                 c.push_back(static_cast<value_type&&>(x));
-                jrSTL::push_heap(c.begin(), c.end(), comp);
+                jrSTL::push_heap<Arity>(c.begin(), c.end(), comp);
             }
 
             template<class... Args>
             void emplace(Args&&... args) {
                 c.push_back(static_cast<Args&&>(args)...);
-                jrSTL::push_heap(c.begin(), c.end(), comp);
+                jrSTL::push_heap<Arity>(c.begin(), c.end(), comp);
             }
 
             void pop() {
-                jrSTL::pop_heap(c.begin(), c.end(), comp);
+                jrSTL::pop_heap<Arity>(c.begin(), c.end(), comp);
                 c.pop_back();
             }
 
+            /* 批量插入：追加到容器尾部后，新元素较多时整体重新建堆（O(n)），
+             * 较少时逐个向上过滤（O(k log n)），取两者中代价较小的
+             */
+            template<class InputIt>
+            void push_range(InputIt first, InputIt last) {
+                size_type old_size = c.size();
+                c.insert(c.end(), first, last);
+                size_type n = c.size(), k = n - old_size;
+                size_type depth = 0;
+                for(size_type x = n; x > 1; x >>= 1)
+                    ++depth;
+                if(k * depth > n) {
+                    jrSTL::make_heap<Arity>(c.begin(), c.end(), comp);
+                } else {
+                    for(size_type i = old_size + 1; i <= n; ++i)
+                        jrSTL::push_heap<Arity>(c.begin(), c.begin() + i, comp);
+                }
+            }
+
+            // 要求底层容器支持reserve
+            void reserve(size_type n) {
+                c.reserve(n);
+            }
+
             void swap(priority_queue& q) noexcept {
                 c.swap(q.c);
                 Compare tc = comp;
@@ -150,9 +182,9 @@ namespace jrSTL {
             }
     };
 
-    template<class T, class Container, class Compare>
-    void swap(priority_queue<T, Container, Compare>& x,
-              priority_queue<T, Container, Compare>& y)
+    template<class T, class Container, class Compare, size_t Arity>
+    void swap(priority_queue<T, Container, Compare, Arity>& x,
+              priority_queue<T, Container, Compare, Arity>& y)
               noexcept(noexcept(x.swap(y))) {
         x.swap(y);
     }
@@ -41,6 +41,22 @@ namespace jrSTL {
           };
 
          protected:
+            // 以键直接与树中元素比较，查找时无需构造临时的value_type
+            struct _key_compare {
+                Compare _comp;
+                _key_compare(const Compare& c) : _comp(c) {}
+
+                template<class K>
+                bool operator()(const value_type& x, const K& k) const {
+                    return _comp(x.first, k);
+                }
+
+                template<class K>
+                bool operator()(const K& k, const value_type& x) const {
+                    return _comp(k, x.first);
+                }
+            };
+
             typedef _tree_node<value_type> tnode;
             typedef _AVL_Tree<value_type, isMultiMap, value_compare, Allocator> tree;
             Compare comp;
@@ -342,66 +358,79 @@ namespace jrSTL {
             }
 
             // map 操作
+            // 以下查找均沿树自顶向下进行，复杂度为O(log n)；
+            // 若Compare定义了is_transparent，则额外提供以任意可比较类型K查找的重载
             iterator find(const key_type& x) {
-                return iterator(t.search(value_type(x, T())),
-                                t.get_header());
+                return iterator(t.find(x, _key_compare(comp)), t.get_header());
             }
 
             const_iterator find(const key_type& x) const {
-                return const_iterator(t.search(value_type(x, T())),
+                return const_iterator(t.find(x, _key_compare(comp)),
+                                      t.get_header());
+            }
+
+            template<class K, class C = Compare, class = typename C::is_transparent>
+            iterator find(const K& x) {
+                return iterator(t.find(x, _key_compare(comp)), t.get_header());
+            }
+
+            template<class K, class C = Compare, class = typename C::is_transparent>
+            const_iterator find(const K& x) const {
+                return const_iterator(t.find(x, _key_compare(comp)),
                                       t.get_header());
             }
 
             size_type count(const key_type& x) const {
-                return t.count(value_type(x, T()));
+                return t.count(x, _key_compare(comp));
+            }
+
+            template<class K, class C = Compare, class = typename C::is_transparent>
+            size_type count(const K& x) const {
+                return t.count(x, _key_compare(comp));
             }
 
             iterator lower_bound(const key_type& x) {
-                if(comp(x, t.get_min()->data.first))
-                    return begin();
-                if(comp(t.get_max()->data.first, x))
-                    return end();
-                iterator it = begin();
-                while(comp(it->first, x) && (it != end()))
-                    ++it;
-                if(comp(x, it->first))
-                    --it;
-                return it;
+                return iterator(t.lower_bound(x, _key_compare(comp)),
+                                t.get_header());
             }
 
             const_iterator lower_bound(const key_type& x) const {
-                if(comp(x, t.get_min()->data.first))
-                    return cbegin();
-                if(comp(t.get_max()->data.first, x))
-                    return cend();
-                const_iterator it = begin();
-                while(comp(it->first, x) && (it != end()))
-                    ++it;
-                if(comp(x, it->first))
-                    --it;
-                return it;
+                return const_iterator(t.lower_bound(x, _key_compare(comp)),
+                                      t.get_header());
+            }
+
+            template<class K, class C = Compare, class = typename C::is_transparent>
+            iterator lower_bound(const K& x) {
+                return iterator(t.lower_bound(x, _key_compare(comp)),
+                                t.get_header());
+            }
+
+            template<class K, class C = Compare, class = typename C::is_transparent>
+            const_iterator lower_bound(const K& x) const {
+                return const_iterator(t.lower_bound(x, _key_compare(comp)),
+                                      t.get_header());
             }
 
             iterator upper_bound(const key_type& x) {
-                if(comp(x, t.get_min()->data.first))
-                    return begin();
-                if(comp(t.get_max()->data.first, x))
-                    return end();
-                iterator it = begin();
-                while(!comp(x, it->first) && (it != end()))
-                    ++it;
-                return it;
+                return iterator(t.upper_bound(x, _key_compare(comp)),
+                                t.get_header());
             }
 
             const_iterator upper_bound(const key_type& x) const {
-                if(comp(x, t.get_min()->data.first))
-                    return cbegin();
-                if(comp(t.get_max()->data.first, x))
-                    return cend();
-                const_iterator it = begin();
-                while(!comp(x, it->first) && (it != end()))
-                    ++it;
-                return it;
+                return const_iterator(t.upper_bound(x, _key_compare(comp)),
+                                      t.get_header());
+            }
+
+            template<class K, class C = Compare, class = typename C::is_transparent>
+            iterator upper_bound(const K& x) {
+                return iterator(t.upper_bound(x, _key_compare(comp)),
+                                t.get_header());
+            }
+
+            template<class K, class C = Compare, class = typename C::is_transparent>
+            const_iterator upper_bound(const K& x) const {
+                return const_iterator(t.upper_bound(x, _key_compare(comp)),
+                                      t.get_header());
             }
 
             std::pair<iterator, iterator>
@@ -412,9 +441,43 @@ namespace jrSTL {
 
             std::pair<const_iterator, const_iterator>
             equal_range(const key_type& x) const {
+                return std::pair<const_iterator, const_iterator>(lower_bound(x),
+                                                                 upper_bound(x));
+            }
+
+            template<class K, class C = Compare, class = typename C::is_transparent>
+            std::pair<iterator, iterator>
+            equal_range(const K& x) {
                 return std::pair<iterator, iterator>(lower_bound(x),
                                                      upper_bound(x));
             }
+
+            template<class K, class C = Compare, class = typename C::is_transparent>
+            std::pair<const_iterator, const_iterator>
+            equal_range(const K& x) const {
+                return std::pair<const_iterator, const_iterator>(lower_bound(x),
+                                                                 upper_bound(x));
+            }
+
+            // 顺序统计：借助节点中的子树大小，均为O(log n)
+            // 返回中序下标为k的元素（从0开始），k不小于size()时返回end()
+            iterator nth(size_type k) {
+                return iterator(t.select(k), t.get_header());
+            }
+
+            const_iterator nth(size_type k) const {
+                return const_iterator(t.select(k), t.get_header());
+            }
+
+            // 返回小于x的元素个数，即lower_bound(x)在容器中的下标
+            size_type rank(const key_type& x) const {
+                return t.rank_lower(x, _key_compare(comp));
+            }
+
+            template<class K, class C = Compare, class = typename C::is_transparent>
+            size_type rank(const K& x) const {
+                return t.rank_lower(x, _key_compare(comp));
+            }
     };
 
     template<class Key, class T, class Compare = jrSTL::less<Key>,
@@ -6,6 +6,7 @@
 #include "../../functional/jr_functional.h"
 #include "../../memory/jr_allocator.h"
 #include "../utils/jr_hashtable.h"
+#include "../utils/jr_flat_hashtable.h"
 #include "../utils/jr_iterators.h"
 
 namespace jrSTL {
@@ -13,7 +14,8 @@ namespace jrSTL {
            class Hash,
            class Pred,
            class Allocator,
-           bool isMultiSet>
+           bool isMultiSet,
+           class HashPolicy>
   class _hashset_base {
   public:
       // 类型
@@ -26,21 +28,25 @@ namespace jrSTL {
       typedef const value_type& const_reference;
       typedef size_t size_type;
       typedef ptrdiff_t difference_type;
-      typedef _hashtable_iterator<Key, Hash, Pred, Allocator, isMultiSet> iterator;
-      typedef _hashtable_iterator<Key, Hash, Pred, Allocator, isMultiSet> const_iterator;
       typedef Hash hasher;
       typedef Pred key_equal;
-      typedef typename forward_list<Key>::iterator local_iterator;
-      typedef typename forward_list<Key>::const_iterator const_local_iterator;
 
    protected:
-      typedef typename forward_list<Key>::const_iterator hnode;
-      typedef _hashtable<Key, Hash, Pred, Allocator, isMultiSet> table;
+      // 底层散列表由HashPolicy选择（链式散列或开放定址），二者提供相同的接口
+      typedef typename HashPolicy::template rebind<Key, Hash, Pred,
+                                                   Allocator, isMultiSet>::other table;
+
+   public:
+      typedef typename table::iterator iterator;
+      typedef typename table::iterator const_iterator;
+      typedef typename table::local_iterator local_iterator;
+      typedef typename table::const_local_iterator const_local_iterator;
+
+   protected:
       hasher _hf;
       key_equal _eql;
       Allocator _alloc_data;
       table _tab;
-      size_type _num_of_elem;
 
    public:
     // 构造/复制/销毁
@@ -48,14 +54,14 @@ namespace jrSTL {
         : _hf(hasher()),
           _eql(key_equal()),
           _alloc_data(Allocator()),
-          _tab(11), _num_of_elem(0)
+          _tab(11)
     {}
 
     explicit _hashset_base(const Allocator& a)
         : _hf(hasher()),
           _eql(key_equal()),
           _alloc_data(a),
-          _tab(11), _num_of_elem(0)
+          _tab(11)
     {}
 
     explicit _hashset_base(size_type n,
@@ -63,7 +69,7 @@ namespace jrSTL {
                            const key_equal& eql = key_equal(),
                            const allocator_type& a = allocator_type())
         : _hf(hf), _eql(eql), _alloc_data(a),
-          _tab(n, hf, eql), _num_of_elem(0)
+          _tab(n, hf, eql)
     {}
 
     template<class InputIt>
@@ -74,50 +80,46 @@ namespace jrSTL {
                   const allocator_type& a = allocator_type())
         : _hf(hf), _eql(eql),
           _tab(jrSTL::distance(first, last) + 5, hf, eql),
-          _alloc_data(a), _num_of_elem(0) {
+          _alloc_data(a) {
         insert(first, last);
     }
 
     _hashset_base(size_type n,
                   const allocator_type& a)
         : _hf(hasher()), _eql(key_equal()), _alloc_data(a),
-          _tab(n), _num_of_elem(0)
+          _tab(n)
     {}
 
     _hashset_base(size_type n,
                   const hasher& hf,
                   const allocator_type& a)
         : _hf(hf), _eql(key_equal()), _alloc_data(a),
-          _tab(n, hf), _num_of_elem(0)
+          _tab(n, hf)
     {}
 
     _hashset_base(const _hashset_base& x,
                   const Allocator& a)
         : _hf(hasher()), _eql(key_equal()), _alloc_data(a),
-          _tab(x._tab), _num_of_elem(x._num_of_elem)
+          _tab(x._tab)
     {}
 
     _hashset_base(_hashset_base&& x,
                   const Allocator& a)
         : _hf(hasher()), _eql(key_equal()), _alloc_data(a),
-          _tab(static_cast<table&&>(x._tab)),
-               _num_of_elem(x._num_of_elem) {
-        x._num_of_elem = 0;
-    }
+          _tab(static_cast<table&&>(x._tab))
+    {}
 
     _hashset_base(const _hashset_base& x)
         : _hf(hasher()), _eql(key_equal()),
           _alloc_data(Allocator()),
-          _tab(x._tab), _num_of_elem(x._num_of_elem)
+          _tab(x._tab)
     {}
 
     _hashset_base(_hashset_base&& x)
         : _hf(hasher()), _eql(key_equal()),
           _alloc_data(Allocator()),
-          _tab(static_cast<table&&>(x._tab)),
-               _num_of_elem(x._num_of_elem) {
-        x._num_of_elem = 0;
-    }
+          _tab(static_cast<table&&>(x._tab))
+    {}
 
     _hashset_base( std::initializer_list<value_type> init,
                    size_type bucket_count,
@@ -137,7 +139,6 @@ namespace jrSTL {
         _hf = x._hf;
         _eql = x._eql;
         _tab = x._tab;
-        _num_of_elem = x._num_of_elem;
         return *this;
     }
 
@@ -147,8 +148,6 @@ namespace jrSTL {
         _hf = x._hf;
         _eql = x._eql;
         _tab = static_cast<table&&>(x._tab);
-        _num_of_elem = x._num_of_elem;
-        x._num_of_elem = 0;
         return *this;
     }
 
@@ -158,60 +157,36 @@ namespace jrSTL {
 
     // 迭代器
     iterator begin() noexcept {
-        size_type i;
-        for(i = 0; i < _tab.table.size(); ++i) {
-            if(!_tab.table[i].empty())
-                return iterator(&_tab, i,
-                                _tab.table[i].cbegin());
-        }
-        return end();
+        return _tab.begin();
     }
 
     const_iterator begin() const noexcept {
-        size_type i;
-        for(i = 0; i < _tab.table.size(); ++i) {
-            if(!_tab.table[i].empty())
-                return const_iterator(&_tab, i,
-                                      _tab.table[i].begin());
-        }
-        return end();
+        return _tab.begin();
     }
 
     iterator end() noexcept {
-        return iterator(&_tab,
-                        _tab.table.size() - 1,
-                        _tab.table.back().cbegin());
+        return _tab.end();
     }
 
     const_iterator end() const noexcept {
-        return const_iterator(&_tab,
-                              _tab.table.size() - 1,
-                              _tab.table.back().begin());
+        return _tab.end();
     }
 
     const_iterator cbegin() const noexcept {
-        size_type i;
-        for(i = 0; i < _tab.table.size(); ++i) {
-            if(!_tab.table[i].empty())
-                return const_iterator(&_tab, i,
-                                      _tab.table[i].begin());
-        }
-        return end();
+        return _tab.begin();
     }
 
     const_iterator cend() const noexcept {
-        return const_iterator(&_tab,
-                            _tab.table.size() - 1,
-                            _tab.table.back().begin());
-  }
+        return _tab.end();
+    }
 
     // 容量
     bool empty() const noexcept {
-        return begin() == end();
+        return _tab.size() == 0;
     }
 
     size_type size() const noexcept {
-        return _num_of_elem;
+        return _tab.size();
     }
 
     size_type max_size() const noexcept {
@@ -240,40 +215,25 @@ namespace jrSTL {
   protected:
     std::pair<iterator, bool> insert(const value_type& obj) {
         bool flag;
-        auto n = _tab.insert(obj, flag);
-        if(flag)
-            ++_num_of_elem;
-        return std::pair<iterator, bool>(
-                    iterator(&_tab, n.first, n.second),
-                    flag);
+        iterator n = _tab.insert(obj, flag);
+        return std::pair<iterator, bool>(n, flag);
     }
 
     std::pair<iterator, bool> insert(value_type&& obj) {
         bool flag;
-        auto n = _tab.insert(static_cast<value_type&&>(obj), flag);
-        if(flag)
-            ++_num_of_elem;
-        return std::pair<iterator, bool>(
-                    iterator(&_tab, n.first, n.second),
-                    flag);
+        iterator n = _tab.insert(static_cast<value_type&&>(obj), flag);
+        return std::pair<iterator, bool>(n, flag);
     }
 
   public:
     iterator insert(const_iterator hint, const value_type& obj) {
         bool flag;
-        auto d = _tab.insert_hint(hint.index, hint.cur, obj, flag);
-        if(flag)
-            ++_num_of_elem;
-        return iterator(&_tab, hint.index, d);
+        return _tab.insert_hint(hint, obj, flag);
     }
 
     iterator insert(const_iterator hint, value_type&& obj) {
         bool flag;
-        auto d = _tab.insert_hint(hint.index, hint.cur,
-                                  static_cast<value_type&&>(obj), flag);
-        if(flag)
-            ++_num_of_elem;
-        return iterator(&_tab, hint.index, d);
+        return _tab.insert_hint(hint, static_cast<value_type&&>(obj), flag);
     }
 
     void insert( std::initializer_list<value_type> ilist ) {
@@ -289,45 +249,29 @@ namespace jrSTL {
         }
     }
 
-    iterator erase(const_iterator position) {
-        difference_type dis = jrSTL::distance(cbegin(), position);
-        _tab.erase(position.index, position.cur);
-        --_num_of_elem;
-        iterator r = begin();
-        jrSTL::advance(r, dis);
-        return r;
+    iterator erase(iterator position) {
+        return _tab.erase(position);
     }
 
     size_type erase(const key_type& k) {
-        size_type cnt = _tab.erase(k);
-        _num_of_elem -= cnt;
-        return cnt;
+        return _tab.erase(k);
     }
 
     iterator erase(const_iterator first, const_iterator last) {
-        difference_type dis = jrSTL::distance(cbegin(), first);
         while(first != last) {
             first = erase(first);
         }
-        iterator r = begin();
-        jrSTL::advance(r, dis);
-        return r;
+        return first;
     }
 
     void swap(_hashset_base& x) {
         if(this == &x)
             return;
-        table tmp = static_cast<table&&>(_tab);
-        _tab = static_cast<table&&>(x._tab);
-        x._tab = static_cast<table&&>(tmp);
-        int t = _num_of_elem;
-        _num_of_elem = x._num_of_elem;
-        x._num_of_elem = t;
+        _tab.swap(x._tab);
     }
 
     void clear() noexcept {
-        erase(begin(), end());
-        _num_of_elem = 0;
+        _tab.clear();
     }
 
     // 观察器
@@ -341,112 +285,70 @@ namespace jrSTL {
 
     // set 操作
     iterator find(const key_type& k) {
-        auto n = _tab.find(k);
-        if(n.first == -1)
-            return end();
-        else
-            return iterator(&_tab, n.first, n.second);
+        return _tab.find(k);
     }
 
     const_iterator find(const key_type& k) const {
-        auto n = _tab.find(k);
-        if(n.first == -1)
-            return cend();
-        else
-            return const_iterator(&_tab, n.first, n.second);
+        return _tab.find(k);
     }
 
-    size_type count(const key_type& k) {
+    size_type count(const key_type& k) const {
         return _tab.count(k);
     }
 
-    std::pair<iterator, iterator>
-    equal_range(const key_type& k) {
-        iterator first = end(), last = end();
-        for(iterator it = begin(); it != end(); ++it) {
-            if(_eql(k, *it)) {
-                first = it;
-                while((it != end()) && _eql(k, *it))
-                    ++it;
-                last = it;
-                break;
-            }
-        }
-        return std::pair<iterator, iterator>(first, last);
-    }
-
-    std::pair<const_iterator, const_iterator>
-    equal_range(const key_type& k) const {
-        const_iterator first = end(), last = end();
-        for(const_iterator it = begin(); it != end(); ++it) {
-            if(_eql(k, *it)) {
-                first = it;
-                while((it != end()) && _eql(k, *it))
-                    ++it;
-                last = it;
-                break;
-            }
-        }
-        return std::pair<const_iterator,
-                         const_iterator>(first, last);
+    std::pair<iterator, iterator> equal_range(const key_type& k) {
+        return _tab.equal_range(k);
+    }
+
+    std::pair<const_iterator, const_iterator> equal_range(const key_type& k) const {
+        return _tab.equal_range(k);
     }
 
     // 桶接口
     size_type bucket_count() const noexcept {
-        size_type cnt = 0;
-        for(size_type i = 0; i < _tab.table.size(); ++i) {
-            if(!_tab.table[i].empty())
-                ++cnt;
-        }
-        return cnt;
+        return _tab.bucket_count();
     }
 
     size_type max_bucket_count() const noexcept {
-        return _tab.table.size() - 1;
+        return _tab.max_bucket_count();
     }
 
     size_type bucket_size(size_type n) const {
-        size_type cnt = 0;
-        hnode t = _tab.table[n].cbegin();
-        while(t != _tab.table[n].cend()) {
-            ++cnt;
-            ++t;
-        }
-        return cnt;
+        return _tab.bucket_size(n);
     }
 
     size_type bucket(const key_type& k) const {
-        return hasher(k);
+        return _tab.bucket(k);
     }
 
     local_iterator
     begin(size_type n) {
-        return _tab.table[n].begin();
+        return _tab.begin(n);
     }
 
     const_local_iterator
     begin(size_type n) const {
-        return _tab.table[n].cbegin();
+        return _tab.begin(n);
     }
 
     local_iterator
     end(size_type n) {
-        return _tab.table[n].end();
+        return _tab.end(n);
     }
 
     const_local_iterator
     end(size_type n) const {
-        return _tab.table[n].cend();
+        return _tab.end(n);
     }
 
     const_local_iterator
     cbegin(size_type n) const {
-        return _tab.table[n].cbegin();
+        return _tab.begin(n);
     }
 
     const_local_iterator
     cend(size_type n) const {
-        return _tab.table[n].cend();
+        return _tab.end(n);
     }
 
     // 散列策略
@@ -455,17 +357,15 @@ namespace jrSTL {
     }
 
     float max_load_factor() const noexcept {
-        return static_cast<float>(size()) / max_bucket_count();
+        return _tab.max_load_factor();
     }
 
     void max_load_factor(float z) {
-        if(load_factor() > z) {
-            _tab.set_length(static_cast<size_type>(size() / z));
-        }
+        _tab.max_load_factor(z);
     }
 
     void rehash(size_type n) {
-        _tab.set_length(n);
+        _tab.rehash(n);
     }
 
     void reserve(size_type n) {
@@ -476,11 +376,12 @@ namespace jrSTL {
   template<class Key,
            class Hash = std::hash<Key>,
            class Pred = jrSTL::equal_to<Key>,
-           class Allocator = jrSTL::allocator<Key> >
+           class Allocator = jrSTL::allocator<Key>,
+           class HashPolicy = chained_hash_policy >
   class unordered_set
-          : public _hashset_base<Key, Hash, Pred, Allocator, false> {
+          : public _hashset_base<Key, Hash, Pred, Allocator, false, HashPolicy> {
   private:
-      typedef _hashset_base<Key, Hash, Pred, Allocator, false> _base;
+      typedef _hashset_base<Key, Hash, Pred, Allocator, false, HashPolicy> _base;
 
   public:
       using _base::insert;
@@ -556,11 +457,12 @@ namespace jrSTL {
   template<class Key,
            class Hash = std::hash<Key>,
            class Pred = jrSTL::equal_to<Key>,
-           class Allocator = jrSTL::allocator<Key>>
+           class Allocator = jrSTL::allocator<Key>,
+           class HashPolicy = chained_hash_policy >
   class unordered_multiset
-          : public _hashset_base<Key, Hash, Pred, Allocator, true> {
+          : public _hashset_base<Key, Hash, Pred, Allocator, true, HashPolicy> {
   private:
-      typedef _hashset_base<Key, Hash, Pred, Allocator, true> _base;
+      typedef _hashset_base<Key, Hash, Pred, Allocator, true, HashPolicy> _base;
 
   public:
       using _base::insert;
@@ -4,6 +4,7 @@
 #include <assert.h>
 #include <cstddef>
 #include "../utils/jr_iterators.h"
+#include "../../algorithm/jr_algorithm.h"
 
 /* array为聚合类类型（C++ Prime 7.5.5）;
  * 没有显式的构造/复制/销毁;
@@ -28,8 +29,7 @@ namespace jrSTL {
     value_type _base_array[N];
     // 聚合类型无显式的构造/复制/销毁
     void fill(const T& u) {
-        for(int i = 0; i < N; i++)
-            _base_array[i] = u;
+        jrSTL::fill_n(_base_array, N, u);
     }
 
     void swap(array& x) noexcept {
@@ -156,11 +156,7 @@ namespace jrSTL {
   template< class T, std::size_t N >
   bool operator==( const jrSTL::array<T,N>& lhs,
                    const jrSTL::array<T,N>& rhs ) {
-      for(int i = 0; i < N; i++) {
-          if(lhs[i] != rhs[i])
-              return false;
-      }
-      return true;
+      return jrSTL::equal(lhs.begin(), lhs.end(), rhs.begin());
   }
 
   template< class T, std::size_t N >
@@ -169,30 +165,24 @@ namespace jrSTL {
       return !(lhs == rhs);
   }
 
+  // 字典序比较
   template< class T, std::size_t N >
   bool operator<( const jrSTL::array<T,N>& lhs,
                   const jrSTL::array<T,N>& rhs ) {
-      for(int i = 0; i < N; i++) {
-          if(lhs[i] >= rhs[i])
-              return false;
-      }
-      return true;
+      return jrSTL::lexicographical_compare(lhs.begin(), lhs.end(),
+                                            rhs.begin(), rhs.end());
   }
 
   template< class T, std::size_t N >
   bool operator>( const jrSTL::array<T,N>& lhs,
                   const jrSTL::array<T,N>& rhs ) {
-      for(int i = 0; i < N; i++) {
-          if(lhs[i] <= rhs[i])
-              return false;
-      }
-      return true;
+      return rhs < lhs;
   }
 
   template< class T, std::size_t N >
   bool operator<=( const jrSTL::array<T,N>& lhs,
                    const jrSTL::array<T,N>& rhs ) {
-      return !(lhs > rhs);
+      return !(rhs < lhs);
   }
 
   template< class T, std::size_t N >
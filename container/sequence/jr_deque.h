@@ -2,11 +2,21 @@
 #define JR_DEQUE_H
 
 #include <cstddef>
+#include <climits>
+#include <utility>
 #include <type_traits>
+#include <initializer_list>
 #include "../../memory/jr_allocator.h"
 #include "../utils/jr_iterators.h"
+#include "../../algorithm/jr_algorithm.h"
 
 namespace jrSTL {
+    /* 分段连续存储的双端队列
+     * map为存储区指针数组，有效存储区位于map中部，两端预留空闲节点；
+     * 存储区仅在元素落入时才分配，整段元素出队后立即释放；
+     * map两端空间用尽时，若map空闲节点足够则原地居中，否则扩充map，两种情况都只移动存储区指针，不移动元素；
+     * 始终保证_finish所在存储区已分配，故头尾插入删除均为均摊O(1)
+     */
     template<class T, class Allocator = allocator<T>, size_t BufSize = 8>
     class deque {
         public:
@@ -36,144 +46,291 @@ namespace jrSTL {
             // 将内存分配策略重绑定至map数组所分配的连续存储区域
             typename Allocator::template rebind<pointer>::other _alloc_map;
 
+            enum { _min_map_size = 8 };
+
         protected:
-            void _init(size_type map_size) {
-                _map = _alloc_map.allocate(map_size + 1);
-                for(size_type i = 0; i <= _map_size; i++)
-                    _map[i] = _alloc.allocate(BufSize + 1);
-                _start.jmp_node(&_map[0]);
-                _finish.jmp_node(&_map[0]);
+            pointer _allocate_block() {
+                return _alloc.allocate(BufSize);
+            }
+
+            void _deallocate_block(pointer p) {
+                _alloc.deallocate(p, BufSize);
+            }
+
+            // 迭代器跳至节点d但保持当前元素位置不变（map重新分配后修正迭代器）
+            static void _set_node(iterator& it, map_pointer d) {
+                pointer c = it.cur;
+                it.jmp_node(d);
+                it.cur = c;
+            }
+
+            // 按元素个数分配map与所需存储区，有效节点位于map正中
+            void _create_map_and_nodes(size_type num_elements) {
+                size_type num_nodes = num_elements / BufSize + 1;
+                _map_size = num_nodes + 2 > _min_map_size ? num_nodes + 2 : static_cast<size_type>(_min_map_size);
+                _map = _alloc_map.allocate(_map_size);
+                for(size_type i = 0; i < _map_size; i++)
+                    _map[i] = nullptr;
+                map_pointer nstart = _map + (_map_size - num_nodes) / 2;
+                map_pointer nfinish = nstart + num_nodes - 1;
+                for(map_pointer cur = nstart; cur <= nfinish; ++cur)
+                    *cur = _allocate_block();
+                _start.jmp_node(nstart);
+                _finish.jmp_node(nfinish);
+                _finish.cur = _finish.first + num_elements % BufSize;
             }
 
             void _free_all() {
-                for(size_type i = 0; i <= _map_size; i++) {
-                    for(size_type j = 0; j <= BufSize; j++)
-                        _alloc.destroy(&_map[i][j]);
-                    _alloc.deallocate(_map[i], BufSize + 1);
+                for(iterator it = _start; it != _finish; ++it)
+                    _alloc.destroy(it.cur);
+                for(map_pointer cur = _start.control_node; cur <= _finish.control_node; ++cur)
+                    _deallocate_block(*cur);
+                _alloc_map.deallocate(_map, _map_size);
+            }
+
+            // 在map前端（或后端）为nodes_to_add个新节点腾出位置；
+            // map中空闲节点超过一半时原地居中，否则扩充map，二者均只复制存储区指针
+            void _reallocate_map(size_type nodes_to_add, bool add_at_front) {
+                size_type old_num_nodes = _finish.control_node - _start.control_node + 1;
+                size_type new_num_nodes = old_num_nodes + nodes_to_add;
+                map_pointer new_nstart;
+                if(_map_size > 2 * new_num_nodes) {
+                    new_nstart = _map + (_map_size - new_num_nodes) / 2
+                               + (add_at_front ? nodes_to_add : 0);
+                    if(new_nstart < _start.control_node) {
+                        for(size_type i = 0; i < old_num_nodes; i++)
+                            new_nstart[i] = _start.control_node[i];
+                    } else {
+                        for(size_type i = old_num_nodes; i > 0; i--)
+                            new_nstart[i - 1] = _start.control_node[i - 1];
+                    }
+                } else {
+                    size_type new_map_size = _map_size
+                                           + (_map_size > nodes_to_add ? _map_size : nodes_to_add)
+                                           + 2;
+                    map_pointer new_map = _alloc_map.allocate(new_map_size);
+                    for(size_type i = 0; i < new_map_size; i++)
+                        new_map[i] = nullptr;
+                    new_nstart = new_map + (new_map_size - new_num_nodes) / 2
+                               + (add_at_front ? nodes_to_add : 0);
+                    for(size_type i = 0; i < old_num_nodes; i++)
+                        new_nstart[i] = _start.control_node[i];
+                    _alloc_map.deallocate(_map, _map_size);
+                    _map = new_map;
+                    _map_size = new_map_size;
                 }
-                _alloc_map.deallocate(_map, _map_size + 1);
+                _set_node(_start, new_nstart);
+                _set_node(_finish, new_nstart + old_num_nodes - 1);
+            }
+
+            void _reserve_map_at_back(size_type nodes_to_add = 1) {
+                if(nodes_to_add + 1 > _map_size - (_finish.control_node - _map))
+                    _reallocate_map(nodes_to_add, false);
+            }
+
+            void _reserve_map_at_front(size_type nodes_to_add = 1) {
+                if(nodes_to_add > static_cast<size_type>(_start.control_node - _map))
+                    _reallocate_map(nodes_to_add, true);
+            }
+
+            // 最后一个存储区只剩一个空位时，先分配下一段存储区再构造元素
+            template<class... Args>
+            void _push_back_aux(Args&&... args) {
+                _reserve_map_at_back();
+                *(_finish.control_node + 1) = _allocate_block();
+                try {
+                    _alloc.construct(_finish.cur, static_cast<Args&&>(args)...);
+                } catch(...) {
+                    _deallocate_block(*(_finish.control_node + 1));
+                    throw;
+                }
+                _finish.jmp_node(_finish.control_node + 1);
+            }
+
+            // 第一个存储区已满时，分配前一段存储区，在其末尾构造元素
+            template<class... Args>
+            void _push_front_aux(Args&&... args) {
+                _reserve_map_at_front();
+                *(_start.control_node - 1) = _allocate_block();
+                try {
+                    pointer p = *(_start.control_node - 1) + BufSize - 1;
+                    _alloc.construct(p, static_cast<Args&&>(args)...);
+                } catch(...) {
+                    _deallocate_block(*(_start.control_node - 1));
+                    throw;
+                }
+                _start.jmp_node(_start.control_node - 1);
+                _start.cur = _start.last - 1;
+            }
+
+            void _pop_back_aux() {
+                _deallocate_block(_finish.first);
+                _finish.jmp_node(_finish.control_node - 1);
+                _finish.cur = _finish.last - 1;
+                _alloc.destroy(_finish.cur);
+            }
+
+            void _pop_front_aux() {
+                _alloc.destroy(_start.cur);
+                _deallocate_block(_start.first);
+                _start.jmp_node(_start.control_node + 1);
+            }
+
+            // 以三次翻转实现[first, last)区间循环左移，使middle处的元素成为首元素
+            static void _reverse(iterator first, iterator last) {
+                while(first != last && first != --last) {
+                    std::swap(*first, *last);
+                    ++first;
+                }
+            }
+
+            static void _rotate(iterator first, iterator middle, iterator last) {
+                _reverse(first, middle);
+                _reverse(middle, last);
+                _reverse(first, last);
+            }
+
+            /* 按存储区分段移动元素：每段在源与目的的存储区内都是连续的，
+             * 交给jrSTL::move/move_backward处理，可平凡拷贝的元素整段memmove
+             * 前移时目的在源之前，后移时目的在源之后，区间可以重叠
+             * 存储区小于256字节时每段只有几个元素，调用memmove反而更慢，仍逐个移动
+             */
+            enum { _segment_move = BufSize * sizeof(T) >= 256 };
+
+            static iterator _move_segments(iterator first, iterator last, iterator d_first) {
+                if(!_segment_move) {
+                    for(; first != last; ++first, ++d_first)
+                        *d_first = static_cast<T&&>(*first);
+                    return d_first;
+                }
+                difference_type n = last - first;
+                while(n > 0) {
+                    difference_type len = first.last - first.cur;
+                    if(d_first.last - d_first.cur < len)
+                        len = d_first.last - d_first.cur;
+                    if(n < len)
+                        len = n;
+                    jrSTL::move(first.cur, first.cur + len, d_first.cur);
+                    first += len;
+                    d_first += len;
+                    n -= len;
+                }
+                return d_first;
+            }
+
+            static iterator _move_segments_backward(iterator first, iterator last, iterator d_last) {
+                if(!_segment_move) {
+                    while(last != first)
+                        *(--d_last) = static_cast<T&&>(*(--last));
+                    return d_last;
+                }
+                difference_type n = last - first;
+                while(n > 0) {
+                    // 位于存储区开头的迭代器，其前一段是上一个存储区的全部
+                    pointer src = last.cur == last.first ? *(last.control_node - 1) + BufSize : last.cur;
+                    pointer dst = d_last.cur == d_last.first ? *(d_last.control_node - 1) + BufSize : d_last.cur;
+                    difference_type len = last.cur == last.first ? BufSize : last.cur - last.first;
+                    difference_type d_len = d_last.cur == d_last.first ? BufSize : d_last.cur - d_last.first;
+                    if(d_len < len)
+                        len = d_len;
+                    if(n < len)
+                        len = n;
+                    jrSTL::move_backward(src - len, src, dst);
+                    last -= len;
+                    d_last -= len;
+                    n -= len;
+                }
+                return d_last;
+            }
+
+            // 新插入的count个元素已暂时放在较近的一端，将其旋转到第index个位置，
+            // 移动的元素个数为min(index, size() - index) + count
+            iterator _move_into_place(size_type index, size_type count, bool at_front) {
+                if(at_front)
+                    _rotate(_start, _start + count, _start + (count + index));
+                else
+                    _rotate(_start + index, _finish - count, _finish);
+                return _start + index;
             }
 
             void _ctor(size_type count, const T& value, std::true_type) {
-                _map_size = count / BufSize + 1;
-                _init(_map_size);
-                size_type i, j, cnt = 0;
-                for(i = 0; i <= _map_size; i++) {
-                    for(j = 0; (j < BufSize) && (cnt < count); j++) {
-                        _alloc.construct(&_map[i][j], value);
-                        ++cnt;
-                    }
+                _create_map_and_nodes(count);
+                iterator it = _start;
+                try {
+                    for(; it != _finish; ++it)
+                        _alloc.construct(it.cur, value);
+                } catch(...) {
+                    _finish = it;
+                    _free_all();
+                    throw;
                 }
-                _finish += count;
             }
 
             template<class InputIt>
             void _ctor(InputIt first, InputIt last, std::false_type) {
-                difference_type count = last - first;
-                _map_size = count / BufSize + 1;
-                _init(_map_size);
+                _create_map_and_nodes(0);
                 while(first != last) {
-                    _alloc.construct(_finish.cur, *first);
+                    push_back(*first);
                     ++first;
-                    ++_finish;
                 }
             }
 
             void _copy(const deque& other) {
-                iterator first = other._start;
-                iterator last = other._finish;
-                _ctor(first, last, std::false_type());
+                _create_map_and_nodes(other.size());
+                const_iterator src = other.cbegin();
+                for(iterator it = _start; it != _finish; ++it, ++src)
+                    _alloc.construct(it.cur, *src);
             }
 
             void _move(deque&& other) {
                 _map_size = other._map_size;
                 _map = other._map;
-                _start = std::move(other._start);
-                _finish = std::move(other._finish);
-                other._map_size = 1;
-                other._init(other._map_size);
-            }
-
-            void _move_map(size_type n) {
-                size_type tmp_sz = _map_size;
-                _map_size = n / BufSize + 1;
-                map_pointer _map_tmp = _map;
-                iterator first = _start, last = _finish;
-                _map = _alloc_map.allocate(_map_size + 1);
-                for(size_type i = 0; i <= _map_size; i++) {
-                    _map[i] = _alloc.allocate(BufSize + 1);
-                }
-                _start.jmp_node(&_map[0]);
-                _finish.jmp_node(&_map[0]);
-                while(first != last) {
-                    _alloc.construct(_finish.cur, *first);
-                    ++first;
-                    ++_finish;
-                }
-                for(size_type i = 0; i <= tmp_sz; i++) {
-                    for(size_type j = 0; j < BufSize; j++)
-                        _alloc.destroy(&_map_tmp[i][j]);
-                    _alloc.deallocate(_map_tmp[i], BufSize + 1);
-                }
-            }
-
-            iterator _move_elements_forward_n(const_iterator pos, difference_type n) {
-                iterator it = iterator(pos.control_node, pos.cur);
-                if(it >= _finish) {
-                    _finish += n;
-                    return _finish;
-                }
-                iterator tmp = _finish - 1;
-                _finish += n;
-                for(; tmp != it - 1; tmp--) {
-                    _alloc.construct(&(*(tmp + n)), *tmp);
-                }
-                it += n;
-                return it;
+                _start = other._start;
+                _finish = other._finish;
+                other._create_map_and_nodes(0);
             }
 
             iterator _insert(const_iterator pos, size_type count,
                              const T& value, std::true_type) {
-                size_type osz = size();
-                if(osz + count > BufSize * _map_size) {
-                    difference_type pdis = jrSTL::distance(cbegin(), pos);
-                    _move_map(osz + count);
-                    pos = cbegin();
-                    jrSTL::advance(pos, pdis);
+                size_type index = pos - cbegin();
+                bool at_front = index < size() / 2;
+                for(size_type i = 0; i < count; i++) {
+                    if(at_front)
+                        push_front(value);
+                    else
+                        push_back(value);
                 }
-                iterator i_pos = _move_elements_forward_n(pos,
-                                                          static_cast<difference_type>(count));
-                iterator before_pos = i_pos - count, tmp = before_pos;
-                while(tmp != i_pos) {
-                    _alloc.construct(&(*tmp), value);
-                    ++tmp;
-                }
-                return before_pos;
+                return _move_into_place(index, count, at_front);
             }
 
             template<class InputIt>
             iterator _insert(const_iterator pos,
                              InputIt first, InputIt last,
                              std::false_type){
-                difference_type dis = pos - cbegin();
-                while(first != last) {
-                    iterator it = insert(pos, *first);
-                    pos = cbegin() + (it - begin());
-                    ++pos;
-                    ++first;
+                size_type index = pos - cbegin();
+                bool at_front = index < size() / 2;
+                size_type count = 0;
+                for(; first != last; ++first, ++count) {
+                    if(at_front)
+                        push_front(*first);
+                    else
+                        push_back(*first);
                 }
-                return begin() + dis;
+                // 逐个头插后新元素为逆序，先翻转回原顺序
+                if(at_front)
+                    _reverse(_start, _start + count);
+                return _move_into_place(index, count, at_front);
             }
 
         public:
             // 构造函数
-            deque() : _map_size(1) {
-                _init(_map_size);
+            deque() {
+                _create_map_and_nodes(0);
             }
 
             explicit deque( const Allocator& a)
-                : _map_size(1), _alloc(a) {
-                _init(_map_size);
+                : _alloc(a) {
+                _create_map_and_nodes(0);
             }
 
             explicit deque( size_type count ) {
@@ -194,16 +351,11 @@ namespace jrSTL {
                 _ctor(first, last, type());
             }
 
-            deque( const deque& other )
-                : _map_size(0){
-                if(this == &other)
-                    return;
+            deque( const deque& other ) {
                 _copy(other);
             }
 
             deque( deque&& other ) {
-                if(this == &other)
-                    return;
                 _move(static_cast<deque&&>(other));
             }
 
@@ -223,7 +375,7 @@ namespace jrSTL {
             deque& operator=( const deque& other ) {
                 if(this == &other)
                     return *this;
-                clear();
+                _free_all();
                 _copy(other);
                 return *this;
             }
@@ -237,7 +389,7 @@ namespace jrSTL {
             }
             // 赋值操作
             void assign( size_type count, const T& value ) {
-                clear();
+                _free_all();
                 _ctor(count, value, std::true_type());
             }
 
@@ -249,8 +401,8 @@ namespace jrSTL {
 
             template< class InputIt >
             void assign( InputIt first, InputIt last ) {
-                clear();
                 typedef std::integral_constant<bool, std::is_integral<InputIt>::value> type;
+                _free_all();
                 _ctor(first, last, type());
             }
 
@@ -264,7 +416,7 @@ namespace jrSTL {
             }
 
             const_iterator begin() const noexcept {
-                return const_iterator(_start.control_node);
+                return cbegin();
             }
 
             iterator end() noexcept {
@@ -272,11 +424,11 @@ namespace jrSTL {
             }
 
             const_iterator end() const noexcept {
-                return const_iterator(_finish.control_node, _finish.cur);
+                return cend();
             }
 
             const_iterator cbegin() const noexcept {
-                return const_iterator(_start.control_node);
+                return const_iterator(_start.control_node, _start.cur);
             }
 
             const_iterator cend() const noexcept {
@@ -354,42 +506,42 @@ namespace jrSTL {
             }
 
             void resize(size_type sz, const T& c) {
-                size_type dis, osz = size();
-                if(sz < osz) {
-                    dis = osz - sz;
-                    while(dis--) {
-                        _alloc.destroy(_finish.cur);
-                        --_finish;
-                    }
-                } else if(sz > osz) {
-                    dis = sz - osz;
-                    if(sz > _map_size * BufSize) {
-                        _move_map(sz);
-                    }
-                    while(dis--) {
-                        _alloc.construct(_finish.cur, c);
-                        ++_finish;
-                    }
-                }
+                while(size() > sz)
+                    pop_back();
+                while(size() < sz)
+                    push_back(c);
             }
 
             void resize(size_type sz) {
                 resize(sz, T());
             }
 
+            // 将map收缩为恰好容纳现有存储区（两端各留一个空闲节点）
             void shrink_to_fit() {
-                _move_map(size());
-            }
-
-            void clear() noexcept {
-                if(!_map_size)
+                size_type num_nodes = _finish.control_node - _start.control_node + 1;
+                size_type new_map_size = num_nodes + 2 > _min_map_size ? num_nodes + 2 : static_cast<size_type>(_min_map_size);
+                if(new_map_size >= _map_size)
                     return;
-                for(size_type i = 0; i <= _map_size; i++) {
-                    for(size_type j = 0; j < BufSize; j++)
-                        _alloc.destroy(&_map[i][j]);
-                }
-                _start.jmp_node(&_map[0]);
-                _finish.jmp_node(&_map[0]);
+                map_pointer new_map = _alloc_map.allocate(new_map_size);
+                for(size_type i = 0; i < new_map_size; i++)
+                    new_map[i] = nullptr;
+                map_pointer new_nstart = new_map + (new_map_size - num_nodes) / 2;
+                for(size_type i = 0; i < num_nodes; i++)
+                    new_nstart[i] = _start.control_node[i];
+                _alloc_map.deallocate(_map, _map_size);
+                _map = new_map;
+                _map_size = new_map_size;
+                _set_node(_start, new_nstart);
+                _set_node(_finish, new_nstart + num_nodes - 1);
+            }
+
+            // 析构全部元素，只保留首个存储区
+            void clear() noexcept {
+                for(iterator it = _start; it != _finish; ++it)
+                    _alloc.destroy(it.cur);
+                for(map_pointer cur = _start.control_node + 1; cur <= _finish.control_node; ++cur)
+                    _deallocate_block(*cur);
+                _finish = _start;
             }
 
             iterator insert( const_iterator pos, size_type count, const T& value ) {
@@ -401,30 +553,11 @@ namespace jrSTL {
             }
 
             iterator insert( const_iterator pos, T&& value ) {
-                size_type osz = size();
-                if(osz + 1 > BufSize * _map_size) {
-                    difference_type pdis = pos - cbegin();
-                    _move_map(osz + 1);
-                    pos = cbegin();
-                    pos += pdis;
-                }
-                iterator i_pos = _move_elements_forward_n(pos, 1);
-                iterator before_pos = i_pos - 1, tmp = before_pos;
-                while(tmp != i_pos) {
-                    _alloc.construct(&(*tmp), static_cast<T&&>(value));
-                    ++tmp;
-                }
-                return before_pos;
+                return emplace(pos, static_cast<T&&>(value));
             }
 
             iterator insert( const_iterator pos, std::initializer_list<T> ilist ) {
-                difference_type dis = pos - cbegin();
-                for(auto it = ilist.begin(); it != ilist.end(); ++it) {
-                    iterator t = insert(pos, *it);
-                    pos = cbegin() + (t - begin());
-                    ++pos;
-                }
-                return begin() + dis;
+                return insert(pos, ilist.begin(), ilist.end());
             }
 
             template< class InputIt >
@@ -433,18 +566,23 @@ namespace jrSTL {
                 return _insert(pos, first, last, type());
             }
 
+            // 被删区间之前的元素较少时向后移动前半部分，否则向前移动后半部分，再从较近的一端出队
             iterator erase( const_iterator first, const_iterator last ) {
-                difference_type n = last - first;
-                iterator it = iterator(last.control_node, last.cur);
-                if(first == last)
-                    return it;
-                iterator tmp = _finish;
-                _finish -= n;
-                for(; it != tmp; it++) {
-                    *(it - n) = *it;
+                size_type index = first - cbegin();
+                size_type n = last - first;
+                if(n == 0)
+                    return _start + index;
+                size_type elems_after = size() - index - n;
+                if(index < elems_after) {
+                    _move_segments_backward(_start, _start + index, _start + (index + n));
+                    for(size_type i = 0; i < n; i++)
+                        pop_front();
+                } else {
+                    _move_segments(_start + (index + n), _finish, _start + index);
+                    for(size_type i = 0; i < n; i++)
+                        pop_back();
                 }
-                it -= n;
-                return it;
+                return _start + index;
             }
 
             iterator erase( const_iterator pos ) {
@@ -454,54 +592,76 @@ namespace jrSTL {
             }
 
             void push_back( const T& value ) {
-                insert(cend(), value);
+                emplace_back(value);
             }
 
             void push_front( const T& value ) {
-                insert(cbegin(), value);
+                emplace_front(value);
             }
 
             void pop_front() {
-                erase(cbegin());
+                if(_start.cur != _start.last - 1) {
+                    _alloc.destroy(_start.cur);
+                    ++_start.cur;
+                } else {
+                    _pop_front_aux();
+                }
             }
 
             void pop_back() {
-                erase(cend() - 1);
+                if(_finish.cur != _finish.first) {
+                    --_finish.cur;
+                    _alloc.destroy(_finish.cur);
+                } else {
+                    _pop_back_aux();
+                }
             }
 
             template< class... Args >
             iterator emplace( const_iterator pos, Args&&... args ) {
-                size_type osz = size();
-                if(osz + 1 > BufSize * _map_size) {
-                    difference_type pdis = pos - cbegin();
-                    _move_map(osz + 1);
-                    pos = cbegin() + pdis;
+                size_type index = pos - cbegin();
+                if(index == size()) {
+                    emplace_back(static_cast<Args&&>(args)...);
+                    return _finish - 1;
                 }
-                iterator i_pos = _move_elements_forward_n(pos, 1);
-                iterator before_pos = i_pos - 1, tmp = before_pos;
-                while(tmp != i_pos) {
-                    _alloc.construct(&(*tmp), static_cast<Args&&>(args)...);
-                    ++tmp;
+                if(index == 0) {
+                    emplace_front(static_cast<Args&&>(args)...);
+                    return _start;
                 }
-                return before_pos;
+                bool at_front = index < size() / 2;
+                if(at_front)
+                    emplace_front(static_cast<Args&&>(args)...);
+                else
+                    emplace_back(static_cast<Args&&>(args)...);
+                return _move_into_place(index, 1, at_front);
             }
 
             template< class... Args >
             void emplace_front( Args&&... args ) {
-                emplace(cbegin(), static_cast<Args&&>(args)...);
+                if(_start.cur != _start.first) {
+                    _alloc.construct(_start.cur - 1, static_cast<Args&&>(args)...);
+                    --_start.cur;
+                } else {
+                    _push_front_aux(static_cast<Args&&>(args)...);
+                }
             }
 
             template< class... Args >
             void emplace_back( Args&&... args ) {
-                emplace(cend(), static_cast<Args&&>(args)...);
+                if(_finish.cur != _finish.last - 1) {
+                    _alloc.construct(_finish.cur, static_cast<Args&&>(args)...);
+                    ++_finish.cur;
+                } else {
+                    _push_back_aux(static_cast<Args&&>(args)...);
+                }
             }
 
             void push_front( T&& value ) {
-                insert(cbegin(), static_cast<T&&>(value));
+                emplace_front(static_cast<T&&>(value));
             }
 
             void push_back( T&& value ) {
-                insert(cend(), static_cast<T&&>(value));
+                emplace_back(static_cast<T&&>(value));
             }
 
             void swap( deque& other ) {
@@ -5,6 +5,7 @@
 #include <type_traits>
 #include "../../memory/jr_allocator.h"
 #include "../utils/jr_iterators.h"
+#include "../utils/jr_list_sort.h"
 
 namespace jrSTL {
 template<class T, class Allocator = jrSTL::allocator<T> >
@@ -152,20 +153,13 @@ template<class T, class Allocator = jrSTL::allocator<T> >
      }
 
      template<class Compare>
-     _forward_node<T> *_merge_sort(_forward_node<T> *h, Compare comp) {
-         if(!h || !h->next)
-             return h;
-         bool is_change; // 与排序无关，为了接口统一而妥协的多余参数(与merge成员有关)
-         _forward_node<T> *slow = h, *fast = h, *new_h = nullptr;
-         while(fast && fast->next && fast->next->next) {
-             slow = slow->next;
-             fast = fast->next->next;
-         }
-         new_h = slow->next;
-         slow->next = nullptr;
-         h = _merge_sort(h, comp);
-         new_h = _merge_sort(new_h, comp);
-         return _merge_list(h, new_h, nullptr, nullptr, comp, is_change);
+     _forward_node<T> *_sort(_forward_node<T> *h, Compare& comp, list_sort_bottom_up) {
+         return jrSTL::_list_merge_sort(h, _tail, comp);
+     }
+
+     template<class Compare>
+     _forward_node<T> *_sort(_forward_node<T> *h, Compare& comp, list_sort_by_pointer) {
+         return jrSTL::_list_pointer_sort(h, _tail, jrSTL::_chain_length(h, _tail), comp);
      }
 
   public:
@@ -252,13 +246,16 @@ template<class T, class Allocator = jrSTL::allocator<T> >
         }
     }
 
+    // 头尾结点不含元素，只释放
     ~forward_list() {
-        while(_head != _tail) {
-            _forward_node<T> *t = _head->next;
-            _alloc.destroy(&(_head->data));
-            _alloc_node.deallocate(_head, 1);
-            _head = t;
+        _forward_node<T> *t = _head->next;
+        while(t != _tail) {
+            _forward_node<T> *next = t->next;
+            _alloc.destroy(&(t->data));
+            _alloc_node.deallocate(t, 1);
+            t = next;
         }
+        _alloc_node.deallocate(_head, 1);
         _alloc_node.deallocate(_tail, 1);
     }
 
@@ -576,9 +573,12 @@ template<class T, class Allocator = jrSTL::allocator<T> >
         }
     }
 
+    // t为最后保留的节点，与之等价的后继逐个摘下；头结点不含元素，从第一个元素开始比较
     template<class BinaryPredicate>
     void unique(BinaryPredicate binary_pred) {
-        _forward_node<T> *t = _head;
+        _forward_node<T> *t = _head->next;
+        if(t == _tail)
+            return;
         while(t->next != _tail) {
             if(binary_pred(t->data, t->next->data)) {
                 _forward_node<T> *m = t->next;
@@ -623,19 +623,18 @@ template<class T, class Allocator = jrSTL::allocator<T> >
         x._head->next = x._tail;
     }
 
+    // 稳定排序，mode为list_sort_bottom_up（默认）或list_sort_by_pointer
+    // 链直接以_tail哨兵结尾排序，不需要先找到最后一个节点；只有按指针排序时才数一遍长度
+    template<class Compare, class Mode>
+    void sort(Compare comp, Mode mode) {
+        if((_head->next == _tail) || (_head->next->next == _tail))
+            return;
+        _head->next = _sort(_head->next, comp, mode);
+    }
+
     template<class Compare>
     void sort(Compare comp) {
-        _forward_node<T> *tmp_h = _head->next, *tmp_t = _head;
-        while(tmp_t->next != _tail)
-            tmp_t = tmp_t->next;
-        _head->next = nullptr;
-        tmp_t->next = nullptr;
-        tmp_h = _merge_sort(tmp_h, comp);
-        _head->next = tmp_h;
-        tmp_t = _head->next;
-        while(tmp_t->next)
-            tmp_t = tmp_t->next;
-        tmp_t->next = _tail;
+        sort(comp, list_sort_bottom_up());
     }
 
     void remove(const T& value) {
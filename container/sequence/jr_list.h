@@ -6,6 +6,7 @@
 #include <cstddef>
 #include "../../memory/jr_allocator.h"
 #include "../utils/jr_iterators.h"
+#include "../utils/jr_list_sort.h"
 
 namespace jrSTL {
     template<class T, class Allocator = allocator<T> >
@@ -59,6 +60,10 @@ namespace jrSTL {
             _alloc_node.destroy(&(node->data));
             _alloc_node.deallocate(node, 1);
         }
+        // Free a node without value (sentinel or dummy), its data was never constructed
+        void _free_node(_node<T> *node) {
+            _alloc_node.deallocate(node, 1);
+        }
         // Insert a node into list head
         void _insert2head(const T& value) {
             _node<T> *node = _create_node(value), *tmp = _head->next;
@@ -275,39 +280,10 @@ namespace jrSTL {
             }
             n1 = dummy->next;
             n1->prev = dummy->next = nullptr;
-            _destroy_node(dummy);
+            _free_node(dummy);
             return n1;
         }
 
-        template<class Compare>
-        _node<T> *_merge_sort(_node<T> *h, Compare comp) {
-            if(!h || !h->next)
-                return h;
-            bool is_change;
-            // Find center postion node(Double-pointer method)
-            _node<T> *next, *slow, *fast;
-            next = nullptr;
-            slow = fast = h;
-            while(fast &&
-                  fast->next &&
-                  fast->next->next) {
-                slow = slow->next;
-                fast = fast->next->next;
-            }
-            next = slow->next;
-            // Cut to two parts from center node
-            slow->next = nullptr;
-            next->prev = nullptr;
-            // Sort left list
-            h = _merge_sort(h, comp);
-            // Sort right list
-            next = _merge_sort(next, comp);
-            // Merge two parts list
-            return _merge_list(h, next,
-                                      nullptr, nullptr,
-                                      comp, is_change);
-        }
-
     public:
         explicit list() : _size(0) {
            _create_empty_node();
@@ -391,12 +367,14 @@ namespace jrSTL {
         }
 
         ~list() {
-            while(_head != _tail) {
-                _node<T> *tmp = _head->next;
-                _destroy_node(_head);
-                _head = tmp;
+            _node<T> *cur = _head->next;
+            while(cur != _tail) {
+                _node<T> *tmp = cur->next;
+                _destroy_node(cur);
+                cur = tmp;
             }
-            _destroy_node(_tail);
+            _free_node(_head);
+            _free_node(_tail);
         }
 
         list& operator=(const list& x) {
@@ -708,9 +686,16 @@ namespace jrSTL {
 
         template<class Predicate>
         void remove_if(Predicate pred) {
-            for(const_iterator it = cbegin(); it != cend(); ++it) {
-                if(pred(*it))
-                    erase(it);
+            _node<T> *cur = _head->next;
+            while(cur != _tail) {
+                _node<T> *next = cur->next;
+                if(pred(cur->data)) {
+                    cur->prev->next = next;
+                    next->prev = cur->prev;
+                    _destroy_node(cur);
+                    --_size;
+                }
+                cur = next;
             }
         }
 
@@ -718,22 +703,23 @@ namespace jrSTL {
             remove_if([value](const T& a)->bool { return value == a;});
         }
 
+        // Single forward pass: compare each node with the last kept one and unlink it in place if equivalent
         template<class BinaryPredicate>
         void unique(BinaryPredicate binary_pred) {
-            _node<T> *t1 = _tail->prev, *t2 = _head;
-            while(t1 != t2) {
-                if(t1 &&
-                   t1->prev &&
-                   binary_pred(t1->data, t1->prev->data)) {
-                    _node<T> *n1 = t1;
-                    _node<T> *n2 = n1->prev;
-                    _node<T> *n3 = n2->prev;
+            if(_head->next == _tail)
+                return;
+            _node<T> *kept = _head->next, *cur = kept->next;
+            while(cur != _tail) {
+                _node<T> *next = cur->next;
+                if(binary_pred(kept->data, cur->data)) {
+                    kept->next = next;
+                    next->prev = kept;
+                    _destroy_node(cur);
                     --_size;
-                    n1->prev = n3;
-                    n3->next = n1;
-                    _destroy_node(n2);
-                }else
-                    t1 = t1->prev;
+                } else {
+                    kept = cur;
+                }
+                cur = next;
             }
         }
 
@@ -793,25 +779,28 @@ namespace jrSTL {
             merge(static_cast<list&&>(x), [=](const T& a, const T& b)->bool {return a < b;});
         }
 
-        // Use merge sort, stable, O(nlogn)
-        template<class Compare>
-        void sort(Compare comp) {
+        // Stable, O(nlogn); mode is list_sort_bottom_up (default) or list_sort_by_pointer
+        template<class Compare, class Mode>
+        void sort(Compare comp, Mode mode) {
             if(_size < 2)
                 return;
-            // Sort
+            // Detach [begin, end) as a nullptr-terminated chain, sort it by next links only
             _node<T> *_h = _head->next;
-            _head->next = nullptr;
-            _h->prev = nullptr;
-            _node<T> *_m = _tail->prev;
-            _m->next = nullptr;
-            _tail->prev = nullptr;
-            _h = _merge_sort(_h, comp);
-            _head->next = _h;
-            _h->prev = _head;
-            while(_h && _h->next)
-                _h = _h->next;
-            _h->next = _tail;
-            _tail->prev = _h;
+            _tail->prev->next = nullptr;
+            _h = jrSTL::_list_sort(_h, static_cast<_node<T> *>(nullptr), _size, comp, mode);
+            // Rebuild prev links in one pass
+            _node<T> *_p = _head;
+            for(; _h; _p = _h, _h = _h->next) {
+                _p->next = _h;
+                _h->prev = _p;
+            }
+            _p->next = _tail;
+            _tail->prev = _p;
+        }
+
+        template<class Compare>
+        void sort(Compare comp) {
+            sort(comp, list_sort_bottom_up());
         }
 
         void sort() {
@@ -3,12 +3,17 @@
 
 #include <type_traits>
 #include <cstddef>
+#include <cstring>
 #include <initializer_list>
 #include "../../memory/jr_allocator.h"
+#include "../../memory/jr_relocate.h"
+#include "../utils/jr_growth_policy.h"
 #include "../../iterator/jr_iterator.h"
+#include "../../algorithm/jr_algorithm.h"
 
 namespace jrSTL {
-    template< class T, class Allocator = jrSTL::allocator<T> >
+    template< class T, class Allocator = jrSTL::allocator<T>,
+              class GrowthPolicy = vector_growth_double >
     class vector {
     public:
         typedef T* iterator;
@@ -17,6 +22,7 @@ namespace jrSTL {
         typedef jrSTL::reverse_iterator<iterator> reverse_iterator;
         typedef T value_type;
         typedef Allocator allocator_type;
+        typedef GrowthPolicy growth_policy_type;
         typedef size_t size_type;
         typedef ptrdiff_t difference_type;
         typedef T& reference;
@@ -28,21 +34,22 @@ namespace jrSTL {
         Allocator _alloc;
         size_type _size, _cap;
         iterator _head, _tail, _end_of_storage;
+        // 本对象发生的重新分配次数，不随swap/移动转移
+        size_type _realloc_count = 0;
+
+        // 将容量调整为new_cap（不小于size），元素经由重定位层搬移：
+        // 可平凡重定位的类型整体memcpy或由realloc原地扩展，其余类型逐个移动
+        void _reallocate(size_type new_cap) {
+            _head = _reallocate_storage(_head, _size, _cap, new_cap, _alloc);
+            _cap = new_cap;
+            _tail = _head + _size;
+            _end_of_storage = _head + _cap;
+            ++_realloc_count;
+        }
 
-        void _move_elements(iterator destination) {
-            iterator tmp = destination, old_head = _head;
-            while(_head != _tail) {
-                _alloc.construct(tmp, static_cast<T&&>(*_head));
-                ++_head;
-                ++tmp;
-            }
-            _head = destination;
-            _tail = tmp;
-            if(old_head) {
-                _alloc.destroy(old_head);
-                _alloc.deallocate(old_head, 1);
-                old_head = nullptr;
-            }
+        // 容量需至少为required时按扩容策略重新分配
+        void _grow_to(size_type required) {
+            _reallocate(GrowthPolicy::grow(_cap, required, sizeof(T)));
         }
 
         void _ctor(size_type count, const_reference value, std::true_type) {
@@ -68,16 +75,13 @@ namespace jrSTL {
             }
         }
 
+        // 调用前已clear，此时容器为空
         void _assign(size_type count, const_reference value, std::true_type) {
+            if(count > _cap)
+                _grow_to(count);
             _size = count;
-            if(count > _cap) {
-                _cap = 2 * _size;
-                _head = _alloc.allocate(_cap);
-                _end_of_storage = _head + _cap;
-            }
             _tail = _head;
             for(size_type i = 0; i < count; ++i) {
-                _alloc.destroy(_tail);
                 _alloc.construct(_tail, value);
                 ++_tail;
             }
@@ -86,12 +90,9 @@ namespace jrSTL {
         template<class InputIt>
         void _assign( InputIt first, InputIt last, std::false_type) {
             difference_type i, dis = last - first;
+            if(static_cast<size_type>(dis) > _cap)
+                _grow_to(dis);
             _size = dis;
-            if(dis > _cap) {
-                _cap = 2 * _size;
-                _head = _alloc.allocate(_cap);
-                _end_of_storage = _head + _cap;
-            }
             _tail = _head;
             for(i = 0; i < dis; ++i) {
                 _alloc.construct(_tail, *(first + i));
@@ -99,24 +100,59 @@ namespace jrSTL {
             }
         }
 
+        // 将[pos, _tail)整体后移count个位置以腾出[pos, pos + count)，返回空位中已构造区域的上界：
+        // 可平凡重定位的类型直接memmove，空位全部视为未初始化内存；
+        // 其余类型逐个移动，落在原尾部之前的空位存有已移出的对象，需赋值而非构造
+        iterator _open_gap(iterator pos, size_type count, std::true_type) {
+            size_type n = _tail - pos;
+            if(n)
+                std::memmove(static_cast<void *>(pos + count), static_cast<const void *>(pos),
+                             n * sizeof(T));
+            return pos;
+        }
+
+        iterator _open_gap(iterator pos, size_type count, std::false_type) {
+            iterator old_tail = _tail;
+            for(iterator src = _tail; src != pos; ) {
+                --src;
+                iterator dst = src + count;
+                if(dst >= old_tail)
+                    _alloc.construct(dst, static_cast<T&&>(*src));
+                else
+                    *dst = static_cast<T&&>(*src);
+            }
+            return old_tail;
+        }
+
+        iterator _open_gap(iterator pos, size_type count) {
+            return _open_gap(pos, count,
+                             std::integral_constant<bool, is_trivially_relocatable<T>::value>());
+        }
+
+        template<class V>
+        void _fill_slot(iterator p, iterator constructed_end, V&& v) {
+            if(p >= constructed_end)
+                _alloc.construct(p, static_cast<V&&>(v));
+            else
+                *p = static_cast<V&&>(v);
+        }
+
         iterator _insert(const_iterator pos, size_type count,
                          const_reference value, std::true_type) {
             difference_type dis = pos - cbegin();
-            if(_size + count > _cap) {
-                _cap = 2 * (_size + count);
-                _move_elements(_alloc.allocate(_cap));
-                _end_of_storage = _head + _cap;
-            }
+            if(count == 0)
+                return begin() + dis;
+            // value可能引用本容器中的元素，扩容或移动前先复制一份
+            value_type tmp(value);
+            if(_size + count > _cap)
+                _grow_to(_size + count);
             iterator pos_mutable = begin() + dis;
-            for(iterator tmp = _tail + count - 1; tmp != pos_mutable; --tmp) {
-                _alloc.construct(&(*tmp), *(tmp - count));
-            }
-            for(size_type i = 0; i < count; ++i) {
-                _alloc.construct(pos_mutable + i, value);
-            }
+            iterator constructed_end = _open_gap(pos_mutable, count);
+            for(size_type i = 0; i < count; ++i)
+                _fill_slot(pos_mutable + i, constructed_end, tmp);
             _tail += count;
             _size += count;
-            return begin() + dis;
+            return pos_mutable;
         }
 
         template<class InputIt>
@@ -402,25 +438,20 @@ namespace jrSTL {
         }
 
         void reserve( size_type new_cap ) {
-            if (new_cap > _cap) {
-                _cap = new_cap;
-                iterator tmp, new_head = _alloc.allocate(_cap);
-                for(tmp = new_head; _head != _tail; ++_head) {
-                    *tmp = *_head;
-                    ++tmp;
-                }
-                _head = new_head;
-                _tail = tmp;
-                _end_of_storage = _head + _size;
-            }
+            if (new_cap > _cap)
+                _reallocate(new_cap);
         }
 
+        // 按收缩策略决定目标容量，策略认为不值得收缩时不重新分配
         void shrink_to_fit() {
-            if(_size == _cap)
+            size_type new_cap = GrowthPolicy::shrink(_size, _cap, sizeof(T));
+            if(new_cap >= _cap)
                 return;
-            _cap = _size;
-            _move_elements(_alloc.allocate(_cap));
-            _end_of_storage = _tail;
+            _reallocate(new_cap);
+        }
+
+        size_type reallocation_count() const noexcept {
+            return _realloc_count;
         }
 
         void swap( vector& other ) {
@@ -454,20 +485,20 @@ namespace jrSTL {
         }
 
         void resize( size_type count, const_reference value ) {
-            if(count == size())
-                return;
-            _size = count;
-            if(_cap < count) {
-                _cap = 2 * _size;
-                size_type m = _tail - _head;
-                _move_elements(_alloc.allocate(_cap));
-                _end_of_storage = _head + _cap;
-                for(size_type i = 0; i < count - m; i++) {
+            if(count < _size) {
+                iterator new_tail = _head + count;
+                for(iterator tmp = new_tail; tmp != _tail; ++tmp)
+                    _alloc.destroy(tmp);
+                _tail = new_tail;
+                _size = count;
+            } else if(count > _size) {
+                if(_cap < count)
+                    _grow_to(count);
+                while(_size < count) {
                     _alloc.construct(_tail, value);
                     ++_tail;
+                    ++_size;
                 }
-            } else if(_cap > count) {
-                _tail = _head + count;
             }
         }
 
@@ -478,26 +509,18 @@ namespace jrSTL {
         iterator erase( iterator pos ) {
             if(pos == end())
                 return end();
-            iterator ret = pos;
-            while(pos != end()) {
-                _alloc.destroy(&(*pos));
-                if((pos + 1) == end())
-                    break;
-                _alloc.construct(&(*pos), *(pos + 1));
-                ++pos;
-            }
-            --_size;
-            --_tail;
-            return ret;
+            return erase(pos, pos + 1);
         }
 
+        // 后部元素整体前移（可平凡拷贝的类型由jrSTL::move直接memmove），再析构尾部多余的元素
         iterator erase( iterator first, iterator last ) {
             if(first == last)
                 return last;
-            while(first != last) {
-                first = erase(first);
-                --last;
-            }
+            iterator new_tail = jrSTL::move(last, _tail, first);
+            for(iterator p = new_tail; p != _tail; ++p)
+                _alloc.destroy(p);
+            _size -= last - first;
+            _tail = new_tail;
             return first;
         }
 
@@ -511,18 +534,11 @@ namespace jrSTL {
 
         iterator insert( const_iterator pos, T&& value ) {
             difference_type dis = pos - _head;
-            if(_size == _cap) {
-                _cap = 2 * (_size + 1);
-                _move_elements(_alloc.allocate(_cap));
-                _end_of_storage = _head + _cap;
-            }
-            iterator pos_mutable = begin();
-            jrSTL::advance(pos_mutable, dis);
-            for(iterator tmp = _tail; tmp != pos_mutable; --tmp) {
-                _alloc.construct(&(*tmp), std::move(*(tmp - 1)));
-            }
-            _alloc.construct(pos_mutable,
-                             std::move(value));
+            if(_size == _cap)
+                _grow_to(_size + 1);
+            iterator pos_mutable = begin() + dis;
+            iterator constructed_end = _open_gap(pos_mutable, 1);
+            _fill_slot(pos_mutable, constructed_end, static_cast<T&&>(value));
             ++_tail;
             ++_size;
             return pos_mutable;
@@ -544,11 +560,11 @@ namespace jrSTL {
         }
 
         void push_back( const_reference value ) {
-            insert(end(), value);
+            emplace_back(value);
         }
 
         void push_back( T&& value ) {
-            insert(end(), std::forward<T&&>(value));
+            emplace_back(static_cast<T&&>(value));
         }
 
         void pop_back() {
@@ -562,99 +578,73 @@ namespace jrSTL {
         template< class... Args >
         iterator emplace( const_iterator pos, Args&&... args ) {
             difference_type dis = pos - _head;
-            if(_size == _cap) {
-                _cap = 2 * (_size + 1);
-                _move_elements(_alloc.allocate(_cap));
-                _end_of_storage = _head + _cap;
+            if(pos == cend()) {
+                emplace_back(static_cast<Args&&>(args)...);
+                return begin() + dis;
             }
-            iterator pos_mutable = begin();
-            jrSTL::advance(pos_mutable, dis);
-            for(iterator tmp = _tail; tmp != pos_mutable; --tmp) {
-                *tmp = *(tmp - 1);
-            }
-            _alloc.construct(pos_mutable,
-                             static_cast<Args&&>(args)...);
-            ++_tail;
-            ++_size;
-            return pos_mutable;
+            // 参数可能引用本容器中的元素，先构造出新元素再移动到位
+            return insert(pos, value_type(static_cast<Args&&>(args)...));
         }
 
         template< class... Args >
         void emplace_back( Args&&... args ) {
             if(_size == _cap) {
-                _cap = 2 * (_size + 1);
-                _move_elements(_alloc.allocate(_cap));
-                _end_of_storage = _head + _cap;
+                // 参数可能引用本容器中的元素，扩容前先构造出新元素
+                value_type tmp(static_cast<Args&&>(args)...);
+                _grow_to(_size + 1);
+                _alloc.construct(_tail, static_cast<value_type&&>(tmp));
+            } else {
+                _alloc.construct(_tail,
+                                 static_cast<Args&&>(args)...);
             }
-            _alloc.construct(_tail,
-                             static_cast<Args&&>(args)...);
             ++_tail;
             ++_size;
         }
     };
 
-    template< class T, class Alloc >
-    void swap( jrSTL::vector<T,Alloc>& lhs,
-               jrSTL::vector<T,Alloc>& rhs ) {
+    template< class T, class Alloc, class Growth >
+    void swap( jrSTL::vector<T,Alloc,Growth>& lhs,
+               jrSTL::vector<T,Alloc,Growth>& rhs ) {
         lhs.swap(rhs);
     }
 
-    template< class T, class Alloc >
-    bool operator==( const jrSTL::vector<T, Alloc>& lhs,
-                     const jrSTL::vector<T, Alloc>& rhs ) {
-        if (lhs.size() != rhs.size())
-            return false;
-        for(size_t i = 0; i < lhs.size(); i++) {
-            if(lhs.at(i) != rhs.at(i))
-                return false;
-        }
-        return true;
+    template< class T, class Alloc, class Growth >
+    bool operator==( const jrSTL::vector<T, Alloc, Growth>& lhs,
+                     const jrSTL::vector<T, Alloc, Growth>& rhs ) {
+        return lhs.size() == rhs.size() &&
+               jrSTL::equal(lhs.begin(), lhs.end(), rhs.begin());
     }
 
-    template< class T, class Alloc >
-    bool operator!=( const jrSTL::vector<T, Alloc>& lhs,
-                     const jrSTL::vector<T, Alloc>& rhs ) {
+    template< class T, class Alloc, class Growth >
+    bool operator!=( const jrSTL::vector<T, Alloc, Growth>& lhs,
+                     const jrSTL::vector<T, Alloc, Growth>& rhs ) {
         return !(lhs == rhs);
     }
 
-    template< class T, class Alloc >
-    bool operator<( const jrSTL::vector<T, Alloc>& lhs,
-                    const jrSTL::vector<T, Alloc>& rhs ) {
-        if (lhs.size() < rhs.size())
-            return true;
-        if (lhs.size() > rhs.size() || operator==(lhs, rhs))
-            return false;
-        for(size_t i = 0; i < lhs.size(); i++) {
-            if(lhs.at(i) > rhs.at(i))
-                return false;
-        }
-        return true;
+    // 字典序比较
+    template< class T, class Alloc, class Growth >
+    bool operator<( const jrSTL::vector<T, Alloc, Growth>& lhs,
+                    const jrSTL::vector<T, Alloc, Growth>& rhs ) {
+        return jrSTL::lexicographical_compare(lhs.begin(), lhs.end(),
+                                              rhs.begin(), rhs.end());
     }
 
-    template< class T, class Alloc >
-    bool operator>( const jrSTL::vector<T, Alloc>& lhs,
-                    const jrSTL::vector<T, Alloc>& rhs ) {
-        if (lhs.size() > rhs.size())
-            return true;
-        if (lhs.size() < rhs.size() || operator==(lhs, rhs))
-            return false;
-        for(size_t i = 0; i < lhs.size(); i++) {
-            if(lhs.at(i) < rhs.at(i))
-                return false;
-        }
-        return true;
+    template< class T, class Alloc, class Growth >
+    bool operator>( const jrSTL::vector<T, Alloc, Growth>& lhs,
+                    const jrSTL::vector<T, Alloc, Growth>& rhs ) {
+        return rhs < lhs;
     }
 
-    template< class T, class Alloc >
-    bool operator>=( const jrSTL::vector<T, Alloc>& lhs,
-                     const jrSTL::vector<T, Alloc>& rhs ) {
+    template< class T, class Alloc, class Growth >
+    bool operator>=( const jrSTL::vector<T, Alloc, Growth>& lhs,
+                     const jrSTL::vector<T, Alloc, Growth>& rhs ) {
         return !(lhs < rhs);
     }
 
-    template< class T, class Alloc >
-    bool operator<=( const jrSTL::vector<T, Alloc>& lhs,
-                     const jrSTL::vector<T, Alloc>& rhs ) {
-        return !(lhs > rhs);
+    template< class T, class Alloc, class Growth >
+    bool operator<=( const jrSTL::vector<T, Alloc, Growth>& lhs,
+                     const jrSTL::vector<T, Alloc, Growth>& rhs ) {
+        return !(rhs < lhs);
     }
 
 }
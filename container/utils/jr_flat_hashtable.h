@@ -0,0 +1,491 @@
+#ifndef JR_FLAT_HASHTABLE_H
+#define JR_FLAT_HASHTABLE_H
+
+#include <cstddef>
+#include <cstring>
+#include <climits>
+#include <utility>
+#include "jr_iterators.h"
+
+// 编译期开关：目标平台支持SSE2时默认以SIMD指令比较整组控制字节；
+// 定义JR_HASH_NO_SIMD可强制使用逐字节比较的标量实现
+#if !defined(JR_HASH_NO_SIMD) && defined(__SSE2__)
+#define JR_HASH_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace jrSTL {
+// 控制字节取值：空槽、墓碑（已删除）、哨兵（标记end迭代器）；
+// 非负值表示槽位已占用，其值为该元素哈希值的低7位（H2）
+const signed char _ctrl_empty = -128;
+const signed char _ctrl_deleted = -2;
+const signed char _ctrl_sentinel = -1;
+
+// 一组连续的控制字节，一次探测检查一整组槽位；
+// 返回的位掩码中第i位对应组内第i个槽位，逐字节比较时不使用分支，避免控制字节随机分布导致的分支预测失败
+struct _ctrl_group_portable {
+    enum { width = 16 };
+    const signed char *ctrl;
+
+    explicit _ctrl_group_portable(const signed char *c) : ctrl(c) {}
+
+    unsigned match(signed char h2) const {
+        unsigned m = 0;
+        for(unsigned i = 0; i < width; ++i)
+            m |= static_cast<unsigned>(ctrl[i] == h2) << i;
+        return m;
+    }
+
+    unsigned match_empty() const {
+        return match(_ctrl_empty);
+    }
+
+    unsigned match_empty_or_deleted() const {
+        unsigned m = 0;
+        for(unsigned i = 0; i < width; ++i)
+            m |= static_cast<unsigned>(ctrl[i] < _ctrl_sentinel) << i;
+        return m;
+    }
+
+    // 从组首开始连续的空槽/墓碑个数，用于迭代器快速跳过
+    size_t count_leading_empty_or_deleted() const {
+        size_t i = 0;
+        while(i < width && ctrl[i] < _ctrl_sentinel)
+            ++i;
+        return i;
+    }
+};
+
+#ifdef JR_HASH_USE_SSE2
+// SSE2实现：一条比较指令处理整组16个控制字节，再用movemask压缩为位掩码
+struct _ctrl_group_sse2 {
+    enum { width = 16 };
+    __m128i ctrl;
+
+    explicit _ctrl_group_sse2(const signed char *c)
+        : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i *>(c))) {}
+
+    unsigned match(signed char h2) const {
+        return static_cast<unsigned>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl)));
+    }
+
+    unsigned match_empty() const {
+        return match(_ctrl_empty);
+    }
+
+    // 空槽与墓碑是仅有的小于哨兵的取值，一次有符号比较即可
+    unsigned match_empty_or_deleted() const {
+        return static_cast<unsigned>(
+            _mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(_ctrl_sentinel), ctrl)));
+    }
+
+    // 掩码低位连续的1的个数，即mask+1的末尾0个数（mask不超过16位，mask+1必不为0）
+    size_t count_leading_empty_or_deleted() const {
+        return static_cast<size_t>(__builtin_ctz(match_empty_or_deleted() + 1));
+    }
+};
+
+typedef _ctrl_group_sse2 _ctrl_group;
+#else
+typedef _ctrl_group_portable _ctrl_group;
+#endif
+
+/* 开放定址散列表（SwissTable风格）
+ * 元素直接存放于连续的槽位数组中，另有一个等长的控制字节数组记录各槽位状态；
+ * 槽位数恒为2^k-1，控制字节数组末尾额外存放一个哨兵与width-1个前部控制字节的副本，
+ * 使任意位置起的一组控制字节都可连续读取；探测以组为单位按三角数序列进行，
+ * 可遍历全部分组；最大负载因子固定为7/8，墓碑计入负载，故表中始终存在空槽，查找必然终止。
+ * 由于等值元素无法保证在迭代序列中相邻，本引擎仅用于不允许重复键值的容器。
+ */
+template<class T, class HashFun, class KeyEqualFun, class Allocator, bool isMulti>
+class _flat_hashtable {
+    static_assert(!isMulti, "flat_hash_policy does not support multi-key containers");
+
+public:
+    typedef _flat_hashtable_iterator<T, HashFun, KeyEqualFun, Allocator, isMulti> iterator;
+    typedef T* local_iterator;
+    typedef const T* const_local_iterator;
+
+private:
+    typedef _ctrl_group group;
+    HashFun Hash;
+    KeyEqualFun KeyEqual;
+    typename Allocator::template rebind<T>::other _alloc_slot;
+    typename Allocator::template rebind<signed char>::other _alloc_ctrl;
+    signed char *_ctrl;
+    T *_slots;
+    size_t _capacity;  // 槽位数，恒为2^k-1
+    size_t _num;  // 元素个数
+    size_t _growth_left;  // 触发扩容前还可占用的空槽数
+
+    // 打散哈希值，避免std::hash对整数取恒等映射导致的聚集
+    static size_t _mix(size_t h) {
+        unsigned long long x = static_cast<unsigned long long>(h) * 0x9E3779B97F4A7C15ULL;
+        return static_cast<size_t>(x ^ (x >> 32));
+    }
+
+    // 高位决定探测起点，低7位存入控制字节用于快速过滤
+    static size_t _h1(size_t h) {
+        return h >> 7;
+    }
+
+    static signed char _h2(size_t h) {
+        return static_cast<signed char>(h & 0x7F);
+    }
+
+    static unsigned _trailing_zeros(unsigned m) {
+        return __builtin_ctz(m);
+    }
+
+    static unsigned _leading_zeros(unsigned m) {
+        return __builtin_clz(m) - (sizeof(unsigned) * CHAR_BIT - group::width);
+    }
+
+    // 槽位数为cap时允许容纳的元素个数（最大负载因子7/8）
+    static size_t _capacity_to_growth(size_t cap) {
+        return cap - cap / 8;
+    }
+
+    // 不小于n的最小合法槽位数
+    static size_t _normalize_capacity(size_t n) {
+        size_t cap = group::width - 1;
+        while(cap < n)
+            cap = cap * 2 + 1;
+        return cap;
+    }
+
+    void _initialize(size_t cap) {
+        _capacity = cap;
+        _ctrl = _alloc_ctrl.allocate(cap + group::width);
+        std::memset(_ctrl, _ctrl_empty, cap + group::width);
+        _ctrl[cap] = _ctrl_sentinel;
+        _slots = _alloc_slot.allocate(cap);
+        _num = 0;
+        _growth_left = _capacity_to_growth(cap);
+    }
+
+    void _release() {
+        for(size_t i = 0; i < _capacity; ++i) {
+            if(_ctrl[i] >= 0)
+                _alloc_slot.destroy(_slots + i);
+        }
+        _alloc_ctrl.deallocate(_ctrl, _capacity + group::width);
+        _alloc_slot.deallocate(_slots, _capacity);
+    }
+
+    // 同时写入控制字节及其位于数组末尾的副本
+    void _set_ctrl(size_t i, signed char h) {
+        _ctrl[i] = h;
+        _ctrl[((i - (group::width - 1)) & _capacity) + (group::width - 1)] = h;
+    }
+
+    iterator _iterator_at(size_t i) const {
+        return iterator(_ctrl + i, _slots + i);
+    }
+
+    // 沿探测序列查找首个空槽或墓碑
+    size_t _find_first_non_full(size_t hash) const {
+        size_t offset = _h1(hash) & _capacity;
+        size_t index = 0;
+        while(true) {
+            unsigned m = group(_ctrl + offset).match_empty_or_deleted();
+            if(m)
+                return (offset + _trailing_zeros(m)) & _capacity;
+            index += group::width;
+            offset = (offset + index) & _capacity;
+        }
+    }
+
+    // 沿探测序列查找与target等价的元素，遇到含空槽的分组即可断定不存在，返回_capacity
+    size_t _find_index(const T& target, size_t hash) const {
+        size_t offset = _h1(hash) & _capacity;
+        size_t index = 0;
+        signed char h2 = _h2(hash);
+        while(true) {
+            group g(_ctrl + offset);
+            unsigned m = g.match(h2);
+            while(m) {
+                size_t i = (offset + _trailing_zeros(m)) & _capacity;
+                if(KeyEqual(_slots[i], target))
+                    return i;
+                m &= m - 1;
+            }
+            if(g.match_empty())
+                return _capacity;
+            index += group::width;
+            offset = (offset + index) & _capacity;
+        }
+    }
+
+    // 将全部元素迁移到槽位数为cap的新数组中（同时清除墓碑）
+    void _resize(size_t cap) {
+        signed char *old_ctrl = _ctrl;
+        T *old_slots = _slots;
+        size_t old_capacity = _capacity;
+        _initialize(cap);
+        for(size_t i = 0; i < old_capacity; ++i) {
+            if(old_ctrl[i] < 0)
+                continue;
+            size_t hash = _mix(Hash(old_slots[i]));
+            size_t j = _find_first_non_full(hash);
+            _alloc_slot.construct(_slots + j, static_cast<T&&>(old_slots[i]));
+            _alloc_slot.destroy(old_slots + i);
+            _set_ctrl(j, _h2(hash));
+            ++_num;
+            --_growth_left;
+        }
+        _alloc_ctrl.deallocate(old_ctrl, old_capacity + group::width);
+        _alloc_slot.deallocate(old_slots, old_capacity);
+    }
+
+    // 空槽耗尽：墓碑较多时原地重建即可，否则槽位数翻倍
+    void _rehash_and_grow() {
+        if(_num <= _capacity / 32 * 25)
+            _resize(_capacity);
+        else
+            _resize(_capacity * 2 + 1);
+    }
+
+    template<class V>
+    iterator _insert(V&& a, bool& flag) {
+        size_t hash = _mix(Hash(a));
+        size_t i = _find_index(a, hash);
+        if(i != _capacity) {
+            flag = false;
+            return _iterator_at(i);
+        }
+        flag = true;
+        i = _find_first_non_full(hash);
+        if(!_growth_left && _ctrl[i] != _ctrl_deleted) {
+            _rehash_and_grow();
+            i = _find_first_non_full(hash);
+        }
+        if(_ctrl[i] == _ctrl_empty)
+            --_growth_left;
+        _alloc_slot.construct(_slots + i, static_cast<V&&>(a));
+        _set_ctrl(i, _h2(hash));
+        ++_num;
+        return _iterator_at(i);
+    }
+
+    void _erase_at(size_t i) {
+        _alloc_slot.destroy(_slots + i);
+        --_num;
+        // 若包含该槽位的任意连续width个槽位从未同时被占满，则没有探测序列会越过它，可直接置空；
+        // 否则须留下墓碑，以免截断其他元素的探测序列
+        size_t before = (i - group::width) & _capacity;
+        unsigned empty_after = group(_ctrl + i).match_empty();
+        unsigned empty_before = group(_ctrl + before).match_empty();
+        bool was_never_full = empty_before && empty_after &&
+                              (_trailing_zeros(empty_after) + _leading_zeros(empty_before))
+                              < static_cast<unsigned>(group::width);
+        _set_ctrl(i, was_never_full ? _ctrl_empty : _ctrl_deleted);
+        if(was_never_full)
+            ++_growth_left;
+    }
+
+public:
+    // 构造与析构
+    _flat_hashtable(size_t size = 0,
+                    const HashFun& h = HashFun(),
+                    const KeyEqualFun& k = KeyEqualFun())
+        : Hash(h), KeyEqual(k) {
+        _initialize(_normalize_capacity(size));
+    }
+
+    _flat_hashtable(const _flat_hashtable& x)
+        : Hash(x.Hash), KeyEqual(x.KeyEqual) {
+        _initialize(x._capacity);
+        std::memcpy(_ctrl, x._ctrl, _capacity + group::width);
+        for(size_t i = 0; i < _capacity; ++i) {
+            if(_ctrl[i] >= 0)
+                _alloc_slot.construct(_slots + i, x._slots[i]);
+        }
+        _num = x._num;
+        _growth_left = x._growth_left;
+    }
+
+    _flat_hashtable(_flat_hashtable&& x)
+        : Hash(x.Hash), KeyEqual(x.KeyEqual),
+          _ctrl(x._ctrl), _slots(x._slots), _capacity(x._capacity),
+          _num(x._num), _growth_left(x._growth_left) {
+        x._initialize(group::width - 1);
+    }
+
+    ~_flat_hashtable() {
+        _release();
+    }
+
+    _flat_hashtable& operator=(const _flat_hashtable& x) {
+        if(this != &x) {
+            _flat_hashtable tmp(x);
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    _flat_hashtable& operator=(_flat_hashtable&& x) {
+        if(this != &x) {
+            _flat_hashtable tmp(static_cast<_flat_hashtable&&>(x));
+            swap(tmp);
+        }
+        return *this;
+    }
+
+    // 迭代器跳过空槽与墓碑，直至遇到占用槽位或末尾的哨兵
+    static void _skip_empty_or_deleted(const signed char *&ctrl, T *&slot) {
+        while(*ctrl < _ctrl_sentinel) {
+            size_t shift = group(ctrl).count_leading_empty_or_deleted();
+            ctrl += shift;
+            slot += shift;
+        }
+    }
+
+    iterator begin() const {
+        const signed char *c = _ctrl;
+        T *s = _slots;
+        _skip_empty_or_deleted(c, s);
+        return iterator(c, s);
+    }
+
+    iterator end() const {
+        return _iterator_at(_capacity);
+    }
+
+    size_t size() const {
+        return _num;
+    }
+
+    iterator find(const T& target) const {
+        size_t i = _find_index(target, _mix(Hash(target)));
+        return i == _capacity ? end() : _iterator_at(i);
+    }
+
+    size_t count(const T& target) const {
+        return _find_index(target, _mix(Hash(target))) != _capacity;
+    }
+
+    std::pair<iterator, iterator> equal_range(const T& target) const {
+        iterator first = find(target);
+        iterator last = first;
+        if(last != end())
+            ++last;
+        return std::pair<iterator, iterator>(first, last);
+    }
+
+    iterator insert(const T& a, bool& flag) {
+        return _insert(a, flag);
+    }
+
+    iterator insert(T&& a, bool& flag) {
+        return _insert(static_cast<T&&>(a), flag);
+    }
+
+    // 插入位置由探测序列决定，hint仅作提示
+    iterator insert_hint(iterator, const T& a, bool& flag) {
+        return _insert(a, flag);
+    }
+
+    iterator insert_hint(iterator, T&& a, bool& flag) {
+        return _insert(static_cast<T&&>(a), flag);
+    }
+
+    // 删除指定位置的元素，返回其后继；删除不移动其他元素，故后继仍然有效
+    iterator erase(iterator position) {
+        iterator next = position;
+        ++next;
+        _erase_at(position.slot - _slots);
+        return next;
+    }
+
+    size_t erase(const T& target) {
+        size_t i = _find_index(target, _mix(Hash(target)));
+        if(i == _capacity)
+            return 0;
+        _erase_at(i);
+        return 1;
+    }
+
+    void clear() {
+        for(size_t i = 0; i < _capacity; ++i) {
+            if(_ctrl[i] >= 0)
+                _alloc_slot.destroy(_slots + i);
+        }
+        std::memset(_ctrl, _ctrl_empty, _capacity + group::width);
+        _ctrl[_capacity] = _ctrl_sentinel;
+        _num = 0;
+        _growth_left = _capacity_to_growth(_capacity);
+    }
+
+    void swap(_flat_hashtable& x) {
+        std::swap(Hash, x.Hash);
+        std::swap(KeyEqual, x.KeyEqual);
+        std::swap(_ctrl, x._ctrl);
+        std::swap(_slots, x._slots);
+        std::swap(_capacity, x._capacity);
+        std::swap(_num, x._num);
+        std::swap(_growth_left, x._growth_left);
+    }
+
+    // 桶接口：每个槽位视为一个至多容纳一个元素的桶
+    size_t bucket_count() const {
+        return _capacity;
+    }
+
+    size_t max_bucket_count() const {
+        return UINT_MAX / sizeof(T);
+    }
+
+    size_t bucket_size(size_t n) const {
+        return _ctrl[n] >= 0 ? 1 : 0;
+    }
+
+    size_t bucket(const T& a) const {
+        return _h1(_mix(Hash(a))) & _capacity;
+    }
+
+    local_iterator begin(size_t n) {
+        return _slots + n;
+    }
+
+    const_local_iterator begin(size_t n) const {
+        return _slots + n;
+    }
+
+    local_iterator end(size_t n) {
+        return _slots + n + bucket_size(n);
+    }
+
+    const_local_iterator end(size_t n) const {
+        return _slots + n + bucket_size(n);
+    }
+
+    // 散列策略：最大负载因子由控制字节布局决定，固定为7/8，设置值仅作提示
+    float max_load_factor() const {
+        return 0.875f;
+    }
+
+    void max_load_factor(float) {}
+
+    // 保证槽位数不小于n，且足以容纳当前全部元素
+    void rehash(size_t n) {
+        size_t need = _num + _num / 7;
+        size_t cap = _normalize_capacity(n > need ? n : need);
+        while(_capacity_to_growth(cap) < _num)
+            cap = cap * 2 + 1;
+        if(cap != _capacity)
+            _resize(cap);
+    }
+};
+
+// 开放定址引擎：元素平铺存放于连续槽位中，插入无需逐个分配节点
+struct flat_hash_policy {
+    template<class T, class HashFun, class KeyEqualFun, class Allocator, bool isMulti>
+    struct rebind {
+        typedef _flat_hashtable<T, HashFun, KeyEqualFun, Allocator, isMulti> other;
+    };
+};
+}
+
+#endif // JR_FLAT_HASHTABLE_H
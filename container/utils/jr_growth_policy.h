@@ -0,0 +1,94 @@
+#ifndef JR_GROWTH_POLICY_H
+#define JR_GROWTH_POLICY_H
+
+#include <cstddef>
+
+namespace jrSTL {
+    /* vector的扩容/收缩策略，作为vector的第三个模板参数：
+     *     grow(cap, required, elem_size)   容量不足required时返回新容量，不小于required
+     *     shrink(size, cap, elem_size)     shrink_to_fit的目标容量，不小于size；
+     *                                      返回值不小于cap时不重新分配
+     * elem_size为元素字节数，供按字节对齐的策略使用
+     */
+
+    // 倍增：摊还复制次数最少，但峰值内存可达所需的2倍，默认策略
+    struct vector_growth_double {
+        static size_t grow(size_t cap, size_t required, size_t) {
+            size_t n = cap * 2;
+            return n < required ? required : n;
+        }
+
+        static size_t shrink(size_t size, size_t, size_t) {
+            return size;
+        }
+    };
+
+    // 1.5倍：峰值内存更低，且释放的旧块之和有机会被后续分配复用
+    struct vector_growth_golden {
+        static size_t grow(size_t cap, size_t required, size_t) {
+            size_t n = cap + cap / 2;
+            return n < required ? required : n;
+        }
+
+        static size_t shrink(size_t size, size_t, size_t) {
+            return size;
+        }
+    };
+
+    // 定长增长：每次增加Chunk的整数倍个元素，适用于规模可预估、对内存浪费敏感的场景；
+    // 收缩时保留到Chunk的整数倍，浪费不足一个Chunk时不重新分配
+    template<size_t Chunk = 4096>
+    struct vector_growth_chunk {
+        static_assert(Chunk > 0, "chunk size must be positive");
+
+        static size_t _round(size_t n) {
+            return (n + Chunk - 1) / Chunk * Chunk;
+        }
+
+        static size_t grow(size_t cap, size_t required, size_t) {
+            size_t n = cap + Chunk;
+            return _round(n < required ? required : n);
+        }
+
+        static size_t shrink(size_t size, size_t, size_t) {
+            return _round(size);
+        }
+    };
+
+    /* 页对齐的大容量增长：字节数低于Huge时倍增；达到Huge后每次只增长1/4，
+     * 且字节数向上取整到Page的整数倍，使大块由mmap分配、经realloc/mremap扩展时只重映射页表。
+     * 数组到达GB级时峰值内存约为所需的1.25倍，而非倍增的2倍
+     */
+    template<size_t Page = 4096, size_t Huge = (size_t(1) << 20)>
+    struct vector_growth_paged {
+        static_assert(Page > 0 && (Page & (Page - 1)) == 0, "page size must be a power of 2");
+
+        static size_t _page_round(size_t n, size_t elem_size) {
+            size_t bytes = (n * elem_size + Page - 1) & ~(Page - 1);
+            return bytes / elem_size;
+        }
+
+        static size_t grow(size_t cap, size_t required, size_t elem_size) {
+            size_t n;
+            if(cap * elem_size < Huge)
+                n = cap * 2;
+            else
+                n = cap + cap / 4;
+            if(n < required)
+                n = required;
+            if(n * elem_size < Huge)
+                return n;
+            return _page_round(n, elem_size);
+        }
+
+        // 大块只释放整页，尾部不足一页的空闲不值得一次重新分配
+        static size_t shrink(size_t size, size_t cap, size_t elem_size) {
+            if(size * elem_size < Huge)
+                return size;
+            size_t n = _page_round(size, elem_size);
+            return n < cap ? n : cap;
+        }
+    };
+}
+
+#endif // JR_GROWTH_POLICY_H
@@ -2,230 +2,411 @@
 #define JR_HASHTABLE_H
 
 #include <cstddef>
+#include <cmath>
 #include <utility>
-#include "../sequence/jr_vector.h"
-#include "../sequence/jr_forward_list.h"
 #include "jr_nodes.h"
+#include "jr_iterators.h"
 
 namespace jrSTL {
+// 桶数取自下表中的素数，每项约为前一项的两倍；以素数取模将哈希值映射为桶下标，
+// 即使std::hash对整数取恒等映射，键值呈等差分布时也不会集中于少数桶
+inline size_t _next_bucket_prime(size_t n) {
+    static const unsigned long long primes[] = {
+        5ULL, 11ULL, 23ULL, 53ULL, 97ULL, 193ULL, 389ULL, 769ULL,
+        1543ULL, 3079ULL, 6151ULL, 12289ULL, 24593ULL, 49157ULL,
+        98317ULL, 196613ULL, 393241ULL, 786433ULL, 1572869ULL,
+        3145739ULL, 6291469ULL, 12582917ULL, 25165843ULL, 50331653ULL,
+        100663319ULL, 201326611ULL, 402653189ULL, 805306457ULL,
+        1610612741ULL, 3221225473ULL, 6442450939ULL, 12884901893ULL,
+        25769803751ULL, 51539607551ULL, 103079215111ULL
+    };
+    const size_t num = sizeof(primes) / sizeof(primes[0]);
+    for(size_t i = 0; i < num; ++i) {
+        if(primes[i] >= n)
+            return static_cast<size_t>(primes[i]);
+    }
+    return static_cast<size_t>(primes[num - 1]);
+}
+
+/* 链式散列表
+ * 桶数组中每个桶保存一条单向链表的头指针，元素结点单独分配；
+ * 哈希值对桶数（素数）取模得到桶下标，内存占用只与元素个数和桶数相关；
+ * 负载因子超过max_load_factor时扩充桶数组，并将原有结点逐个摘下挂入新桶，不复制元素；
+ * 允许重复时等值元素总是相邻存放（equal_range依赖于此）
+ */
 template<class T, class HashFun, class KeyEqualFun, class Allocator, bool isMulti>
 class _hashtable{
     template<class U, class T1, class T2, class T3, bool a>
     friend struct _hashtable_iterator;
 
-    template<class U, class T1, class T2, class T3, bool a>
-    friend class _hashset_base;
-
-    template<class U1, class U2, class T1, class T2, class T3, bool a>
-    friend class _hashmap_base;
+public:
+    typedef _hashtable_iterator<T, HashFun, KeyEqualFun, Allocator, isMulti> iterator;
+    typedef _forward_list_iterator<T, T&, T*> local_iterator;
+    typedef _forward_list_iterator<T, const T&, const T*> const_local_iterator;
 
 private:
-    typedef typename forward_list<T>::const_iterator hnode;
+    typedef _forward_node<T> node;
+    typedef node* hnode;
     HashFun Hash;
     KeyEqualFun KeyEqual;
-    vector<forward_list<T, Allocator>,
-           typename Allocator::template rebind<forward_list<T, Allocator> >::other> table;
+    typename Allocator::template rebind<T>::other _alloc_data;
+    typename Allocator::template rebind<node>::other _alloc_node;
+    typename Allocator::template rebind<hnode>::other _alloc_bucket;
+    hnode *_buckets;
+    size_t _bucket_count;
+    size_t _num;  // 元素个数
+    float _max_load;  // 最大负载因子
+
+    size_t _index(const T& a) const {
+        return Hash(a) % _bucket_count;
+    }
+
+    hnode *_allocate_buckets(size_t n) {
+        hnode *b = _alloc_bucket.allocate(n);
+        for(size_t i = 0; i < n; ++i)
+            b[i] = nullptr;
+        return b;
+    }
+
+    template<class V>
+    hnode _create_node(V&& a) {
+        hnode n = _alloc_node.allocate(1);
+        try {
+            _alloc_data.construct(&(n->data), static_cast<V&&>(a));
+        } catch(...) {
+            _alloc_node.deallocate(n, 1);
+            throw;
+        }
+        n->next = nullptr;
+        return n;
+    }
+
+    void _destroy_node(hnode n) {
+        _alloc_data.destroy(&(n->data));
+        _alloc_node.deallocate(n, 1);
+    }
+
+    void _destroy_all() {
+        for(size_t i = 0; i < _bucket_count; ++i) {
+            hnode n = _buckets[i];
+            while(n) {
+                hnode next = n->next;
+                _destroy_node(n);
+                n = next;
+            }
+            _buckets[i] = nullptr;
+        }
+        _num = 0;
+    }
+
+    // 按x的桶数复制全部结点，各桶内结点顺序保持不变
+    void _copy_from(const _hashtable& x) {
+        _buckets = _allocate_buckets(x._bucket_count);
+        _bucket_count = x._bucket_count;
+        _num = 0;
+        try {
+            for(size_t i = 0; i < x._bucket_count; ++i) {
+                hnode *tail = _buckets + i;
+                for(hnode n = x._buckets[i]; n; n = n->next) {
+                    *tail = _create_node(n->data);
+                    tail = &((*tail)->next);
+                    ++_num;
+                }
+            }
+        } catch(...) {
+            _destroy_all();
+            _alloc_bucket.deallocate(_buckets, _bucket_count);
+            throw;
+        }
+    }
+
+    // 将全部结点重新挂入n个桶中；按原链表顺序逐个头插，相邻的等值元素在新桶中依然相邻
+    void _relink(size_t n) {
+        hnode *b = _allocate_buckets(n);
+        for(size_t i = 0; i < _bucket_count; ++i) {
+            hnode cur = _buckets[i];
+            while(cur) {
+                hnode next = cur->next;
+                size_t j = Hash(cur->data) % n;
+                cur->next = b[j];
+                b[j] = cur;
+                cur = next;
+            }
+        }
+        _alloc_bucket.deallocate(_buckets, _bucket_count);
+        _buckets = b;
+        _bucket_count = n;
+    }
+
+    // 容纳n个元素所需的最少桶数
+    size_t _buckets_for(size_t n) const {
+        return static_cast<size_t>(std::ceil(static_cast<double>(n) / _max_load));
+    }
+
+    // 插入前检查负载因子，超限时桶数至少翻倍
+    void _reserve_for_insert() {
+        if(_num + 1 > static_cast<double>(_bucket_count) * _max_load) {
+            size_t n = _buckets_for(_num + 1);
+            if(n < _bucket_count * 2)
+                n = _bucket_count * 2;
+            _relink(_next_bucket_prime(n));
+        }
+    }
+
+    // 在桶index中查找首个与目标键相等的结点，不存在时返回空指针
+    hnode _find_in_bucket(size_t index, const T& target) const {
+        hnode n = _buckets[index];
+        while(n && !KeyEqual(n->data, target))
+            n = n->next;
+        return n;
+    }
+
+    // 若不允许键值重复且该键值已存在，则什么都不做；
+    // 若允许重复且键值已存在，则插入到相同键值之后，保证等值元素相邻；
+    // 否则，挂在对应桶的链表头部
+    template<class V>
+    iterator _insert(V&& a, bool& flag) {
+        size_t index = _index(a);
+        hnode t = _find_in_bucket(index, a);
+        if(!isMulti && t) {
+            flag = false;
+            return iterator(this, index, t);
+        }
+        flag = true;
+        // 重新散列只改变结点所在的桶，t及其后继的相对位置不变
+        _reserve_for_insert();
+        hnode n = _create_node(static_cast<V&&>(a));
+        index = _index(n->data);
+        if(t) {
+            n->next = t->next;
+            t->next = n;
+        } else {
+            n->next = _buckets[index];
+            _buckets[index] = n;
+        }
+        ++_num;
+        return iterator(this, index, n);
+    }
 
 public:
     // 构造与析构
-    _hashtable() = default;
-
-    _hashtable(size_t size,
+    _hashtable(size_t size = 0,
                const HashFun& h = HashFun(),
                const KeyEqualFun& k = KeyEqualFun())
-        : Hash(h), KeyEqual(k) {
-        for(size_t i = 0; i < size; i++) {
-            table.push_back(forward_list<T>());
-        }
+        : Hash(h), KeyEqual(k), _num(0), _max_load(1.0f) {
+        _bucket_count = _next_bucket_prime(size);
+        _buckets = _allocate_buckets(_bucket_count);
     }
 
     _hashtable(const _hashtable& x)
-        : Hash(x.Hash), KeyEqual(x.KeyEqual) {
-        for(size_t i = 0; i < x.table.size(); i++) {
-            table.push_back(forward_list<T>(x.table[i]));
-        }
+        : Hash(x.Hash), KeyEqual(x.KeyEqual), _max_load(x._max_load) {
+        _copy_from(x);
     }
 
     _hashtable(_hashtable&& x)
-        : Hash(x.Hash), KeyEqual(x.KeyEqual) {
-        for(size_t i = 0; i < x.table.size(); i++) {
-            table.push_back(std::move(forward_list<T>(std::move(x.table[i]))));
-        }
+        : Hash(x.Hash), KeyEqual(x.KeyEqual), _max_load(x._max_load) {
+        _bucket_count = _next_bucket_prime(0);
+        _buckets = _allocate_buckets(_bucket_count);
+        _num = 0;
+        swap(x);
     }
 
-    ~_hashtable() {}
+    ~_hashtable() {
+        _destroy_all();
+        _alloc_bucket.deallocate(_buckets, _bucket_count);
+    }
 
     _hashtable& operator=(const _hashtable& x) {
         if(this == &x)
             return *this;
-        Hash = x.Hash;
-        KeyEqual = x.KeyEqual;
-        for(auto n : table)
-            n.clear();
-        table.clear();
-        for(size_t i = 0; i < x.table.size(); i++) {
-            table.push_back(forward_list<T>(x.table[i]));
-        }
+        _hashtable tmp(x);
+        swap(tmp);
         return *this;
     }
 
     _hashtable& operator=(_hashtable&& x) {
         if(this == &x)
             return *this;
-        Hash = x.Hash;
-        KeyEqual = x.KeyEqual;
-        for(auto n : table)
-            n.clear();
-        table.clear();
-        for(size_t i = 0; i < x.table.size(); i++) {
-            table.push_back(std::move(forward_list<T>(std::move(x.table[i]))));
-        }
+        clear();
+        swap(x);
         return *this;
     }
 
-    // 设置表长
-    void set_length(size_t len) {
-        while(table.size() < len) {
-            table.push_back(forward_list<T>());
-        }
-    }
-
-    // 查找目标键
-    std::pair<const int, hnode> find(const T& target) {
-        const int hash_index = Hash(target);
-        // 起始位置没有元素，或索引超出范围，说明该键值不存在，返回-1
-        if((hash_index >= table.size() - 1)
-         || table[hash_index].empty())
-            return std::pair<const int, hnode>(-1, table.back().cend());
-        hnode m = table[hash_index].cbegin();
-        while(m != table[hash_index].cend() && !KeyEqual(*m, target))
-            ++m;
-        if(m == table[hash_index].cend())
-            return std::pair<const int, hnode>(-1, m);
-        else
-            return std::pair<const int, hnode>(hash_index, m);
-    }
-
     // 元素计数器
-    size_t count(const T& k) {
+    size_t count(const T& k) const {
         size_t cnt = 0;
-        const int hash_index = Hash(k);
-        // 起始位置没有元素，或索引超出范围，说明该键值不存在，返回0
-        if((hash_index >= table.size() - 1)
-         || table[hash_index].empty())
-            return 0;
-        hnode m = table[hash_index].cbegin();
-        while(m != table[hash_index].cend()) {
-            if(KeyEqual(*m, k))
-                ++cnt;
-            ++m;
+        hnode n = _find_in_bucket(_index(k), k);
+        // 等值元素相邻，遇到第一个不相等的元素即可停止
+        while(n && KeyEqual(n->data, k)) {
+            ++cnt;
+            n = n->next;
+            if(!isMulti)
+                break;
         }
         return cnt;
     }
 
-    // 插入新元素
-    std::pair<const int, hnode> insert(const T& a, bool& flag) {
-        // 若不允许键值重复且该键值已存在，则什么都不做；否则，挂在哈希值对应索引的链表的头部
-        auto t = find(a);
-        if(!isMulti && (t.first != -1)) {
-            flag = false;
-            return t;
-        }
-        else {
-            flag = true;
-            int hash_index = Hash(a);
-            // 插入元素所需桶的数量超过原来的表长-1时，扩充表长(最后一个桶用于标记end迭代器)
-//            while(hash_index >= table.size() - 1) {
-//                table.push_back(forward_list<T>());
-//            }
-            set_length(hash_index + 5);
-            // 直接在链表头插入
-            table[hash_index].push_front(a);
-            return std::pair<const int, hnode>(hash_index,
-                                               table[hash_index].cbegin());
+    // 以下为供_hashmap_base/_hashset_base使用的统一引擎接口
+    iterator begin() const {
+        for(size_t i = 0; i < _bucket_count; ++i) {
+            if(_buckets[i])
+                return iterator(this, i, _buckets[i]);
         }
+        return end();
     }
 
-    std::pair<const int, hnode> insert(T&& a, bool& flag) {
-        auto t = find(a);
-        if(!isMulti && (t.first != -1)) {
-            flag = false;
-            return t;
-        }
-        else {
-            flag = true;
-            int hash_index = Hash(a);
-            // 插入元素所需桶的数量超过原来的表长-1时，扩充表长(最后一个桶用于标记end迭代器)
-            while(hash_index >= table.size() - 1) {
-                table.push_back(forward_list<T>());
-            }
-            // 直接在链表头插入
-            table[hash_index].push_front(static_cast<T&&>(a));
-            return std::pair<const int, hnode>(hash_index,
-                                               table[hash_index].cbegin());
-        }
+    iterator end() const {
+        return iterator(this, _bucket_count, nullptr);
     }
-    
-    // 将元素插入到指定位置（hint）之后
-    hnode insert_hint(size_t index, hnode hint,
-                      const T& a, bool& flag) {
-        auto t = find(a);
-        if(!isMulti && (t.first != -1)) {
-            flag = false;
-            return t.second;
-        }
-        flag = true;
-        table[index].insert_after(hint, a);
-        return ++hint;
-    }
-    
-    hnode insert_hint(size_t index, hnode hint,
-                      T&& a, bool& flag) {
-        auto t = find(a);
-        if(!isMulti && (t.first != -1)) {
-            flag = false;
-            return t.second;
-        }
-        flag = true;
-        table[index].insert_after(hint,
-                                  static_cast<T&&>(a));
-        return ++hint;
-    }
-    
-    // 删除指定位置的元素
-    void erase(size_t hash_index, hnode n) {
-        hnode pre, m = table[hash_index].cbefore_begin();
-        while(m != n) {
-            pre = m++;
-        }
-        table[hash_index].erase_after(pre);
+
+    iterator find(const T& target) const {
+        size_t index = _index(target);
+        hnode n = _find_in_bucket(index, target);
+        if(!n)
+            return end();
+        return iterator(this, index, n);
+    }
+
+    // 等值元素在同一链表中相邻存放，从首个匹配处向后扫描即可
+    std::pair<iterator, iterator> equal_range(const T& target) const {
+        iterator first = find(target);
+        iterator last = first;
+        while(last != end() && KeyEqual(*last, target))
+            ++last;
+        return std::pair<iterator, iterator>(first, last);
+    }
+
+    iterator insert(const T& a, bool& flag) {
+        return _insert(a, flag);
+    }
+
+    iterator insert(T&& a, bool& flag) {
+        return _insert(static_cast<T&&>(a), flag);
+    }
+
+    // 链式散列的插入位置完全由哈希值决定，hint仅作提示
+    iterator insert_hint(iterator, const T& a, bool& flag) {
+        return insert(a, flag);
+    }
+
+    iterator insert_hint(iterator, T&& a, bool& flag) {
+        return insert(static_cast<T&&>(a), flag);
+    }
+
+    // 删除指定位置的元素，返回其后继
+    iterator erase(iterator position) {
+        iterator next = position;
+        ++next;
+        hnode *pre = _buckets + position.index;
+        while(*pre != position.cur)
+            pre = &((*pre)->next);
+        *pre = position.cur->next;
+        _destroy_node(position.cur);
+        --_num;
+        return next;
     }
 
     // 删除对应键值的所有元素
     size_t erase(const T& target) {
         size_t cnt = 0;
-        int hash_index = Hash(target);
-        // 该键值不存在，无需删除
-        if((hash_index >= table.size() - 1)
-         || table[hash_index].empty()) {
-            return 0;
-        }
-        hnode pre = table[hash_index].cbefore_begin();
-        hnode m = table[hash_index].cbegin();
-        while(m != table[hash_index].cend()) {
-            if(KeyEqual(*m, target)) {
-                table[hash_index].erase_after(pre);
-                ++cnt;
-                if(!isMulti)
-                    break;
-                m = pre;
-            } else {
-                pre = m;
-            }
-            ++m;
+        hnode *pre = _buckets + _index(target);
+        while(*pre && !KeyEqual((*pre)->data, target))
+            pre = &((*pre)->next);
+        while(*pre && KeyEqual((*pre)->data, target)) {
+            hnode n = *pre;
+            *pre = n->next;
+            _destroy_node(n);
+            ++cnt;
+            if(!isMulti)
+                break;
         }
+        _num -= cnt;
+        return cnt;
+    }
+
+    void clear() {
+        _destroy_all();
+    }
+
+    size_t size() const {
+        return _num;
+    }
+
+    void swap(_hashtable& x) {
+        std::swap(Hash, x.Hash);
+        std::swap(KeyEqual, x.KeyEqual);
+        std::swap(_buckets, x._buckets);
+        std::swap(_bucket_count, x._bucket_count);
+        std::swap(_num, x._num);
+        std::swap(_max_load, x._max_load);
+    }
+
+    // 桶接口
+    size_t bucket_count() const {
+        return _bucket_count;
+    }
+
+    size_t max_bucket_count() const {
+        return _next_bucket_prime(static_cast<size_t>(-1));
+    }
+
+    size_t bucket_size(size_t n) const {
+        size_t cnt = 0;
+        for(hnode t = _buckets[n]; t; t = t->next)
+            ++cnt;
         return cnt;
     }
+
+    size_t bucket(const T& a) const {
+        return _index(a);
+    }
+
+    local_iterator begin(size_t n) {
+        return local_iterator(_buckets[n]);
+    }
+
+    const_local_iterator begin(size_t n) const {
+        return const_local_iterator(_buckets[n]);
+    }
+
+    local_iterator end(size_t) {
+        return local_iterator(nullptr);
+    }
+
+    const_local_iterator end(size_t) const {
+        return const_local_iterator(nullptr);
+    }
+
+    // 散列策略
+    float max_load_factor() const {
+        return _max_load;
+    }
+
+    void max_load_factor(float z) {
+        if(z <= 0)
+            return;
+        _max_load = z;
+        if(_buckets_for(_num) > _bucket_count)
+            rehash(0);
+    }
+
+    // 桶数调整为不小于n且足以在最大负载因子下容纳现有元素的素数，结点原地重新挂链
+    void rehash(size_t n) {
+        size_t need = _buckets_for(_num);
+        if(n < need)
+            n = need;
+        n = _next_bucket_prime(n);
+        if(n != _bucket_count)
+            _relink(n);
+    }
+};
+
+// 链式散列引擎（默认）：桶数组保存各条单向链表的头指针
+struct chained_hash_policy {
+    template<class T, class HashFun, class KeyEqualFun, class Allocator, bool isMulti>
+    struct rebind {
+        typedef _hashtable<T, HashFun, KeyEqualFun, Allocator, isMulti> other;
+    };
 };
 }
 
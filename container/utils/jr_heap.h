@@ -1,28 +1,60 @@
 #ifndef JR_HEAP_H
 #define JR_HEAP_H
 
+#include <cstddef>
+#include <utility>
 #include "../../iterator/jr_iterator.h"
 
 /*堆操作*/
 namespace jrSTL {
+    // 把value从hole处向上过滤，直至top
+    template< class RandomIt, class Distance, class T, class Compare >
+    void _push_heap_hole( RandomIt first, Distance hole, Distance top,
+                          T value, Compare& comp ) {
+        Distance parent = (hole - 1) / 2;
+        while(hole > top && comp(first[parent], value)) {
+            first[hole] = std::move(first[parent]);
+            hole = parent;
+            parent = (hole - 1) / 2;
+        }
+        first[hole] = std::move(value);
+    }
+
+    /* 以hole为根的子树中填入value：先让空位沿较大的儿子一路下沉到叶子（每层只比较一次），
+     * 再从叶子把value向上过滤；value通常来自堆尾，会落在靠近叶子的位置，比逐层与value比较省约一半的比较
+     */
+    template< class RandomIt, class Distance, class T, class Compare >
+    void _adjust_heap( RandomIt first, Distance hole, Distance len,
+                       T value, Compare& comp ) {
+        const Distance top = hole;
+        Distance child = hole;
+        while(child < (len - 1) / 2) {
+            child = 2 * child + 2;
+            if(comp(first[child], first[child - 1]))
+                --child;
+            first[hole] = std::move(first[child]);
+            hole = child;
+        }
+        // 最后一个父节点只有左儿子
+        if((len & 1) == 0 && child == (len - 2) / 2) {
+            child = 2 * child + 1;
+            first[hole] = std::move(first[child]);
+            hole = child;
+        }
+        jrSTL::_push_heap_hole(first, hole, top, std::move(value), comp);
+    }
+
     // 向上过滤
     template< class RandomIt, class Compare >
     void push_heap( RandomIt first, RandomIt last,
                     Compare comp ) {
-        if(first == last - 1 || first == last)
-            return;
         typedef typename jrSTL::iterator_traits<RandomIt>::value_type type;
         typedef typename jrSTL::iterator_traits<RandomIt>::difference_type dis_type;
-        RandomIt target = last - 1;
-        type target_var = *target;
-        dis_type index = jrSTL::distance(first, target);
-        dis_type parent = (index - 1) / 2;
-        while(index && comp(*(first+parent), target_var)) {
-            *(first+index) = *(first+parent);
-            index = parent;
-            parent = (index - 1) / 2;
-        }
-        *(first+index) = target_var;
+        dis_type len = last - first;
+        if(len < 2)
+            return;
+        type value = std::move(first[len - 1]);
+        jrSTL::_push_heap_hole(first, len - 1, dis_type(0), std::move(value), comp);
     }
 
     template< class RandomIt >
@@ -33,11 +65,20 @@ namespace jrSTL {
                           ->bool { return x < y; });
     }
 
+    // Floyd建堆：自最后一个父节点起逐个向下调整，总代价O(n)
     template< class RandomIt, class Compare >
     void make_heap( RandomIt first, RandomIt last, Compare comp ) {
-        RandomIt tmp = first;
-        while(tmp != last)
-            jrSTL::push_heap(first, ++tmp, comp);
+        typedef typename jrSTL::iterator_traits<RandomIt>::value_type type;
+        typedef typename jrSTL::iterator_traits<RandomIt>::difference_type dis_type;
+        dis_type len = last - first;
+        if(len < 2)
+            return;
+        for(dis_type parent = (len - 2) / 2; ; --parent) {
+            type value = std::move(first[parent]);
+            jrSTL::_adjust_heap(first, parent, len, std::move(value), comp);
+            if(parent == 0)
+                break;
+        }
     }
 
     template< class RandomIt >
@@ -48,41 +89,17 @@ namespace jrSTL {
                           ->bool { return x < y; });
     }
 
-    // 向下过滤
+    // 堆顶移到堆尾，原堆尾元素从根部向下过滤
     template< class RandomIt, class Compare >
     void pop_heap( RandomIt first, RandomIt last, Compare comp ) {
-        if(first == last - 1)
-            return;
         typedef typename jrSTL::iterator_traits<RandomIt>::value_type type;
         typedef typename jrSTL::iterator_traits<RandomIt>::difference_type dis_type;
-        RandomIt target = last - 1;
-        // 交换first与last-1位置的元素, 同时保存交换前的堆尾元素
-        // 即交换堆顶与堆尾的元素
-        type tmp = *target;
-        *target = *first;
-        *first = tmp;
-        // 上滤节点，将其调整为最大堆
-        dis_type len = jrSTL::distance(first, target);
-        dis_type parent = 0, child = parent * 2 + 1;
-        while(child < len) {
-            // 在左右儿子里找最大的那个
-            if((child < len)
-             &&(child + 1 < len)
-             && comp(first[child], first[child + 1]))
-                ++child;
-            //  父节点 < 最大的儿子
-            if(comp(first[parent], first[child])) {
-                tmp = first[parent];
-                first[parent] = first[child];
-                first[child] = tmp;
-            }
-            // 反之则说明堆已经调整好了
-            else
-                break;
-            parent = child;
-            child = parent * 2 + 1;
-        }
-        first[parent] = tmp;
+        dis_type len = last - first;
+        if(len < 2)
+            return;
+        type value = std::move(first[len - 1]);
+        first[len - 1] = std::move(*first);
+        jrSTL::_adjust_heap(first, dis_type(0), len - 1, std::move(value), comp);
     }
 
     template< class RandomIt >
@@ -108,29 +125,19 @@ namespace jrSTL {
     }
 
     template< class RandomIt, class Compare >
-    bool is_heap( RandomIt first, RandomIt last, Compare comp ) {
-        if(first == last || first == last - 1)
-            return true;
+    RandomIt is_heap_until( RandomIt first, RandomIt last, Compare comp ) {
         typedef typename jrSTL::iterator_traits<RandomIt>::difference_type dis_type;
-        dis_type len = jrSTL::distance(first, last - 1);
-        dis_type parent = 0, child = parent * 2 + 1;
-        while(child < len) {
-            if(child < len) {
-                if(comp(first[parent], first[child]))
-                    return false;
-                else {
-                    ++child;
-                    if((child < len)
-                     && comp(first[parent], first[child]))
-                        return false;
-                }
-            } else {
-                break;
-            }
-            parent++;
-            child = parent * 2 + 1;
+        dis_type len = last - first;
+        for(dis_type child = 1; child < len; ++child) {
+            if(comp(first[(child - 1) / 2], first[child]))
+                return first + child;
         }
-        return true;
+        return last;
+    }
+
+    template< class RandomIt, class Compare >
+    bool is_heap( RandomIt first, RandomIt last, Compare comp ) {
+        return jrSTL::is_heap_until(first, last, comp) == last;
     }
 
     template< class RandomIt >
@@ -141,12 +148,6 @@ namespace jrSTL {
                                ->bool { return x < y; });
     }
 
-    template< class RandomIt, class Compare >
-    RandomIt is_heap_until( RandomIt first, RandomIt last, Compare comp ) {
-        while((first != last) && jrSTL::is_heap(first, last--, comp));
-        return last;
-    }
-
     template< class RandomIt >
     RandomIt is_heap_until( RandomIt first, RandomIt last ) {
         typedef typename jrSTL::iterator_traits<RandomIt>::value_type type;
@@ -154,6 +155,151 @@ namespace jrSTL {
                                      [](const type& x, const type& y)
                                      ->bool { return x < y; });
     }
+
+    /* d叉堆：push_heap<D>/pop_heap<D>/make_heap<D>等以D为每个节点的儿子数，
+     * 节点i的儿子为D*i+1 ~ D*i+D，父节点为(i-1)/D
+     * 树高降为log_D(n)，且同一节点的儿子在内存中连续（D=8、元素为8字节时恰好一个缓存行），
+     * 向下过滤时每层只访问一个缓存行，适合pop远多于push的场景
+     * 不带D的版本即二叉堆
+     */
+    template< size_t D, class RandomIt, class Distance, class T, class Compare >
+    void _dary_push_hole( RandomIt first, Distance hole, Distance top,
+                          T value, Compare& comp ) {
+        Distance parent = (hole - 1) / static_cast<Distance>(D);
+        while(hole > top && comp(first[parent], value)) {
+            first[hole] = std::move(first[parent]);
+            hole = parent;
+            parent = (hole - 1) / static_cast<Distance>(D);
+        }
+        first[hole] = std::move(value);
+    }
+
+    // 与_adjust_heap相同：空位沿最大的儿子下沉到叶子，再把value向上过滤
+    template< size_t D, class RandomIt, class Distance, class T, class Compare >
+    void _dary_adjust_heap( RandomIt first, Distance hole, Distance len,
+                            T value, Compare& comp ) {
+        static_assert(D >= 2, "heap arity must be at least 2");
+        const Distance top = hole;
+        while(true) {
+            Distance child = static_cast<Distance>(D) * hole + 1;
+            if(child >= len)
+                break;
+            Distance end = len - child > static_cast<Distance>(D) ? child + static_cast<Distance>(D) : len;
+            Distance best = child;
+            for(++child; child < end; ++child) {
+                if(comp(first[best], first[child]))
+                    best = child;
+            }
+            first[hole] = std::move(first[best]);
+            hole = best;
+        }
+        jrSTL::_dary_push_hole<D>(first, hole, top, std::move(value), comp);
+    }
+
+    template< size_t D, class RandomIt, class Compare >
+    void push_heap( RandomIt first, RandomIt last, Compare comp ) {
+        typedef typename jrSTL::iterator_traits<RandomIt>::value_type type;
+        typedef typename jrSTL::iterator_traits<RandomIt>::difference_type dis_type;
+        dis_type len = last - first;
+        if(len < 2)
+            return;
+        type value = std::move(first[len - 1]);
+        jrSTL::_dary_push_hole<D>(first, len - 1, dis_type(0), std::move(value), comp);
+    }
+
+    template< size_t D, class RandomIt >
+    void push_heap( RandomIt first, RandomIt last ) {
+        typedef typename jrSTL::iterator_traits<RandomIt>::value_type type;
+        jrSTL::push_heap<D>(first, last,
+                             [](const type& x, const type& y)
+                             ->bool { return x < y; });
+    }
+
+    template< size_t D, class RandomIt, class Compare >
+    void make_heap( RandomIt first, RandomIt last, Compare comp ) {
+        typedef typename jrSTL::iterator_traits<RandomIt>::value_type type;
+        typedef typename jrSTL::iterator_traits<RandomIt>::difference_type dis_type;
+        dis_type len = last - first;
+        if(len < 2)
+            return;
+        for(dis_type parent = (len - 2) / static_cast<dis_type>(D); ; --parent) {
+            type value = std::move(first[parent]);
+            jrSTL::_dary_adjust_heap<D>(first, parent, len, std::move(value), comp);
+            if(parent == 0)
+                break;
+        }
+    }
+
+    template< size_t D, class RandomIt >
+    void make_heap( RandomIt first, RandomIt last ) {
+        typedef typename jrSTL::iterator_traits<RandomIt>::value_type type;
+        jrSTL::make_heap<D>(first, last,
+                             [](const type& x, const type& y)
+                             ->bool { return x < y; });
+    }
+
+    template< size_t D, class RandomIt, class Compare >
+    void pop_heap( RandomIt first, RandomIt last, Compare comp ) {
+        typedef typename jrSTL::iterator_traits<RandomIt>::value_type type;
+        typedef typename jrSTL::iterator_traits<RandomIt>::difference_type dis_type;
+        dis_type len = last - first;
+        if(len < 2)
+            return;
+        type value = std::move(first[len - 1]);
+        first[len - 1] = std::move(*first);
+        jrSTL::_dary_adjust_heap<D>(first, dis_type(0), len - 1, std::move(value), comp);
+    }
+
+    template< size_t D, class RandomIt >
+    void pop_heap( RandomIt first, RandomIt last ) {
+        typedef typename jrSTL::iterator_traits<RandomIt>::value_type type;
+        jrSTL::pop_heap<D>(first, last,
+                            [](const type& x, const type& y)
+                            ->bool { return x < y; });
+    }
+
+    template< size_t D, class RandomIt, class Compare >
+    void sort_heap( RandomIt first, RandomIt last, Compare comp ) {
+        while(last - first > 1)
+            jrSTL::pop_heap<D>(first, last--, comp);
+    }
+
+    template< size_t D, class RandomIt >
+    void sort_heap( RandomIt first, RandomIt last ) {
+        typedef typename jrSTL::iterator_traits<RandomIt>::value_type type;
+        jrSTL::sort_heap<D>(first, last,
+                             [](const type& x, const type& y)
+                             ->bool { return x < y; });
+    }
+
+    template< size_t D, class RandomIt, class Compare >
+    RandomIt is_heap_until( RandomIt first, RandomIt last, Compare comp ) {
+        typedef typename jrSTL::iterator_traits<RandomIt>::difference_type dis_type;
+        dis_type len = last - first;
+        for(dis_type child = 1; child < len; ++child) {
+            if(comp(first[(child - 1) / static_cast<dis_type>(D)], first[child]))
+                return first + child;
+        }
+        return last;
+    }
+
+    template< size_t D, class RandomIt >
+    RandomIt is_heap_until( RandomIt first, RandomIt last ) {
+        typedef typename jrSTL::iterator_traits<RandomIt>::value_type type;
+        return jrSTL::is_heap_until<D>(first, last,
+                                        [](const type& x, const type& y)
+                                        ->bool { return x < y; });
+    }
+
+    template< size_t D, class RandomIt, class Compare >
+    bool is_heap( RandomIt first, RandomIt last, Compare comp ) {
+        return jrSTL::is_heap_until<D>(first, last, comp) == last;
+    }
+
+    template< size_t D, class RandomIt >
+    bool is_heap( RandomIt first, RandomIt last ) {
+        return jrSTL::is_heap_until<D>(first, last) == last;
+    }
 }
 
 #endif // JR_HEAP_H
@@ -386,18 +386,14 @@ namespace jrSTL {
         typedef forward_iterator_tag iterator_category;
         // 自己特殊定义
         typedef _hashtable<U, Hash, KeyEqual, Allocator, isMulti> table;
-        typedef _forward_list_iterator<U, const U&, const U*> hnode;
-        size_type index;
+        typedef _forward_node<U>* hnode;
+        size_type index;  // 当前结点所在的桶，end迭代器为桶数
         const table *tab;
-        hnode cur;
+        hnode cur;  // 当前结点，end迭代器为空指针
 
         // construct iterator
-        _hashtable_iterator(table *t, size_type o, hnode n)
-            : tab(t), index(o), cur(n)
-        {}
-
         _hashtable_iterator(const table *t, size_type o, hnode n)
-            : tab(t), index(o), cur(n)
+            : index(o), tab(t), cur(n)
         {}
 
         ~_hashtable_iterator() = default;
@@ -412,7 +408,7 @@ namespace jrSTL {
         }
 
         reference operator*() const {
-            return const_cast<reference>(*cur);
+            return cur->data;
         }
 
         pointer operator->() const {
@@ -421,22 +417,10 @@ namespace jrSTL {
 
         // front postion ++
         _hashtable_iterator& operator++() {
-            ++cur;
-            // 桶内无内容，则跳至下一个桶
-            if(cur == tab->table[index].cend()) {
-                ++index;
-                while(index < tab->table.size() - 1) {
-                    if(!tab->table[index].empty()){
-                        cur = tab->table[index].cbegin();
-                        break;
-                    }
-                    ++index;
-                }
-                // 到达end迭代器
-                if(index == tab->table.size() - 1) {
-                    cur = tab->table[index].cend();
-                }
-            }
+            cur = cur->next;
+            // 桶内已无后继，则跳至下一个非空桶；全部桶都为空时到达end迭代器
+            while(!cur && ++index < tab->_bucket_count)
+                cur = tab->_buckets[index];
             return *this;
         }
 
@@ -447,6 +431,65 @@ namespace jrSTL {
             return tmp;
         }
     };
+
+    template<class T1, class T2, class T3, class T4, bool isMulti>
+    class _flat_hashtable;
+
+    template<class U, class Hash, class KeyEqual,
+             class Allocator, bool isMulti>
+    struct _flat_hashtable_iterator{
+        // 迭代器通用的类型定义
+        typedef U value_type;
+        typedef U* pointer;
+        typedef U& reference;
+        typedef size_t size_type;
+        typedef ptrdiff_t difference_type;
+        typedef forward_iterator_tag iterator_category;
+        // 自己特殊定义
+        typedef _flat_hashtable<U, Hash, KeyEqual, Allocator, isMulti> table;
+        const signed char *ctrl;  // 当前槽位的控制字节
+        U *slot;  // 当前槽位
+
+        // construct iterator
+        _flat_hashtable_iterator(const signed char *c, U *s)
+            : ctrl(c), slot(s)
+        {}
+
+        ~_flat_hashtable_iterator() = default;
+
+        // overloading ==, !=, *, ->, ++
+        bool operator==(const _flat_hashtable_iterator& x) const {
+            return ctrl == x.ctrl;
+        }
+
+        bool operator!=(const _flat_hashtable_iterator& x) const {
+            return !(*this == x);
+        }
+
+        reference operator*() const {
+            return *slot;
+        }
+
+        pointer operator->() const {
+            return slot;
+        }
+
+        // front postion ++
+        _flat_hashtable_iterator& operator++() {
+            ++ctrl;
+            ++slot;
+            // 跳过空槽与墓碑
+            table::_skip_empty_or_deleted(ctrl, slot);
+            return *this;
+        }
+
+        // post position ++
+        _flat_hashtable_iterator operator++(int) {
+            _flat_hashtable_iterator tmp(*this);
+            ++(*this);
+            return tmp;
+        }
+    };
 }
 
 #endif // ITERATORS_H
@@ -0,0 +1,114 @@
+#ifndef JR_LIST_SORT_H
+#define JR_LIST_SORT_H
+
+#include <cstddef>
+#include <new>
+#include "../../algorithm/jr_algorithm.h"
+
+/* list与forward_list共用的链表排序，只通过next指针操作以end结尾的节点链（end可以是nullptr或哨兵节点），
+ * 排序后的链同样以end结尾；双向链表的prev指针由调用者在排序后一次性修复
+ */
+namespace jrSTL {
+    /* 排序方式：
+     * list_sort_bottom_up   自底向上归并（默认），不申请内存，不递归，不寻找中点
+     * list_sort_by_pointer  把节点指针拷贝到数组中稳定排序后重新串接，比较时顺序访问指针数组，
+     *                       节点在内存中分散时缓存表现更好；需要n个指针的额外空间，申请失败时退回归并
+     */
+    struct list_sort_bottom_up {};
+    struct list_sort_by_pointer {};
+
+    // 稳定地归并两条以end结尾的有序链，相等时先取a中的节点
+    template<class Node, class Compare>
+    Node *_merge_chain(Node *a, Node *b, Node *end, Compare& comp) {
+        Node *head = end, **tail = &head;
+        while(a != end && b != end) {
+            if(comp(b->data, a->data)) {
+                *tail = b;
+                tail = &b->next;
+                b = b->next;
+            } else {
+                *tail = a;
+                tail = &a->next;
+                a = a->next;
+            }
+        }
+        *tail = a != end ? a : b;
+        return head;
+    }
+
+    /* 与libstdc++相同的桶数组归并：bin[i]为空或是长度为2^i的有序链，
+     * 每次取下一个节点作为进位，与bin[0]、bin[1]……依次归并直到遇到空桶；
+     * 64个桶足以容纳任意长度的链表，最后把各桶由低到高归并起来
+     * bin[i]中的节点总是早于进位与更低的桶，归并时放在左侧以保证稳定；不需要链的长度
+     */
+    template<class Node, class Compare>
+    Node *_list_merge_sort(Node *h, Node *end, Compare& comp) {
+        Node *bin[64];
+        int fill = 0;
+        while(h != end) {
+            Node *carry = h;
+            h = h->next;
+            carry->next = end;
+            int i = 0;
+            for(; i < fill && bin[i]; ++i) {
+                carry = jrSTL::_merge_chain(bin[i], carry, end, comp);
+                bin[i] = nullptr;
+            }
+            bin[i] = carry;
+            if(i == fill)
+                ++fill;
+        }
+        Node *result = end;
+        for(int i = 0; i < fill; ++i) {
+            if(bin[i])
+                result = jrSTL::_merge_chain(bin[i], result, end, comp);
+        }
+        return result;
+    }
+
+    template<class Node, class Compare>
+    struct _node_ptr_less {
+        Compare& comp;
+
+        bool operator()(const Node *a, const Node *b) const {
+            return comp(a->data, b->data);
+        }
+    };
+
+    // n为链的长度
+    template<class Node, class Compare>
+    Node *_list_pointer_sort(Node *h, Node *end, size_t n, Compare& comp) {
+        jrSTL::_buffer<Node *> nodes(n);
+        if(!nodes.is_valid())
+            return jrSTL::_list_merge_sort(h, end, comp);
+        for(size_t i = 0; i < n; ++i, h = h->next)
+            nodes[i] = h;
+        _node_ptr_less<Node, Compare> less = {comp};
+        jrSTL::stable_sort(&nodes[0], &nodes[0] + n, less);
+        for(size_t i = 0; i + 1 < n; ++i)
+            nodes[i]->next = nodes[i + 1];
+        nodes[n - 1]->next = end;
+        return nodes[0];
+    }
+
+    // 链的长度，只有需要n的排序方式才调用
+    template<class Node>
+    size_t _chain_length(const Node *h, const Node *end) {
+        size_t n = 0;
+        for(; h != end; h = h->next)
+            ++n;
+        return n;
+    }
+
+    template<class Node, class Compare>
+    Node *_list_sort(Node *h, Node *end, size_t, Compare& comp, list_sort_bottom_up) {
+        return jrSTL::_list_merge_sort(h, end, comp);
+    }
+
+    template<class Node, class Compare>
+    Node *_list_sort(Node *h, Node *end, size_t n, Compare& comp, list_sort_by_pointer) {
+        return jrSTL::_list_pointer_sort(h, end, n, comp);
+    }
+}
+
+#endif // JR_LIST_SORT_H
@@ -1,6 +1,8 @@
 #ifndef JR_NODES_H
 #define JR_NODES_H
 
+#include <cstddef>
+
 namespace jrSTL {
     // 单向链表节点定义
     template<class U>
@@ -26,12 +28,24 @@ namespace jrSTL {
         U data;
         _tree_node *left, *right;
         _tree_node *parent;
+        int height;  // 以该节点为根的子树高度（叶节点为1）
+        size_t size;  // 以该节点为根的子树节点个数（用于顺序统计）
         _tree_node()
             : left(nullptr),
               right(nullptr),
-              parent(nullptr)
+              parent(nullptr),
+              height(1),
+              size(1)
         {}
     };
+
+    // 配对堆节点：child指向第一个儿子，sibling指向右兄弟，
+    // prev指向左兄弟，是第一个儿子时指向父节点
+    template<class U>
+    struct _pairing_node {
+        U data;
+        _pairing_node *child, *sibling, *prev;
+    };
 }
 
 #endif // JR_NODES_H
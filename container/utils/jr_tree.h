@@ -24,23 +24,22 @@ namespace jrSTL {
         Allocator _alloc_data;
         typename Allocator::template rebind<tnode>::other _alloc_node;
 
-        // 求以r为根节点的二叉树高度（与计算平衡因子有关）
-        int _height(tnode *r) {
-            if(!r)
-                return 0;
-            int lh = _height(r->left);
-            int rh = _height(r->right);
-            return 1 + (lh > rh ? lh : rh);
+        // 求以r为根节点的二叉树高度（与计算平衡因子有关），直接读取节点中缓存的高度
+        static int _height(const tnode *r) {
+            return r ? r->height : 0;
         }
 
-        // 先序遍历计数目标元素
-        size_t _dfs(tnode *r, const T target) const {
-            if(!r)
-                return 0;
-            int cur = 0;
-            if(!comp(r->data, target) && !comp(target, r->data))
-                cur = 1;
-            return cur + _dfs(r->left, target) + _dfs(r->right, target);
+        // 以r为根的子树节点个数
+        static size_t _size(const tnode *r) {
+            return r ? r->size : 0;
+        }
+
+        // 由左右子树的缓存值重新计算r的高度与子树大小，子树结构改变后须自底向上调用
+        static void _update_node(tnode *r) {
+            int lh = _height(r->left);
+            int rh = _height(r->right);
+            r->height = 1 + (lh > rh ? lh : rh);
+            r->size = 1 + _size(r->left) + _size(r->right);
         }
 
         // 向左单向旋转, n指向不平衡节点
@@ -56,6 +55,9 @@ namespace jrSTL {
             y->parent = x;
             if(y->right)
                 y->right->parent = y;
+            // 先更新下沉的y，再更新上升的x
+            _update_node(y);
+            _update_node(x);
             // 改变子树根指向
             y = x;
         }
@@ -73,6 +75,9 @@ namespace jrSTL {
             y->parent = x;
             if(y->left)
                 y->left->parent = y;
+            // 先更新下沉的y，再更新上升的x
+            _update_node(y);
+            _update_node(x);
             // 改变子树根指向
             y = x;
         }
@@ -80,6 +85,8 @@ namespace jrSTL {
         // 将不平衡的子树调整为平衡树
         void _adjust_to_balance(tnode *&r) {
             if(r) {
+                // 子树已调整完毕，先刷新r的高度与子树大小
+                _update_node(r);
                 // 检查平衡因子，判断是否需要进行旋转
                 int balance_factor = _height(r->left) - _height(r->right);
                 // 平衡因子为2,说明以r为根的子树的左子树比右子树高2,进行相应调整
@@ -97,7 +104,7 @@ namespace jrSTL {
                 } else if(balance_factor == -2) {
                     // 若删除节点后，右子树的右子树不低于右子树的左子树，则r子树向左旋转
                     if(r->right && (_height(r->right->right)
-                                    >= _height(r->right->right)))
+                                    >= _height(r->right->left)))
                         _left_rotation(r);
                     // 若删除节点后，右子树的右子树低于右子树的左子树，则r子树右-左旋转
                     else {
@@ -165,6 +172,13 @@ namespace jrSTL {
                 b->left->parent = b;
             if(b->right)
                 b->right->parent = b;
+            // 高度与子树大小属于位置而非节点，随位置一同交换
+            int h = a->height;
+            a->height = b->height;
+            b->height = h;
+            size_t sz = a->size;
+            a->size = b->size;
+            b->size = sz;
         }
 
         // 插入节点的递归实现
@@ -176,6 +190,8 @@ namespace jrSTL {
                 r = _alloc_node.allocate(1);
                 _alloc_data.construct(&(r->data), value);
                 r->left = r->right = r->parent = nullptr;
+                r->height = 1;
+                r->size = 1;
                 ret = r;
             } else if(comp(value, r->data)) {
                 // 若插入位置在左子树，则先递归向左子树插入
@@ -209,6 +225,8 @@ namespace jrSTL {
                 _alloc_data.construct(&(r->data),
                                       static_cast<T&&>(value));
                 r->left = r->right = r->parent = nullptr;
+                r->height = 1;
+                r->size = 1;
                 ret = r;
             } else if(comp(value, r->data)) {
                 // 若插入位置在左子树，则先递归向左子树插入
@@ -236,20 +254,24 @@ namespace jrSTL {
             return ret;
         }
 
-        // 删除节点的递归实现
-        void _erase_helper(tnode*& r, const T& key,
+        /* 删除节点的递归实现，返回是否删除了节点
+         * key可能就是hint节点的数据（multiset按迭代器删除），删除之后不能再使用key
+         */
+        bool _erase_helper(tnode*& r, const T& key,
                            tnode *hint = nullptr) {
             /*普通BST删除操作*/
             if(!r)
-                return;
+                return false;
+            bool erased = true;
             if(comp(key, r->data)) {
-                _erase_helper(r->left, key, hint);
+                erased = _erase_helper(r->left, key, hint);
             } else if(comp(r->data, key)) {
-                _erase_helper(r->right, key, hint);
+                erased = _erase_helper(r->right, key, hint);
             } else {
                 if(hint && (r != hint)) {
-                    _erase_helper(r->left, key, hint);
-                    _erase_helper(r->right, key, hint);
+                    // 在左子树中找到后不再搜索右子树
+                    erased = _erase_helper(r->left, key, hint)
+                             || _erase_helper(r->right, key, hint);
                 } else {
                     if(!r->left && !r->right) {
                         // 待删除节点为叶节点, 直接删除
@@ -284,6 +306,7 @@ namespace jrSTL {
             }
             // 调整平衡
             _adjust_to_balance(r);
+            return erased;
         }
 
         // 析构每个节点的数据域，再释放每个节点所占空间
@@ -360,37 +383,101 @@ namespace jrSTL {
             return _header;
         }
 
-        // 查找，返回头指针说明目标元素不存在
-        tnode *search(const T& target) {
+        // 返回首个不小于key的节点，不存在则返回_header
+        // kc须支持kc(节点值, key)与kc(key, 节点值)两种调用，使容器可直接以键（或异构键）查找
+        template<class K, class KeyCompare>
+        tnode *lower_bound(const K& key, KeyCompare kc) const {
             tnode *tmp = _root;
+            tnode *ret = _header;
             while(tmp) {
-                if(comp(tmp->data, target)) {
+                if(kc(tmp->data, key)) {
                     tmp = tmp->right;
-                } else if(comp(target, tmp->data)) {
+                } else {
+                    ret = tmp;
                     tmp = tmp->left;
-                } else{
-                    return tmp;
                 }
             }
-            return _header;
+            return ret;
+        }
+
+        // 返回首个大于key的节点，不存在则返回_header
+        template<class K, class KeyCompare>
+        tnode *upper_bound(const K& key, KeyCompare kc) const {
+            tnode *tmp = _root;
+            tnode *ret = _header;
+            while(tmp) {
+                if(kc(key, tmp->data)) {
+                    ret = tmp;
+                    tmp = tmp->left;
+                } else {
+                    tmp = tmp->right;
+                }
+            }
+            return ret;
+        }
+
+        // 查找与key等价的首个节点，返回_header说明目标元素不存在
+        template<class K, class KeyCompare>
+        tnode *find(const K& key, KeyCompare kc) const {
+            tnode *ret = lower_bound(key, kc);
+            if(ret == _header || kc(key, ret->data))
+                return _header;
+            return ret;
         }
 
-        tnode *search(T&& target) {
+        // 小于key的元素个数，即lower_bound(key)在中序序列中的下标
+        template<class K, class KeyCompare>
+        size_t rank_lower(const K& key, KeyCompare kc) const {
+            size_t ret = 0;
             tnode *tmp = _root;
             while(tmp) {
-                if(comp(tmp->data, target)) {
+                if(kc(tmp->data, key)) {
+                    ret += _size(tmp->left) + 1;
                     tmp = tmp->right;
-                } else if(comp(target, tmp->data)) {
+                } else {
                     tmp = tmp->left;
-                } else{
-                    return tmp;
                 }
             }
-            return _header;
+            return ret;
+        }
+
+        // 不大于key的元素个数，即upper_bound(key)在中序序列中的下标
+        template<class K, class KeyCompare>
+        size_t rank_upper(const K& key, KeyCompare kc) const {
+            size_t ret = 0;
+            tnode *tmp = _root;
+            while(tmp) {
+                if(kc(key, tmp->data)) {
+                    tmp = tmp->left;
+                } else {
+                    ret += _size(tmp->left) + 1;
+                    tmp = tmp->right;
+                }
+            }
+            return ret;
         }
 
-        size_t count(const T& target) const {
-            return _dfs(_root, target);
+        // 与key等价的元素个数，两次自顶向下查找，O(log n)
+        template<class K, class KeyCompare>
+        size_t count(const K& key, KeyCompare kc) const {
+            return rank_upper(key, kc) - rank_lower(key, kc);
+        }
+
+        // 返回中序序列中下标为k的节点（从0开始），越界则返回_header
+        tnode *select(size_t k) const {
+            tnode *tmp = _root;
+            while(tmp) {
+                size_t ls = _size(tmp->left);
+                if(k < ls) {
+                    tmp = tmp->left;
+                } else if(k == ls) {
+                    return tmp;
+                } else {
+                    k -= ls + 1;
+                    tmp = tmp->right;
+                }
+            }
+            return _header;
         }
 
         tnode* get_min() const {
@@ -424,18 +511,13 @@ namespace jrSTL {
         }
 
         // 插入value到尽可能前于hint 的位置
-        tnode *insert_hint(const T& value, tnode *&hint, bool& flag) {
-            if(!comp(value, hint->data))
-                return insert(value, flag);
-            return _insert_helper(hint->left, value, flag);
+        // 直接插入hint的子树会绕过祖先节点的高度维护与再平衡，故hint仅作提示，仍从根插入
+        tnode *insert_hint(const T& value, tnode *&, bool& flag) {
+            return insert(value, flag);
         }
 
-        tnode *insert_hint(T&& value, tnode *&hint, bool& flag) {
-            if(!comp(value, hint->data))
-                return insert(static_cast<T&&>(value), flag);
-            return _insert_helper(hint->left,
-                                  static_cast<T&&>(value),
-                                  flag);
+        tnode *insert_hint(T&& value, tnode *&, bool& flag) {
+            return insert(static_cast<T&&>(value), flag);
         }
 
         // 删除值与value相等的节点,主要用于无重复键值
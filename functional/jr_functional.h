@@ -359,7 +359,7 @@ namespace jrSTL {
             }
     };
 
-    template< class T >
+    template< class T = void >
     struct less {
         protected:
             typedef T first_argument_type;
@@ -373,7 +373,18 @@ namespace jrSTL {
             }
     };
 
-    template< class T >
+    // 透明比较器：参数类型由调用时推导，关联容器据is_transparent启用异构查找
+    template< >
+    struct less<void> {
+        typedef void is_transparent;
+
+        template< class T, class U >
+        bool operator()(const T& x, const U& y) const {
+            return x < y;
+        }
+    };
+
+    template< class T = void >
     struct greater {
         protected:
             typedef T first_argument_type;
@@ -386,6 +397,16 @@ namespace jrSTL {
             }
     };
 
+    template< >
+    struct greater<void> {
+        typedef void is_transparent;
+
+        template< class T, class U >
+        bool operator()(const T& x, const U& y) const {
+            return x > y;
+        }
+    };
+
     template< class T >
     struct less_equal {
         protected:
@@ -4,6 +4,7 @@
 #include <cstddef>
 #include <utility>
 #include <iterator>
+#include <type_traits>
 
 #define USE_STD_TRAITS
 
@@ -22,6 +23,8 @@ namespace jrSTL {
     typedef std::forward_iterator_tag forward_iterator_tag;
     typedef std::bidirectional_iterator_tag bidirectional_iterator_tag;
     typedef std::random_access_iterator_tag random_access_iterator_tag;
+    /*Contiguous iterator tag (C++20), elements are adjacent in memory*/
+    struct contiguous_iterator_tag : public random_access_iterator_tag {};
 
     /*A base class, convenient for other classes to inherit*/
     template<
@@ -69,6 +72,29 @@ namespace jrSTL {
         typedef const T& reference ;
     };
 
+    /*Contiguous iterator traits, native pointers (and thus vector/array iterators) are contiguous,
+      other contiguous iterator types may specialize it*/
+    template< class Iter >
+    struct is_contiguous_iterator : std::false_type {};
+
+    template< class T >
+    struct is_contiguous_iterator<T*> : std::true_type {};
+
+    /*Iterator concept, contiguous_iterator_tag for contiguous iterators, otherwise the category*/
+    template< class Iter >
+    struct iterator_concept {
+        typedef typename std::conditional<is_contiguous_iterator<Iter>::value,
+                                          contiguous_iterator_tag,
+                                          typename iterator_traits<Iter>::iterator_category>::type type;
+    };
+
+    /*Address of the element a contiguous iterator refers to*/
+    template< class T >
+    T *_to_address(T *p) { return p; }
+
+    template< class Iter >
+    typename iterator_traits<Iter>::pointer _to_address(const Iter& it) { return &*it; }
+
     /*Reverse Iterator Adapter*/
     template< class Iter >
     class reverse_iterator
@@ -63,6 +63,21 @@ namespace jrSTL {
         void deallocate(pointer p, size_type){
              free(p);
         }
+        /* resize the space pointed by p, the old contents are moved bitwise
+         * @param: p pointer of the old space (may be null)
+         *         n number of instance x in the old space
+         *         new_n number of instance x in the new space
+         * @return: pointer of the new space
+         * ATTENTION: only for trivially relocatable types. Large blocks are
+         *            remapped by realloc (mremap) instead of being copied.
+         */
+        pointer reallocate(pointer p, size_type, size_type new_n) const {
+            pointer np = static_cast<pointer>(realloc(static_cast<void *>(p), static_cast<size_type>((new_n ? new_n : 1) * sizeof(T))));
+            if(!np){
+                throw "out of memory.";
+            }
+            return np;
+        }
         /* calculate the allocable capacity of this allocator
          * @param: void
          * @return: size_t, allocator's capacity
@@ -0,0 +1,308 @@
+#ifndef JR_POOL_ALLOCATOR_H
+#define JR_POOL_ALLOCATOR_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include "jr_allocator.h"
+
+namespace jrSTL {
+    /* 节点池与单调区域分配器
+     * 容器内部用rebind得到节点分配器时总是默认构造，不会从用户传入的分配器复制状态，
+     * 因此两种分配器都把状态放在静态的池/区域中：
+     *     pool_allocator<T>         每个被rebind到的类型各自一个定长空闲链表，单个对象的分配/释放为O(1)
+     *     arena_allocator<T, Tag>   同一Tag下所有类型共用一块单调区域，释放为空操作，由release()整体归还
+     * 池与区域的操作以自旋锁保护，可在多个线程的容器间共享
+     */
+
+    class _spin_lock {
+        private:
+            std::atomic_flag &_flag;
+
+        public:
+            explicit _spin_lock(std::atomic_flag &f) : _flag(f) {
+                while(_flag.test_and_set(std::memory_order_acquire))
+                    ;
+            }
+
+            ~_spin_lock() {
+                _flag.clear(std::memory_order_release);
+            }
+    };
+
+    /* 定长块的空闲链表，内存以slab为单位向系统申请，slab头部串成链表以便整体释放
+     * Owner只用于区分实例：大小与对齐相同的不同类型也各用一个池，release()不会波及其他类型
+     */
+    template<size_t Size, size_t Align, class Owner>
+    class _node_pool {
+        private:
+            union _slot {
+                _slot *next;
+                alignas(Align) unsigned char data[Size];
+            };
+
+            struct _slab {
+                _slab *next;
+            };
+
+            static const size_t _min_slab = 32;
+            static const size_t _max_slab = 4096;
+
+            std::atomic_flag _lock;
+            _slot *_free;
+            _slab *_slabs;
+            size_t _slab_slots;
+
+            // slab头按_slot对齐存放，其后紧跟count个_slot
+            static size_t _header_size() {
+                return (sizeof(_slab) + alignof(_slot) - 1) / alignof(_slot) * alignof(_slot);
+            }
+
+            void _refill() {
+                size_t count = _slab_slots;
+                void *raw = malloc(_header_size() + count * sizeof(_slot));
+                if(!raw)
+                    throw "out of memory.";
+                _slab *s = static_cast<_slab *>(raw);
+                s->next = _slabs;
+                _slabs = s;
+                _slot *first = reinterpret_cast<_slot *>(static_cast<char *>(raw) + _header_size());
+                for(size_t i = 0; i + 1 < count; ++i)
+                    first[i].next = first + i + 1;
+                first[count - 1].next = _free;
+                _free = first;
+                if(_slab_slots < _max_slab)
+                    _slab_slots *= 2;
+            }
+
+        public:
+            _node_pool() : _free(nullptr), _slabs(nullptr), _slab_slots(_min_slab) {
+                _lock.clear();
+            }
+
+            ~_node_pool() {
+                release();
+            }
+
+            void *allocate() {
+                _spin_lock guard(_lock);
+                if(!_free)
+                    _refill();
+                _slot *p = _free;
+                _free = p->next;
+                return p;
+            }
+
+            void deallocate(void *p) {
+                _spin_lock guard(_lock);
+                _slot *s = static_cast<_slot *>(p);
+                s->next = _free;
+                _free = s;
+            }
+
+            // 归还全部slab，调用时不得再有对象位于池中
+            void release() {
+                _spin_lock guard(_lock);
+                while(_slabs) {
+                    _slab *s = _slabs;
+                    _slabs = s->next;
+                    free(s);
+                }
+                _free = nullptr;
+                _slab_slots = _min_slab;
+            }
+
+            // 进程退出时不析构，避免静态容器晚于池析构时把节点归还到已释放的池中
+            static _node_pool& instance() {
+                static _node_pool *pool = new _node_pool;
+                return *pool;
+            }
+    };
+
+    /* 节点池分配器：单个对象从T专属的池中取出，多个对象（桶数组、vector等）仍交给malloc
+     * 使list/forward_list/map/unordered_map等的节点聚集在连续的slab中
+     */
+    template<class T>
+    class pool_allocator : public allocator<T> {
+    public:
+        typedef allocator<T> base;
+        typedef typename base::pointer pointer;
+        typedef typename base::size_type size_type;
+
+        typedef _node_pool<(sizeof(T) > sizeof(void *) ? sizeof(T) : sizeof(void *)),
+                           (alignof(T) > alignof(void *) ? alignof(T) : alignof(void *)),
+                           T> pool_type;
+
+        pool_allocator() noexcept {}
+        pool_allocator(const pool_allocator&) noexcept : base() {}
+        template<class U>
+        pool_allocator(const pool_allocator<U>&) noexcept {}
+
+        template<typename U>
+        struct rebind{
+            typedef pool_allocator<U> other;
+        };
+
+        pointer allocate(size_type n, const void *hint = 0) const {
+            if(n == 1)
+                return static_cast<pointer>(pool_type::instance().allocate());
+            return base::allocate(n, hint);
+        }
+
+        void deallocate(pointer p, size_type n) {
+            if(n == 1)
+                pool_type::instance().deallocate(p);
+            else
+                base::deallocate(p, n);
+        }
+
+        // 涉及单个对象的块来自池，不能交给realloc，改为分配、按字节复制再释放
+        pointer reallocate(pointer p, size_type n, size_type new_n) const {
+            if(n != 1 && new_n != 1)
+                return base::reallocate(p, n, new_n);
+            pointer np = allocate(new_n);
+            if(p) {
+                std::memcpy(static_cast<void *>(np), static_cast<const void *>(p),
+                            (n < new_n ? n : new_n) * sizeof(T));
+                const_cast<pool_allocator *>(this)->deallocate(p, n);
+            }
+            return np;
+        }
+
+        // 整体归还T的池中的全部内存，调用时不得再有容器使用该池
+        static void release() {
+            pool_type::instance().release();
+        }
+    };
+
+    template<class T1, class T2>
+    bool operator==(const pool_allocator<T1>&, const pool_allocator<T2>&) noexcept{
+        return true;
+    }
+    template<class T1, class T2>
+    bool operator!=(const pool_allocator<T1>&, const pool_allocator<T2>&) noexcept{
+        return false;
+    }
+
+    // 单调区域：顺序切分大块内存，单个释放为空操作，release()一次归还全部块
+    class monotonic_arena {
+        private:
+            struct _block {
+                _block *next;
+                size_t size;
+            };
+
+            static const size_t _min_block = 4096;
+
+            std::atomic_flag _lock;
+            _block *_blocks;
+            char *_cur, *_end;
+            size_t _next_size;
+            size_t _used;
+
+        public:
+            monotonic_arena() : _blocks(nullptr), _cur(nullptr), _end(nullptr),
+                                _next_size(_min_block), _used(0) {
+                _lock.clear();
+            }
+
+            monotonic_arena(const monotonic_arena&) = delete;
+            monotonic_arena& operator=(const monotonic_arena&) = delete;
+
+            ~monotonic_arena() {
+                release();
+            }
+
+            void *allocate(size_t bytes, size_t align) {
+                _spin_lock guard(_lock);
+                size_t cur = reinterpret_cast<size_t>(_cur);
+                size_t aligned = (cur + align - 1) & ~(align - 1);
+                if(!_cur || aligned + bytes > reinterpret_cast<size_t>(_end)) {
+                    // 新块至少容纳本次请求，块大小按倍数增长以摊薄malloc次数
+                    size_t need = sizeof(_block) + bytes + align;
+                    size_t size = _next_size;
+                    while(size < need)
+                        size *= 2;
+                    _block *b = static_cast<_block *>(malloc(size));
+                    if(!b)
+                        throw "out of memory.";
+                    b->next = _blocks;
+                    b->size = size;
+                    _blocks = b;
+                    _cur = reinterpret_cast<char *>(b + 1);
+                    _end = reinterpret_cast<char *>(b) + size;
+                    _next_size = size * 2;
+                    cur = reinterpret_cast<size_t>(_cur);
+                    aligned = (cur + align - 1) & ~(align - 1);
+                }
+                _cur = reinterpret_cast<char *>(aligned + bytes);
+                _used += bytes;
+                return reinterpret_cast<void *>(aligned);
+            }
+
+            // 归还全部块，调用时不得再有对象位于区域中
+            void release() {
+                _spin_lock guard(_lock);
+                while(_blocks) {
+                    _block *b = _blocks;
+                    _blocks = b->next;
+                    free(b);
+                }
+                _cur = _end = nullptr;
+                _next_size = _min_block;
+                _used = 0;
+            }
+
+            // 自上次release以来分配出去的字节数
+            size_t bytes_used() const noexcept {
+                return _used;
+            }
+    };
+
+    /* 单调区域分配器：同一Tag下的所有实例（含rebind得到的节点分配器）共用一块区域，
+     * 不同的用途以不同的Tag隔离；容器析构后以arena().release()一次释放全部节点
+     */
+    template<class T, class Tag = void>
+    class arena_allocator : public allocator<T> {
+    public:
+        typedef allocator<T> base;
+        typedef typename base::pointer pointer;
+        typedef typename base::size_type size_type;
+
+        arena_allocator() noexcept {}
+        arena_allocator(const arena_allocator&) noexcept : base() {}
+        template<class U>
+        arena_allocator(const arena_allocator<U, Tag>&) noexcept {}
+
+        template<typename U>
+        struct rebind{
+            typedef arena_allocator<U, Tag> other;
+        };
+
+        static monotonic_arena& arena() {
+            static monotonic_arena *a = new monotonic_arena;
+            return *a;
+        }
+
+        pointer allocate(size_type n, const void * = 0) const {
+            return static_cast<pointer>(arena().allocate(n * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(pointer, size_type) {}
+
+        // 区域中的块不能交给realloc，屏蔽基类的reallocate，扩容时分配新块并逐个搬移
+        pointer reallocate(pointer, size_type, size_type) const = delete;
+    };
+
+    template<class T1, class T2, class Tag>
+    bool operator==(const arena_allocator<T1, Tag>&, const arena_allocator<T2, Tag>&) noexcept{
+        return true;
+    }
+    template<class T1, class T2, class Tag>
+    bool operator!=(const arena_allocator<T1, Tag>&, const arena_allocator<T2, Tag>&) noexcept{
+        return false;
+    }
+}
+
+#endif // JR_POOL_ALLOCATOR_H
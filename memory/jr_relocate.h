@@ -0,0 +1,106 @@
+#ifndef JR_RELOCATE_H
+#define JR_RELOCATE_H
+
+#include <cstddef>
+#include <cstring>
+#include <utility>
+#include <type_traits>
+
+namespace jrSTL {
+    /* 可平凡重定位：对象可按字节搬到新地址，旧地址上的对象无需析构即可丢弃
+     * 默认仅平凡可复制类型满足；对不持有自身地址的用户类型，可特化为true_type开启该优化：
+     *     template<> struct jrSTL::is_trivially_relocatable<Record> : std::true_type {};
+     */
+    template<class T>
+    struct is_trivially_relocatable
+        : std::integral_constant<bool, std::is_trivially_copyable<T>::value> {};
+
+    // 检测分配器是否提供reallocate(p, n, new_n)，提供时可原地扩展或由realloc/mremap整体搬移
+    template<class Alloc>
+    class _has_reallocate {
+        private:
+            template<class A>
+            static auto _test(int)
+                -> decltype(std::declval<A&>().reallocate(
+                                std::declval<typename A::pointer>(), size_t(), size_t()),
+                            std::true_type());
+
+            template<class A>
+            static std::false_type _test(...);
+
+        public:
+            static const bool value = decltype(_test<Alloc>(0))::value;
+    };
+
+    // 平凡重定位：一次memcpy搬移全部对象
+    template<class T, class Alloc>
+    T *_relocate(T *first, T *last, T *dest, Alloc&, std::true_type) {
+        size_t n = static_cast<size_t>(last - first);
+        if(n)
+            std::memcpy(static_cast<void *>(dest), static_cast<const void *>(first), n * sizeof(T));
+        return dest + n;
+    }
+
+    // 非平凡重定位：移动构造不抛异常（或不可复制）时逐个移动，否则逐个复制以保证强异常安全；
+    // 全部构造成功后才析构源对象
+    template<class T, class Alloc>
+    T *_relocate(T *first, T *last, T *dest, Alloc& a, std::false_type) {
+        T *cur = dest;
+        try {
+            for(T *p = first; p != last; ++p, ++cur)
+                a.construct(cur, std::move_if_noexcept(*p));
+        } catch(...) {
+            for(T *p = dest; p != cur; ++p)
+                a.destroy(p);
+            throw;
+        }
+        for(T *p = first; p != last; ++p)
+            a.destroy(p);
+        return cur;
+    }
+
+    // 将[first, last)中的对象重定位至dest起始的未初始化内存，返回新区间的尾
+    template<class T, class Alloc>
+    T *_relocate(T *first, T *last, T *dest, Alloc& a) {
+        return _relocate(first, last, dest, a,
+                         std::integral_constant<bool, is_trivially_relocatable<T>::value>());
+    }
+
+    // 分配器支持reallocate且元素可平凡重定位时，直接调整原内存块大小
+    template<class T, class Alloc>
+    T *_reallocate_storage(T *p, size_t n, size_t old_cap, size_t new_cap,
+                           Alloc& a, std::true_type) {
+        (void)n;
+        return a.reallocate(p, old_cap, new_cap);
+    }
+
+    // 否则分配新内存、重定位全部元素后释放旧内存
+    template<class T, class Alloc>
+    T *_reallocate_storage(T *p, size_t n, size_t old_cap, size_t new_cap,
+                           Alloc& a, std::false_type) {
+        T *np = a.allocate(new_cap);
+        try {
+            _relocate(p, p + n, np, a);
+        } catch(...) {
+            a.deallocate(np, new_cap);
+            throw;
+        }
+        if(p)
+            a.deallocate(p, old_cap);
+        return np;
+    }
+
+    /* 将容量为old_cap、前n个位置存有对象的内存p调整为new_cap个元素大小，返回新内存
+     * 元素按字节搬移时不调用任何构造/析构函数；
+     * 非平凡类型在移动构造不抛异常时逐个移动，否则逐个复制
+     */
+    template<class T, class Alloc>
+    T *_reallocate_storage(T *p, size_t n, size_t old_cap, size_t new_cap, Alloc& a) {
+        return _reallocate_storage(p, n, old_cap, new_cap, a,
+                                   std::integral_constant<bool,
+                                       is_trivially_relocatable<T>::value
+                                       && _has_reallocate<Alloc>::value>());
+    }
+}
+
+#endif // JR_RELOCATE_H
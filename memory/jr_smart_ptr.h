@@ -2,9 +2,16 @@
 #define JR_SMART_PTR_H
 
 #include <cstddef>
+#include <cstdint>
 #include <utility>
 #include <fstream>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
 #include <type_traits>
+#include <typeinfo>
 #include "jr_allocator.h"
 
 namespace jrSTL {
@@ -437,154 +444,258 @@ namespace jrSTL {
     template< class T >
     class weak_ptr;
 
-    // 类型擦除（采用多态实现的类型擦除）实现不依赖模板参数存储删除器与分配器
-    struct _shared_deleter_base {
-        virtual void delete_fun(void*) = 0;
+    /* 引用计数策略：默认使用原子计数，shared_ptr可以在线程间自由拷贝、销毁；
+     * 定义宏JRSTL_SHARED_PTR_SINGLE_THREADED后改用普通整数计数，只在单线程中使用时省去原子操作的开销
+     */
+    struct _atomic_count_policy {
+        typedef std::atomic<long> count_type;
 
-        virtual ~_shared_deleter_base() {}
+        static long load(const count_type& c) {
+            return c.load(std::memory_order_relaxed);
+        }
+
+        // 增加计数的线程必然已经持有一个引用，不需要同步
+        static void increment(count_type& c) {
+            c.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /* 返回减一后的值：释放语义保证此前对对象的访问先于析构，
+         * 获取语义使减到0的线程看到其他持有者对对象的全部写入
+         */
+        static long decrement(count_type& c) {
+            return c.fetch_sub(1, std::memory_order_acq_rel) - 1;
+        }
+
+        // 计数不为0时加一，用于weak_ptr提升为shared_ptr；计数一旦为0对象即已析构，不能再复活
+        static bool increment_if_nonzero(count_type& c) {
+            long n = c.load(std::memory_order_relaxed);
+            while(n != 0) {
+                if(c.compare_exchange_weak(n, n + 1,
+                                           std::memory_order_acq_rel,
+                                           std::memory_order_relaxed))
+                    return true;
+            }
+            return false;
+        }
     };
 
-    template< class Y, class Deleter >
-    struct _shared_deleter
-            : public _shared_deleter_base {
-        Deleter _d;
+    struct _single_thread_count_policy {
+        typedef long count_type;
 
-        _shared_deleter(Deleter d) : _d(d) {}
+        static long load(const count_type& c) {
+            return c;
+        }
+
+        static void increment(count_type& c) {
+            ++c;
+        }
 
-        virtual void delete_fun(void* ptr) {
-            _d(static_cast<Y*>(ptr));
+        static long decrement(count_type& c) {
+            return --c;
+        }
+
+        static bool increment_if_nonzero(count_type& c) {
+            if(c == 0)
+                return false;
+            ++c;
+            return true;
         }
     };
 
-    // shared_ptr计数器
+#ifdef JRSTL_SHARED_PTR_SINGLE_THREADED
+    typedef _single_thread_count_policy _default_count_policy;
+#else
+    typedef _atomic_count_policy _default_count_policy;
+#endif
+
+    /* shared_ptr计数器
+     * 全部shared_ptr合起来在弱引用计数中只占1，由最后一个shared_ptr在析构对象后释放，
+     * 因此弱引用计数减到0的线程就是最后一个使用控制块的线程，可以直接删除控制块
+     */
+    template< class Policy >
     struct _shared_count {
-        int _strong_count, _weak_count;
+        typename Policy::count_type _strong_count, _weak_count;
 
+        // 创建时即被一个shared_ptr持有
         _shared_count()
-            : _strong_count(0),
-              _weak_count(0)
+            : _strong_count(1),
+              _weak_count(1)
         {}
 
         // 获取强引用计数
-        int use_count() const {
-            return _strong_count;
+        long use_count() const {
+            return Policy::load(_strong_count);
         }
 
-        // 获取弱引用计数
-        int weak_count() const {
-            return _weak_count;
+        // 获取弱引用计数（不含shared_ptr占用的1）
+        long weak_count() const {
+            return Policy::load(_weak_count) - (use_count() != 0);
         }
 
-        // 改变引用计数
+        // 改变引用计数，减少计数时返回是否已减到0
         void add_strong_cnt() {
-            ++_strong_count;
+            Policy::increment(_strong_count);
+        }
+
+        bool add_strong_cnt_if_nonzero() {
+            return Policy::increment_if_nonzero(_strong_count);
         }
 
         void add_weak_cnt() {
-            ++_weak_count;
+            Policy::increment(_weak_count);
         }
 
-        void decrease_strong_cnt() {
-            --_strong_count;
+        bool decrease_strong_cnt() {
+            return Policy::decrement(_strong_count) == 0;
         }
 
-        void decrease_weak_cnt() {
-            --_weak_count;
+        bool decrease_weak_cnt() {
+            return Policy::decrement(_weak_count) == 0;
         }
     };
 
-    // shared_ptr控制块(存放引用计数，删除器与分配器)
+    /* shared_ptr控制块(存放引用计数，删除器与分配器)
+     * 计数直接存放在基类中，增减计数不经过虚函数；只有析构对象、释放控制块这两个
+     * 每个对象各一次的操作需要类型擦除
+     */
     struct _control_block_base {
+        _shared_count<_default_count_policy> _cnt;
+
         // 获取强引用计数
-        virtual int use_count() const = 0;
+        long use_count() const {
+            return _cnt.use_count();
+        }
 
         // 获取弱引用计数
-        virtual int weak_count() const = 0;
+        long weak_count() const {
+            return _cnt.weak_count();
+        }
 
         // 改变引用计数
-        virtual void add_strong_cnt() = 0;
+        void add_strong_cnt() {
+            _cnt.add_strong_cnt();
+        }
 
-        virtual void add_weak_cnt() = 0;
+        bool add_strong_cnt_if_nonzero() {
+            return _cnt.add_strong_cnt_if_nonzero();
+        }
 
-        virtual void decrease_strong_cnt() = 0;
+        void add_weak_cnt() {
+            _cnt.add_weak_cnt();
+        }
 
-        virtual void decrease_weak_cnt() = 0;
+        // 释放一个强引用，最后一个强引用析构对象并释放全部shared_ptr共同占用的弱引用
+        void release_strong() {
+            if(_cnt.decrease_strong_cnt()) {
+                delete_fun();
+                release_weak();
+            }
+        }
+
+        void release_weak() {
+            if(_cnt.decrease_weak_cnt())
+                destroy();
+        }
 
-        // 删除器操作
-        virtual void delete_fun(void *ptr) = 0;
+        // 用删除器析构所管理的对象
+        virtual void delete_fun() = 0;
+
+        // 析构并释放控制块本身
+        virtual void destroy() = 0;
+
+        // 删除器类型为ti时返回其地址，供get_deleter使用
+        virtual void *_get_deleter(const std::type_info&) {
+            return nullptr;
+        }
 
         virtual ~_control_block_base() {}
     };
 
-    template< class T >
+    /* 由指针构造时使用的控制块，计数与删除器在同一次分配中，由Alloc分配
+     * 控制块记录创建时的指针，保证析构的总是原对象，而不是别名构造或类型转换后得到的指针
+     */
+    template< class Y, class Deleter, class Alloc >
     struct _control_block
             : public _control_block_base {
+            typedef typename Alloc::template rebind<_control_block>::other _block_alloc;
 
-            _shared_count *_cnt;
-            _shared_deleter_base *_deleter;
-
-            _control_block()
-                : _cnt(new _shared_count()),
-                  _deleter(new _shared_deleter<T, jrSTL::default_delete<T> >(jrSTL::default_delete<T>()))
-            {}
-
-            _control_block(_shared_count *cnt)
-                : _cnt(cnt),
-                  _deleter(new _shared_deleter<T, jrSTL::default_delete<T> >(jrSTL::default_delete<T>()))
-            {}
-
-            template< class Deleter>
-            _control_block(Deleter d, int)
-                : _cnt(new _shared_count()),
-                  _deleter(new _shared_deleter< T, Deleter >(d))
-            {}
+            Y *_p;
+            Deleter _d;
+            Alloc _alloc;
 
-            template< class Deleter, class Alloc >
-            _control_block(Deleter d, Alloc)
-                : _cnt(new _shared_count()),
-                  _deleter(new _shared_deleter< T, Deleter >(d))
+            _control_block(Y *p, Deleter d, const Alloc& alloc)
+                : _p(p),
+                  _d(d),
+                  _alloc(alloc)
             {}
 
-            ~_control_block() {
-                if(_cnt)
-                    delete _cnt;
-                if(_deleter)
-                    delete _deleter;
+            virtual void delete_fun() {
+                _d(_p);
             }
 
-            // 获取强引用计数
-            virtual int use_count() const {
-                return _cnt->use_count();
+            virtual void destroy() {
+                _block_alloc a(_alloc);
+                this->~_control_block();
+                a.deallocate(this, 1);
             }
 
-            // 获取弱引用计数
-            virtual int weak_count() const {
-                return _cnt->weak_count();
+            virtual void *_get_deleter(const std::type_info& ti) {
+                return ti == typeid(Deleter) ? &_d : nullptr;
             }
+    };
 
-            // 改变引用计数
-            virtual void add_strong_cnt() {
-                _cnt->add_strong_cnt();
-            }
+    // 分配失败时不调用删除器，由调用者决定是否释放p
+    template< class Y, class Deleter, class Alloc >
+    _control_block_base *_new_control_block(Y *p, Deleter& d, const Alloc& alloc) {
+        typedef _control_block<Y, Deleter, Alloc> block;
+        typename block::_block_alloc a(alloc);
+        block *b = a.allocate(1);
+        try {
+            ::new(static_cast<void*>(b)) block(p, d, alloc);
+        } catch(...) {
+            a.deallocate(b, 1);
+            throw;
+        }
+        return b;
+    }
+
+    // 不指定分配器时控制块的分配器，使用时再rebind到具体的控制块类型
+    typedef jrSTL::allocator<_control_block_base> _default_block_alloc;
+
+    /* make_shared、allocate_shared使用的控制块：对象就地存放在计数之后，
+     * 对象、计数只占用一次分配，析构对象与释放内存都使用Alloc
+     */
+    template< class T, class Alloc >
+    struct _inplace_control_block
+            : public _control_block_base {
+            typedef typename Alloc::template rebind<_inplace_control_block>::other _block_alloc;
 
-            virtual void add_weak_cnt() {
-                _cnt->add_weak_cnt();
+            Alloc _alloc;
+            typename std::aligned_storage<sizeof(T), alignof(T)>::type _storage;
+
+            template< class... Args >
+            explicit _inplace_control_block(const Alloc& alloc, Args&&... args)
+                : _alloc(alloc) {
+                _alloc.construct(ptr(), std::forward<Args>(args)...);
             }
 
-            virtual void decrease_strong_cnt() {
-                _cnt->decrease_strong_cnt();
+            T *ptr() {
+                return static_cast<T*>(static_cast<void*>(&_storage));
             }
 
-            virtual void decrease_weak_cnt() {
-                _cnt->decrease_weak_cnt();
+            virtual void delete_fun() {
+                _alloc.destroy(ptr());
             }
 
-            // 删除器操作
-            virtual void delete_fun(void *ptr) {
-                _deleter->delete_fun(ptr);
+            virtual void destroy() {
+                _block_alloc a(_alloc);
+                this->~_inplace_control_block();
+                a.deallocate(this, 1);
             }
     };
 
+    struct _sp_atomic;
+
     // shaered_ptr本体
     template< class T >
     class shared_ptr {
@@ -598,6 +709,11 @@ namespace jrSTL {
         template< class U >
         friend class weak_ptr;
 
+        template< class U, class Alloc, class... Args >
+        friend shared_ptr<U> allocate_shared( const Alloc& alloc, Args&&... args );
+
+        friend struct _sp_atomic;
+
         public:
             typedef T element_type;
 
@@ -605,26 +721,40 @@ namespace jrSTL {
             element_type *_ptr;
             _control_block_base *_cb;
 
-            void _delete_object() {
-                if(!_ptr)
-                    return;
-                _cb->delete_fun(_ptr);
+            void _drop_strong_count() {
+                if(_cb)
+                    _cb->release_strong();
+                _cb = nullptr;
                 _ptr = nullptr;
             }
 
-            void _delete_control_block() {
-                delete _cb;
-                _cb = nullptr;
+            // 接管p，控制块分配失败时用删除器释放p
+            template< class Y, class Deleter, class Alloc >
+            void _own( Y *p, Deleter& d, const Alloc& alloc ) {
+                try {
+                    _cb = jrSTL::_new_control_block(p, d, alloc);
+                } catch(...) {
+                    d(p);
+                    throw;
+                }
             }
 
-            void _drop_strong_count() {
-                if(!_cb)
-                    return;
-                _cb->decrease_strong_cnt();
-                if(!use_count()) {
-                    _delete_object();
-                    if(!_cb->weak_count())
-                        _delete_control_block();
+            struct _adopt_tag {};
+
+            // allocate_shared使用：接管已持有一个强引用的控制块
+            shared_ptr( _control_block_base *cb, element_type *ptr, _adopt_tag ) noexcept
+                : _ptr(ptr),
+                  _cb(cb)
+            {}
+
+            // weak_ptr::lock使用：对象已析构时得到空指针而不抛出异常
+            template< class Y >
+            shared_ptr( const jrSTL::weak_ptr<Y>& r, std::nothrow_t ) noexcept
+                : _ptr(nullptr),
+                  _cb(nullptr) {
+                if(r._cb && r._cb->add_strong_cnt_if_nonzero()) {
+                    _cb = r._cb;
+                    _ptr = static_cast<element_type*>(r._ptr);
                 }
             }
 
@@ -642,28 +772,30 @@ namespace jrSTL {
             template< class Y >
             explicit shared_ptr( Y* ptr )
                 : _ptr(static_cast<element_type*>(ptr)),
-                  _cb(new _control_block<element_type>()) {
-                _cb->add_strong_cnt();
+                  _cb(nullptr) {
+                jrSTL::default_delete<Y> d;
+                _own(ptr, d, _default_block_alloc());
             }
 
             template< class Y, class Deleter >
             shared_ptr( Y *ptr, Deleter d )
                 : _ptr(static_cast<element_type*>(ptr)),
-                  _cb(new _control_block<element_type>(d, 0)) {
-                _cb->add_strong_cnt();
+                  _cb(nullptr) {
+                _own(ptr, d, _default_block_alloc());
             }
 
             template< class Deleter >
             shared_ptr( std::nullptr_t ptr, Deleter d )
                 : _ptr(ptr),
-                  _cb(new _control_block<T>(d, 0))
-            {}
+                  _cb(nullptr) {
+                _own(_ptr, d, _default_block_alloc());
+            }
 
             template< class Y, class Deleter, class Alloc >
             shared_ptr( Y *ptr, Deleter d, Alloc alloc )
                 : _ptr(static_cast<element_type*>(ptr)),
-                  _cb(new _control_block<element_type>(d, alloc)) {
-                _cb->add_strong_cnt();
+                  _cb(nullptr) {
+                _own(ptr, d, alloc);
             }
 
             template< class Deleter, class Alloc >
@@ -671,35 +803,40 @@ namespace jrSTL {
                         Deleter d,
                         Alloc alloc )
                 : _ptr(ptr),
-                  _cb(new _control_block<element_type>(d, alloc))
-            {}
+                  _cb(nullptr) {
+                _own(_ptr, d, alloc);
+            }
 
             template< class Y >
             shared_ptr( const shared_ptr<Y>& r,
                         element_type* ptr ) noexcept
                 : _ptr(ptr),
                   _cb(r._cb) {
-                _cb->add_strong_cnt();
+                if(_cb)
+                    _cb->add_strong_cnt();
             }
 
             shared_ptr( const shared_ptr& r ) noexcept
                 : _ptr(r.get()),
                   _cb(r._cb) {
-                _cb->add_strong_cnt();
+                if(_cb)
+                    _cb->add_strong_cnt();
             }
 
             template< class Y >
             shared_ptr( const shared_ptr<Y>& r ) noexcept
                 : _ptr(static_cast<element_type*>(r.get())),
                   _cb(r._cb) {
-                _cb->add_strong_cnt();
+                if(_cb)
+                    _cb->add_strong_cnt();
             }
 
+            // 移动不改变引用计数，被移动的指针置空
             shared_ptr( shared_ptr&& r ) noexcept
                 : _ptr(r.get()),
                   _cb(r._cb) {
                 r._ptr = nullptr;
-                r._cb = new _control_block<element_type>();
+                r._cb = nullptr;
             }
 
             template< class Y >
@@ -707,80 +844,55 @@ namespace jrSTL {
                 : _ptr(static_cast<element_type*>(r.get())),
                   _cb(r._cb) {
                 r._ptr = nullptr;
-                r._cb = new _control_block<Y>();
+                r._cb = nullptr;
             }
 
+            // 对象已析构时抛出bad_weak_ptr
             template< class Y >
             explicit shared_ptr( const jrSTL::weak_ptr<Y>& r )
-                : _ptr(static_cast<element_type*>(r._ptr)),
-                  _cb(r._cb) {
-                if(_cb)
-                    _cb->add_strong_cnt();
+                : shared_ptr(r, std::nothrow) {
+                if(!_cb)
+                    throw std::bad_weak_ptr();
             }
 
             template< class Y, class Deleter >
             shared_ptr( jrSTL::unique_ptr<Y, Deleter>&& r )
-                : _ptr(static_cast<element_type*>(r.release())),
-                  _cb(new _control_block<element_type>(r.get_deleter(), 0)) {
-                _cb->add_strong_cnt();
+                : _ptr(static_cast<element_type*>(r.get())),
+                  _cb(jrSTL::_new_control_block(r.get(), r.get_deleter(),
+                                                _default_block_alloc())) {
+                r.release();
             }
 
             ~shared_ptr() {
                 _drop_strong_count();
             }
 
+            // 赋值均先构造临时对象再交换，先增加新对象的计数、后释放旧对象，自赋值也安全
             shared_ptr& operator=( const shared_ptr& r ) noexcept {
-                if(this != &r) {
-                    _ptr = r.get();
-                    _drop_strong_count();
-                    _cb = r._cb;
-                    _cb->add_strong_cnt();
-                }
+                shared_ptr(r).swap(*this);
                 return *this;
             }
 
             template< class Y >
             shared_ptr& operator=( const shared_ptr<Y>& r ) noexcept {
-                if(std::is_same<T, Y>::value) {
-                    _ptr = static_cast<element_type*>(r.get());
-                    _drop_strong_count();
-                    _cb = r._cb;
-                    _cb->add_strong_cnt();
-                }
+                shared_ptr(r).swap(*this);
                 return *this;
             }
 
             shared_ptr& operator=( shared_ptr&& r ) noexcept {
-                if(this != &r) {
-                    _ptr = r.get();
-                    _drop_strong_count();
-                    _cb = r._cb;
-                    r._ptr = nullptr;
-                    r._cb = new _control_block<element_type>();
-                }
+                shared_ptr(std::move(r)).swap(*this);
                 return *this;
             }
 
             template< class Y >
             shared_ptr& operator=( shared_ptr<Y>&& r ) noexcept {
-                if(std::is_same<T, Y>::value) {
-                    _ptr = static_cast<element_type*>(r.get());
-                    _drop_strong_count();
-                    _cb = r._cb;
-                    r._ptr = nullptr;
-                    r._cb = new _control_block<Y>();
-                }
+                shared_ptr(std::move(r)).swap(*this);
                 return *this;
             }
 
             template< class Y, class Deleter >
             shared_ptr& operator=( jrSTL::unique_ptr<Y, Deleter>&& r ) {
-                if(std::is_same<T, Y>::value) {
-                    _ptr = static_cast<element_type*>(r.release());
-                    _drop_strong_count();
-                    _cb = new _control_block<Y>(r.get_deleter());
-                    _cb->add_strong_cnt();
-                }
+                shared_ptr(std::move(r)).swap(*this);
                 return *this;
             }
 
@@ -790,26 +902,17 @@ namespace jrSTL {
 
             template< class Y >
             void reset( Y* ptr ) {
-                _drop_strong_count();
-                _ptr = static_cast<element_type*>(ptr);
-                _cb = new _control_block<Y>();
-                _cb->add_strong_cnt();
+                shared_ptr(ptr).swap(*this);
             }
 
             template< class Y, class Deleter >
             void reset( Y* ptr, Deleter d ) {
-                _drop_strong_count();
-                _ptr = static_cast<element_type*>(ptr);
-                _cb = new _control_block<Y>(d,0);
-                _cb->add_strong_cnt();
+                shared_ptr(ptr, d).swap(*this);
             }
 
             template< class Y, class Deleter, class Alloc >
             void reset( Y* ptr, Deleter d, Alloc alloc ) {
-                _drop_strong_count();
-                _ptr = static_cast<element_type*>(ptr);
-                _cb = new _control_block<Y>(d, alloc);
-                _cb->add_strong_cnt();
+                shared_ptr(ptr, d, alloc).swap(*this);
             }
 
             T* get() const noexcept {
@@ -824,7 +927,7 @@ namespace jrSTL {
                 }
 
                 {
-                    _control_block<T> *sc = _cb;
+                    _control_block_base *sc = _cb;
                     _cb = r._cb;
                     r._cb = sc;
                 }
@@ -839,7 +942,7 @@ namespace jrSTL {
             }
 
             long use_count() const noexcept {
-                return _cb->use_count();
+                return _cb ? _cb->use_count() : 0;
             }
 
             bool unique() const noexcept {
@@ -864,19 +967,23 @@ namespace jrSTL {
     template< class T, class Alloc, class... Args >
     shared_ptr<T> allocate_shared( const Alloc& alloc,
                                    Args&&... args ) {
-        T *p = alloc.allocate(1);
-        alloc.construct(p, std::forward<Args>(args)...);
-        return shared_ptr<T>(p);
+        typedef _inplace_control_block<T, Alloc> block;
+        typename block::_block_alloc a(alloc);
+        block *b = a.allocate(1);
+        try {
+            ::new(static_cast<void*>(b)) block(alloc, std::forward<Args>(args)...);
+        } catch(...) {
+            a.deallocate(b, 1);
+            throw;
+        }
+        return shared_ptr<T>(static_cast<_control_block_base*>(b), b->ptr(),
+                             typename shared_ptr<T>::_adopt_tag());
     }
 
     template< class T, class... Args >
     shared_ptr<T> make_shared( Args&&... args ) {
-        auto a = jrSTL::allocator<T>();
-        return allocate_shared< T,
-                                jrSTL::allocator<T>,
-                                Args...
-                              >(a,
-                                std::forward<Args>(args)...);
+        return jrSTL::allocate_shared<T>(jrSTL::allocator<typename std::remove_cv<T>::type>(),
+                                         std::forward<Args>(args)...);
     }
 
     template< class T, class U >
@@ -896,9 +1003,344 @@ namespace jrSTL {
 
     template< class Deleter, class T >
     Deleter* get_deleter( const shared_ptr<T>& p ) noexcept {
-        return p._cb->_deleter;
+        return p._cb ? static_cast<Deleter*>(p._cb->_get_deleter(typeid(Deleter)))
+                     : nullptr;
     }
 
+    /*==============shared ptr原子操作==============*/
+    /* 对同一个shared_ptr对象的原子操作，x86-64上不使用全局锁：
+     * _cb字段的高16位作为读者计数，最低位作为写者标记（控制块至少8字节对齐）
+     * 读者对该字计数加一即钉住当前的(_ptr, _cb)，增加强引用计数后再减一，读者之间互不等待；
+     * 写者先置写者标记阻止新的读者进入，等正在读取的少数几条指令完成（读者计数归0）后再替换两个字段，
+     * 被替换下的旧值在清除标记之后才释放，对象的析构不会发生在临界区内
+     * 这要求控制块地址只用到低48位：x86-64用户态地址在4级页表下不超过47位，5级页表（LA57）下
+     * 内核也只在mmap显式给出高位提示时才返回更高的地址；写入前检查新的控制块，不满足时抛出异常而不写入
+     * 其他平台（如arm64的top-byte标记、MTE）以及HWASan下指针高位带有标记，改用按地址分段的互斥锁，
+     * 定义JRSTL_ATOMIC_SHARED_PTR_NO_PACKING也可以在x86-64上强制使用互斥锁
+     */
+#if !defined(JRSTL_ATOMIC_SHARED_PTR_NO_PACKING) && defined(__x86_64__) && !defined(__SANITIZE_HWADDRESS__)
+#define JRSTL_ATOMIC_SHARED_PTR_PACKED
+#endif
+#if defined(JRSTL_ATOMIC_SHARED_PTR_PACKED) && defined(__has_feature)
+#if __has_feature(hwaddress_sanitizer)
+#undef JRSTL_ATOMIC_SHARED_PTR_PACKED
+#endif
+#endif
+
+#ifdef JRSTL_ATOMIC_SHARED_PTR_PACKED
+    struct _sp_atomic {
+        static_assert(sizeof(void*) == 8, "jrSTL atomic shared_ptr requires 64-bit pointers");
+
+        static const uintptr_t _writer = 1;
+        static const uintptr_t _reader = uintptr_t(1) << 48;
+        static const uintptr_t _cb_mask = (uintptr_t(1) << 48) - 1 - _writer;
+
+        static uintptr_t _word(_control_block_base *cb) {
+            return reinterpret_cast<uintptr_t>(cb);
+        }
+
+        static _control_block_base *_cb(uintptr_t w) {
+            return reinterpret_cast<_control_block_base*>(w & _cb_mask);
+        }
+
+        // 控制块地址的高16位为0时才能与读者计数共用一个字
+        static bool _packable(_control_block_base *cb) {
+            return (_word(cb) & ~_cb_mask & ~_writer) == 0;
+        }
+
+        static void _check_packable(_control_block_base *cb) {
+            if(!_packable(cb))
+                throw "atomic shared_ptr: control block address exceeds 48 bits.";
+        }
+        // __atomic内建函数对指针对象按字节（即uintptr_t）运算
+        static uintptr_t _fetch_add(_control_block_base **slot, uintptr_t v) {
+            return _word(__atomic_fetch_add(slot, v, __ATOMIC_SEQ_CST));
+        }
+
+        static uintptr_t _fetch_sub(_control_block_base **slot, uintptr_t v) {
+            return _word(__atomic_fetch_sub(slot, v, __ATOMIC_SEQ_CST));
+        }
+
+        static uintptr_t _load(_control_block_base **slot) {
+            return _word(__atomic_load_n(slot, __ATOMIC_ACQUIRE));
+        }
+
+        // 取得写者标记并等待读者离开，返回当前的控制块
+        static _control_block_base *_lock(_control_block_base **slot) {
+            uintptr_t w = _load(slot);
+            while(true) {
+                if(!(w & _writer)) {
+                    _control_block_base *expected = reinterpret_cast<_control_block_base*>(w);
+                    if(__atomic_compare_exchange_n(slot, &expected,
+                                                   reinterpret_cast<_control_block_base*>(w | _writer),
+                                                   true, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+                        break;
+                    w = _word(expected);
+                } else {
+                    std::this_thread::yield();
+                    w = _load(slot);
+                }
+            }
+            while(_load(slot) >= _reader)
+                std::this_thread::yield();
+            return _cb(w);
+        }
+
+        /* 写入新的控制块，同时清除写者标记；不能整字写入：
+         * 持有标记期间仍可能有读者加上计数、看到标记后再减去，整字写入会清掉这部分计数，
+         * 之后读者的减一使计数回绕，所有写者都将永远等待。持有标记时低48位恰为old | _writer，
+         * 只对低位加上差值即可保留高位的读者计数（结果的低位为new，不会向高位进位或借位）
+         */
+        static void _unlock(_control_block_base **slot, _control_block_base *old_cb,
+                            _control_block_base *new_cb) {
+            _fetch_add(slot, _word(new_cb) - (_word(old_cb) | _writer));
+        }
+
+        template< class T >
+        static shared_ptr<T> load(const shared_ptr<T> *p) {
+            _control_block_base **slot = const_cast<_control_block_base**>(&p->_cb);
+            uintptr_t w;
+            while(true) {
+                w = _fetch_add(slot, _reader);
+                if(!(w & _writer))
+                    break;
+                // 写者正在替换，退出后等待其完成
+                _fetch_sub(slot, _reader);
+                while(_load(slot) & _writer)
+                    std::this_thread::yield();
+            }
+            _control_block_base *cb = _cb(w);
+            T *ptr = __atomic_load_n(&p->_ptr, __ATOMIC_RELAXED);
+            if(cb)
+                cb->add_strong_cnt();
+            _fetch_sub(slot, _reader);
+            return shared_ptr<T>(cb, ptr, typename shared_ptr<T>::_adopt_tag());
+        }
+
+        // 把r的所有权转入*p，返回*p原来的值
+        template< class T >
+        static shared_ptr<T> exchange(shared_ptr<T> *p, shared_ptr<T>& r) {
+            _check_packable(r._cb);
+            _control_block_base *cb = _lock(&p->_cb);
+            T *ptr = __atomic_load_n(&p->_ptr, __ATOMIC_RELAXED);
+            __atomic_store_n(&p->_ptr, r._ptr, __ATOMIC_RELAXED);
+            _unlock(&p->_cb, cb, r._cb);
+            r._ptr = nullptr;
+            r._cb = nullptr;
+            return shared_ptr<T>(cb, ptr, typename shared_ptr<T>::_adopt_tag());
+        }
+
+        // *p与*v持有同一个指针且共享所有权时换为w；否则把*p的值拷贝到*v
+        template< class T >
+        static bool compare_exchange(shared_ptr<T> *p, shared_ptr<T> *v, shared_ptr<T>& w) {
+            _check_packable(w._cb);
+            _control_block_base *cb = _lock(&p->_cb);
+            T *ptr = __atomic_load_n(&p->_ptr, __ATOMIC_RELAXED);
+            if(ptr == v->_ptr && cb == v->_cb) {
+                __atomic_store_n(&p->_ptr, w._ptr, __ATOMIC_RELAXED);
+                _unlock(&p->_cb, cb, w._cb);
+                w._ptr = nullptr;
+                w._cb = nullptr;
+                // 交换出的旧值在临界区之外释放
+                shared_ptr<T> old(cb, ptr, typename shared_ptr<T>::_adopt_tag());
+                return true;
+            }
+            if(cb)
+                cb->add_strong_cnt();
+            _unlock(&p->_cb, cb, cb);
+            *v = shared_ptr<T>(cb, ptr, typename shared_ptr<T>::_adopt_tag());
+            return false;
+        }
+    };
+#else
+    // 按shared_ptr对象的地址分段加锁，读者之间也互斥
+    struct _sp_atomic {
+        static const size_t _stripes = 64;
+
+        static std::mutex& _stripe(const void *p) {
+            static std::mutex locks[_stripes];
+            return locks[(reinterpret_cast<uintptr_t>(p) >> 4) % _stripes];
+        }
+
+        template< class T >
+        static shared_ptr<T> load(const shared_ptr<T> *p) {
+            _control_block_base *cb;
+            T *ptr;
+            {
+                std::lock_guard<std::mutex> guard(_stripe(p));
+                cb = p->_cb;
+                ptr = p->_ptr;
+                if(cb)
+                    cb->add_strong_cnt();
+            }
+            return shared_ptr<T>(cb, ptr, typename shared_ptr<T>::_adopt_tag());
+        }
+
+        template< class T >
+        static shared_ptr<T> exchange(shared_ptr<T> *p, shared_ptr<T>& r) {
+            _control_block_base *cb;
+            T *ptr;
+            {
+                std::lock_guard<std::mutex> guard(_stripe(p));
+                cb = p->_cb;
+                ptr = p->_ptr;
+                p->_cb = r._cb;
+                p->_ptr = r._ptr;
+            }
+            r._ptr = nullptr;
+            r._cb = nullptr;
+            return shared_ptr<T>(cb, ptr, typename shared_ptr<T>::_adopt_tag());
+        }
+
+        template< class T >
+        static bool compare_exchange(shared_ptr<T> *p, shared_ptr<T> *v, shared_ptr<T>& w) {
+            _control_block_base *cb;
+            T *ptr;
+            bool equal;
+            {
+                std::lock_guard<std::mutex> guard(_stripe(p));
+                cb = p->_cb;
+                ptr = p->_ptr;
+                equal = ptr == v->_ptr && cb == v->_cb;
+                if(equal) {
+                    p->_cb = w._cb;
+                    p->_ptr = w._ptr;
+                } else if(cb) {
+                    cb->add_strong_cnt();
+                }
+            }
+            // 交换出的旧值与拷贝出的当前值都在锁外释放或赋值
+            shared_ptr<T> cur(cb, ptr, typename shared_ptr<T>::_adopt_tag());
+            if(equal) {
+                w._ptr = nullptr;
+                w._cb = nullptr;
+                return true;
+            }
+            *v = std::move(cur);
+            return false;
+        }
+    };
+#endif
+
+    // 写者需要等待正在读取的读者，因此不是无锁的
+    template< class T >
+    bool atomic_is_lock_free( const shared_ptr<T>* ) {
+        return false;
+    }
+
+    template< class T >
+    shared_ptr<T> atomic_load( const shared_ptr<T>* p ) {
+        return _sp_atomic::load(p);
+    }
+
+    // 所有原子操作均为顺序一致，忽略更弱的内存序要求
+    template< class T >
+    shared_ptr<T> atomic_load_explicit( const shared_ptr<T>* p, std::memory_order ) {
+        return _sp_atomic::load(p);
+    }
+
+    template< class T >
+    void atomic_store( shared_ptr<T>* p, shared_ptr<T> r ) {
+        _sp_atomic::exchange(p, r);
+    }
+
+    template< class T >
+    void atomic_store_explicit( shared_ptr<T>* p, shared_ptr<T> r, std::memory_order ) {
+        _sp_atomic::exchange(p, r);
+    }
+
+    template< class T >
+    shared_ptr<T> atomic_exchange( shared_ptr<T>* p, shared_ptr<T> r ) {
+        return _sp_atomic::exchange(p, r);
+    }
+
+    template< class T >
+    shared_ptr<T> atomic_exchange_explicit( shared_ptr<T>* p, shared_ptr<T> r, std::memory_order ) {
+        return _sp_atomic::exchange(p, r);
+    }
+
+    // 不会伪失败，weak与strong相同
+    template< class T >
+    bool atomic_compare_exchange_weak( shared_ptr<T>* p, shared_ptr<T>* expected,
+                                       shared_ptr<T> desired ) {
+        return _sp_atomic::compare_exchange(p, expected, desired);
+    }
+
+    template< class T >
+    bool atomic_compare_exchange_strong( shared_ptr<T>* p, shared_ptr<T>* expected,
+                                         shared_ptr<T> desired ) {
+        return _sp_atomic::compare_exchange(p, expected, desired);
+    }
+
+    template< class T >
+    bool atomic_compare_exchange_weak_explicit( shared_ptr<T>* p, shared_ptr<T>* expected,
+                                                shared_ptr<T> desired,
+                                                std::memory_order, std::memory_order ) {
+        return _sp_atomic::compare_exchange(p, expected, desired);
+    }
+
+    template< class T >
+    bool atomic_compare_exchange_strong_explicit( shared_ptr<T>* p, shared_ptr<T>* expected,
+                                                  shared_ptr<T> desired,
+                                                  std::memory_order, std::memory_order ) {
+        return _sp_atomic::compare_exchange(p, expected, desired);
+    }
+
+    // 相当于C++20的std::atomic<std::shared_ptr<T>>，用于发布读多写少的快照
+    template< class T >
+    class atomic_shared_ptr {
+        private:
+            shared_ptr<T> _p;
+
+        public:
+            typedef shared_ptr<T> value_type;
+
+            constexpr atomic_shared_ptr() noexcept {}
+
+            atomic_shared_ptr( shared_ptr<T> desired ) noexcept
+                : _p(std::move(desired))
+            {}
+
+            atomic_shared_ptr( const atomic_shared_ptr& ) = delete;
+            atomic_shared_ptr& operator=( const atomic_shared_ptr& ) = delete;
+
+            void operator=( shared_ptr<T> desired ) {
+                store(std::move(desired));
+            }
+
+            bool is_lock_free() const noexcept {
+                return jrSTL::atomic_is_lock_free(&_p);
+            }
+
+            void store( shared_ptr<T> desired,
+                        std::memory_order = std::memory_order_seq_cst ) {
+                _sp_atomic::exchange(&_p, desired);
+            }
+
+            shared_ptr<T> load( std::memory_order = std::memory_order_seq_cst ) const {
+                return _sp_atomic::load(&_p);
+            }
+
+            operator shared_ptr<T>() const {
+                return load();
+            }
+
+            shared_ptr<T> exchange( shared_ptr<T> desired,
+                                    std::memory_order = std::memory_order_seq_cst ) {
+                return _sp_atomic::exchange(&_p, desired);
+            }
+
+            bool compare_exchange_weak( shared_ptr<T>& expected, shared_ptr<T> desired,
+                                        std::memory_order = std::memory_order_seq_cst ) {
+                return _sp_atomic::compare_exchange(&_p, &expected, desired);
+            }
+
+            bool compare_exchange_strong( shared_ptr<T>& expected, shared_ptr<T> desired,
+                                          std::memory_order = std::memory_order_seq_cst ) {
+                return _sp_atomic::compare_exchange(&_p, &expected, desired);
+            }
+    };
+
     template <class T, class U, class V>
     std::basic_ostream<U, V>&
     operator<<(std::basic_ostream<U, V>& os,
@@ -1082,69 +1524,45 @@ namespace jrSTL {
         }
 
         ~weak_ptr() {
-            if(_cb && !_cb->weak_count()) {
-                delete _cb;
-                _cb = nullptr;
-            }
+            if(_cb)
+                _cb->release_weak();
         }
 
         weak_ptr& operator=( const weak_ptr& r ) noexcept {
-            if(this != &r) {
-                _cb = r._cb;
-                _ptr = r._ptr;
-                if(_cb)
-                    _cb->add_weak_cnt();
-            }
+            weak_ptr(r).swap(*this);
             return *this;
         }
 
         template< class Y >
         weak_ptr& operator=( const weak_ptr<Y>& r ) noexcept {
-            _cb = r._cb;
-            _ptr = static_cast<element_type*>(r._ptr);
-            if(_cb)
-                _cb->add_weak_cnt();
+            weak_ptr(r).swap(*this);
             return *this;
         }
 
         template< class Y >
         weak_ptr& operator=( const shared_ptr<Y>& r ) noexcept {
-            _cb = r._cb;
-            _ptr = r._ptr;
-            if(_cb)
-                _cb->add_weak_cnt();
+            weak_ptr(r).swap(*this);
             return *this;
         }
 
         template< class Y >
         weak_ptr& operator=( weak_ptr<Y>&& r ) noexcept {
-            _cb = r._cb;
-            _ptr = static_cast<element_type*>(r._ptr);
-            r._cb = nullptr;
-            r._ptr = nullptr;
+            weak_ptr(std::move(r)).swap(*this);
             return *this;
         }
 
         weak_ptr& operator=( weak_ptr&& r ) noexcept {
-            if(this != &r) {
-                _cb = r._cb;
-                _ptr = r._ptr;
-                r._cb = nullptr;
-                r._ptr = nullptr;
-            }
+            weak_ptr(std::move(r)).swap(*this);
             return *this;
         }
 
         void reset() noexcept {
-            if(_cb)
-                _cb->decrease_weak_cnt();
-            _cb = nullptr;
-            _ptr = nullptr;
+            weak_ptr().swap(*this);
         }
 
         void swap( weak_ptr& r ) noexcept {
             {
-                int *wt = _cb;
+                _control_block_base *wt = _cb;
                 _cb = r._cb;
                 r._cb = wt;
             }
@@ -1157,16 +1575,16 @@ namespace jrSTL {
         }
 
         long use_count() const noexcept {
-            return _cb->use_count();
+            return _cb ? _cb->use_count() : 0;
         }
 
         bool expired() const noexcept {
-            return _ptr == nullptr;
+            return use_count() == 0;
         }
 
+        // 先检查再构造会与其他线程释放最后一个shared_ptr竞争，因此由控制块原子地“非0时加一”
         shared_ptr<T> lock() const noexcept {
-            return use_count() ? shared_ptr<element_type>(*this)
-                               : shared_ptr<element_type>();
+            return shared_ptr<element_type>(*this, std::nothrow);
         }
 
         template< class Y >
@@ -1176,7 +1594,7 @@ namespace jrSTL {
 
         template< class Y >
         bool owner_before( const shared_ptr<Y>& other) const noexcept {
-            return _cb < other._cb->_cb;
+            return _cb < other._cb;
         }
     };
 
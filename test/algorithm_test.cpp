@@ -3,9 +3,18 @@
 #include <thread>
 #include <chrono>
 #include <sstream>
+#include <iterator>
 #include <random>
+#include <limits>
+#include <cmath>
+#include <cctype>
+#include <string>
+#include <vector>
 #include "../algorithm/jr_algorithm.h"
+#include "../algorithm/jr_execution.h"
 #include "../algorithm/jr_numeric.h"
+#include "../algorithm/jr_searcher.h"
+#include "../algorithm/jr_top_k.h"
 #include "../functional/jr_functional.h"
 #include "../container/sequence/jr_vector.h"
 #include "../container/sequence/jr_array.h"
@@ -53,6 +62,80 @@ TEST(testCase, find) {
     ASSERT_EQ(result2, v.end());
 }
 
+// 在标量、SSE2、AVX2各级实现下与std比较，取值范围小以产生大量重复值
+template<class T>
+void check_simd_scan(std::mt19937_64& rng, T lo, T span) {
+    const size_t sizes[] = {0, 1, 7, 31, 33, 64, 255, 1000, 5000, 70000};
+    int saved = jrSTL::_simd_level();
+    for(size_t n : sizes) {
+        jrSTL::vector<T> v(n);
+        for(size_t i = 0; i < n; ++i)
+            v[i] = static_cast<T>(lo + static_cast<T>(rng() % static_cast<uint64_t>(span)));
+        T probe = n ? v[rng() % n] : lo;
+        for(int level = 0; level <= jrSTL::_simd_detect(); ++level) {
+            jrSTL::_simd_level() = level;
+            SCOPED_TRACE(testing::Message() << typeid(T).name() << " n=" << n << " level=" << level);
+            const T *b = n ? &v[0] : nullptr, *e = b + n;
+            ASSERT_EQ(jrSTL::find(b, e, probe), std::find(b, e, probe));
+            ASSERT_EQ(jrSTL::find(b, e, static_cast<T>(lo + span)), e);
+            ASSERT_EQ(jrSTL::count(b, e, probe), std::count(b, e, probe));
+            ASSERT_EQ(jrSTL::min_element(b, e), std::min_element(b, e));
+            ASSERT_EQ(jrSTL::max_element(b, e), std::max_element(b, e));
+            ASSERT_TRUE(jrSTL::minmax_element(b, e) == std::minmax_element(b, e));
+        }
+    }
+    jrSTL::_simd_level() = saved;
+}
+
+TEST(testCase, simd_scan) {
+    std::mt19937_64 rng(std::random_device{}());
+    check_simd_scan<int8_t>(rng, -100, 50);
+    check_simd_scan<uint8_t>(rng, 100, 150);
+    check_simd_scan<char>(rng, 'a', 26);
+    check_simd_scan<int16_t>(rng, -15000, 30000);
+    check_simd_scan<uint16_t>(rng, 1, 65000);
+    check_simd_scan<int>(rng, -1000, 2000);
+    check_simd_scan<unsigned>(rng, 0x7ffffff0u, 100);
+    check_simd_scan<int64_t>(rng, -(int64_t(1) << 40), int64_t(1) << 41);
+    check_simd_scan<uint64_t>(rng, uint64_t(1) << 63, 1000);
+    check_simd_scan<float>(rng, -50.0f, 100.0f);
+    check_simd_scan<double>(rng, -1e6, 2e6);
+
+    // 值不能用元素类型表示时没有匹配；有符号与无符号的比较与std相同
+    jrSTL::vector<int8_t> s8(100, -1);
+    ASSERT_EQ(jrSTL::find(s8.begin(), s8.end(), 255), s8.end());
+    ASSERT_EQ(jrSTL::count(s8.begin(), s8.end(), -1L), 100);
+    jrSTL::vector<unsigned> u32(100, 0xffffffffu);
+    ASSERT_EQ(jrSTL::count(u32.begin(), u32.end(), -1), std::count(u32.begin(), u32.end(), -1));
+    ASSERT_EQ(jrSTL::count(u32.begin(), u32.end(), -1LL), std::count(u32.begin(), u32.end(), -1LL));
+
+    // NaN使比较不构成严格弱序，结果应与标量算法相同
+    int saved = jrSTL::_simd_level();
+    jrSTL::vector<double> d(5000);
+    for(size_t i = 0; i < d.size(); ++i)
+        d[i] = static_cast<double>(rng() % 1000);
+    d[1234] = std::numeric_limits<double>::quiet_NaN();
+    d[0] = std::numeric_limits<double>::quiet_NaN();
+    for(int level = 0; level <= jrSTL::_simd_detect(); ++level) {
+        jrSTL::_simd_level() = level;
+        ASSERT_EQ(jrSTL::min_element(d.begin(), d.end()), std::min_element(d.begin(), d.end()));
+        ASSERT_EQ(jrSTL::max_element(d.begin(), d.end()), std::max_element(d.begin(), d.end()));
+        ASSERT_TRUE(jrSTL::minmax_element(d.begin(), d.end()) == std::minmax_element(d.begin(), d.end()));
+        ASSERT_EQ(jrSTL::find(d.begin(), d.end(), d[0]), d.end());
+        ASSERT_EQ(jrSTL::count(d.begin(), d.end(), 0.0), std::count(d.begin(), d.end(), 0.0));
+    }
+    jrSTL::_simd_level() = saved;
+
+    // 带比较器的minmax_element与非连续区间走标量实现
+    jrSTL::forward_list<int> fl{3, 1, 4, 1, 5, 9, 2, 6, 5, 3, 9};
+    auto mm = jrSTL::minmax_element(fl.begin(), fl.end());
+    ASSERT_EQ(std::distance(fl.begin(), mm.first), 1);
+    ASSERT_EQ(std::distance(fl.begin(), mm.second), 10);
+    auto mg = jrSTL::minmax_element(fl.begin(), fl.end(), jrSTL::greater<int>());
+    ASSERT_EQ(std::distance(fl.begin(), mg.first), 5);
+    ASSERT_EQ(std::distance(fl.begin(), mg.second), 3);
+}
+
 TEST(testCase, find_end) {
     // bid迭代器
     jrSTL::vector<int> v{1, 2, 3, 4, 1, 2, 3, 4, 1, 2, 3, 4};
@@ -97,6 +180,103 @@ TEST(testCase, search) {
     ASSERT_EQ(false, in_quote(vec, s2));
 }
 
+// 对各种查找方式与std::search的结果进行比较，返回匹配位置
+template<class T>
+void check_searchers(const std::vector<T>& text, const std::vector<T>& pat) {
+    const T *b = text.data(), *e = b + text.size();
+    const T *pb = pat.data(), *pe = pb + pat.size();
+    const T *expect = std::search(b, e, pb, pe);
+    jrSTL::default_searcher<const T *> ds(pb, pe);
+    jrSTL::boyer_moore_horspool_searcher<const T *> bmh(pb, pe);
+    jrSTL::boyer_moore_searcher<const T *> bm(pb, pe);
+    if(pat.empty()) {
+        ASSERT_EQ(e, jrSTL::search(b, e, pb, pe));
+        ASSERT_EQ(std::make_pair(b, b), ds(b, e));
+        ASSERT_EQ(std::make_pair(b, b), bmh(b, e));
+        ASSERT_EQ(std::make_pair(b, b), bm(b, e));
+        return;
+    }
+    const T *expect_last = expect == e ? e : expect + pat.size();
+    ASSERT_EQ(expect, jrSTL::search(b, e, pb, pe));
+    ASSERT_EQ(expect, jrSTL::search(b, e, pb, pe, [](const T& x, const T& y) { return x == y; }));
+    ASSERT_EQ(std::make_pair(expect, expect_last), ds(b, e));
+    ASSERT_EQ(std::make_pair(expect, expect_last), bmh(b, e));
+    ASSERT_EQ(std::make_pair(expect, expect_last), bm(b, e));
+    ASSERT_EQ(expect, jrSTL::search(b, e, bm));
+}
+
+TEST(testCase, searchers) {
+    std::mt19937 gen(2023);
+    for(int alphabet : {2, 4, 26, 256}) {
+        for(int round = 0; round < 200; ++round) {
+            std::vector<unsigned char> text(gen() % 300), pat(gen() % 12);
+            for(auto& c : text)
+                c = static_cast<unsigned char>('a' + gen() % alphabet);
+            for(auto& c : pat)
+                c = static_cast<unsigned char>('a' + gen() % alphabet);
+            // 一半的模式取自文本，保证能够找到
+            if(round % 2 && text.size() > pat.size()) {
+                size_t pos = gen() % (text.size() - pat.size() + 1);
+                std::copy(text.begin() + pos, text.begin() + pos + pat.size(), pat.begin());
+            }
+            check_searchers(text, pat);
+            std::vector<char> ctext(text.begin(), text.end()), cpat(pat.begin(), pat.end());
+            check_searchers(ctext, cpat);
+            // 非单字节元素：SIMD预筛选与散列表形式的坏字符表
+            std::vector<int> itext(text.begin(), text.end()), ipat(pat.begin(), pat.end());
+            for(auto& x : itext)
+                x *= 65537;
+            for(auto& x : ipat)
+                x *= 65537;
+            check_searchers(itext, ipat);
+        }
+    }
+    // 周期性的退化输入，预筛选在这里退回KMP
+    std::vector<char> a(5000, 'a'), p1(300, 'a'), p2(300, 'a');
+    p1.back() = 'b';
+    p2.front() = 'b';
+    check_searchers(a, p1);
+    check_searchers(a, p2);
+    a.back() = 'b';
+    check_searchers(a, p1);
+    a.back() = 'a';
+    a.front() = 'b';
+    check_searchers(a, p2);
+    check_searchers(std::vector<int>(3000, 7), std::vector<int>(50, 7));
+}
+
+TEST(testCase, searcher_reuse_and_predicate) {
+    struct nocase_hash {
+        size_t operator()(char c) const { return std::hash<int>()(std::tolower(c)); }
+    };
+    struct nocase_equal {
+        bool operator()(char a, char b) const { return std::tolower(a) == std::tolower(b); }
+    };
+    std::string pat = "Needle";
+    jrSTL::boyer_moore_searcher<std::string::const_iterator, nocase_hash, nocase_equal>
+            bm(pat.begin(), pat.end());
+    jrSTL::boyer_moore_horspool_searcher<std::string::const_iterator, nocase_hash, nocase_equal>
+            bmh(pat.begin(), pat.end());
+    jrSTL::default_searcher<std::string::const_iterator, nocase_equal> ds(pat.begin(), pat.end());
+    const char *texts[] = {"hay NEEDLE hay", "needlneedle", "no match here", "Needl", "xneedle"};
+    for(const char *t : texts) {
+        std::string s = t;
+        std::string::const_iterator expect = std::search(s.cbegin(), s.cend(), pat.cbegin(), pat.cend(), nocase_equal());
+        ASSERT_EQ(expect, jrSTL::search(s.cbegin(), s.cend(), bm));
+        ASSERT_EQ(expect, jrSTL::search(s.cbegin(), s.cend(), bmh));
+        ASSERT_EQ(expect, jrSTL::search(s.cbegin(), s.cend(), ds));
+    }
+    // 元素为string，坏字符表为散列表
+    std::vector<std::string> words = {"a", "rose", "is", "a", "rose", "is", "a", "rose"};
+    std::vector<std::string> phrase = {"is", "a", "rose"};
+    jrSTL::boyer_moore_searcher<std::vector<std::string>::const_iterator> wbm(phrase.begin(), phrase.end());
+    auto r = wbm(words.cbegin(), words.cend());
+    ASSERT_EQ(2, r.first - words.cbegin());
+    ASSERT_EQ(5, r.second - words.cbegin());
+    auto r2 = wbm(r.first + 1, words.cend());
+    ASSERT_EQ(5, r2.first - words.cbegin());
+}
+
 template <class Container, class Size, class T>
 bool consecutive_values(const Container& c, Size count, const T& v, int f)
 {
@@ -186,6 +366,103 @@ TEST(testCase, move) {
     ASSERT_EQ(str_thread, "thread 1 ended thread 2 ended thread 3 ended ");
 }
 
+// 连续区间按字节处理的路径与逐个处理的结果一致
+TEST(testCase, contiguous_bytewise) {
+    std::mt19937 rng(2024);
+    ASSERT_TRUE(jrSTL::is_contiguous_iterator<int*>::value);
+    ASSERT_TRUE(jrSTL::is_contiguous_iterator<jrSTL::vector<int>::const_iterator>::value);
+    ASSERT_FALSE(jrSTL::is_contiguous_iterator<jrSTL::forward_list<int>::iterator>::value);
+    ASSERT_FALSE(jrSTL::is_contiguous_iterator<jrSTL::reverse_iterator<int*> >::value);
+    ASSERT_TRUE((std::is_same<jrSTL::iterator_concept<const char*>::type,
+                              jrSTL::contiguous_iterator_tag>::value));
+
+    // 重叠区间的move/copy_backward/move_backward
+    jrSTL::vector<int> v(100);
+    for(int i = 0; i < 100; ++i)
+        v[i] = i;
+    std::vector<int> s(v.begin(), v.end());
+    ASSERT_EQ(jrSTL::move(v.begin() + 10, v.end(), v.begin()), v.begin() + 90);
+    std::move(s.begin() + 10, s.end(), s.begin());
+    ASSERT_TRUE(std::equal(s.begin(), s.end(), v.begin()));
+    ASSERT_EQ(jrSTL::copy_backward(v.begin(), v.begin() + 50, v.begin() + 70), v.begin() + 20);
+    std::copy_backward(s.begin(), s.begin() + 50, s.begin() + 70);
+    ASSERT_TRUE(std::equal(s.begin(), s.end(), v.begin()));
+    ASSERT_EQ(jrSTL::move_backward(v.begin(), v.begin() + 30, v.end()), v.begin() + 70);
+    std::move_backward(s.begin(), s.begin() + 30, s.end());
+    ASSERT_TRUE(std::equal(s.begin(), s.end(), v.begin()));
+    int out[5];
+    ASSERT_EQ(jrSTL::copy_n(v.cbegin(), 5, out), out + 5);
+    ASSERT_TRUE(std::equal(out, out + 5, v.begin()));
+    ASSERT_EQ(jrSTL::copy_n(v.cbegin(), -1, out), out);
+
+    // 非平凡类型仍逐个移动
+    jrSTL::vector<std::string> strs{"a", "b", "c", "d"};
+    jrSTL::move(strs.begin() + 1, strs.end(), strs.begin());
+    ASSERT_EQ(strs[0], "b");
+    ASSERT_EQ(strs[2], "d");
+
+    // fill：单字节、全0、非0与-0.0
+    unsigned char bytes[37];
+    jrSTL::fill(bytes, bytes + 37, 0xab);
+    ASSERT_EQ(std::count(bytes, bytes + 37, 0xab), 37);
+    double d[9];
+    jrSTL::fill_n(d, 9, 1.5);
+    ASSERT_EQ(std::count(d, d + 9, 1.5), 9);
+    jrSTL::fill(d, d + 9, -0.0);
+    ASSERT_TRUE(std::signbit(d[8]));
+    jrSTL::fill(d, d + 9, 0);
+    ASSERT_FALSE(std::signbit(d[8]));
+    ASSERT_EQ(jrSTL::fill_n(d, 0, 3.0), d);
+    const char *ptrs[4];
+    jrSTL::fill(ptrs, ptrs + 4, nullptr);
+    ASSERT_EQ(ptrs[3], nullptr);
+
+    // equal/mismatch与std比较，不同位置跨越memcmp的分块边界
+    for(size_t n : {0, 1, 63, 64, 65, 300, 1000}) {
+        jrSTL::vector<int> a(n), b(n);
+        for(size_t i = 0; i < n; ++i)
+            a[i] = b[i] = static_cast<int>(rng() % 5);
+        ASSERT_TRUE(jrSTL::equal(a.begin(), a.end(), b.begin()));
+        ASSERT_EQ(jrSTL::mismatch(a.begin(), a.end(), b.cbegin()).first, a.end());
+        if(n) {
+            size_t k = rng() % n;
+            b[k] += 1;
+            ASSERT_FALSE(jrSTL::equal(a.begin(), a.end(), b.begin()));
+            auto mm = jrSTL::mismatch(a.cbegin(), a.cend(), b.cbegin());
+            ASSERT_EQ(mm.first, a.cbegin() + k);
+            ASSERT_EQ(mm.second, b.cbegin() + k);
+        }
+    }
+    double nan = std::numeric_limits<double>::quiet_NaN(), pz = 0.0, nz = -0.0;
+    ASSERT_FALSE(jrSTL::equal(&nan, &nan + 1, &nan));
+    ASSERT_TRUE(jrSTL::equal(&pz, &pz + 1, &nz));
+
+    // 字典序：unsigned char走memcmp，有符号字节逐个比较
+    const unsigned char u1[] = {1, 2, 200}, u2[] = {1, 2, 3, 4};
+    ASSERT_FALSE(jrSTL::lexicographical_compare(u1, u1 + 3, u2, u2 + 4));
+    ASSERT_TRUE(jrSTL::lexicographical_compare(u2, u2 + 4, u1, u1 + 3));
+    ASSERT_TRUE(jrSTL::lexicographical_compare(u2, u2 + 2, u2, u2 + 3));
+    ASSERT_FALSE(jrSTL::lexicographical_compare(u2, u2 + 3, u2, u2 + 3));
+    const signed char c1[] = {1, -1}, c2[] = {1, 1};
+    ASSERT_TRUE(jrSTL::lexicographical_compare(c1, c1 + 2, c2, c2 + 2));
+    std::string x = "apple", y = "apricot";
+    ASSERT_EQ(jrSTL::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end()),
+              std::lexicographical_compare(x.begin(), x.end(), y.begin(), y.end()));
+    ASSERT_FALSE(jrSTL::lexicographical_compare(y.begin(), y.end(), x.begin(), x.end()));
+
+    // 容器比较为字典序
+    jrSTL::vector<int> p{1, 2, 3}, q{1, 3};
+    ASSERT_TRUE(p < q);
+    ASSERT_TRUE(q > p);
+    ASSERT_TRUE(p <= p);
+    ASSERT_FALSE(p == q);
+    jrSTL::array<int, 3> r{{1, 2, 3}}, t{{1, 2, 4}};
+    ASSERT_TRUE(r < t);
+    ASSERT_FALSE(t <= r);
+    r.fill(7);
+    ASSERT_EQ(r[2], 7);
+}
+
 TEST(testCase, fill) {
     jrSTL::vector<int> v{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
     jrSTL::fill(v.begin(), v.end(), -1);
@@ -292,6 +569,71 @@ TEST(testCase, unique) {
     }
 }
 
+// 有序且含长短不一重复段的输入
+template<class T, class F>
+std::vector<T> dup_runs(size_t n, std::mt19937& gen, F make) {
+    std::vector<T> v;
+    int id = 0;
+    while(v.size() < n) {
+        size_t run = gen() % 4 == 0 ? gen() % 50 + 1 : gen() % 3 + 1;
+        for(size_t i = 0; i < run && v.size() < n; ++i)
+            v.push_back(make(id));
+        ++id;
+    }
+    return v;
+}
+
+TEST(testCase, unique_linear) {
+    std::mt19937 gen(25);
+    jrSTL::task_pool pool(4);
+    const jrSTL::execution::parallel_policy par = jrSTL::execution::par.on(pool);
+    for(size_t n : {0, 1, 2, 100, 50000}) {
+        std::vector<int> a = dup_runs<int>(n, gen, [](int id) { return id; });
+        std::vector<int> b = a, c = a;
+        a.erase(std::unique(a.begin(), a.end()), a.end());
+        b.erase(jrSTL::unique(b.begin(), b.end()), b.end());
+        c.erase(jrSTL::unique(par, c.begin(), c.end()), c.end());
+        ASSERT_EQ(a, b);
+        ASSERT_EQ(a, c);
+
+        std::vector<std::string> s = dup_runs<std::string>(n, gen, [](int id) { return std::to_string(id); });
+        std::vector<std::string> t = s, u = s, out;
+        jrSTL::unique_copy(s.begin(), s.end(), std::back_inserter(out));
+        s.erase(std::unique(s.begin(), s.end()), s.end());
+        t.erase(jrSTL::unique(t.begin(), t.end()), t.end());
+        u.erase(jrSTL::unique(par, u.begin(), u.end()), u.end());
+        ASSERT_EQ(s, t);
+        ASSERT_EQ(s, u);
+        ASSERT_EQ(s, out);
+
+        // 谓词为按十位分组的等价关系，每组保留第一个元素
+        std::vector<int> d(n);
+        for(size_t i = 0; i < n; ++i)
+            d[i] = static_cast<int>(i / 7 * 3 + gen() % 3);
+        std::vector<int> e = d, f = d;
+        auto same_tens = [](int x, int y) { return x / 10 == y / 10; };
+        d.erase(std::unique(d.begin(), d.end(), same_tens), d.end());
+        e.erase(jrSTL::unique(e.begin(), e.end(), same_tens), e.end());
+        f.erase(jrSTL::unique(par, f.begin(), f.end(), same_tens), f.end());
+        ASSERT_EQ(d, e);
+        ASSERT_EQ(d, f);
+    }
+    // 前向迭代器
+    jrSTL::forward_list<int> fl = {1, 1, 2, 2, 2, 3, 1, 1};
+    auto fend = jrSTL::unique(fl.begin(), fl.end());
+    auto fit = fl.begin();
+    for(int x : {1, 2, 3, 1})
+        ASSERT_EQ(x, *fit++);
+    ASSERT_EQ(fend, fit);
+    // 输入迭代器只能遍历一次
+    std::istringstream in("5 5 6 7 7 7 5 8 8");
+    std::vector<int> got;
+    jrSTL::unique_copy(std::istream_iterator<int>(in), std::istream_iterator<int>(), std::back_inserter(got));
+    ASSERT_EQ(std::vector<int>({5, 6, 7, 5, 8}), got);
+    std::vector<int> empty, none;
+    ASSERT_EQ(none.begin(), jrSTL::unique_copy(empty.begin(), empty.end(), none.begin()));
+}
+
 TEST(testCase, is_partitioned) {
     jrSTL::array<int, 9> v = { 1, 2, 3, 4, 5, 6, 7, 8, 9 };
     auto is_even = [](int i){ return i % 2 == 0; };
@@ -323,6 +665,11 @@ TEST(testCase, partition) {
     for(auto i = v.begin(); i != it; ++i) {
         ASSERT_EQ((*i) % 2 == 0, true);
     }
+    ASSERT_EQ(v.begin() + 5, it);
+    for(auto i = it; i != v.end(); ++i)
+        ASSERT_NE((*i) % 2, 0);
+    ASSERT_EQ(v.end(), jrSTL::partition(v.begin(), v.end(), [](int i){ return i >= 0; }));
+    ASSERT_EQ(v.begin(), jrSTL::partition(v.begin(), v.end(), [](int i){ return i < 0; }));
     jrSTL::forward_list<int> fl = {1, 30, -4, 3, 5, -4, 1, 6, -8, 2, -5, 64, 1, 92};
     quicksort(fl.begin(), fl.end());
     auto a = fl.begin();
@@ -398,6 +745,40 @@ TEST(testCase, sort) {
     }
 }
 
+// 大规模排序：各种分布的整数（无分支划分）与字符串（普通划分）结果与std::sort一致
+TEST(testCase, sort_large) {
+    std::mt19937 rng(std::random_device{}());
+    const int n = 30000;
+    for(int kind = 0; kind < 7; ++kind) {
+        std::vector<int> src(n);
+        for(int i = 0; i < n; ++i) {
+            switch(kind) {
+                case 0: src[i] = static_cast<int>(rng()); break;
+                case 1: src[i] = i; break;
+                case 2: src[i] = n - i; break;
+                case 3: src[i] = static_cast<int>(rng() % 8); break;
+                case 4: src[i] = i < n / 2 ? i : n - i; break;
+                case 5: src[i] = i % 64 ? i : static_cast<int>(rng()); break;
+                default: src[i] = (i * 1103515245 + 12345) % (n / 3); break;
+            }
+        }
+        std::vector<int> des(src);
+        std::vector<std::string> ssrc, sdes;
+        for(int i = 0; i < n / 10; ++i)
+            ssrc.push_back(std::to_string(src[i]));
+        sdes = ssrc;
+        std::sort(src.begin(), src.end());
+        jrSTL::sort(des.begin(), des.end());
+        ASSERT_EQ(src, des);
+        std::sort(src.begin(), src.end(), std::greater<int>());
+        jrSTL::sort(des.begin(), des.end(), jrSTL::greater<int>());
+        ASSERT_EQ(src, des);
+        std::sort(ssrc.begin(), ssrc.end());
+        jrSTL::sort(sdes.begin(), sdes.end());
+        ASSERT_EQ(ssrc, sdes);
+    }
+}
+
 TEST(testCase, partial_sort) {
     jrSTL::array<int, 10> s{5, 7, 4, 2, 8, 6, 1, 9, 0, 3};
     jrSTL::partial_sort(s.begin(), s.begin() + 3, s.end());
@@ -434,6 +815,222 @@ TEST(testCase, stable_sort) {
     ASSERT_EQ(v[2].name, "Ford");
 }
 
+// 大规模稳定排序与原地归并：随机、有序、逆序、少量不同值、分段有序输入与std::stable_sort一致
+TEST(testCase, stable_sort_large) {
+    std::mt19937 rng(std::random_device{}());
+    const size_t n = 20000;
+    for(int kind = 0; kind < 5; ++kind) {
+        std::vector<std::pair<int, int> > src(n);
+        for(size_t i = 0; i < n; ++i) {
+            int key;
+            switch(kind) {
+                case 0: key = static_cast<int>(rng()); break;
+                case 1: key = static_cast<int>(i); break;
+                case 2: key = static_cast<int>(n - i); break;
+                case 3: key = static_cast<int>(rng() % 4); break;
+                default: key = static_cast<int>(i % 1000) + static_cast<int>(rng() % 3); break;
+            }
+            src[i] = std::make_pair(key, static_cast<int>(i));
+        }
+        auto by_key = [](const std::pair<int, int>& a, const std::pair<int, int>& b) {
+            return a.first < b.first;
+        };
+        std::vector<std::pair<int, int> > des(src);
+        std::stable_sort(src.begin(), src.end(), by_key);
+        jrSTL::stable_sort(des.begin(), des.end(), by_key);
+        for(size_t i = 0; i < n; ++i)
+            ASSERT_EQ(src[i], des[i]);
+
+        std::vector<std::pair<int, int> > half(src.begin(), src.begin() + n / 3);
+        std::vector<std::pair<int, int> > other(src.begin() + n / 3, src.end());
+        std::reverse(other.begin(), other.end());
+        std::stable_sort(other.begin(), other.end(), by_key);
+        half.insert(half.end(), other.begin(), other.end());
+        std::vector<std::pair<int, int> > merged(half);
+        std::inplace_merge(half.begin(), half.begin() + n / 3, half.end(), by_key);
+        jrSTL::inplace_merge(merged.begin(), merged.begin() + n / 3, merged.end(), by_key);
+        for(size_t i = 0; i < n; ++i)
+            ASSERT_EQ(half[i], merged[i]);
+    }
+}
+
+TEST(testCase, parallel_algorithms) {
+    std::mt19937 rng(std::random_device{}());
+    jrSTL::task_pool pool(4);
+    const jrSTL::execution::parallel_policy par = jrSTL::execution::par.on(pool);
+    const size_t n = 200000;
+    auto by_key = [](const std::pair<int, int>& a, const std::pair<int, int>& b) {
+        return a.first < b.first;
+    };
+    for(int kind = 0; kind < 3; ++kind) {
+        std::vector<std::pair<int, int> > src(n);
+        for(size_t i = 0; i < n; ++i) {
+            int key = kind == 0 ? static_cast<int>(rng()) :
+                      kind == 1 ? static_cast<int>(rng() % 16) : static_cast<int>(n - i);
+            src[i] = std::make_pair(key, static_cast<int>(i));
+        }
+
+        std::vector<std::pair<int, int> > a(src), b(src);
+        std::sort(a.begin(), a.end());
+        jrSTL::sort(par, b.begin(), b.end());
+        ASSERT_TRUE(a == b);
+
+        a = src, b = src;
+        std::stable_sort(a.begin(), a.end(), by_key);
+        jrSTL::stable_sort(par, b.begin(), b.end(), by_key);
+        ASSERT_TRUE(a == b);
+
+        a = src, b = src;
+        std::partial_sort(a.begin(), a.begin() + 100, a.end());
+        jrSTL::partial_sort(par, b.begin(), b.begin() + 100, b.end());
+        ASSERT_TRUE(std::equal(a.begin(), a.begin() + 100, b.begin()));
+        std::sort(a.begin(), a.end());
+        std::sort(b.begin(), b.end());
+        ASSERT_TRUE(a == b);
+
+        std::vector<std::pair<int, int> > l(src.begin(), src.begin() + n / 3);
+        std::vector<std::pair<int, int> > r(src.begin() + n / 3, src.end());
+        std::stable_sort(l.begin(), l.end(), by_key);
+        std::stable_sort(r.begin(), r.end(), by_key);
+        std::vector<std::pair<int, int> > m1(n), m2(n);
+        std::merge(l.begin(), l.end(), r.begin(), r.end(), m1.begin(), by_key);
+        ASSERT_TRUE(jrSTL::merge(par, l.begin(), l.end(), r.begin(), r.end(),
+                                 m2.begin(), by_key) == m2.end());
+        ASSERT_TRUE(m1 == m2);
+
+        a = l, b = l;
+        a.insert(a.end(), r.begin(), r.end());
+        b.insert(b.end(), r.begin(), r.end());
+        std::inplace_merge(a.begin(), a.begin() + n / 3, a.end(), by_key);
+        jrSTL::inplace_merge(par, b.begin(), b.begin() + n / 3, b.end(), by_key);
+        ASSERT_TRUE(a == b);
+    }
+
+    std::vector<std::string> s1, s2;
+    for(size_t i = 0; i < n / 4; ++i)
+        s1.push_back(std::to_string(rng()));
+    s2 = s1;
+    std::sort(s1.begin(), s1.end());
+    jrSTL::sort(par, s2.begin(), s2.end());
+    ASSERT_TRUE(s1 == s2);
+    s2 = s1;
+    jrSTL::sort(jrSTL::execution::seq, s2.begin(), s2.end());
+    ASSERT_TRUE(s1 == s2);
+}
+
+TEST(testCase, radix_sort) {
+    std::mt19937_64 rng(std::random_device{}());
+    jrSTL::task_pool pool(4);
+    const jrSTL::execution::parallel_policy par = jrSTL::execution::par.on(pool);
+    const size_t sizes[] = {0, 1, 100, 5000, 100000};
+    for(size_t n : sizes) {
+        std::vector<uint64_t> u1(n);
+        for(size_t i = 0; i < n; ++i)
+            u1[i] = i % 3 ? rng() : rng() % 1000;
+        std::vector<uint64_t> u2(u1), u3(u1);
+        std::sort(u1.begin(), u1.end());
+        jrSTL::radix_sort(u2.begin(), u2.end());
+        jrSTL::radix_sort(par, u3.begin(), u3.end());
+        ASSERT_TRUE(u1 == u2);
+        ASSERT_TRUE(u1 == u3);
+
+        std::vector<int> i1(n);
+        for(size_t i = 0; i < n; ++i)
+            i1[i] = static_cast<int>(rng() % 2001) - 1000;
+        std::vector<int> i2(i1);
+        std::sort(i1.begin(), i1.end());
+        jrSTL::radix_sort(i2.begin(), i2.end());
+        ASSERT_TRUE(i1 == i2);
+
+        std::vector<double> d1(n);
+        for(size_t i = 0; i < n; ++i)
+            d1[i] = (static_cast<double>(rng() % 20001) - 10000.0) / 7.0;
+        if(n > 4) {
+            d1[0] = -std::numeric_limits<double>::infinity();
+            d1[1] = std::numeric_limits<double>::infinity();
+            d1[2] = std::numeric_limits<double>::max();
+            d1[3] = -std::numeric_limits<double>::denorm_min();
+        }
+        std::vector<double> d2(d1);
+        std::sort(d1.begin(), d1.end());
+        jrSTL::radix_sort(d2.begin(), d2.end());
+        ASSERT_TRUE(d1 == d2);
+
+        // 键提取器与稳定性
+        std::vector<std::pair<float, uint32_t> > p1(n);
+        for(size_t i = 0; i < n; ++i)
+            p1[i] = std::make_pair(static_cast<float>(static_cast<int>(rng() % 64) - 32) / 4,
+                                   static_cast<uint32_t>(i));
+        std::vector<std::pair<float, uint32_t> > p2(p1), p3(p1);
+        auto by_key = [](const std::pair<float, uint32_t>& a, const std::pair<float, uint32_t>& b) {
+            return a.first < b.first;
+        };
+        auto key = [](const std::pair<float, uint32_t>& x) { return x.first; };
+        std::stable_sort(p1.begin(), p1.end(), by_key);
+        jrSTL::radix_sort(p2.begin(), p2.end(), key);
+        jrSTL::radix_sort(par, p3.begin(), p3.end(), key);
+        ASSERT_TRUE(p1 == p2);
+        ASSERT_TRUE(p1 == p3);
+
+        std::vector<std::string> s1(n);
+        for(size_t i = 0; i < n; ++i) {
+            s1[i] = i % 2 ? "prefix/" : "";
+            size_t len = rng() % 12;
+            for(size_t k = 0; k < len; ++k)
+                s1[i].push_back(static_cast<char>(rng() % 4 ? 'a' + rng() % 3 : rng() % 256));
+        }
+        std::vector<std::string> s2(s1), s3(s1);
+        std::sort(s1.begin(), s1.end());
+        jrSTL::radix_sort(s2.begin(), s2.end());
+        jrSTL::radix_sort(par, s3.begin(), s3.end());
+        ASSERT_TRUE(s1 == s2);
+        ASSERT_TRUE(s1 == s3);
+
+        // -0.0与+0.0相等，保持输入中的先后次序
+        std::vector<std::pair<double, uint32_t> > z1(n);
+        for(size_t i = 0; i < n; ++i) {
+            double v = static_cast<double>(static_cast<int>(rng() % 5) - 2);
+            z1[i] = std::make_pair(v == 0 && rng() % 2 ? -0.0 : v, static_cast<uint32_t>(i));
+        }
+        std::vector<std::pair<double, uint32_t> > z2(z1), z3(z1);
+        auto zkey = [](const std::pair<double, uint32_t>& x) { return x.first; };
+        std::stable_sort(z1.begin(), z1.end(),
+                         [](const std::pair<double, uint32_t>& a, const std::pair<double, uint32_t>& b) {
+                             return a.first < b.first;
+                         });
+        jrSTL::radix_sort(z2.begin(), z2.end(), zkey);
+        jrSTL::radix_sort(par, z3.begin(), z3.end(), zkey);
+        for(size_t i = 0; i < n; ++i) {
+            ASSERT_EQ(z1[i].second, z2[i].second);
+            ASSERT_EQ(z1[i].second, z3[i].second);
+            ASSERT_EQ(std::signbit(z1[i].first), std::signbit(z2[i].first));
+        }
+
+        // 没有编码的算术键退回按键比较的稳定排序
+        std::vector<long double> l1(n);
+        for(size_t i = 0; i < n; ++i)
+            l1[i] = static_cast<long double>(static_cast<int>(rng() % 2001) - 1000) / 3;
+        std::vector<long double> l2(l1), l3(l1);
+        std::sort(l1.begin(), l1.end());
+        jrSTL::radix_sort(l2.begin(), l2.end());
+        jrSTL::radix_sort(par, l3.begin(), l3.end());
+        ASSERT_TRUE(l1 == l2);
+        ASSERT_TRUE(l1 == l3);
+
+        std::vector<std::pair<bool, uint32_t> > b1(n);
+        for(size_t i = 0; i < n; ++i)
+            b1[i] = std::make_pair(rng() % 2 == 0, static_cast<uint32_t>(i));
+        std::vector<std::pair<bool, uint32_t> > b2(b1);
+        std::stable_sort(b1.begin(), b1.end(),
+                         [](const std::pair<bool, uint32_t>& a, const std::pair<bool, uint32_t>& b) {
+                             return a.first < b.first;
+                         });
+        jrSTL::radix_sort(b2.begin(), b2.end(),
+                          [](const std::pair<bool, uint32_t>& x) { return x.first; });
+        ASSERT_TRUE(b1 == b2);
+    }
+}
+
 TEST(testCase, nth_element) {
     jrSTL::vector<int> v{5, 6, 4, 3, 2, 6, 7, 9, 3};
     jrSTL::nth_element(v.begin(), v.begin() + v.size()/2, v.end());
@@ -442,6 +1039,143 @@ TEST(testCase, nth_element) {
     ASSERT_EQ(v[1], 7);
 }
 
+// 生成各种分布的输入：随机、有序、逆序、全部相等、少量不同值、先增后减
+std::vector<int> select_input(size_t n, int kind, std::mt19937& gen) {
+    std::vector<int> v(n);
+    for(size_t i = 0; i < n; ++i) {
+        switch(kind) {
+            case 0: v[i] = static_cast<int>(gen() % 100000); break;
+            case 1: v[i] = static_cast<int>(i); break;
+            case 2: v[i] = static_cast<int>(n - i); break;
+            case 3: v[i] = 7; break;
+            case 4: v[i] = static_cast<int>(gen() % 3); break;
+            default: v[i] = static_cast<int>(i < n / 2 ? i : n - i); break;
+        }
+    }
+    return v;
+}
+
+template<class F>
+void check_select(F select) {
+    std::mt19937 gen(24);
+    for(size_t n : {1, 2, 5, 23, 24, 25, 100, 1000, 10007}) {
+        for(int kind = 0; kind < 6; ++kind) {
+            std::vector<int> input = select_input(n, kind, gen);
+            std::vector<int> sorted = input;
+            std::sort(sorted.begin(), sorted.end());
+            for(size_t k : {size_t(0), n / 3, n / 2, n - 1}) {
+                std::vector<int> v = input;
+                select(v.data(), v.data() + k, v.data() + n);
+                ASSERT_EQ(sorted[k], v[k]);
+                for(size_t i = 0; i < k; ++i)
+                    ASSERT_LE(v[i], v[k]);
+                for(size_t i = k + 1; i < n; ++i)
+                    ASSERT_GE(v[i], v[k]);
+                std::sort(v.begin(), v.end());
+                ASSERT_EQ(sorted, v);
+            }
+        }
+    }
+}
+
+TEST(testCase, nth_element_introselect) {
+    check_select([](int *first, int *nth, int *last) { jrSTL::nth_element(first, nth, last); });
+    // 直接使用中位数的中位数取主元，分别走分块与普通划分
+    check_select([](int *first, int *nth, int *last) {
+        jrSTL::_introselect(first, nth, last, jrSTL::less<int>(), 0, true, std::true_type());
+    });
+    check_select([](int *first, int *nth, int *last) {
+        jrSTL::_introselect(first, nth, last, jrSTL::less<int>(), 0, true, std::false_type());
+    });
+    std::mt19937 gen(5);
+    std::vector<std::string> s(3000), t;
+    for(auto& x : s)
+        x = std::to_string(gen() % 500);
+    t = s;
+    std::nth_element(t.begin(), t.begin() + 1000, t.end(), std::greater<std::string>());
+    jrSTL::nth_element(s.begin(), s.begin() + 1000, s.end(), jrSTL::greater<std::string>());
+    ASSERT_EQ(t[1000], s[1000]);
+    jrSTL::vector<int> e;
+    jrSTL::nth_element(e.begin(), e.begin(), e.end());
+}
+
+TEST(testCase, partial_sort_select) {
+    std::mt19937 gen(7);
+    for(size_t n : {0, 1, 30, 1000, 20000}) {
+        for(int kind = 0; kind < 6; ++kind) {
+            std::vector<int> input = select_input(n, kind, gen);
+            for(size_t k : {size_t(0), size_t(1), n / 10, n}) {
+                if(k > n)
+                    continue;
+                std::vector<int> a = input, b = input;
+                std::partial_sort(a.begin(), a.begin() + k, a.end());
+                jrSTL::partial_sort(b.begin(), b.begin() + k, b.end());
+                ASSERT_TRUE(std::equal(a.begin(), a.begin() + k, b.begin()));
+                std::sort(a.begin(), a.end());
+                std::sort(b.begin(), b.end());
+                ASSERT_EQ(a, b);
+            }
+        }
+    }
+}
+
+TEST(testCase, partial_sort_copy) {
+    std::vector<int> src = {9, 3, 7, 1, 8, 2, 6, 4, 5, 0};
+    std::vector<int> a(4), b(4), c(15), d(15);
+    // 输入迭代器只能遍历一次
+    std::istringstream in1("9 3 7 1 8 2 6 4 5 0"), in2("9 3 7 1 8 2 6 4 5 0");
+    auto ra = std::partial_sort_copy(std::istream_iterator<int>(in1), std::istream_iterator<int>(),
+                                     a.begin(), a.end(), std::greater<int>());
+    auto rb = jrSTL::partial_sort_copy(std::istream_iterator<int>(in2), std::istream_iterator<int>(),
+                                       b.begin(), b.end(), jrSTL::greater<int>());
+    ASSERT_EQ(a, b);
+    ASSERT_EQ(ra - a.begin(), rb - b.begin());
+    auto rc = std::partial_sort_copy(src.begin(), src.end(), c.begin(), c.end());
+    auto rd = jrSTL::partial_sort_copy(src.begin(), src.end(), d.begin(), d.end());
+    ASSERT_EQ(c, d);
+    ASSERT_EQ(rc - c.begin(), rd - d.begin());
+    ASSERT_EQ(d.begin(), jrSTL::partial_sort_copy(src.begin(), src.begin(), d.begin(), d.end()));
+}
+
+TEST(testCase, top_k) {
+    std::mt19937 gen(100);
+    for(size_t k : {0, 1, 10, 100, 5000}) {
+        std::vector<int> input(3000);
+        for(auto& x : input)
+            x = static_cast<int>(gen() % 1000);
+        jrSTL::top_k<int, jrSTL::greater<int> > largest(k);
+        jrSTL::top_k<int> smallest(k);
+        for(int x : input)
+            largest.push(x);
+        smallest.push(input.begin(), input.end());
+        ASSERT_EQ(std::min(k, input.size()), largest.size());
+        std::vector<int> expect(std::min(k, input.size()));
+        std::partial_sort_copy(input.begin(), input.end(), expect.begin(), expect.end(), std::greater<int>());
+        jrSTL::vector<int> got = largest.sorted();
+        ASSERT_TRUE(std::equal(expect.begin(), expect.end(), got.begin()));
+        if(!expect.empty()) {
+            ASSERT_EQ(expect.back(), largest.back());
+        }
+        std::partial_sort_copy(input.begin(), input.end(), expect.begin(), expect.end());
+        got = smallest.sorted();
+        ASSERT_TRUE(std::equal(expect.begin(), expect.end(), got.begin()));
+        // sorted不改变状态，可以继续累加
+        smallest.push(-1);
+        if(k) {
+            ASSERT_EQ(-1, smallest.sorted()[0]);
+        }
+        smallest.clear();
+        ASSERT_TRUE(smallest.empty());
+    }
+    jrSTL::top_k<std::string> words(2);
+    words.push(std::string("pear"));
+    words.push(std::string("apple"));
+    std::string fig = "fig";
+    words.push(fig);
+    ASSERT_EQ("apple", words.sorted()[0]);
+    ASSERT_EQ("fig", words.sorted()[1]);
+}
+
 TEST(testCase, lower_bound) {
     std::vector<int> data = { 1, 2, 4, 5, 5, 6 };
     jrSTL::vector<int> data0 = { 1, 2, 4, 5, 5, 6 };
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include <map>
+#include <list>
+#include <string>
+#include <type_traits>
+#include "../memory/jr_pool_allocator.h"
+#include "../container/sequence/jr_list.h"
+#include "../container/sequence/jr_vector.h"
+#include "../container/associate/jr_map.h"
+#include "../container/associate/jr_unordered_map.h"
+
+#define MAX_SIZE 2000
+
+void get_random_size_var(size_t max_size,
+                         size_t& size,
+                         int& var,
+                         size_t min_size = 0);
+
+// 节点池分配器测试：map/unordered_map的节点取自池，反复插入删除后内容与std一致，
+// 释放的节点被后续插入复用
+TEST(testCase, pool_allocator_test) {
+    size_t cnt;
+    int var;
+    get_random_size_var(MAX_SIZE, cnt, var, 10);
+    typedef jrSTL::pool_allocator<std::pair<const int, int> > alloc;
+    std::map<int, int> src;
+    jrSTL::map<int, int, jrSTL::less<int>, alloc> des;
+    jrSTL::unordered_map<int, int, std::hash<int>, jrSTL::equal_to<int>, alloc> hdes;
+    for(size_t i = 0; i < cnt; i++) {
+        int k = var + static_cast<int>(i * 7919 % cnt);
+        src.insert(std::make_pair(k, static_cast<int>(i)));
+        des.insert(std::make_pair(k, static_cast<int>(i)));
+        hdes.insert(std::make_pair(k, static_cast<int>(i)));
+    }
+    for(size_t i = 0; i < cnt; i += 2) {
+        int k = var + static_cast<int>(i);
+        src.erase(k);
+        des.erase(k);
+        hdes.erase(k);
+    }
+    for(size_t i = 0; i < cnt; i += 3) {
+        int k = var + static_cast<int>(i);
+        src[k] = -1;
+        des[k] = -1;
+        hdes[k] = -1;
+    }
+    ASSERT_EQ(src.size(), des.size());
+    ASSERT_EQ(src.size(), hdes.size());
+    auto it = src.begin();
+    for(auto dit = des.begin(); dit != des.end(); ++dit, ++it) {
+        EXPECT_EQ(*it, *dit);
+        EXPECT_EQ(it->second, hdes[it->first]);
+    }
+
+    // 单个对象的块来自池，经reallocate扩容后内容不变
+    jrSTL::vector<int, jrSTL::pool_allocator<int> > v;
+    v.shrink_to_fit();
+    for(size_t i = 0; i < cnt; i++)
+        v.push_back(static_cast<int>(i));
+    v.resize(1);
+    v.shrink_to_fit();
+    v.push_back(1);
+    ASSERT_EQ(2, v.size());
+    EXPECT_EQ(0, v[0]);
+    EXPECT_EQ(1, v[1]);
+
+    // 大小相同的不同类型各用一个池，release()只归还本类型的slab
+    struct pool_a { long x, y; };
+    struct pool_b { double x, y; };
+    ASSERT_FALSE((std::is_same<jrSTL::pool_allocator<pool_a>::pool_type,
+                               jrSTL::pool_allocator<pool_b>::pool_type>::value));
+    jrSTL::pool_allocator<pool_b> ab;
+    pool_b *b = ab.allocate(1);
+    b->x = 1.5;
+    b->y = 2.5;
+    jrSTL::pool_allocator<pool_a> aa;
+    aa.deallocate(aa.allocate(1), 1);
+    jrSTL::pool_allocator<pool_a>::release();
+    pool_a *a = aa.allocate(1);
+    ASSERT_NE(static_cast<void *>(a), static_cast<void *>(b));
+    a->x = a->y = -1;
+    EXPECT_EQ(1.5, b->x);
+    EXPECT_EQ(2.5, b->y);
+    aa.deallocate(a, 1);
+    ab.deallocate(b, 1);
+}
+
+// 单调区域分配器测试：节点顺序切分自区域，容器析构后一次性归还
+struct arena_test_tag {};
+
+TEST(testCase, arena_allocator_test) {
+    size_t cnt;
+    int var;
+    get_random_size_var(MAX_SIZE, cnt, var, 1);
+    typedef jrSTL::arena_allocator<std::string, arena_test_tag> alloc;
+    {
+        std::list<std::string> src;
+        jrSTL::list<std::string, alloc> des;
+        for(size_t i = 0; i < cnt; i++) {
+            std::string s = std::to_string(var + static_cast<int>(i));
+            if(i % 2) {
+                src.push_back(s);
+                des.push_back(s);
+            } else {
+                src.push_front(s);
+                des.push_front(s);
+            }
+        }
+        ASSERT_EQ(src.size(), des.size());
+        auto it = src.begin();
+        for(auto dit = des.begin(); dit != des.end(); ++dit, ++it)
+            EXPECT_EQ(*it, *dit);
+        jrSTL::vector<std::string, alloc> v;
+        for(auto dit = des.begin(); dit != des.end(); ++dit)
+            v.push_back(*dit);
+        for(size_t i = 0; i < cnt; i++)
+            v.push_back(v[i]);
+        ASSERT_EQ(cnt * 2, v.size());
+        EXPECT_EQ(v[0], v[cnt]);
+        EXPECT_GE(alloc::arena().bytes_used(), cnt * sizeof(std::string));
+    }
+    alloc::arena().release();
+    EXPECT_EQ(0, alloc::arena().bytes_used());
+}
@@ -2,6 +2,7 @@
 #include <random>
 #include <deque>
 #include <iostream>
+#include <string>
 #include "../container/sequence/jr_deque.h"
 
 #define MAX_SIZE 2000
@@ -362,6 +363,42 @@ TEST(testCase, deque_erase_test) {
     EXPECT_EQ(src.size(), des.size());
 }
 
+// 跨越多个存储区的erase：存储区足够大时按段移动（可平凡拷贝的元素memmove），否则逐个移动
+template<class T, size_t BufSize, class Make>
+void deque_erase_segments_check(Make make) {
+    std::mt19937 rng(12345);
+    for(int round = 0; round < 200; ++round) {
+        size_t n = rng() % 300 + 1;
+        jrSTL::deque<T, jrSTL::allocator<T>, BufSize> des;
+        std::deque<T> src;
+        for(size_t i = 0; i < n; ++i) {
+            // 两端交替插入，使起点不在存储区开头
+            T v = make(static_cast<int>(rng()));
+            if(i % 3) {
+                des.push_back(v);
+                src.push_back(v);
+            } else {
+                des.push_front(v);
+                src.push_front(v);
+            }
+        }
+        size_t first = rng() % n, len = rng() % (n - first + 1);
+        auto it = des.erase(des.cbegin() + first, des.cbegin() + (first + len));
+        src.erase(src.begin() + first, src.begin() + (first + len));
+        ASSERT_EQ(static_cast<size_t>(it - des.begin()), first);
+        ASSERT_EQ(src.size(), des.size());
+        for(size_t i = 0; i < des.size(); ++i)
+            ASSERT_EQ(src[i], des[i]);
+    }
+}
+
+TEST(testCase, deque_erase_segments_test) {
+    deque_erase_segments_check<int, 8>([](int x) { return x; });
+    deque_erase_segments_check<int, 64>([](int x) { return x; });
+    deque_erase_segments_check<std::string, 8>([](int x) { return std::to_string(x); });
+    deque_erase_segments_check<std::string, 16>([](int x) { return std::to_string(x); });
+}
+
 // swap测试
 TEST(testCase, deque_swap_test) {
     size_t cnt;
@@ -415,3 +452,46 @@ TEST(testCase, deque_iterator_sub_test) {
     rit -= 5;
     EXPECT_EQ(*it, *rit);
 }
+
+// 头尾交替插入删除测试：两端操作不移动已有元素
+TEST(testCase, deque_front_back_mixed_test) {
+    size_t cnt;
+    int var;
+    get_random_size_var(MAX_SIZE * 10, cnt, var, 100);
+    std::deque<int> src;
+    jrSTL::deque<int> des;
+    des.push_back(var);
+    src.push_back(var);
+    const int *first = &des.front();
+    for(size_t i = 0; i < cnt; i++) {
+        int n = static_cast<int>(i);
+        if(i % 2) {
+            src.push_front(n);
+            des.push_front(n);
+        } else {
+            src.push_back(n);
+            des.push_back(n);
+        }
+    }
+    // map扩充只移动存储区指针，元素地址保持不变
+    EXPECT_EQ(first, &des[cnt / 2]);
+    ASSERT_EQ(src.size(), des.size());
+    for(size_t i = 0; i < des.size(); ++i)
+        EXPECT_EQ(src[i], des[i]);
+    // 队列用法：从尾部入队、从头部出队
+    for(size_t i = 0; i < cnt * 2; i++) {
+        src.push_back(static_cast<int>(i));
+        des.push_back(static_cast<int>(i));
+        src.pop_front();
+        des.pop_front();
+    }
+    ASSERT_EQ(src.size(), des.size());
+    for(size_t i = 0; i < des.size(); ++i)
+        EXPECT_EQ(src[i], des[i]);
+    while(!des.empty()) {
+        EXPECT_EQ(src.back(), des.back());
+        src.pop_back();
+        des.pop_back();
+    }
+    EXPECT_EQ(des.begin(), des.end());
+}
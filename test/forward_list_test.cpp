@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include <random>
 #include <forward_list>
+#include <string>
 #include <iostream>
 #include "../container/sequence/jr_forward_list.h"
 
@@ -510,6 +511,21 @@ TEST(testCase, forward_list_unique_test) {
     EXPECT_EQ(std::distance(src.begin(), src.end()), jrSTL::distance(des.begin(), des.end()));
 }
 
+TEST(testCase, forward_list_unique_predicate_test) {
+    std::forward_list<std::string> src{"apple", "avocado", "banana", "blueberry", "cherry", "apricot", "apple"};
+    jrSTL::forward_list<std::string> des{"apple", "avocado", "banana", "blueberry", "cherry", "apricot", "apple"};
+    auto same_initial = [](const std::string& a, const std::string& b) { return a[0] == b[0]; };
+    src.unique(same_initial);
+    des.unique(same_initial);
+    auto it = src.begin();
+    for(auto dit = des.begin(); dit != des.end(); ++dit, ++it)
+        EXPECT_EQ(*it, *dit);
+    EXPECT_EQ(it, src.end());
+    jrSTL::forward_list<std::string> none;
+    none.unique();
+    EXPECT_TRUE(none.empty());
+}
+
 // remove测试
 TEST(testCase, forward_list_reove_test) {
     std::forward_list<int> src0{32,53423,4245,25,234,25,45,2,4245,25,234,25,45,2,4245,25,234,25,45,2,4245,25,234,25,45,2,235,23,24,6,47,6,5224,2};
@@ -535,3 +551,34 @@ TEST(testCase, forward_list_reverse_test) {
     for(; dit0 != des0.end(); ++dit0, ++it0)
         EXPECT_EQ(*it0, *dit0);
 }
+
+// 大规模稳定排序与两种排序方式测试
+TEST(testCase, forward_list_sort_large_test) {
+    size_t cnt;
+    int var;
+    get_random_size_var(MAX_SIZE * 50, cnt, var);
+    std::mt19937 rng(static_cast<unsigned>(var));
+    std::forward_list<std::pair<int, int> > src;
+    jrSTL::forward_list<std::pair<int, int> > des0, des1;
+    for(size_t i = 0; i < cnt; i++) {
+        std::pair<int, int> x(static_cast<int>(rng() % 100), static_cast<int>(i));
+        src.push_front(x);
+        des0.push_front(x);
+        des1.push_front(x);
+    }
+    auto by_key = [](const std::pair<int, int>& a, const std::pair<int, int>& b) {
+        return a.first < b.first;
+    };
+    src.sort(by_key);
+    des0.sort(by_key);
+    des1.sort(by_key, jrSTL::list_sort_by_pointer());
+    auto it = src.begin();
+    auto dit0 = des0.begin(), dit1 = des1.begin();
+    for(; it != src.end(); ++dit0, ++dit1, ++it) {
+        ASSERT_TRUE(dit0 != des0.end());
+        ASSERT_EQ(*it, *dit0);
+        ASSERT_EQ(*it, *dit1);
+    }
+    ASSERT_TRUE(dit0 == des0.end());
+    ASSERT_TRUE(dit1 == des1.end());
+}
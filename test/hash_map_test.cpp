@@ -444,6 +444,74 @@ TEST(testCase, unordered_map_range) {
     EXPECT_EQ(i2, p2.second);
 }
 
+// 开放定址引擎测试：随机插入/删除后与std::unordered_map对比
+TEST(testCase, unordered_map_flat_policy) {
+    size_t cnt;
+    int var;
+    get_random_size_var(MAX_SIZE * 10, cnt, var, 100);
+    std::unordered_map<int, int> src;
+    jrSTL::unordered_map<int, int, std::hash<int>, jrSTL::equal_to<int>,
+                         jrSTL::allocator<std::pair<const int, int> >,
+                         jrSTL::flat_hash_policy> des;
+    for(size_t i = 0; i < cnt; i++) {
+        int k = rand() % static_cast<int>(cnt);
+        if(rand() % 3) {
+            EXPECT_EQ(src.insert({k, k}).second, des.insert({k, k}).second);
+        } else {
+            EXPECT_EQ(src.erase(k), des.erase(k));
+        }
+    }
+    ASSERT_EQ(src.size(), des.size());
+    size_t n = 0;
+    for(auto it = des.begin(); it != des.end(); ++it, ++n)
+        EXPECT_EQ(1, src.count(it->first));
+    EXPECT_EQ(src.size(), n);
+    for(int i = 0; i < static_cast<int>(cnt); i++) {
+        EXPECT_EQ(src.count(i), des.count(i));
+        if(src.count(i)) {
+            EXPECT_EQ(src[i], des[i]);
+        }
+    }
+    des.clear();
+    EXPECT_EQ(0, des.size());
+    EXPECT_EQ(des.begin(), des.end());
+}
+
+// 负载因子与重新散列测试：哈希值范围很大时桶数仍只随元素个数增长
+struct wide_hash{
+    size_t operator()(int n) const {
+        return (static_cast<size_t>(1) << 40) + static_cast<size_t>(n) * 4096;
+    }
+};
+
+TEST(testCase, unordered_map_rehash) {
+    size_t cnt;
+    int var;
+    get_random_size_var(MAX_SIZE * 10, cnt, var, 100);
+    jrSTL::unordered_map<int, int, wide_hash> des;
+    for(int i = 0; i < static_cast<int>(cnt); i++)
+        des.insert({i, i});
+    ASSERT_EQ(cnt, des.size());
+    EXPECT_LE(des.load_factor(), des.max_load_factor());
+    EXPECT_LT(des.bucket_count(), cnt * 4);
+    // 调低最大负载因子后桶数随之增加
+    des.max_load_factor(0.25f);
+    EXPECT_LE(des.load_factor(), 0.25f);
+    des.reserve(cnt * 8);
+    EXPECT_GE(des.bucket_count() * des.max_load_factor(), cnt * 8);
+    des.rehash(0);
+    EXPECT_LE(des.load_factor(), 0.25f);
+    size_t n = 0;
+    for(size_t b = 0; b < des.bucket_count(); b++) {
+        n += des.bucket_size(b);
+        for(auto it = des.begin(b); it != des.end(b); ++it)
+            EXPECT_EQ(b, des.bucket(it->first));
+    }
+    EXPECT_EQ(cnt, n);
+    for(int i = 0; i < static_cast<int>(cnt); i++)
+        EXPECT_EQ(i, des.find(i)->second);
+}
+
 //// 桶接口测试
 //TEST(testCase, unordered_set_bucket) {
 //    // 打印某个桶
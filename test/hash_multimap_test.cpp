@@ -439,6 +439,32 @@ TEST(testCase, unordered_multimap_range) {
     EXPECT_EQ(i2, p2.second);
 }
 
+// 重新散列测试：等值元素在重新散列后仍然相邻
+TEST(testCase, unordered_multimap_rehash) {
+    size_t cnt;
+    int var;
+    get_random_size_var(MAX_SIZE, cnt, var, 100);
+    std::unordered_multimap<int, int> src;
+    jrSTL::unordered_multimap<int, int> des;
+    for(size_t i = 0; i < cnt * 4; i++) {
+        int k = rand() % static_cast<int>(cnt);
+        src.insert({k, i});
+        des.insert({k, i});
+    }
+    des.rehash(cnt * 16);
+    des.max_load_factor(4.0f);
+    des.rehash(0);
+    ASSERT_EQ(src.size(), des.size());
+    for(int i = 0; i < static_cast<int>(cnt); i++) {
+        auto p = des.equal_range(i);
+        size_t n = 0;
+        for(auto it = p.first; it != p.second; ++it, ++n)
+            EXPECT_EQ(i, it->first);
+        EXPECT_EQ(src.count(i), n);
+        EXPECT_EQ(src.count(i), des.count(i));
+    }
+}
+
 //// 桶接口测试
 //TEST(testCase, unordered_set_bucket) {
 //    // 打印某个桶
@@ -440,6 +440,38 @@ TEST(testCase, unordered_set_range) {
     EXPECT_EQ(i2, p2.second);
 }
 
+// 开放定址引擎测试：随机插入/删除后与std::unordered_set对比
+TEST(testCase, unordered_set_flat_policy) {
+    size_t cnt;
+    int var;
+    get_random_size_var(MAX_SIZE * 10, cnt, var, 100);
+    std::unordered_set<int> src;
+    jrSTL::unordered_set<int, std::hash<int>, jrSTL::equal_to<int>,
+                         jrSTL::allocator<int>, jrSTL::flat_hash_policy> des;
+    for(size_t i = 0; i < cnt; i++) {
+        int k = rand() % static_cast<int>(cnt);
+        if(rand() % 3) {
+            EXPECT_EQ(src.insert(k).second, des.insert(k).second);
+        } else {
+            EXPECT_EQ(src.erase(k), des.erase(k));
+        }
+    }
+    ASSERT_EQ(src.size(), des.size());
+    // 迭代器删除奇数元素
+    for(auto it = des.begin(); it != des.end(); ) {
+        if(*it % 2) {
+            src.erase(*it);
+            it = des.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    ASSERT_EQ(src.size(), des.size());
+    des.rehash(cnt * 4);
+    for(int i = 0; i < static_cast<int>(cnt); i++)
+        EXPECT_EQ(src.count(i), des.count(i));
+}
+
 //// 桶接口测试
 //TEST(testCase, unordered_set_bucket) {
 //    // 打印某个桶
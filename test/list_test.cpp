@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include <random>
 #include <list>
+#include <string>
+#include <vector>
 #include "../container/sequence/jr_list.h"
 
 #define MAX_SIZE 2000
@@ -502,6 +504,43 @@ TEST(testCase, list_sort_test) {
         EXPECT_EQ(*it, *dit);
 }
 
+// 大规模稳定排序与两种排序方式测试
+TEST(testCase, list_sort_large_test) {
+    size_t cnt;
+    int var;
+    get_random_size_var(MAX_SIZE * 50, cnt, var);
+    std::mt19937 rng(static_cast<unsigned>(var));
+    std::list<std::pair<int, int> > src;
+    jrSTL::list<std::pair<int, int> > des0, des1;
+    for(size_t i = 0; i < cnt; i++) {
+        std::pair<int, int> x(static_cast<int>(rng() % 100), static_cast<int>(i));
+        src.push_back(x);
+        des0.push_back(x);
+        des1.push_back(x);
+    }
+    auto by_key = [](const std::pair<int, int>& a, const std::pair<int, int>& b) {
+        return a.first < b.first;
+    };
+    src.sort(by_key);
+    des0.sort(by_key);
+    des1.sort(by_key, jrSTL::list_sort_by_pointer());
+    ASSERT_EQ(src.size(), des0.size());
+    ASSERT_EQ(src.size(), des1.size());
+    auto it = src.begin();
+    auto dit0 = des0.begin(), dit1 = des1.begin();
+    for(; dit0 != des0.end(); ++dit0, ++dit1, ++it) {
+        ASSERT_EQ(*it, *dit0);
+        ASSERT_EQ(*it, *dit1);
+    }
+    // 反向遍历检查prev指针
+    auto rit = src.rbegin();
+    for(auto rdit = des0.rbegin(); rdit != des0.rend(); ++rdit, ++rit)
+        ASSERT_EQ(*rit, *rdit);
+    des0.push_back(std::make_pair(-1, -1));
+    des0.push_front(std::make_pair(-2, -2));
+    ASSERT_EQ(cnt + 2, des0.size());
+}
+
 // merge测试
 TEST(testCase, list_merge_test) {
     std::list<int> src0{32,53423,4245,25,234,25,45,2,235,23,24,6,47,6,5224,2};
@@ -618,6 +657,26 @@ TEST(testCase, list_unique_test) {
     EXPECT_EQ(src.size(), des.size());
 }
 
+// 每段保留第一个元素，谓词的参数顺序为(保留者, 当前元素)
+TEST(testCase, list_unique_predicate_test) {
+    typedef std::pair<int, std::string> P;
+    std::list<P> src{{1, "a"}, {1, "b"}, {2, "c"}, {2, "d"}, {2, "e"}, {1, "f"}, {3, "g"}, {3, "h"}};
+    jrSTL::list<P> des{{1, "a"}, {1, "b"}, {2, "c"}, {2, "d"}, {2, "e"}, {1, "f"}, {3, "g"}, {3, "h"}};
+    std::vector<P> src_args, des_args;
+    src.unique([&src_args](const P& a, const P& b) { src_args.push_back(a); return a.first == b.first; });
+    des.unique([&des_args](const P& a, const P& b) { des_args.push_back(a); return a.first == b.first; });
+    ASSERT_EQ(src.size(), des.size());
+    ASSERT_EQ(src_args, des_args);
+    auto it = src.begin();
+    for(auto dit = des.begin(); dit != des.end(); ++dit, ++it)
+        EXPECT_EQ(*it, *dit);
+    jrSTL::list<std::string> one{"x"}, none;
+    one.unique();
+    none.unique();
+    EXPECT_EQ(1u, one.size());
+    EXPECT_EQ(0u, none.size());
+}
+
 // remove测试
 TEST(testCase, list_reove_test) {
     std::list<int> src0{32,53423,4245,25,234,25,45,2,4245,25,234,25,45,2,4245,25,234,25,45,2,4245,25,234,25,45,2,235,23,24,6,47,6,5224,2};
@@ -629,6 +688,15 @@ TEST(testCase, list_reove_test) {
     auto dit0 = des0.begin();
     for(; dit0 != des0.end(); ++dit0, ++it0)
         EXPECT_EQ(*it0, *dit0);
+    // 相邻的多个元素被删除
+    std::list<std::string> src1{"a", "bb", "cc", "d", "ee", "ff", "gg"};
+    jrSTL::list<std::string> des1{"a", "bb", "cc", "d", "ee", "ff", "gg"};
+    src1.remove_if([](const std::string& x){ return x.size() == 2; });
+    des1.remove_if([](const std::string& x){ return x.size() == 2; });
+    ASSERT_EQ(src1.size(), des1.size());
+    auto it1 = src1.begin();
+    for(auto dit1 = des1.begin(); dit1 != des1.end(); ++dit1, ++it1)
+        EXPECT_EQ(*it1, *dit1);
 }
 
 // 反转测试
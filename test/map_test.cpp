@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include <map>
+#include <string>
 #include "../container/sequence/jr_deque.h"
 #include "../container/associate/jr_map.h"
 
@@ -463,3 +464,61 @@ TEST(testCase, map_range) {
     else
         EXPECT_EQ(*p1.second, *p2.second);
 }
+
+// 大规模顺序插入/删除测试（缓存高度后插入删除为O(log n)）
+TEST(testCase, map_bulk_insert_erase_test) {
+    const int n = 100000;
+    std::map<int,int> src;
+    jrSTL::map<int,int> des;
+    for(int i = 0; i < n; i++) {
+        src.insert(std::make_pair(i, i));
+        des.insert(std::make_pair(i, i));
+    }
+    ASSERT_EQ(des.size(), src.size());
+    for(int i = 0; i < n; i += 2) {
+        EXPECT_EQ(src.erase(i), des.erase(i));
+    }
+    ASSERT_EQ(des.size(), src.size());
+    auto it = src.begin();
+    auto dit = des.begin();
+    for(; dit != des.end(); ++dit, ++it)
+        EXPECT_EQ(*it, *dit);
+}
+
+// 透明比较器下的异构查找测试
+TEST(testCase, map_heterogeneous_lookup) {
+    jrSTL::map<std::string, int, jrSTL::less<> > des;
+    des.insert(std::make_pair(std::string("apple"), 1));
+    des.insert(std::make_pair(std::string("banana"), 2));
+    des.insert(std::make_pair(std::string("cherry"), 3));
+    const char *key = "banana";
+    ASSERT_EQ(des.find(key) != des.end(), true);
+    EXPECT_EQ(des.find(key)->second, 2);
+    EXPECT_EQ(des.find("durian") == des.end(), true);
+    EXPECT_EQ(des.count("apple"), 1);
+    EXPECT_EQ(des.lower_bound("b")->first, "banana");
+    EXPECT_EQ(des.upper_bound("banana")->first, "cherry");
+    auto p = des.equal_range("cherry");
+    EXPECT_EQ(p.first->second, 3);
+    EXPECT_EQ(p.second == des.end(), true);
+}
+
+// 顺序统计nth,rank测试
+TEST(testCase, map_nth_rank) {
+    size_t cnt;
+    int var;
+    get_random_size_var(MAX_SIZE, cnt, var, 1);
+    std::map<int,int> src;
+    jrSTL::map<int,int> des;
+    for(size_t i = 0; i < cnt; i++) {
+        src.insert(std::make_pair(var, i));
+        des.insert(std::make_pair(var, i));
+        var -= 3;
+    }
+    size_t k = 0;
+    for(auto it = src.begin(); it != src.end(); ++it, ++k) {
+        EXPECT_EQ(*it, *des.nth(k));
+        EXPECT_EQ(k, des.rank(it->first));
+        EXPECT_EQ(k + 1, des.rank(it->first + 1));
+    }
+}
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include <set>
+#include <string>
 #include <algorithm>
 #include "../container/sequence/jr_deque.h"
 #include "../container/associate/jr_set.h"
@@ -460,3 +461,72 @@ TEST(testCase, multiset_range) {
     else
         EXPECT_EQ(*p1.second, *p2.second);
 }
+
+// 逐键比较lower_bound,upper_bound,equal_range的结果
+TEST(testCase, multiset_bound_all_keys) {
+    size_t cnt;
+    int var;
+    get_random_size_var(MAX_SIZE, cnt, var, 1);
+    std::multiset<int> src;
+    jrSTL::multiset<int> des;
+    for(int i = 0; i < static_cast<int>(cnt); i++) {
+        src.insert(i * 2 % 97);
+        des.insert(i * 2 % 97);
+    }
+    for(int k = -1; k <= 97; k++) {
+        EXPECT_EQ(std::distance(src.begin(), src.lower_bound(k)),
+                  jrSTL::distance(des.begin(), des.lower_bound(k)));
+        EXPECT_EQ(std::distance(src.begin(), src.upper_bound(k)),
+                  jrSTL::distance(des.begin(), des.upper_bound(k)));
+        EXPECT_EQ(src.count(k), des.count(k));
+    }
+}
+
+// 顺序统计nth,rank测试
+TEST(testCase, multiset_nth_rank) {
+    size_t cnt;
+    int var;
+    get_random_size_var(MAX_SIZE, cnt, var, 1);
+    std::multiset<int> src;
+    jrSTL::multiset<int> des;
+    for(int i = 0; i < static_cast<int>(cnt); i++) {
+        src.insert(i * 7 % 31);
+        des.insert(i * 7 % 31);
+    }
+    auto it = src.begin();
+    for(size_t k = 0; k < src.size(); ++k, ++it)
+        EXPECT_EQ(*it, *des.nth(k));
+    EXPECT_EQ(des.nth(des.size()) == des.end(), true);
+    for(int k = -1; k <= 31; k++) {
+        EXPECT_EQ(static_cast<size_t>(std::distance(src.begin(), src.lower_bound(k))),
+                  des.rank(k));
+    }
+    // 删除后子树大小仍应正确
+    for(int k = 0; k < 31; k += 3)
+        des.erase(k), src.erase(k);
+    it = src.begin();
+    for(size_t k = 0; k < src.size(); ++k, ++it)
+        EXPECT_EQ(*it, *des.nth(k));
+}
+
+// 按迭代器删除重复键中的一个：键即被删节点自身的数据，删除后不能再被用来比较
+TEST(testCase, multiset_erase_duplicate_position_test) {
+    std::multiset<std::string> src;
+    jrSTL::multiset<std::string> des;
+    for(int i = 0; i < 300; ++i) {
+        std::string s = "key-" + std::to_string(i % 7);
+        src.insert(s);
+        des.insert(s);
+    }
+    while(!des.empty()) {
+        size_t pos = des.size() * 5 / 11;
+        auto i = src.begin();
+        auto j = des.begin();
+        std::advance(i, pos);
+        jrSTL::advance(j, pos);
+        src.erase(i);
+        des.erase(j);
+        ASSERT_EQ(src.size(), des.size());
+        ASSERT_TRUE(std::equal(src.begin(), src.end(), des.begin()));
+    }
+}
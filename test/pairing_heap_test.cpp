@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include <queue>
+#include <vector>
+#include <functional>
+#include "../container/adapter/jr_pairing_heap.h"
+
+#define MAX_SIZE 2000
+
+void get_random_size_var(size_t max_size,
+                         size_t& size,
+                         int& var,
+                         size_t min_size = 0);
+
+// push、pop、top、emplace测试
+TEST(testCase, pairing_heap_mem_fn_test) {
+    size_t cnt;
+    int var;
+    get_random_size_var(MAX_SIZE, cnt, var);
+    std::priority_queue<int> src;
+    jrSTL::pairing_heap<int> des;
+    for(size_t i = 0; i < cnt; i++) {
+        int x = static_cast<int>((i * 2654435761u) % 997) - var;
+        src.push(x);
+        des.push(x);
+        if(i % 3 == 0) {
+            src.pop();
+            des.pop();
+        }
+    }
+    src.emplace(-108);
+    des.emplace(-108);
+    ASSERT_EQ(src.size(), des.size());
+    while(!des.empty()) {
+        EXPECT_EQ(src.top(), des.top());
+        src.pop();
+        des.pop();
+    }
+}
+
+// decrease_key、erase、merge测试
+TEST(testCase, pairing_heap_handle_test) {
+    size_t cnt;
+    int var;
+    get_random_size_var(MAX_SIZE, cnt, var, 2);
+    jrSTL::pairing_heap<int, jrSTL::greater<int> > des, other;
+    std::vector<jrSTL::pairing_heap<int, jrSTL::greater<int> >::handle> handles;
+    std::vector<int> keys;
+    for(size_t i = 0; i < cnt; i++) {
+        int x = static_cast<int>((i * 2654435761u) % 10007);
+        handles.push_back(i % 2 ? des.push(x) : other.push(x));
+        keys.push_back(x);
+    }
+    des.merge(other);
+    ASSERT_TRUE(other.empty());
+    ASSERT_EQ(cnt, des.size());
+    for(size_t i = 0; i < cnt; i += 3) {
+        keys[i] -= static_cast<int>(i % 100) + 1;
+        des.decrease_key(handles[i], keys[i]);
+        ASSERT_EQ(keys[i], *handles[i]);
+    }
+    std::priority_queue<int, std::vector<int>, std::greater<int> > src;
+    for(size_t i = 0; i < cnt; i++) {
+        if(i % 5 == 1)
+            des.erase(handles[i]);
+        else
+            src.push(keys[i]);
+    }
+    ASSERT_EQ(src.size(), des.size());
+    while(!des.empty()) {
+        EXPECT_EQ(src.top(), des.top());
+        src.pop();
+        des.pop();
+    }
+}
+
+// 以Dijkstra最短路对比decrease_key与std::priority_queue的惰性删除
+TEST(testCase, pairing_heap_dijkstra_test) {
+    size_t n;
+    int var;
+    get_random_size_var(MAX_SIZE, n, var, 2);
+    std::vector<std::vector<std::pair<size_t, long long> > > g(n);
+    unsigned seed = static_cast<unsigned>(var) + 12345u;
+    for(size_t u = 0; u < n; u++) {
+        for(int k = 0; k < 4; k++) {
+            seed = seed * 1103515245u + 12345u;
+            size_t v = (seed >> 8) % n;
+            g[u].push_back(std::make_pair(v, static_cast<long long>((seed >> 4) % 100 + 1)));
+        }
+        g[u].push_back(std::make_pair((u + 1) % n, 1000LL));
+    }
+    const long long inf = -1;
+    std::vector<long long> d1(n, inf), d2(n, inf);
+    typedef std::pair<long long, size_t> item;
+    std::priority_queue<item, std::vector<item>, std::greater<item> > lazy;
+    d1[0] = 0;
+    lazy.push(item(0, 0));
+    while(!lazy.empty()) {
+        item t = lazy.top();
+        lazy.pop();
+        if(t.first != d1[t.second])
+            continue;
+        for(size_t k = 0; k < g[t.second].size(); k++) {
+            size_t v = g[t.second][k].first;
+            long long nd = t.first + g[t.second][k].second;
+            if(d1[v] == inf || nd < d1[v]) {
+                d1[v] = nd;
+                lazy.push(item(nd, v));
+            }
+        }
+    }
+    typedef jrSTL::pairing_heap<item, jrSTL::greater<item> > heap;
+    heap h;
+    std::vector<heap::handle> handle(n);
+    std::vector<bool> in_heap(n, false);
+    d2[0] = 0;
+    handle[0] = h.push(item(0, 0));
+    in_heap[0] = true;
+    while(!h.empty()) {
+        item t = h.top();
+        h.pop();
+        in_heap[t.second] = false;
+        for(size_t k = 0; k < g[t.second].size(); k++) {
+            size_t v = g[t.second][k].first;
+            long long nd = t.first + g[t.second][k].second;
+            if(d2[v] == inf) {
+                d2[v] = nd;
+                handle[v] = h.push(item(nd, v));
+                in_heap[v] = true;
+            } else if(nd < d2[v]) {
+                d2[v] = nd;
+                ASSERT_TRUE(in_heap[v]);
+                h.decrease_key(handle[v], item(nd, v));
+            }
+        }
+    }
+    for(size_t i = 0; i < n; i++)
+        ASSERT_EQ(d1[i], d2[i]);
+}
@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 #include <queue>
+#include <vector>
+#include <algorithm>
 #include "../container/adapter/jr_priority_queue.h"
 
 #define MAX_SIZE 2000
@@ -130,3 +132,99 @@ TEST(testCase, priority_queue_swap_test) {
         tmp0.pop();
     }
 }
+
+// 建堆、以容器构造与批量插入测试
+TEST(testCase, priority_queue_bulk_test) {
+    size_t cnt;
+    int var;
+    get_random_size_var(MAX_SIZE * 50, cnt, var, 1);
+    jrSTL::vector<int> v;
+    std::vector<int> s;
+    for(size_t i = 0; i < cnt; i++) {
+        int x = static_cast<int>((i * 2654435761u) % 1000) - var;
+        v.push_back(x);
+        s.push_back(x);
+    }
+    jrSTL::vector<int> h(v);
+    jrSTL::make_heap(h.begin(), h.end());
+    ASSERT_TRUE(jrSTL::is_heap(h.begin(), h.end()));
+    ASSERT_TRUE(std::is_heap(h.begin(), h.end()));
+    jrSTL::sort_heap(h.begin(), h.end());
+    std::sort(s.begin(), s.end());
+    for(size_t i = 0; i < cnt; i++)
+        ASSERT_EQ(s[i], h[i]);
+    ASSERT_TRUE(jrSTL::is_heap_until(h.begin(), h.end()) == std::is_heap_until(h.begin(), h.end()));
+
+    std::priority_queue<int> src(std::less<int>(), std::vector<int>(s.rbegin(), s.rend()));
+    jrSTL::priority_queue<int> des(jrSTL::less<int>(), v);
+    jrSTL::priority_queue<int> bulk;
+    bulk.reserve(cnt * 2);
+    bulk.push_range(v.begin(), v.end());
+    bulk.push(var);
+    bulk.push_range(v.begin(), v.begin() + cnt / 100);
+    std::priority_queue<int> ref(s.begin(), s.end());
+    ref.push(var);
+    for(size_t i = 0; i < cnt / 100; i++)
+        ref.push(v[i]);
+    ASSERT_EQ(src.size(), des.size());
+    while(!des.empty()) {
+        ASSERT_EQ(src.top(), des.top());
+        src.pop();
+        des.pop();
+    }
+    ASSERT_EQ(ref.size(), bulk.size());
+    while(!bulk.empty()) {
+        ASSERT_EQ(ref.top(), bulk.top());
+        ref.pop();
+        bulk.pop();
+    }
+}
+
+// d叉堆测试
+TEST(testCase, priority_queue_arity_test) {
+    size_t cnt;
+    int var;
+    get_random_size_var(MAX_SIZE * 10, cnt, var);
+    std::vector<int> s;
+    for(size_t i = 0; i < cnt; i++)
+        s.push_back(static_cast<int>((i * 2654435761u) % 1000) - var);
+    std::vector<int> h4(s), h8(s);
+    jrSTL::make_heap<4>(h4.begin(), h4.end());
+    jrSTL::make_heap<8>(h8.begin(), h8.end(), jrSTL::greater<int>());
+    ASSERT_TRUE(jrSTL::is_heap<4>(h4.begin(), h4.end()));
+    ASSERT_TRUE(jrSTL::is_heap<8>(h8.begin(), h8.end(), jrSTL::greater<int>()));
+    jrSTL::sort_heap<4>(h4.begin(), h4.end());
+    jrSTL::sort_heap<8>(h8.begin(), h8.end(), jrSTL::greater<int>());
+    std::vector<int> asc(s);
+    std::sort(asc.begin(), asc.end());
+    ASSERT_TRUE(asc == h4);
+    ASSERT_TRUE(std::equal(asc.rbegin(), asc.rend(), h8.begin()));
+
+    std::priority_queue<int> src;
+    jrSTL::priority_queue<int, jrSTL::vector<int>, jrSTL::less<int>, 4> des4;
+    jrSTL::priority_queue<int, jrSTL::vector<int>, jrSTL::less<int>, 8> des8;
+    for(size_t i = 0; i < cnt; i++) {
+        src.push(s[i]);
+        des4.push(s[i]);
+        des8.push(s[i]);
+        if(i % 4 == 0) {
+            src.pop();
+            des4.pop();
+            des8.pop();
+        }
+    }
+    des8.push_range(s.begin(), s.end());
+    ASSERT_EQ(src.size(), des4.size());
+    while(!des4.empty()) {
+        ASSERT_EQ(src.top(), des4.top());
+        src.pop();
+        des4.pop();
+    }
+    int prev = des8.top();
+    ASSERT_EQ(cnt - (cnt + 3) / 4 + cnt, des8.size());
+    while(!des8.empty()) {
+        ASSERT_LE(des8.top(), prev);
+        prev = des8.top();
+        des8.pop();
+    }
+}
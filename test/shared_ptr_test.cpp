@@ -6,6 +6,8 @@
 #include <chrono>
 #include <mutex>
 #include <sstream>
+#include <atomic>
+#include <vector>
 
 /*构造函数测试*/
 std::string ctor = "", ctor0 = "";
@@ -195,3 +197,282 @@ TEST(testCase, shared_ptr_type_cast_test) {
 
     ASSERT_EQ(cast, cast0);
 }
+
+/*多线程拷贝、销毁测试*/
+TEST(testCase, shared_ptr_thread_test) {
+    static std::atomic<int> dtor(0);
+    struct Foo {
+        int bar = 7;
+        ~Foo() { ++dtor; }
+    };
+
+    const int threads = 4, rounds = 20000;
+    for(int k = 0; k < 10; ++k) {
+        jrSTL::shared_ptr<Foo> sp(new Foo);
+        std::vector<std::thread> ts;
+        for(int t = 0; t < threads; ++t) {
+            // 每个线程持有自己的拷贝，最后一个释放者不确定
+            ts.push_back(std::thread([sp]() mutable {
+                for(int i = 0; i < rounds; ++i) {
+                    jrSTL::shared_ptr<Foo> c(sp);
+                    jrSTL::shared_ptr<Foo> d;
+                    d = c;
+                    ASSERT_EQ(d->bar, 7);
+                }
+                sp.reset();
+            }));
+        }
+        sp.reset();
+        ASSERT_EQ(sp.use_count(), 0);
+        for(auto& t : ts)
+            t.join();
+        ASSERT_EQ(dtor.load(), k + 1);
+    }
+}
+
+/*空指针与移动测试*/
+TEST(testCase, shared_ptr_move_test) {
+    jrSTL::shared_ptr<int> a(new int(3));
+    jrSTL::shared_ptr<int> b(std::move(a));
+    ASSERT_EQ(a.use_count(), 0);
+    ASSERT_FALSE(a);
+    ASSERT_EQ(b.use_count(), 1);
+    jrSTL::shared_ptr<int> c;
+    c = b;
+    c = c;
+    ASSERT_EQ(b.use_count(), 2);
+    c = std::move(b);
+    ASSERT_EQ(c.use_count(), 1);
+    ASSERT_EQ(*c, 3);
+    c.reset();
+    ASSERT_EQ(c.use_count(), 0);
+}
+
+/*allocate_shared单次分配测试*/
+static int alloc_calls = 0, dealloc_calls = 0;
+
+template<class T>
+struct counting_allocator : jrSTL::allocator<T> {
+    template<class U>
+    struct rebind {
+        typedef counting_allocator<U> other;
+    };
+
+    counting_allocator() {}
+
+    template<class U>
+    counting_allocator(const counting_allocator<U>&) {}
+
+    T *allocate(size_t n) {
+        ++alloc_calls;
+        return jrSTL::allocator<T>::allocate(n);
+    }
+
+    void deallocate(T *p, size_t n) {
+        ++dealloc_calls;
+        jrSTL::allocator<T>::deallocate(p, n);
+    }
+};
+
+TEST(testCase, shared_ptr_allocate_shared_test) {
+    struct Foo {
+        std::string s;
+        double d;
+        Foo(const std::string& a, double b) : s(a), d(b) {}
+    };
+
+    {
+        jrSTL::shared_ptr<Foo> sp =
+            jrSTL::allocate_shared<Foo>(counting_allocator<Foo>(), "abc", 1.5);
+        ASSERT_EQ(alloc_calls, 1);
+        ASSERT_EQ(sp->s, "abc");
+        ASSERT_EQ(sp->d, 1.5);
+        ASSERT_EQ(reinterpret_cast<size_t>(sp.get()) % alignof(Foo), 0u);
+        jrSTL::weak_ptr<Foo> wp(sp);
+        sp.reset();
+        // 对象已析构，弱引用仍持有控制块，内存尚未释放
+        ASSERT_TRUE(wp.expired());
+        ASSERT_EQ(dealloc_calls, 0);
+    }
+    ASSERT_EQ(dealloc_calls, 1);
+
+    // 自定义删除器与分配器：控制块由分配器分配，删除器可通过get_deleter取回
+    int deleted = 0;
+    auto del = [&deleted](int *p) { ++deleted; delete p; };
+    {
+        jrSTL::shared_ptr<int> sp(new int(5), del, counting_allocator<int>());
+        ASSERT_EQ(alloc_calls, 2);
+        ASSERT_TRUE(jrSTL::get_deleter<decltype(del)>(sp) != nullptr);
+        ASSERT_TRUE(jrSTL::get_deleter<jrSTL::default_delete<int> >(sp) == nullptr);
+    }
+    ASSERT_EQ(deleted, 1);
+    ASSERT_EQ(dealloc_calls, 2);
+}
+
+/*原子操作测试*/
+TEST(testCase, shared_ptr_atomic_test) {
+    jrSTL::shared_ptr<int> a(new int(1)), b(new int(2));
+    jrSTL::shared_ptr<int> slot = a;
+    ASSERT_FALSE(jrSTL::atomic_is_lock_free(&slot));
+    ASSERT_EQ(*jrSTL::atomic_load(&slot), 1);
+    jrSTL::shared_ptr<int> old = jrSTL::atomic_exchange(&slot, b);
+    ASSERT_EQ(old, a);
+    ASSERT_EQ(jrSTL::atomic_load(&slot), b);
+    ASSERT_EQ(b.use_count(), 2);
+
+    // 期望值不符时得到当前值
+    jrSTL::shared_ptr<int> expected = a;
+    ASSERT_FALSE(jrSTL::atomic_compare_exchange_strong(&slot, &expected, a));
+    ASSERT_EQ(expected, b);
+    ASSERT_TRUE(jrSTL::atomic_compare_exchange_strong(&slot, &expected, a));
+    ASSERT_EQ(jrSTL::atomic_load(&slot), a);
+    ASSERT_EQ(b.use_count(), 2);
+    expected.reset();
+    ASSERT_EQ(b.use_count(), 1);
+
+    jrSTL::atomic_store(&slot, jrSTL::shared_ptr<int>());
+    ASSERT_FALSE(jrSTL::atomic_load(&slot));
+    ASSERT_EQ(a.use_count(), 2);
+}
+
+/*一个写者、多个读者并发发布快照*/
+TEST(testCase, atomic_shared_ptr_snapshot_test) {
+    static std::atomic<int> alive(0);
+    struct snapshot {
+        long a, b;
+        snapshot(long x) : a(x), b(2 * x) { ++alive; }
+        ~snapshot() { a = b = -1; --alive; }
+    };
+
+    {
+        jrSTL::atomic_shared_ptr<snapshot> cur(jrSTL::make_shared<snapshot>(0));
+        std::atomic<bool> done(false);
+        std::vector<std::thread> readers;
+        for(int t = 0; t < 3; ++t) {
+            readers.push_back(std::thread([&cur, &done]() {
+                long last = 0;
+                while(!done.load()) {
+                    jrSTL::shared_ptr<snapshot> s = cur.load();
+                    ASSERT_EQ(s->b, 2 * s->a);
+                    ASSERT_GE(s->a, last);
+                    last = s->a;
+                }
+            }));
+        }
+        for(long i = 1; i <= 20000; ++i)
+            cur.store(jrSTL::make_shared<snapshot>(i));
+        done = true;
+        for(auto& t : readers)
+            t.join();
+        ASSERT_EQ(cur.load()->a, 20000);
+        ASSERT_EQ(alive.load(), 1);
+    }
+    ASSERT_EQ(alive.load(), 0);
+
+    // 多个线程用compare_exchange_weak累加，每次都换入新对象
+    jrSTL::atomic_shared_ptr<long> counter(jrSTL::make_shared<long>(0));
+    std::vector<std::thread> ts;
+    for(int t = 0; t < 4; ++t) {
+        ts.push_back(std::thread([&counter]() {
+            for(int i = 0; i < 5000; ++i) {
+                jrSTL::shared_ptr<long> e = counter.load();
+                while(!counter.compare_exchange_weak(e, jrSTL::make_shared<long>(*e + 1)))
+                    ;
+            }
+        }));
+    }
+    for(auto& t : ts)
+        t.join();
+    ASSERT_EQ(*counter.load(), 20000);
+}
+
+#ifdef JRSTL_ATOMIC_SHARED_PTR_PACKED
+// shared_ptr中控制块指针所在的字，高16位为读者计数
+template< class T >
+static jrSTL::_control_block_base **cb_slot(jrSTL::shared_ptr<T>& p) {
+    return reinterpret_cast<jrSTL::_control_block_base**>(reinterpret_cast<char*>(&p) + sizeof(T*));
+}
+
+template< class T >
+static uintptr_t reader_field(jrSTL::shared_ptr<T>& p) {
+    return jrSTL::_sp_atomic::_load(cb_slot(p)) >> 48;
+}
+
+/*写者解锁不能清掉持有写者标记期间进入又将退出的读者计数*/
+TEST(testCase, atomic_shared_ptr_unlock_keeps_readers_test) {
+    typedef jrSTL::_sp_atomic sp_atomic;
+    jrSTL::shared_ptr<int> slot(new int(1));
+    jrSTL::_control_block_base **w = cb_slot(slot);
+    // 写者取得标记并等到读者归0之后，读者才加上计数、看到标记后准备退出
+    jrSTL::_control_block_base *cb = sp_atomic::_lock(w);
+    sp_atomic::_fetch_add(w, sp_atomic::_reader);
+    sp_atomic::_unlock(w, cb, cb);
+    ASSERT_EQ(reader_field(slot), 1u);
+    sp_atomic::_fetch_sub(w, sp_atomic::_reader);
+    ASSERT_EQ(reader_field(slot), 0u);
+    ASSERT_EQ(*slot, 1);
+    jrSTL::atomic_store(&slot, jrSTL::make_shared<int>(2));
+    ASSERT_EQ(*jrSTL::atomic_load(&slot), 2);
+    ASSERT_EQ(reader_field(slot), 0u);
+}
+
+/*高16位不为0的控制块地址（带标记的指针、LA57下的高地址）不能与读者计数打包*/
+TEST(testCase, atomic_shared_ptr_packable_test) {
+    typedef jrSTL::_sp_atomic sp_atomic;
+    jrSTL::shared_ptr<int> sp(new int(1));
+    ASSERT_TRUE(sp_atomic::_packable(*cb_slot(sp)));
+    ASSERT_TRUE(sp_atomic::_packable(nullptr));
+    ASSERT_FALSE(sp_atomic::_packable(reinterpret_cast<jrSTL::_control_block_base*>(
+        (uintptr_t(0x2a) << 56) | 0x1000)));
+    ASSERT_FALSE(sp_atomic::_packable(reinterpret_cast<jrSTL::_control_block_base*>(
+        uintptr_t(1) << 52)));
+}
+#endif
+
+/*多个写者与多个读者同时竞争*/
+TEST(testCase, atomic_shared_ptr_writers_readers_stress_test) {
+    static std::atomic<int> alive(0);
+    struct node {
+        long v;
+        node(long x) : v(x) { ++alive; }
+        ~node() { v = -1; --alive; }
+    };
+
+    {
+        jrSTL::shared_ptr<node> slot = jrSTL::make_shared<node>(0);
+        std::atomic<int> writers_left(4);
+        std::vector<std::thread> ts;
+        for(int t = 0; t < 4; ++t) {
+            ts.push_back(std::thread([&slot, &writers_left, t]() {
+                for(long i = 1; i <= 5000; ++i) {
+                    if(i % 2)
+                        jrSTL::atomic_store(&slot, jrSTL::make_shared<node>(i * 4 + t));
+                    else
+                        jrSTL::atomic_exchange(&slot, jrSTL::make_shared<node>(i * 4 + t));
+                    if(i % 64 == 0)
+                        std::this_thread::yield();
+                }
+                --writers_left;
+            }));
+            ts.push_back(std::thread([&slot, &writers_left]() {
+                while(writers_left.load() > 0) {
+                    jrSTL::shared_ptr<node> s = jrSTL::atomic_load(&slot);
+                    ASSERT_GE(s->v, 0);
+                }
+            }));
+        }
+        for(auto& t : ts)
+            t.join();
+        // 全部线程退出后读者计数必须为0，且仍可以继续写入
+#ifdef JRSTL_ATOMIC_SHARED_PTR_PACKED
+        ASSERT_EQ(reader_field(slot), 0u);
+#endif
+        ASSERT_EQ(slot.use_count(), 1);
+        jrSTL::atomic_store(&slot, jrSTL::make_shared<node>(0));
+#ifdef JRSTL_ATOMIC_SHARED_PTR_PACKED
+        ASSERT_EQ(reader_field(slot), 0u);
+#endif
+        ASSERT_EQ(alive.load(), 1);
+    }
+    ASSERT_EQ(alive.load(), 0);
+}
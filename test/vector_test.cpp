@@ -2,6 +2,7 @@
 #include <random>
 #include <iostream>
 #include <vector>
+#include <string>
 #include "../container/sequence/jr_vector.h"
 
 #define MAX_SIZE 2000
@@ -320,6 +321,27 @@ TEST(testCase, vector_erase_test) {
     EXPECT_EQ(src.size(), des.size());
 }
 
+// 非平凡类型的erase与clear：后部元素前移，尾部多余的元素析构
+TEST(testCase, vector_erase_nontrivial_test) {
+    jrSTL::vector<std::string> des;
+    std::vector<std::string> src;
+    for(int i = 0; i < 50; ++i) {
+        des.push_back(std::to_string(i));
+        src.push_back(std::to_string(i));
+    }
+    EXPECT_EQ(*des.erase(des.begin() + 5, des.begin() + 20),
+              *src.erase(src.begin() + 5, src.begin() + 20));
+    EXPECT_EQ(*des.erase(des.begin()), *src.erase(src.begin()));
+    auto it = des.erase(des.end() - 3, des.end());
+    EXPECT_EQ(it, des.end());
+    src.erase(src.end() - 3, src.end());
+    ASSERT_EQ(des.size(), src.size());
+    for(size_t i = 0; i < des.size(); ++i)
+        EXPECT_EQ(des[i], src[i]);
+    des.clear();
+    EXPECT_TRUE(des.empty());
+}
+
 // swap测试
 TEST(testCase, vector_swap_test) {
     size_t cnt;
@@ -349,6 +371,61 @@ TEST(testCase, vector_shrink_to_fit_test) {
     EXPECT_EQ(des.capacity(), 5);
 }
 
+// 扩容策略测试：各策略下内容与std一致，重新分配次数符合策略的增长方式
+template<class Vec>
+void growth_policy_check(size_t cnt, const std::vector<int>& src) {
+    Vec des;
+    size_t growth = des.reallocation_count();
+    for(size_t i = 0; i < cnt; i++) {
+        size_t cap = des.capacity();
+        des.push_back(src[i]);
+        EXPECT_GE(des.capacity(), des.size());
+        if(des.capacity() != cap)
+            ++growth;
+    }
+    EXPECT_EQ(growth, des.reallocation_count());
+    ASSERT_EQ(src.size(), des.size());
+    for(size_t i = 0; i < cnt; i++)
+        EXPECT_EQ(src[i], des[i]);
+    des.insert(des.begin(), cnt, 7);
+    EXPECT_EQ(cnt * 2, des.size());
+    EXPECT_EQ(7, des.front());
+    EXPECT_EQ(src.back(), des.back());
+}
+
+TEST(testCase, vector_growth_policy_test) {
+    size_t cnt;
+    int var;
+    get_random_size_var(MAX_SIZE * 10, cnt, var, 100);
+    std::vector<int> src;
+    for(size_t i = 0; i < cnt; i++)
+        src.push_back(var + static_cast<int>(i));
+    typedef jrSTL::allocator<int> alloc;
+    growth_policy_check<jrSTL::vector<int> >(cnt, src);
+    growth_policy_check<jrSTL::vector<int, alloc, jrSTL::vector_growth_golden> >(cnt, src);
+    growth_policy_check<jrSTL::vector<int, alloc, jrSTL::vector_growth_chunk<16> > >(cnt, src);
+    growth_policy_check<jrSTL::vector<int, alloc, jrSTL::vector_growth_paged<4096, 256> > >(cnt, src);
+
+    // 定长增长每次只多出一个Chunk，收缩时浪费不足一个Chunk则不重新分配
+    jrSTL::vector<int, alloc, jrSTL::vector_growth_chunk<16> > chunk;
+    for(size_t i = 0; i < 40; i++)
+        chunk.push_back(static_cast<int>(i));
+    EXPECT_EQ(48, chunk.capacity());
+    size_t count = chunk.reallocation_count();
+    chunk.shrink_to_fit();
+    EXPECT_EQ(count, chunk.reallocation_count());
+    chunk.reserve(100);
+    chunk.shrink_to_fit();
+    EXPECT_EQ(48, chunk.capacity());
+    EXPECT_EQ(count + 2, chunk.reallocation_count());
+
+    // 页对齐策略在大容量时按整页分配
+    jrSTL::vector<int, alloc, jrSTL::vector_growth_paged<4096, 4096> > paged;
+    for(size_t i = 0; i < 5000; i++)
+        paged.push_back(static_cast<int>(i));
+    EXPECT_EQ(0, paged.capacity() * sizeof(int) % 4096);
+}
+
 // 逆序访问测试
 TEST(testCase, vector_reverse_test) {
     size_t cnt;
@@ -368,3 +445,54 @@ TEST(testCase, vector_reverse_test) {
         ++it;
     }
 }
+
+// 重定位测试：声明为可平凡重定位的类型扩容时不调用拷贝/移动构造函数，
+// 非平凡类型扩容后内容保持不变
+struct reloc_record {
+    static int copies;
+    int key;
+    char payload[28];
+    explicit reloc_record(int k = 0) : key(k) {}
+    reloc_record(const reloc_record& x) : key(x.key) { ++copies; }
+    reloc_record(reloc_record&& x) : key(x.key) { ++copies; }
+};
+int reloc_record::copies = 0;
+
+namespace jrSTL {
+    template<>
+    struct is_trivially_relocatable<reloc_record> : std::true_type {};
+}
+
+TEST(testCase, vector_relocate_test) {
+    size_t cnt;
+    int var;
+    get_random_size_var(MAX_SIZE * 10, cnt, var, 100);
+    jrSTL::vector<reloc_record> des;
+    // 每次扩容只移动一次新插入的元素，已有元素按字节搬移
+    int growth = 0;
+    for(size_t i = 0; i < cnt; i++) {
+        size_t cap = des.capacity();
+        des.emplace_back(static_cast<int>(i));
+        if(des.capacity() != cap)
+            ++growth;
+    }
+    EXPECT_EQ(growth, reloc_record::copies);
+    reloc_record::copies = 0;
+    des.reserve(cnt * 4);
+    des.shrink_to_fit();
+    EXPECT_EQ(0, reloc_record::copies);
+    ASSERT_EQ(cnt, des.size());
+    for(size_t i = 0; i < cnt; i++)
+        EXPECT_EQ(static_cast<int>(i), des[i].key);
+    std::vector<std::string> src;
+    jrSTL::vector<std::string> str;
+    for(size_t i = 0; i < cnt; i++) {
+        src.push_back(std::to_string(i * 1000003));
+        str.push_back(std::to_string(i * 1000003));
+    }
+    str.reserve(cnt * 3);
+    str.shrink_to_fit();
+    ASSERT_EQ(src.size(), str.size());
+    for(size_t i = 0; i < cnt; i++)
+        EXPECT_EQ(src[i], str[i]);
+}
@@ -2,6 +2,8 @@
 #include "../memory/jr_smart_ptr.h"
 #include <string>
 #include <memory>
+#include <thread>
+#include <atomic>
 
 /*弱指针观察器功能测试*/
 std::string ob = "", ob0 = "";
@@ -121,3 +123,50 @@ TEST(testCase, weak_ptr_circle_ref_test) {
 
     ASSERT_EQ(circle, circle0);
 }
+
+/*lock与最后一个shared_ptr的释放并发测试*/
+TEST(testCase, weak_ptr_lock_race_test) {
+    static std::atomic<int> dtor(0);
+    struct Foo {
+        int bar = 42;
+        ~Foo() { bar = 0; ++dtor; }
+    };
+
+    for(int k = 0; k < 200; ++k) {
+        jrSTL::shared_ptr<Foo> sp(new Foo);
+        jrSTL::weak_ptr<Foo> wp(sp);
+        std::atomic<bool> go(false);
+        std::thread t([wp, &go]() {
+            while(!go.load())
+                std::this_thread::yield();
+            // 一旦lock失败，之后的lock都必须失败，且成功时对象一定完好
+            bool expired = false;
+            for(int i = 0; i < 1000; ++i) {
+                jrSTL::shared_ptr<Foo> p = wp.lock();
+                if(p) {
+                    ASSERT_FALSE(expired);
+                    ASSERT_EQ(p->bar, 42);
+                } else {
+                    expired = true;
+                }
+            }
+        });
+        go = true;
+        sp.reset();
+        t.join();
+        ASSERT_TRUE(wp.expired());
+        ASSERT_EQ(dtor.load(), k + 1);
+    }
+
+    jrSTL::weak_ptr<int> empty;
+    ASSERT_TRUE(empty.expired());
+    ASSERT_FALSE(empty.lock());
+    jrSTL::weak_ptr<int> dead;
+    {
+        jrSTL::shared_ptr<int> sp(new int(1));
+        dead = sp;
+        ASSERT_FALSE(dead.expired());
+    }
+    ASSERT_TRUE(dead.expired());
+    ASSERT_THROW(jrSTL::shared_ptr<int>{dead}, std::bad_weak_ptr);
+}